@@ -40,11 +40,14 @@
 #include <librepcb/core/library/pkg/package.h>
 #include <librepcb/core/library/sym/symbol.h>
 #include <librepcb/core/project/board/board.h>
+#include <librepcb/core/project/board/boardautorouter.h>
 #include <librepcb/core/project/board/boardd356netlistexport.h>
+#include <librepcb/core/project/board/boarddesignrules.h>
 #include <librepcb/core/project/board/boardfabricationoutputsettings.h>
 #include <librepcb/core/project/board/boardgerberexport.h>
 #include <librepcb/core/project/board/boardpickplacegenerator.h>
 #include <librepcb/core/project/board/drc/boarddesignrulecheck.h>
+#include <librepcb/core/project/board/drc/boarddesignrulechecksettings.h>
 #include <librepcb/core/project/bomgenerator.h>
 #include <librepcb/core/project/erc/electricalrulecheck.h>
 #include <librepcb/core/project/project.h>
@@ -52,6 +55,7 @@
 #include <librepcb/core/project/schematic/schematicpainter.h>
 #include <librepcb/core/utils/toolbox.h>
 
+#include <QtConcurrent>
 #include <QtCore>
 
 #include <algorithm>
@@ -117,6 +121,13 @@ int CommandLineInterface::execute(const QStringList& args) noexcept {
          "settings. If not set, the settings from the boards will be used "
          "instead."),
       tr("file"));
+  QCommandLineOption autorouteOption(
+      "autoroute",
+      tr("Route all airwires between pads of the boards automatically before "
+         "running the DRC or exports. Traces and vias get the minimum size "
+         "allowed by the board's design rules, on the board's grid. Pass '%1' "
+         "to save the modified project to disk.")
+          .arg("--save"));
   QCommandLineOption exportSchematicsOption(
       "export-schematics",
       tr("Export schematics to given file(s). Existing files will be "
@@ -243,6 +254,7 @@ int CommandLineInterface::execute(const QStringList& args) noexcept {
     parser.addOption(ercOption);
     parser.addOption(drcOption);
     parser.addOption(drcSettingsOption);
+    parser.addOption(autorouteOption);
     parser.addOption(exportSchematicsOption);
     parser.addOption(exportBomOption);
     parser.addOption(exportBoardBomOption);
@@ -341,6 +353,7 @@ int CommandLineInterface::execute(const QStringList& args) noexcept {
         parser.isSet(ercOption),  // run ERC
         parser.isSet(drcOption),  // run DRC
         parser.value(drcSettingsOption),  // DRC settings
+        parser.isSet(autorouteOption),  // run autorouter
         parser.values(exportSchematicsOption),  // export schematics
         parser.values(exportBomOption),  // export generic BOM
         parser.values(exportBoardBomOption),  // export board BOM
@@ -381,10 +394,10 @@ int CommandLineInterface::execute(const QStringList& args) noexcept {
 
 bool CommandLineInterface::openProject(
     const QString& projectFile, bool runErc, bool runDrc,
-    const QString& drcSettingsPath, const QStringList& exportSchematicsFiles,
-    const QStringList& exportBomFiles, const QStringList& exportBoardBomFiles,
-    const QString& bomAttributes, bool exportPcbFabricationData,
-    const QString& pcbFabricationSettingsPath,
+    const QString& drcSettingsPath, bool autoroute,
+    const QStringList& exportSchematicsFiles, const QStringList& exportBomFiles,
+    const QStringList& exportBoardBomFiles, const QString& bomAttributes,
+    bool exportPcbFabricationData, const QString& pcbFabricationSettingsPath,
     const QStringList& exportPnpTopFiles,
     const QStringList& exportPnpBottomFiles,
     const QStringList& exportNetlistFiles, const QStringList& boardNames,
@@ -523,6 +536,50 @@ bool CommandLineInterface::openProject(
       }
     }
 
+    // Autorouter
+    if (autoroute) {
+      print(tr("Run autorouter..."));
+      foreach (Board* board, boards) {
+        QElapsedTimer timer;
+        timer.start();
+        // Use the smallest dimensions allowed by the DRC settings. Disabled
+        // checks (zero values) fall back to the default DRC settings.
+        const BoardDesignRuleCheckSettings& drcSettings =
+            board->getDrcSettings();
+        const BoardDesignRuleCheckSettings defaultDrcSettings;
+        auto getMin = [](const UnsignedLength& value,
+                         const UnsignedLength& fallback) {
+          return PositiveLength((*value > 0) ? *value : *fallback);
+        };
+        const PositiveLength traceWidth =
+            getMin(drcSettings.getMinCopperWidth(),
+                   defaultDrcSettings.getMinCopperWidth());
+        const PositiveLength viaDrill =
+            getMin(drcSettings.getMinPthDrillDiameter(),
+                   defaultDrcSettings.getMinPthDrillDiameter());
+        const Length viaAnnularRing = std::max(
+            *board->getDesignRules().getViaAnnularRing().calcValue(*viaDrill),
+            *drcSettings.getMinPthAnnularRing());
+        const PositiveLength viaSize(*viaDrill + viaAnnularRing * 2);
+        try {
+          BoardAutoRouter router(*board, traceWidth, viaSize, viaDrill,
+                                 board->getGridInterval());
+          const BoardAutoRouter::Result result = router.route();  // can throw
+          qDebug() << "Autorouted board in" << timer.elapsed() << "ms.";
+          print("  " %
+                tr("Board '%1': Routed %2 of %3 airwires.")
+                    .arg(*board->getName())
+                    .arg(result.routedAirWires)
+                    .arg(result.routedAirWires + result.failedAirWires));
+        } catch (const Exception& e) {
+          printErr("  " %
+                   tr("ERROR: Failed to autoroute board '%1': %2")
+                       .arg(*board->getName(), e.getMsg()));
+          success = false;
+        }
+      }
+    }
+
     // DRC
     if (runDrc) {
       print(tr("Run DRC..."));
@@ -542,14 +599,51 @@ bool CommandLineInterface::openProject(
           boardsToCheck.clear();  // avoid exporting any boards
         }
       }
+      // Planes and airwires are rebuilt sequentially in the main thread since
+      // this modifies the boards. Afterwards the boards are only read, so the
+      // checks of all boards run in parallel. The results are printed in the
+      // order of the boards.
+      struct DrcJob {
+        Board* board;
+        std::shared_ptr<BoardDesignRuleCheck> drc;
+        QString error;
+      };
+      QVector<DrcJob> jobs;
       foreach (Board* board, boardsToCheck) {
-        print("  " % tr("Board '%1':").arg(*board->getName()));
-        BoardDesignRuleCheck drc(
-            *board, customSettings ? *customSettings : board->getDrcSettings());
-        drc.execute(false);
+        DrcJob job{board,
+                   std::make_shared<BoardDesignRuleCheck>(
+                       *board,
+                       customSettings ? *customSettings
+                                      : board->getDrcSettings()),
+                   QString()};
+        try {
+          job.drc->prepare(false);  // can throw
+        } catch (const Exception& e) {
+          job.error = e.getMsg();
+        }
+        jobs.append(job);
+      }
+      QtConcurrent::blockingMap(jobs, [](DrcJob& job) {
+        if (job.error.isNull()) {
+          try {
+            job.drc->runChecks();  // can throw
+          } catch (const Exception& e) {
+            job.error = e.getMsg();
+          }
+        }
+      });
+      int totalApprovedMsgCount = 0;
+      int totalNonApprovedMsgCount = 0;
+      foreach (const DrcJob& job, jobs) {
+        print("  " % tr("Board '%1':").arg(*job.board->getName()));
+        if (!job.error.isNull()) {
+          printErr("    " % tr("ERROR: %1").arg(job.error));
+          success = false;
+          continue;
+        }
         int approvedMsgCount = 0;
         const QStringList nonApproved = prepareRuleCheckMessages(
-            drc.getMessages(), board->getDrcMessageApprovals(),
+            job.drc->getMessages(), job.board->getDrcMessageApprovals(),
             approvedMsgCount);
         print("    " % tr("Approved messages: %1").arg(approvedMsgCount));
         print("    " %
@@ -558,6 +652,14 @@ bool CommandLineInterface::openProject(
           printErr("      - " % msg);
           success = false;
         }
+        totalApprovedMsgCount += approvedMsgCount;
+        totalNonApprovedMsgCount += nonApproved.count();
+      }
+      if (jobs.count() > 1) {
+        print("  " % tr("Total of all boards:"));
+        print("    " % tr("Approved messages: %1").arg(totalApprovedMsgCount));
+        print("    " %
+              tr("Non-approved messages: %1").arg(totalNonApprovedMsgCount));
       }
     }
 
@@ -59,7 +59,7 @@ public:
 
 private:  // Methods
   bool openProject(const QString& projectFile, bool runErc, bool runDrc,
-                   const QString& drcSettingsPath,
+                   const QString& drcSettingsPath, bool autoroute,
                    const QStringList& exportSchematicsFiles,
                    const QStringList& exportBomFiles,
                    const QStringList& exportBoardBomFiles,
@@ -22,11 +22,12 @@
  ******************************************************************************/
 #include "airwiresbuilder.h"
 
-#include <unordered_map>
+#include "delaunaytriangulation.h"
 
 #include <QtCore>
 
-#include <delaunay.h>
+#include <list>
+#include <tuple>
 
 /*******************************************************************************
  *  Namespace
@@ -44,13 +45,12 @@ public:
   ~AirWiresBuilderImpl() noexcept {}
 
   int addPoint(const Point& p) noexcept {
-    int id = mPoints.size();
-    mPoints.emplace_back(p.getX().toNm(), p.getY().toNm(), id);
-    return id;
+    mPoints.append(p);
+    return mPoints.count() - 1;
   }
 
   void addEdge(int p1, int p2) noexcept {
-    mEdges.emplace_back(mPoints[p1], mPoints[p2], -1);
+    mEdges.push_back(Edge{p1, p2, -1});
   }
 
   AirWiresBuilder::AirWires buildAirWires() noexcept {
@@ -58,30 +58,18 @@ public:
     uint connectedEdges = mEdges.size();
 
     // determine additional edges between found points (candidates for airwires)
-    if (mPoints.size() == 2) {
-      mEdges.emplace_back(mPoints[0], mPoints[1], -1);
-    } else if (mPoints.size() == 3) {
-      // manually triangulate since it is easy and more stable than the
-      // delaunay-triangulation library
-      mEdges.emplace_back(mPoints[0], mPoints[1], -1);
-      mEdges.emplace_back(mPoints[1], mPoints[2], -1);
-      mEdges.emplace_back(mPoints[2], mPoints[0], -1);
-    } else if (mPoints.size() >= 3) {
-      // since delaunay-triangulation sometimes doesn't work well, add fallback
-      // edges to make sure at least all points are connected somehow
-      for (std::size_t i = 1; i < mPoints.size(); ++i) {
-        mEdges.emplace_back(mPoints[i - 1], mPoints[i], -1);
-      }
-
-      // now run delaunay triangulation to add additional edges
-      delaunay::Delaunay<qreal> del;
-      del.triangulate(mPoints);
-      mEdges.insert(mEdges.end(), del.getEdges().begin(), del.getEdges().end());
+    foreach (const DelaunayTriangulation::Edge& edge,
+             DelaunayTriangulation::triangulate(mPoints)) {
+      mEdges.push_back(Edge{edge.first, edge.second, -1});
     }
 
     // determine weights of these new edges
     for (uint i = connectedEdges; i < mEdges.size(); ++i) {
-      mEdges[i].weight = mEdges[i].p1.dist2(mEdges[i].p2);
+      const Point& p1 = mPoints.at(mEdges[i].p1);
+      const Point& p2 = mPoints.at(mEdges[i].p2);
+      const qreal dx = p2.getX().toNm() - p1.getX().toNm();
+      const qreal dy = p2.getY().toNm() - p1.getY().toNm();
+      mEdges[i].weight = dx * dx + dy * dy;
     }
 
     // find airwires in list of edges
@@ -90,6 +78,13 @@ public:
 
   AirWiresBuilderImpl& operator=(const AirWiresBuilderImpl& rhs) = delete;
 
+private:  // Types
+  struct Edge {
+    int p1;
+    int p2;
+    qreal weight;  ///< Squared length, or -1 for already connected edges
+  };
+
 private:  // Methods
   // adapted from horizon/kicad
   AirWiresBuilder::AirWires kruskalMst() noexcept {
@@ -98,17 +93,13 @@ private:  // Methods
     unsigned int mstSize = 0;
     bool ratsnestLines = false;
 
-    // printf("mst nodes : %d edges : %d\n", mPoints.size(), mEdges.size () );
     // The output
     AirWiresBuilder::AirWires mst;
 
     // Set tags for marking cycles
-    std::unordered_map<int, int> tags;
-    unsigned int tag = 0;
-
-    for (auto& node : mPoints) {
-      node.tag = tag;
-      tags[node.id] = tag++;
+    QVector<int> tags(nodeNumber);
+    for (unsigned int i = 0; i < nodeNumber; ++i) {
+      tags[i] = i;
     }
 
     // Lists of nodes connected together (subtrees) to detect cycles in the
@@ -117,61 +108,38 @@ private:  // Methods
 
     for (unsigned int i = 0; i < nodeNumber; ++i) cycles[i].push_back(i);
 
-    // Kruskal algorithm requires edges to be sorted by their weight
-    std::sort(
-        mEdges.begin(), mEdges.end(),
-        [](const delaunay::Edge<qreal>& a, const delaunay::Edge<qreal>& b) {
-          return a.weight > b.weight;
-        });
+    // Kruskal algorithm requires edges to be sorted by their weight. Edges of
+    // the same weight are sorted by their points to get a deterministic
+    // result.
+    std::sort(mEdges.begin(), mEdges.end(), [](const Edge& a, const Edge& b) {
+      return std::tie(a.weight, a.p1, a.p2) > std::tie(b.weight, b.p1, b.p2);
+    });
 
     while (mstSize < mstExpectedSize && !mEdges.empty()) {
       auto& dt = mEdges.back();
 
-      int srcTag = tags[dt.p1.id];
-      int trgTag = tags[dt.p2.id];
-      // printf("mstSize %d %d %f %d<>%d\n", mstSize, mstExpectedSize,
-      // dt.weight, srcTag, trgTag);
+      int srcTag = tags[dt.p1];
+      int trgTag = tags[dt.p2];
 
       // Check if by adding this edge we are going to join two different
       // forests
       if (srcTag != trgTag) {
         // Because edges are sorted by their weight, first we always process
-        // connected
-        // items (weight == 0). Once we stumble upon an edge with non-zero
-        // weight,
-        // it means that the rest of the lines are ratsnest.
+        // connected items (weight < 0). Once we stumble upon an edge with
+        // non-negative weight, it means that the rest of the lines are
+        // ratsnest.
         if (!ratsnestLines && dt.weight >= 0) ratsnestLines = true;
 
         // Update tags
+        for (auto it = cycles[trgTag].begin(); it != cycles[trgTag].end();
+             ++it) {
+          tags[*it] = srcTag;
+        }
+
         if (ratsnestLines) {
-          for (auto it = cycles[trgTag].begin(); it != cycles[trgTag].end();
-               ++it) {
-            tags[mPoints[*it].id] = srcTag;
-          }
-
-          // Do a copy of edge, but make it RN_EDGE_MST. In contrary to
-          // RN_EDGE,
-          // RN_EDGE_MST saves both source and target node and does not
-          // require any other
-          // edges to exist for getting source/target nodes
-          // CN_EDGE newEdge ( dt.GetSourceNode(), dt.GetTargetNode(),
-          // dt.GetWeight() );
-
-          // assert( newEdge.GetSourceNode()->GetTag() !=
-          // newEdge.GetTargetNode()->GetTag() );
-          // assert(dt.p1.tag != dt.p2.tag);
-          mst.append(std::make_pair(dt.p1.id, dt.p2.id));
+          mst.append(std::make_pair(dt.p1, dt.p2));
           ++mstSize;
         } else {
-          // for( it = cycles[trgTag].begin(), itEnd =
-          // cycles[trgTag].end(); it != itEnd; ++it )
-          // for( auto it : cycles[trgTag] )
-          for (auto it = cycles[trgTag].begin(); it != cycles[trgTag].end();
-               ++it) {
-            tags[mPoints[*it].id] = srcTag;
-            mPoints[*it].tag = srcTag;
-          }
-
           // Processing a connection, decrease the expected size of the
           // ratsnest MST
           --mstExpectedSize;
@@ -190,8 +158,8 @@ private:  // Methods
   }
 
 private:  // Data
-  std::vector<delaunay::Vector2<qreal>> mPoints;
-  std::vector<delaunay::Edge<qreal>> mEdges;
+  QVector<Point> mPoints;
+  std::vector<Edge> mEdges;
 };
 
 /*******************************************************************************
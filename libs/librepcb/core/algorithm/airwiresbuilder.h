@@ -40,6 +40,11 @@ class AirWiresBuilderImpl;
 
 /**
  * @brief The AirWiresBuilder class
+ *
+ * Determines the air wires of a net as the minimum spanning tree of all
+ * points, taking already connected points into account. Candidate edges are
+ * obtained with ::librepcb::DelaunayTriangulation since the euclidean
+ * minimum spanning tree is a subgraph of the delaunay triangulation.
  */
 class AirWiresBuilder final {
   Q_DECLARE_TR_FUNCTIONS(AirWiresBuilder)
@@ -97,9 +102,9 @@ public:
 
 private:  // Data
   /**
-   * The actual implementation is in the *.cpp file to make the dependency to
-   * the delaunay triangulation library a private implementation detail. So
-   * all other libraries do not need this dependency.
+   * The actual implementation is in the *.cpp file to keep the delaunay
+   * triangulation and the minimum spanning tree algorithm a private
+   * implementation detail.
    */
   QScopedPointer<AirWiresBuilderImpl> mImpl;
 };
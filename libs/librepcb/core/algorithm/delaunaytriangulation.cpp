@@ -0,0 +1,393 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "delaunaytriangulation.h"
+
+#include <QtConcurrent/QtConcurrent>
+#include <QtCore>
+
+#include <algorithm>
+#include <tuple>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Data Structs
+ ******************************************************************************/
+
+/**
+ * @brief One of the four directed (primal or dual) edges of a quad edge
+ *
+ * Only the primal edges (index 0 and 2) have an origin vertex, the dual
+ * edges are only needed for the topological operations.
+ */
+struct DelaunayTriangulation::QuarterEdge {
+  QuarterEdge* next;  ///< Next edge counterclockwise around the origin
+  int org;  ///< Index of the origin vertex (-1 for dual edges)
+  int index;  ///< Index within the quad edge (0..3)
+
+  QuarterEdge* rot() noexcept { return (index < 3) ? (this + 1) : (this - 3); }
+  QuarterEdge* invRot() noexcept {
+    return (index > 0) ? (this - 1) : (this + 3);
+  }
+  QuarterEdge* sym() noexcept { return (index < 2) ? (this + 2) : (this - 2); }
+  QuarterEdge* oNext() noexcept { return next; }
+  QuarterEdge* oPrev() noexcept { return rot()->next->rot(); }
+  QuarterEdge* lNext() noexcept { return invRot()->next->rot(); }
+  QuarterEdge* rPrev() noexcept { return sym()->next; }
+  int dest() noexcept { return sym()->org; }
+};
+
+struct DelaunayTriangulation::QuadEdge {
+  QuarterEdge edges[4];
+  bool deleted;
+};
+
+/**
+ * @brief Unsigned 128 bit integer, just enough for the in-circle predicate
+ */
+struct DelaunayTriangulation::UInt128 {
+  quint64 high;
+  quint64 low;
+
+  static UInt128 multiply(quint64 a, quint64 b) noexcept {
+    const quint64 a0 = a & 0xFFFFFFFFu;
+    const quint64 a1 = a >> 32;
+    const quint64 b0 = b & 0xFFFFFFFFu;
+    const quint64 b1 = b >> 32;
+    const quint64 p00 = a0 * b0;
+    const quint64 p01 = a0 * b1;
+    const quint64 p10 = a1 * b0;
+    const quint64 p11 = a1 * b1;
+    const quint64 mid =
+        (p00 >> 32) + (p01 & 0xFFFFFFFFu) + (p10 & 0xFFFFFFFFu);
+    return UInt128{p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32),
+                   (p00 & 0xFFFFFFFFu) | (mid << 32)};
+  }
+
+  UInt128& operator+=(const UInt128& rhs) noexcept {
+    low += rhs.low;
+    high += rhs.high + ((low < rhs.low) ? 1 : 0);
+    return *this;
+  }
+
+  bool operator>(const UInt128& rhs) const noexcept {
+    return (high > rhs.high) || ((high == rhs.high) && (low > rhs.low));
+  }
+};
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+QVector<DelaunayTriangulation::Edge> DelaunayTriangulation::triangulate(
+    const QVector<Point>& points, int minParallelPoints) noexcept {
+  QVector<Edge> edges;
+  if (points.count() < 2) {
+    return edges;
+  }
+
+  // Translate all points to non-negative coordinates and scale them down
+  // if needed, to avoid overflows in the exact predicates.
+  qint64 minX = points.first().getX().toNm();
+  qint64 minY = points.first().getY().toNm();
+  qint64 maxX = minX;
+  qint64 maxY = minY;
+  foreach (const Point& p, points) {
+    minX = std::min(minX, p.getX().toNm());
+    minY = std::min(minY, p.getY().toNm());
+    maxX = std::max(maxX, p.getX().toNm());
+    maxY = std::max(maxY, p.getY().toNm());
+  }
+  const quint64 span = std::max(static_cast<quint64>(maxX) - minX,
+                                static_cast<quint64>(maxY) - minY);
+  int shift = 0;
+  while ((span >> shift) > 0x7FFFFFFFu) {
+    ++shift;
+  }
+  QVector<Vertex> normalized;
+  normalized.reserve(points.count());
+  foreach (const Point& p, points) {
+    normalized.append(Vertex{
+        static_cast<qint64>((static_cast<quint64>(p.getX().toNm()) - minX) >>
+                            shift),
+        static_cast<qint64>((static_cast<quint64>(p.getY().toNm()) - minY) >>
+                            shift)});
+  }
+
+  // Sort the points by X and Y, and skip duplicates.
+  QVector<int> order(points.count());
+  for (int i = 0; i < order.count(); ++i) {
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(), [&normalized](int a, int b) {
+    const Vertex& va = normalized.at(a);
+    const Vertex& vb = normalized.at(b);
+    return std::make_tuple(va.x, va.y, a) < std::make_tuple(vb.x, vb.y, b);
+  });
+  QVector<Vertex> vertices;
+  QVector<int> indices;
+  vertices.reserve(order.count());
+  indices.reserve(order.count());
+  foreach (int i, order) {
+    const Vertex& v = normalized.at(i);
+    if ((!vertices.isEmpty()) && (vertices.last().x == v.x) &&
+        (vertices.last().y == v.y)) {
+      edges.append(std::make_pair(std::min(indices.last(), i),
+                                  std::max(indices.last(), i)));
+    } else {
+      vertices.append(v);
+      indices.append(i);
+    }
+  }
+
+  // Triangulate the distinct points. Each thread gets its own arena so
+  // edges can be allocated without locking.
+  if (vertices.count() >= 2) {
+    const int threads = std::max(QThread::idealThreadCount(), 1);
+    std::vector<Arena> arenas(threads);
+    build(vertices, 0, vertices.count(), arenas, 0, threads,
+          minParallelPoints);
+    for (const Arena& arena : arenas) {
+      for (const QuadEdge& quadEdge : arena) {
+        if (!quadEdge.deleted) {
+          const int p1 = indices.at(quadEdge.edges[0].org);
+          const int p2 = indices.at(quadEdge.edges[2].org);
+          edges.append(std::make_pair(std::min(p1, p2), std::max(p1, p2)));
+        }
+      }
+    }
+  }
+
+  // The order of the arenas depends on the number of threads, thus sort the
+  // edges to make the result fully deterministic.
+  std::sort(edges.begin(), edges.end());
+  return edges;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+DelaunayTriangulation::Hull DelaunayTriangulation::build(
+    const QVector<Vertex>& vertices, int begin, int end,
+    std::vector<Arena>& arenas, int arena, int arenaCount,
+    int minParallelPoints) noexcept {
+  Arena& edges = arenas[arena];
+  const int count = end - begin;
+  if (count == 2) {
+    QuarterEdge* a = makeEdge(edges, begin, begin + 1);
+    return std::make_pair(a, a->sym());
+  } else if (count == 3) {
+    QuarterEdge* a = makeEdge(edges, begin, begin + 1);
+    QuarterEdge* b = makeEdge(edges, begin + 1, begin + 2);
+    splice(a->sym(), b);
+    const Vertex& v0 = vertices.at(begin);
+    const Vertex& v1 = vertices.at(begin + 1);
+    const Vertex& v2 = vertices.at(begin + 2);
+    if (isCcw(v0, v1, v2)) {
+      connect(edges, b, a);
+      return std::make_pair(a, b->sym());
+    } else if (isCcw(v0, v2, v1)) {
+      QuarterEdge* c = connect(edges, b, a);
+      return std::make_pair(c->sym(), c);
+    } else {
+      return std::make_pair(a, b->sym());  // Collinear.
+    }
+  }
+
+  const int mid = begin + count / 2;
+  Hull left, right;
+  if ((arenaCount > 1) && (count >= minParallelPoints)) {
+    const int leftArenas = arenaCount / 2;
+    QFuture<Hull> future = QtConcurrent::run([&]() {
+      return build(vertices, mid, end, arenas, arena + leftArenas,
+                   arenaCount - leftArenas, minParallelPoints);
+    });
+    left = build(vertices, begin, mid, arenas, arena, leftArenas,
+                 minParallelPoints);
+    right = future.result();
+  } else {
+    left = build(vertices, begin, mid, arenas, arena, 1, minParallelPoints);
+    right = build(vertices, mid, end, arenas, arena, 1, minParallelPoints);
+  }
+  return merge(vertices, left, right, edges);
+}
+
+DelaunayTriangulation::Hull DelaunayTriangulation::merge(
+    const QVector<Vertex>& vertices, const Hull& left, const Hull& right,
+    Arena& arena) noexcept {
+  auto isLeftOf = [&vertices](int v, QuarterEdge* e) {
+    return isCcw(vertices.at(v), vertices.at(e->org), vertices.at(e->dest()));
+  };
+  auto isRightOf = [&vertices](int v, QuarterEdge* e) {
+    return isCcw(vertices.at(v), vertices.at(e->dest()), vertices.at(e->org));
+  };
+
+  // Find the lower common tangent of both hulls.
+  QuarterEdge* ldo = left.first;
+  QuarterEdge* ldi = left.second;
+  QuarterEdge* rdi = right.first;
+  QuarterEdge* rdo = right.second;
+  while (true) {
+    if (isLeftOf(rdi->org, ldi)) {
+      ldi = ldi->lNext();
+    } else if (isRightOf(ldi->org, rdi)) {
+      rdi = rdi->rPrev();
+    } else {
+      break;
+    }
+  }
+  QuarterEdge* base = connect(arena, rdi->sym(), ldi);
+  if (ldi->org == ldo->org) {
+    ldo = base->sym();
+  }
+  if (rdi->org == rdo->org) {
+    rdo = base;
+  }
+
+  // Zip both triangulations together from bottom to top.
+  while (true) {
+    QuarterEdge* lcand = base->sym()->oNext();
+    if (isRightOf(lcand->dest(), base)) {
+      while (isInCircle(vertices.at(base->dest()), vertices.at(base->org),
+                        vertices.at(lcand->dest()),
+                        vertices.at(lcand->oNext()->dest()))) {
+        QuarterEdge* next = lcand->oNext();
+        deleteEdge(lcand);
+        lcand = next;
+      }
+    }
+    QuarterEdge* rcand = base->oPrev();
+    if (isRightOf(rcand->dest(), base)) {
+      while (isInCircle(vertices.at(base->dest()), vertices.at(base->org),
+                        vertices.at(rcand->dest()),
+                        vertices.at(rcand->oPrev()->dest()))) {
+        QuarterEdge* prev = rcand->oPrev();
+        deleteEdge(rcand);
+        rcand = prev;
+      }
+    }
+    const bool lvalid = isRightOf(lcand->dest(), base);
+    const bool rvalid = isRightOf(rcand->dest(), base);
+    if ((!lvalid) && (!rvalid)) {
+      break;  // Reached the upper common tangent.
+    }
+    if ((!lvalid) ||
+        (rvalid &&
+         isInCircle(vertices.at(lcand->dest()), vertices.at(lcand->org),
+                    vertices.at(rcand->org), vertices.at(rcand->dest())))) {
+      base = connect(arena, rcand, base->sym());
+    } else {
+      base = connect(arena, base->sym(), lcand->sym());
+    }
+  }
+  return std::make_pair(ldo, rdo);
+}
+
+DelaunayTriangulation::QuarterEdge* DelaunayTriangulation::makeEdge(
+    Arena& arena, int org, int dest) noexcept {
+  arena.emplace_back();
+  QuadEdge& q = arena.back();
+  for (int i = 0; i < 4; ++i) {
+    q.edges[i].index = i;
+    q.edges[i].org = -1;
+  }
+  q.edges[0].next = &q.edges[0];
+  q.edges[1].next = &q.edges[3];
+  q.edges[2].next = &q.edges[2];
+  q.edges[3].next = &q.edges[1];
+  q.edges[0].org = org;
+  q.edges[2].org = dest;
+  q.deleted = false;
+  return &q.edges[0];
+}
+
+DelaunayTriangulation::QuarterEdge* DelaunayTriangulation::connect(
+    Arena& arena, QuarterEdge* a, QuarterEdge* b) noexcept {
+  QuarterEdge* e = makeEdge(arena, a->dest(), b->org);
+  splice(e, a->lNext());
+  splice(e->sym(), b);
+  return e;
+}
+
+void DelaunayTriangulation::splice(QuarterEdge* a, QuarterEdge* b) noexcept {
+  QuarterEdge* alpha = a->oNext()->rot();
+  QuarterEdge* beta = b->oNext()->rot();
+  std::swap(a->next, b->next);
+  std::swap(alpha->next, beta->next);
+}
+
+void DelaunayTriangulation::deleteEdge(QuarterEdge* e) noexcept {
+  splice(e, e->oPrev());
+  splice(e->sym(), e->sym()->oPrev());
+  reinterpret_cast<QuadEdge*>(e - e->index)->deleted = true;
+}
+
+bool DelaunayTriangulation::isCcw(const Vertex& a, const Vertex& b,
+                                  const Vertex& c) noexcept {
+  // Coordinates are less than 2^31, so the products fit into 64 bits.
+  return ((b.x - a.x) * (c.y - a.y)) > ((b.y - a.y) * (c.x - a.x));
+}
+
+bool DelaunayTriangulation::isInCircle(const Vertex& a, const Vertex& b,
+                                       const Vertex& c,
+                                       const Vertex& d) noexcept {
+  // Sign of the 3x3 lifted determinant. The lifted coordinates and the 2x2
+  // minors are less than 2^63, so each product fits into 128 bits. Positive
+  // and negative terms are summed up separately to avoid signed arithmetic.
+  const qint64 adx = a.x - d.x;
+  const qint64 ady = a.y - d.y;
+  const qint64 bdx = b.x - d.x;
+  const qint64 bdy = b.y - d.y;
+  const qint64 cdx = c.x - d.x;
+  const qint64 cdy = c.y - d.y;
+  const quint64 lifts[3] = {
+      static_cast<quint64>(adx * adx) + static_cast<quint64>(ady * ady),
+      static_cast<quint64>(bdx * bdx) + static_cast<quint64>(bdy * bdy),
+      static_cast<quint64>(cdx * cdx) + static_cast<quint64>(cdy * cdy),
+  };
+  const qint64 minors[3] = {
+      (bdx * cdy) - (cdx * bdy),
+      (cdx * ady) - (adx * cdy),
+      (adx * bdy) - (bdx * ady),
+  };
+  UInt128 positive{0, 0};
+  UInt128 negative{0, 0};
+  for (int i = 0; i < 3; ++i) {
+    if (minors[i] > 0) {
+      positive += UInt128::multiply(lifts[i], static_cast<quint64>(minors[i]));
+    } else if (minors[i] < 0) {
+      negative += UInt128::multiply(lifts[i], static_cast<quint64>(-minors[i]));
+    }
+  }
+  return positive > negative;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
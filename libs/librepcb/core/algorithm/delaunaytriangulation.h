@@ -0,0 +1,123 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_DELAUNAYTRIANGULATION_H
+#define LIBREPCB_CORE_DELAUNAYTRIANGULATION_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../types/point.h"
+
+#include <QtCore>
+
+#include <deque>
+#include <vector>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class DelaunayTriangulation
+ ******************************************************************************/
+
+/**
+ * @brief Delaunay triangulation of a set of points
+ *
+ * Implements the divide-and-conquer algorithm of Guibas and Stolfi on a
+ * quad-edge data structure, which takes O(n*log(n)) time.
+ *
+ * All geometric predicates are evaluated exactly on integer coordinates, so
+ * collinear and cocircular points are handled robustly and the result does
+ * not depend on floating point rounding. To keep the predicates within 128
+ * bits, coordinates are translated to the origin and, only if the points span
+ * more than 2^31 nanometers (about 2.1 meters), scaled down by a power of two.
+ *
+ * Large point sets are split into halves which are triangulated in parallel.
+ * As the recursion does not depend on the thread scheduling, the result is
+ * the same as for a single-threaded run.
+ *
+ * Points at the same location are not part of the triangulation, instead
+ * each of them is connected to the first point at that location.
+ */
+class DelaunayTriangulation final {
+public:
+  // Types
+  typedef std::pair<int, int> Edge;
+
+  // Constructors / Destructor
+  DelaunayTriangulation() = delete;
+  DelaunayTriangulation(const DelaunayTriangulation& other) = delete;
+  ~DelaunayTriangulation() = delete;
+
+  // General Methods
+
+  /**
+   * @brief Triangulate a set of points
+   *
+   * @param points            The points to triangulate.
+   * @param minParallelPoints Minimum number of points of a subset to
+   *                          triangulate its two halves in parallel.
+   * @return  Edges of the triangulation as pairs of indices into `points`.
+   *          Each edge is returned once with the lower index first, and the
+   *          list is sorted.
+   */
+  static QVector<Edge> triangulate(const QVector<Point>& points,
+                                   int minParallelPoints = 10000) noexcept;
+
+  // Operator Overloadings
+  DelaunayTriangulation& operator=(const DelaunayTriangulation& rhs) = delete;
+
+private:  // Types
+  struct Vertex {
+    qint64 x;
+    qint64 y;
+  };
+  struct QuarterEdge;
+  struct QuadEdge;
+  struct UInt128;
+  typedef std::deque<QuadEdge> Arena;
+  typedef std::pair<QuarterEdge*, QuarterEdge*> Hull;
+
+private:  // Methods
+  static Hull build(const QVector<Vertex>& vertices, int begin, int end,
+                    std::vector<Arena>& arenas, int arena, int arenaCount,
+                    int minParallelPoints) noexcept;
+  static Hull merge(const QVector<Vertex>& vertices, const Hull& left,
+                    const Hull& right, Arena& arena) noexcept;
+  static QuarterEdge* makeEdge(Arena& arena, int org, int dest) noexcept;
+  static QuarterEdge* connect(Arena& arena, QuarterEdge* a,
+                              QuarterEdge* b) noexcept;
+  static void splice(QuarterEdge* a, QuarterEdge* b) noexcept;
+  static void deleteEdge(QuarterEdge* e) noexcept;
+  static bool isCcw(const Vertex& a, const Vertex& b,
+                    const Vertex& c) noexcept;
+  static bool isInCircle(const Vertex& a, const Vertex& b, const Vertex& c,
+                         const Vertex& d) noexcept;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
@@ -37,7 +37,8 @@ namespace librepcb {
 
 QString AttributeSubstitutor::substitute(QString str,
                                          const AttributeProvider* ap,
-                                         FilterFunction filter) noexcept {
+                                         FilterFunction filter,
+                                         Dependencies* dependencies) noexcept {
   int startPos = 0;
   int length = 0;
   int outerVariableStart = -1;
@@ -62,7 +63,7 @@ QString AttributeSubstitutor::substitute(QString str,
             key.length() - 2;  // do not search for variables in the value
         keyFound = true;
         break;
-      } else if ((getValueOfKey(key, value, ap)) &&
+      } else if ((getValueOfKey(key, value, ap, dependencies)) &&
                  (!keyBacktrace.contains(key))) {
         // replace "{{KEY}}" with the value of KEY
         str.replace(startPos, length, value);
@@ -82,6 +83,18 @@ QString AttributeSubstitutor::substitute(QString str,
   return str;
 }
 
+bool AttributeSubstitutor::dependenciesChanged(
+    const Dependencies& dependencies, const AttributeProvider* ap) noexcept {
+  for (auto it = dependencies.begin(); it != dependencies.end(); ++it) {
+    QString value;
+    getValueOfKey(it.key(), value, ap, nullptr);
+    if (value != it.value()) {
+      return true;
+    }
+  }
+  return false;
+}
+
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
@@ -90,7 +103,7 @@ bool AttributeSubstitutor::searchVariablesInText(const QString& text,
                                                  int startPos, int& pos,
                                                  int& length,
                                                  QStringList& keys) noexcept {
-  QRegularExpression re("\\{\\{(.*?)\\}\\}");
+  static const QRegularExpression re("\\{\\{(.*?)\\}\\}");
   QRegularExpressionMatch match = re.match(text, startPos);
   if (match.hasMatch() && match.capturedLength() > 0) {
     pos = match.capturedStart();
@@ -120,11 +133,16 @@ void AttributeSubstitutor::applyFilter(QString& str, int& start, int& end,
 }
 
 bool AttributeSubstitutor::getValueOfKey(const QString& key, QString& value,
-                                         const AttributeProvider* ap) noexcept {
+                                         const AttributeProvider* ap,
+                                         Dependencies* dependencies) noexcept {
   if (ap) {
     value = ap->getAttributeValue(key);
+    if (dependencies) {
+      dependencies->insert(key, value);
+    }
     return !value.isEmpty();
   } else {
+    value.clear();
     return false;
   }
 }
@@ -60,6 +60,10 @@ class AttributeSubstitutor final {
 public:
   using FilterFunction = std::function<QString(const QString&)>;
 
+  /// Attribute keys looked up during a substitution, with their values at
+  /// that time (empty if the attribute did not exist)
+  using Dependencies = QHash<QString, QString>;
+
   // Constructors / Destructor / Operator Overloadings
   AttributeSubstitutor() = delete;
   AttributeSubstitutor(const AttributeSubstitutor& other) = delete;
@@ -79,11 +83,34 @@ public:
    *                  be passed to this function first. This allows for example
    *                  to remove invalid characters if the resulting string is
    *                  used for a file path.
+   * @param dependencies  If not nullptr, all attributes looked up during the
+   *                      substitution (including the ones referenced by
+   *                      other attribute values) will be written into this
+   *                      map. See #dependenciesChanged().
    *
    * @return True if str was modified in some way, false if not
    */
   static QString substitute(QString str, const AttributeProvider* ap = nullptr,
-                            FilterFunction filter = nullptr) noexcept;
+                            FilterFunction filter = nullptr,
+                            Dependencies* dependencies = nullptr) noexcept;
+
+  /**
+   * @brief Check if a substitution would lead to a different result now
+   *
+   * The result of #substitute() only depends on the values of the attributes
+   * it has looked up. So if none of their values has changed, substituting
+   * the same string again would return the same result. This is much cheaper
+   * to check than substituting again, and avoids updating texts which do not
+   * reference any of the modified attributes.
+   *
+   * @param dependencies  The dependencies determined by #substitute().
+   * @param ap            The attribute provider for attribute lookup (must be
+   *                      the same as passed to #substitute()).
+   *
+   * @return True if any of the attribute values has changed, false if not.
+   */
+  static bool dependenciesChanged(const Dependencies& dependencies,
+                                  const AttributeProvider* ap) noexcept;
 
 private:  // Methods
   /**
@@ -109,7 +136,8 @@ private:  // Methods
                           FilterFunction filter) noexcept;
 
   static bool getValueOfKey(const QString& key, QString& value,
-                            const AttributeProvider* ap) noexcept;
+                            const AttributeProvider* ap,
+                            Dependencies* dependencies) noexcept;
 };
 
 /*******************************************************************************
@@ -178,8 +178,17 @@ QByteArray TransactionalFileSystem::read(const QString& path) const {
 void TransactionalFileSystem::write(const QString& path,
                                     const QByteArray& content) {
   QString cleanedPath = cleanPath(path);
-  mModifiedFiles[cleanedPath] = content;
   mRemovedFiles.remove(cleanedPath);
+
+  // If the content is identical to the file on the disk, keep the file
+  // unmodified. Otherwise every save would write (and backup) all files even
+  // if only one of them was changed.
+  if ((!isRemoved(cleanedPath)) &&
+      isFileOnDiskEqualTo(cleanedPath, content)) {
+    mModifiedFiles.remove(cleanedPath);
+  } else {
+    mModifiedFiles[cleanedPath] = content;
+  }
 }
 
 void TransactionalFileSystem::removeFile(const QString& path) {
@@ -392,6 +401,20 @@ bool TransactionalFileSystem::isRemoved(const QString& path) const noexcept {
   return false;
 }
 
+bool TransactionalFileSystem::isFileOnDiskEqualTo(
+    const QString& path, const QByteArray& content) const noexcept {
+  const FilePath fp = mFilePath.getPathTo(path);
+  const QFileInfo info(fp.toStr());
+  if ((!info.isFile()) || (info.size() != content.size())) {
+    return false;  // Avoid reading the file if not needed.
+  }
+  try {
+    return FileUtils::readFile(fp) == content;  // can throw
+  } catch (const Exception& e) {
+    return false;
+  }
+}
+
 void TransactionalFileSystem::exportDirToZip(QuaZipFile& file,
                                              const FilePath& zipFp,
                                              const QString& dir,
@@ -198,6 +198,8 @@ public:
 
 private:  // Methods
   bool isRemoved(const QString& path) const noexcept;
+  bool isFileOnDiskEqualTo(const QString& path,
+                           const QByteArray& content) const noexcept;
   void exportDirToZip(QuaZipFile& file, const FilePath& zipFp,
                       const QString& dir, FilterFunction filter) const;
   void saveDiff(const QString& type) const;
@@ -26,11 +26,28 @@
 
 #include <QtCore>
 
+#include <map>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
 namespace librepcb {
 
+/*******************************************************************************
+ *  Struct PadGeometry::Cache
+ ******************************************************************************/
+
+struct PadGeometry::Cache {
+  /// Maximum number of cached #withOffset() results, to avoid unlimited
+  /// growth if many different offsets are requested (e.g. in editors)
+  static constexpr std::size_t sMaxOffsetVariants = 16;
+
+  QMutex mutex;
+  tl::optional<QVector<Path>> outlines;
+  tl::optional<PadGeometry> withoutHoles;
+  std::map<Length, PadGeometry> withOffset;
+};
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -42,7 +59,8 @@ PadGeometry::PadGeometry(const PadGeometry& other) noexcept
     mRadius(other.mRadius),
     mPath(other.mPath),
     mOffset(other.mOffset),
-    mHoles(other.mHoles) {
+    mHoles(other.mHoles),
+    mCache(other.mCache) {
 }
 
 PadGeometry::PadGeometry(Shape shape, const Length& width, const Length& height,
@@ -55,7 +73,8 @@ PadGeometry::PadGeometry(Shape shape, const Length& width, const Length& height,
     mRadius(radius),
     mPath(path),
     mOffset(offset),
-    mHoles(holes) {
+    mHoles(holes),
+    mCache(std::make_shared<Cache>()) {
 }
 
 PadGeometry::~PadGeometry() noexcept {
@@ -77,70 +96,11 @@ UnsignedLength PadGeometry::getCornerRadius() const noexcept {
  ******************************************************************************/
 
 QVector<Path> PadGeometry::toOutlines() const {
-  const Length w = getWidth();
-  const Length h = getHeight();
-  const UnsignedLength r = getCornerRadius();
-
-  QVector<Path> result;
-  switch (mShape) {
-    case Shape::RoundedRect: {
-      if ((w > 0) && (h > 0)) {
-        result.append(
-            Path::centeredRect(PositiveLength(w), PositiveLength(h), r));
-      }
-      break;
-    }
-    case Shape::RoundedOctagon: {
-      if ((w > 0) && (h > 0)) {
-        result.append(Path::octagon(PositiveLength(w), PositiveLength(h), r));
-      }
-      break;
-    }
-    case Shape::Stroke: {
-      if (w > 0) {
-        result = mPath.toOutlineStrokes(PositiveLength(w));
-        // Unite all outlines to get only a single, non-intersecting outline.
-        // Not needed if there's only one straight line segment since it
-        // cannot be self-intersecting.
-        if ((result.count() > 1) ||
-            ((result.count() == 1) &&
-             (mPath.getVertices().first().getAngle() != Angle::deg0()))) {
-          ClipperLib::Paths paths =
-              ClipperHelpers::convert(result, maxArcTolerance());
-          std::unique_ptr<ClipperLib::PolyTree> tree =
-              ClipperHelpers::uniteToTree(paths,
-                                          ClipperLib::pftNonZero);  // can throw
-          paths = ClipperHelpers::flattenTree(*tree);  // can throw
-          result = ClipperHelpers::convert(paths);
-        }
-      }
-      break;
-    }
-    case Shape::Custom: {
-      const Path outline = mPath.toClosedPath();
-      if (outline.getVertices().count() >= 3) {
-        // Note: If mOffset is zero, the offset operation sounds superfluous.
-        // However, this operation ensures that invalid outlines (e.g.
-        // overlaps or intersections) will be cleaned before any further
-        // processing of the pad shape (e.g. Gerber export).
-        ClipperLib::Paths paths{
-            ClipperHelpers::convert(outline, maxArcTolerance())};
-        std::unique_ptr<ClipperLib::PolyTree> tree =
-            ClipperHelpers::offsetToTree(paths, mOffset,
-                                         maxArcTolerance());  // can throw
-        paths = ClipperHelpers::flattenTree(*tree);  // can throw
-        result = ClipperHelpers::convert(paths);
-      }
-      break;
-    }
-    default: {
-      qCritical() << "Unhandled switch-case in PadGeometry::toOutlines():"
-                  << static_cast<int>(mShape);
-      Q_ASSERT(false);
-      break;
-    }
+  QMutexLocker lock(&mCache->mutex);
+  if (!mCache->outlines) {
+    mCache->outlines = buildOutlines();  // can throw
   }
-  return result;
+  return *mCache->outlines;
 }
 
 QPainterPath PadGeometry::toQPainterPathPx() const noexcept {
@@ -181,13 +141,35 @@ QPainterPath PadGeometry::toHolesQPainterPathPx() const noexcept {
 }
 
 PadGeometry PadGeometry::withOffset(const Length& offset) const noexcept {
-  return PadGeometry(mShape, mBaseWidth, mBaseHeight, mRadius, mPath,
-                     mOffset + offset, mHoles);
+  if (offset == 0) {
+    return *this;
+  }
+  QMutexLocker lock(&mCache->mutex);
+  auto it = mCache->withOffset.find(offset);
+  if (it == mCache->withOffset.end()) {
+    if (mCache->withOffset.size() >= Cache::sMaxOffsetVariants) {
+      mCache->withOffset.clear();
+    }
+    it = mCache->withOffset
+             .insert(std::make_pair(
+                 offset,
+                 PadGeometry(mShape, mBaseWidth, mBaseHeight, mRadius, mPath,
+                             mOffset + offset, mHoles)))
+             .first;
+  }
+  return it->second;
 }
 
 PadGeometry PadGeometry::withoutHoles() const noexcept {
-  return PadGeometry(mShape, mBaseWidth, mBaseHeight, mRadius, mPath, mOffset,
-                     PadHoleList{});
+  if (mHoles.isEmpty()) {
+    return *this;
+  }
+  QMutexLocker lock(&mCache->mutex);
+  if (!mCache->withoutHoles) {
+    mCache->withoutHoles = PadGeometry(mShape, mBaseWidth, mBaseHeight, mRadius,
+                                       mPath, mOffset, PadHoleList{});
+  }
+  return *mCache->withoutHoles;
 }
 
 /*******************************************************************************
@@ -252,9 +234,81 @@ PadGeometry& PadGeometry::operator=(const PadGeometry& rhs) noexcept {
   mPath = rhs.mPath;
   mOffset = rhs.mOffset;
   mHoles = rhs.mHoles;
+  mCache = rhs.mCache;
   return *this;
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+QVector<Path> PadGeometry::buildOutlines() const {
+  const Length w = getWidth();
+  const Length h = getHeight();
+  const UnsignedLength r = getCornerRadius();
+
+  QVector<Path> result;
+  switch (mShape) {
+    case Shape::RoundedRect: {
+      if ((w > 0) && (h > 0)) {
+        result.append(
+            Path::centeredRect(PositiveLength(w), PositiveLength(h), r));
+      }
+      break;
+    }
+    case Shape::RoundedOctagon: {
+      if ((w > 0) && (h > 0)) {
+        result.append(Path::octagon(PositiveLength(w), PositiveLength(h), r));
+      }
+      break;
+    }
+    case Shape::Stroke: {
+      if (w > 0) {
+        result = mPath.toOutlineStrokes(PositiveLength(w));
+        // Unite all outlines to get only a single, non-intersecting outline.
+        // Not needed if there's only one straight line segment since it
+        // cannot be self-intersecting.
+        if ((result.count() > 1) ||
+            ((result.count() == 1) &&
+             (mPath.getVertices().first().getAngle() != Angle::deg0()))) {
+          ClipperLib::Paths paths =
+              ClipperHelpers::convert(result, maxArcTolerance());
+          std::unique_ptr<ClipperLib::PolyTree> tree =
+              ClipperHelpers::uniteToTree(paths,
+                                          ClipperLib::pftNonZero);  // can throw
+          paths = ClipperHelpers::flattenTree(*tree);  // can throw
+          result = ClipperHelpers::convert(paths);
+        }
+      }
+      break;
+    }
+    case Shape::Custom: {
+      const Path outline = mPath.toClosedPath();
+      if (outline.getVertices().count() >= 3) {
+        // Note: If mOffset is zero, the offset operation sounds superfluous.
+        // However, this operation ensures that invalid outlines (e.g.
+        // overlaps or intersections) will be cleaned before any further
+        // processing of the pad shape (e.g. Gerber export).
+        ClipperLib::Paths paths{
+            ClipperHelpers::convert(outline, maxArcTolerance())};
+        std::unique_ptr<ClipperLib::PolyTree> tree =
+            ClipperHelpers::offsetToTree(paths, mOffset,
+                                         maxArcTolerance());  // can throw
+        paths = ClipperHelpers::flattenTree(*tree);  // can throw
+        result = ClipperHelpers::convert(paths);
+      }
+      break;
+    }
+    default: {
+      qCritical() << "Unhandled switch-case in PadGeometry::toOutlines():"
+                  << static_cast<int>(mShape);
+      Q_ASSERT(false);
+      break;
+    }
+  }
+  return result;
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -31,6 +31,8 @@
 
 #include <QtCore>
 
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -42,6 +44,13 @@ namespace librepcb {
 
 /**
  * @brief The PadGeometry class describes the shape of a pad
+ *
+ * Derived data which is expensive to calculate (the outlines returned by
+ * #toOutlines() and the geometries returned by #withOffset() and
+ * #withoutHoles()) is calculated lazily and cached. The cache is shared by
+ * all copies of an object, so for example all board pads of the same
+ * footprint pad calculate the (untransformed) outlines only once in total.
+ * Access to the cache is thread-safe.
  */
 class PadGeometry final {
   Q_DECLARE_TR_FUNCTIONS(PadGeometry)
@@ -98,6 +107,9 @@ public:
   }
   PadGeometry& operator=(const PadGeometry& rhs) noexcept;
 
+private:  // Types
+  struct Cache;
+
 private:  // Methods
   PadGeometry(Shape shape, const Length& width, const Length& height,
               const UnsignedLimitedRatio& radius, const Path& path,
@@ -112,6 +124,8 @@ private:  // Methods
     return PositiveLength(5000);
   }
 
+  QVector<Path> buildOutlines() const;
+
 private:  // Data
   Shape mShape;
   Length mBaseWidth;
@@ -120,6 +134,9 @@ private:  // Data
   Path mPath;
   Length mOffset;
   PadHoleList mHoles;
+
+  /// Lazily calculated derived data, shared by all copies of this object
+  std::shared_ptr<Cache> mCache;
 };
 
 /*******************************************************************************
@@ -109,6 +109,7 @@ FootprintPad::FootprintPad(const FootprintPad& other) noexcept
     mSolderPasteConfig(other.mSolderPasteConfig),
     mComponentSide(other.mComponentSide),
     mHoles(other.mHoles),
+    mGeometry(other.mGeometry),
     mHolesEditedSlot(*this, &FootprintPad::holesEdited) {
   mHoles.onEdited.attach(mHolesEditedSlot);
 }
@@ -134,6 +135,7 @@ FootprintPad::FootprintPad(
     mSolderPasteConfig(autoSolderPaste),
     mComponentSide(side),
     mHoles(holes),
+    mGeometry(buildGeometry()),
     mHolesEditedSlot(*this, &FootprintPad::holesEdited) {
   mHoles.onEdited.attach(mHolesEditedSlot);
 }
@@ -155,6 +157,7 @@ FootprintPad::FootprintPad(const SExpression& node)
         deserialize<MaskConfig>(node.getChild("solder_paste/@0"))),
     mComponentSide(deserialize<ComponentSide>(node.getChild("side/@0"))),
     mHoles(node),
+    mGeometry(buildGeometry()),
     mHolesEditedSlot(*this, &FootprintPad::holesEdited) {
   mHoles.onEdited.attach(mHolesEditedSlot);
 }
@@ -214,22 +217,6 @@ bool FootprintPad::hasAutoBottomSolderPaste() const noexcept {
       (isTht() != (mComponentSide == ComponentSide::Bottom));
 }
 
-PadGeometry FootprintPad::getGeometry() const noexcept {
-  switch (mShape) {
-    case Shape::RoundedRect:
-      return PadGeometry::roundedRect(mWidth, mHeight, mRadius, mHoles);
-    case Shape::RoundedOctagon:
-      return PadGeometry::roundedOctagon(mWidth, mHeight, mRadius, mHoles);
-    case Shape::Custom:
-      return PadGeometry::custom(mCustomShapeOutline, mHoles);
-    default:
-      qCritical() << "Unhandled switch-case in FootprintPad::getGeometry():"
-                  << static_cast<int>(mShape);
-      Q_ASSERT(false);
-      return PadGeometry::roundedRect(mWidth, mHeight, mRadius, mHoles);
-  }
-}
-
 /*******************************************************************************
  *  Setters
  ******************************************************************************/
@@ -270,6 +257,7 @@ bool FootprintPad::setShape(Shape shape) noexcept {
   }
 
   mShape = shape;
+  mGeometry = buildGeometry();
   onEdited.notify(Event::ShapeChanged);
   return true;
 }
@@ -280,6 +268,7 @@ bool FootprintPad::setWidth(const PositiveLength& width) noexcept {
   }
 
   mWidth = width;
+  mGeometry = buildGeometry();
   onEdited.notify(Event::WidthChanged);
   return true;
 }
@@ -290,6 +279,7 @@ bool FootprintPad::setHeight(const PositiveLength& height) noexcept {
   }
 
   mHeight = height;
+  mGeometry = buildGeometry();
   onEdited.notify(Event::HeightChanged);
   return true;
 }
@@ -300,6 +290,7 @@ bool FootprintPad::setRadius(const UnsignedLimitedRatio& radius) noexcept {
   }
 
   mRadius = radius;
+  mGeometry = buildGeometry();
   onEdited.notify(Event::RadiusChanged);
   return true;
 }
@@ -310,6 +301,7 @@ bool FootprintPad::setCustomShapeOutline(const Path& outline) noexcept {
   }
 
   mCustomShapeOutline = outline;
+  mGeometry = buildGeometry();
   onEdited.notify(Event::CustomShapeOutlineChanged);
   return true;
 }
@@ -429,6 +421,22 @@ UnsignedLimitedRatio FootprintPad::getRecommendedRadius(
  *  Private Methods
  ******************************************************************************/
 
+PadGeometry FootprintPad::buildGeometry() const noexcept {
+  switch (mShape) {
+    case Shape::RoundedRect:
+      return PadGeometry::roundedRect(mWidth, mHeight, mRadius, mHoles);
+    case Shape::RoundedOctagon:
+      return PadGeometry::roundedOctagon(mWidth, mHeight, mRadius, mHoles);
+    case Shape::Custom:
+      return PadGeometry::custom(mCustomShapeOutline, mHoles);
+    default:
+      qCritical() << "Unhandled switch-case in FootprintPad::buildGeometry():"
+                  << static_cast<int>(mShape);
+      Q_ASSERT(false);
+      return PadGeometry::roundedRect(mWidth, mHeight, mRadius, mHoles);
+  }
+}
+
 void FootprintPad::holesEdited(const PadHoleList& list, int index,
                                const std::shared_ptr<const PadHole>& hole,
                                PadHoleList::Event event) noexcept {
@@ -436,6 +444,7 @@ void FootprintPad::holesEdited(const PadHoleList& list, int index,
   Q_UNUSED(index);
   Q_UNUSED(hole);
   Q_UNUSED(event);
+  mGeometry = buildGeometry();
   onEdited.notify(Event::HolesEdited);
 }
 
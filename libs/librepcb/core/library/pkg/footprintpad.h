@@ -131,7 +131,7 @@ public:
   bool hasAutoBottomStopMask() const noexcept;
   bool hasAutoTopSolderPaste() const noexcept;
   bool hasAutoBottomSolderPaste() const noexcept;
-  PadGeometry getGeometry() const noexcept;
+  const PadGeometry& getGeometry() const noexcept { return mGeometry; }
 
   // Setters
   bool setPackagePadUuid(const tl::optional<Uuid>& pad) noexcept;
@@ -167,6 +167,7 @@ public:
       const PositiveLength& width, const PositiveLength& height) noexcept;
 
 private:  // Methods
+  PadGeometry buildGeometry() const noexcept;
   void holesEdited(const PadHoleList& list, int index,
                    const std::shared_ptr<const PadHole>& hole,
                    PadHoleList::Event event) noexcept;
@@ -192,6 +193,13 @@ private:  // Data
   ComponentSide mComponentSide;
   PadHoleList mHoles;  ///< If not empty, it's a THT pad.
 
+  /// The pad geometry, derived from the properties above
+  ///
+  /// Kept as a member (rather than built on demand) so all copies of it
+  /// (e.g. the geometries of all board pads of this footprint pad) share the
+  /// same cache of derived data, see ::librepcb::PadGeometry.
+  PadGeometry mGeometry;
+
   // Slots
   PadHoleList::OnEditedSlot mHolesEditedSlot;
 };
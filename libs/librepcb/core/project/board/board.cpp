@@ -75,6 +75,7 @@ Board::Board(Project& project,
     mDirectoryName(directoryName),
     mDirectory(std::move(directory)),
     mIsAddedToProject(false),
+    mIsModified(true),
     mDesignRules(new BoardDesignRules()),
     mDrcSettings(new BoardDesignRuleCheckSettings()),
     mFabricationOutputSettings(new BoardFabricationOutputSettings()),
@@ -156,9 +157,30 @@ QList<BI_Base*> Board::getAllItems() const noexcept {
  *  Setters
  ******************************************************************************/
 
+void Board::setName(const ElementName& name) noexcept {
+  mName = name;
+  setModified();
+}
+
+void Board::setDefaultFontName(const QString& name) noexcept {
+  mDefaultFontFileName = name;
+  setModified();
+}
+
+void Board::setGridInterval(const PositiveLength& interval) noexcept {
+  mGridInterval = interval;
+  setModified();
+}
+
+void Board::setGridUnit(const LengthUnit& unit) noexcept {
+  mGridUnit = unit;
+  setModified();
+}
+
 void Board::setInnerLayerCount(int count) noexcept {
   if (count != mInnerLayerCount) {
     mInnerLayerCount = count;
+    setModified();
     mCopperLayers.clear();
     mCopperLayers.insert(&Layer::topCopper());
     mCopperLayers.insert(&Layer::botCopper());
@@ -174,6 +196,7 @@ void Board::setInnerLayerCount(int count) noexcept {
 void Board::setDesignRules(const BoardDesignRules& rules) noexcept {
   if (rules != *mDesignRules) {
     *mDesignRules = rules;
+    setModified();
     emit designRulesModified();
     emit attributesChanged();
   }
@@ -182,6 +205,13 @@ void Board::setDesignRules(const BoardDesignRules& rules) noexcept {
 void Board::setDrcSettings(
     const BoardDesignRuleCheckSettings& settings) noexcept {
   *mDrcSettings = settings;
+  setModified();
+}
+
+void Board::setFabricationOutputSettings(
+    const BoardFabricationOutputSettings& settings) noexcept {
+  *mFabricationOutputSettings = settings;
+  setModified();
 }
 
 /*******************************************************************************
@@ -192,6 +222,7 @@ void Board::loadDrcMessageApprovals(
     const Version& version, const QSet<SExpression>& approvals) noexcept {
   mDrcMessageApprovalsVersion = version;
   mDrcMessageApprovals = approvals;
+  setModified();
 }
 
 bool Board::updateDrcMessageApprovals(QSet<SExpression> approvals,
@@ -210,6 +241,7 @@ bool Board::updateDrcMessageApprovals(QSet<SExpression> approvals,
   if (mDrcMessageApprovalsVersion < Application::getFileFormatVersion()) {
     mDrcMessageApprovalsVersion = Application::getFileFormatVersion();
     mDrcMessageApprovals &= approvals;
+    setModified();
     return true;
   }
 
@@ -219,6 +251,7 @@ bool Board::updateDrcMessageApprovals(QSet<SExpression> approvals,
       mDrcMessageApprovals - (mSupportedDrcMessageApprovals - approvals);
   if (approvals != mDrcMessageApprovals) {
     mDrcMessageApprovals = approvals;
+    setModified();
     return true;
   }
 
@@ -232,6 +265,7 @@ void Board::setDrcMessageApproved(const SExpression& approval,
   } else {
     mDrcMessageApprovals.remove(approval);
   }
+  setModified();
 }
 
 /*******************************************************************************
@@ -244,7 +278,8 @@ BI_Device* Board::getDeviceInstanceByComponentUuid(const Uuid& uuid) const
 }
 
 void Board::addDeviceInstance(BI_Device& instance) {
-  if ((mDeviceInstances.values().contains(&instance)) ||
+  if ((mDeviceInstances.value(instance.getComponentInstanceUuid()) ==
+       &instance) ||
       (&instance.getBoard() != this)) {
     throw LogicError(__FILE__, __LINE__);
   }
@@ -258,6 +293,7 @@ void Board::addDeviceInstance(BI_Device& instance) {
     instance.addToBoard();  // can throw
   }
   mDeviceInstances.insert(instance.getComponentInstanceUuid(), &instance);
+  setModified();
   emit deviceAdded(instance);
 }
 
@@ -270,6 +306,7 @@ void Board::removeDeviceInstance(BI_Device& instance) {
     instance.removeFromBoard();  // can throw
   }
   mDeviceInstances.remove(instance.getComponentInstanceUuid());
+  setModified();
   emit deviceRemoved(instance);
 }
 
@@ -278,7 +315,7 @@ void Board::removeDeviceInstance(BI_Device& instance) {
  ******************************************************************************/
 
 void Board::addNetSegment(BI_NetSegment& netsegment) {
-  if ((mNetSegments.values().contains(&netsegment)) ||
+  if ((mNetSegments.value(netsegment.getUuid()) == &netsegment) ||
       (&netsegment.getBoard() != this)) {
     throw LogicError(__FILE__, __LINE__);
   }
@@ -292,6 +329,7 @@ void Board::addNetSegment(BI_NetSegment& netsegment) {
     netsegment.addToBoard();  // can throw
   }
   mNetSegments.insert(netsegment.getUuid(), &netsegment);
+  setModified();
   emit netSegmentAdded(netsegment);
 }
 
@@ -303,6 +341,7 @@ void Board::removeNetSegment(BI_NetSegment& netsegment) {
     netsegment.removeFromBoard();  // can throw
   }
   mNetSegments.remove(netsegment.getUuid());
+  setModified();
   emit netSegmentRemoved(netsegment);
 }
 
@@ -311,7 +350,8 @@ void Board::removeNetSegment(BI_NetSegment& netsegment) {
  ******************************************************************************/
 
 void Board::addPlane(BI_Plane& plane) {
-  if ((mPlanes.values().contains(&plane)) || (&plane.getBoard() != this)) {
+  if ((mPlanes.value(plane.getUuid()) == &plane) ||
+      (&plane.getBoard() != this)) {
     throw LogicError(__FILE__, __LINE__);
   }
   if (mPlanes.contains(plane.getUuid())) {
@@ -323,6 +363,7 @@ void Board::addPlane(BI_Plane& plane) {
     plane.addToBoard();  // can throw
   }
   mPlanes.insert(plane.getUuid(), &plane);
+  setModified();
   emit planeAdded(plane);
 }
 
@@ -334,6 +375,7 @@ void Board::removePlane(BI_Plane& plane) {
     plane.removeFromBoard();  // can throw
   }
   mPlanes.remove(plane.getUuid());
+  setModified();
   emit planeRemoved(plane);
 }
 
@@ -349,12 +391,50 @@ void Board::rebuildAllPlanes() noexcept {
   }
 }
 
+void Board::rebuildPlanesInArea(const Point& dirtyMin,
+                                const Point& dirtyMax) noexcept {
+  QList<BI_Plane*> planes = mPlanes.values();
+  std::sort(planes.begin(), planes.end(),
+            [](const BI_Plane* p1, const BI_Plane* p2) {
+              return !(*p1 < *p2);
+            });  // sort by priority (highest priority first)
+  Point min(std::min(dirtyMin.getX(), dirtyMax.getX()),
+            std::min(dirtyMin.getY(), dirtyMax.getY()));
+  Point max(std::max(dirtyMin.getX(), dirtyMax.getX()),
+            std::max(dirtyMin.getY(), dirtyMax.getY()));
+  bool fullRebuild = false;
+  foreach (BI_Plane* plane, planes) {
+    BoardPlaneFragmentsBuilder builder(*plane);
+    if (fullRebuild) {
+      plane->setCalculatedFragments(builder.buildFragments());
+      continue;
+    }
+    const QVector<Path> oldFragments = plane->getFragments();
+    plane->setCalculatedFragments(builder.buildFragments(min, max));
+    // Planes with lower priority are affected by this plane up to their
+    // clearance around the modified area.
+    const Length clearance = *plane->getMinClearance();
+    min -= Point(clearance, clearance);
+    max += Point(clearance, clearance);
+    // Removing orphans is not limited to the modified area, so the fragments
+    // of this plane may also have changed somewhere else. In that case, the
+    // planes with lower priority need to be rebuilt completely.
+    // Vertices on the border of the area may be off by rounding, ignore them.
+    const Point tolerance(Length(10), Length(10));
+    if (!BoardPlaneFragmentsBuilder::differOnlyWithin(
+            oldFragments, plane->getFragments(), min - tolerance,
+            max + tolerance)) {
+      fullRebuild = true;
+    }
+  }
+}
+
 /*******************************************************************************
  *  Polygon Methods
  ******************************************************************************/
 
 void Board::addPolygon(BI_Polygon& polygon) {
-  if ((mPolygons.values().contains(&polygon)) ||
+  if ((mPolygons.value(polygon.getUuid()) == &polygon) ||
       (&polygon.getBoard() != this)) {
     throw LogicError(__FILE__, __LINE__);
   }
@@ -368,6 +448,7 @@ void Board::addPolygon(BI_Polygon& polygon) {
     polygon.addToBoard();  // can throw
   }
   mPolygons.insert(polygon.getUuid(), &polygon);
+  setModified();
   emit polygonAdded(polygon);
 }
 
@@ -379,6 +460,7 @@ void Board::removePolygon(BI_Polygon& polygon) {
     polygon.removeFromBoard();  // can throw
   }
   mPolygons.remove(polygon.getUuid());
+  setModified();
   emit polygonRemoved(polygon);
 }
 
@@ -387,7 +469,8 @@ void Board::removePolygon(BI_Polygon& polygon) {
  ******************************************************************************/
 
 void Board::addStrokeText(BI_StrokeText& text) {
-  if ((mStrokeTexts.values().contains(&text)) || (&text.getBoard() != this)) {
+  if ((mStrokeTexts.value(text.getUuid()) == &text) ||
+      (&text.getBoard() != this)) {
     throw LogicError(__FILE__, __LINE__);
   }
   if (mStrokeTexts.contains(text.getUuid())) {
@@ -400,6 +483,7 @@ void Board::addStrokeText(BI_StrokeText& text) {
     text.addToBoard();  // can throw
   }
   mStrokeTexts.insert(text.getUuid(), &text);
+  setModified();
   emit strokeTextAdded(text);
 }
 
@@ -411,6 +495,7 @@ void Board::removeStrokeText(BI_StrokeText& text) {
     text.removeFromBoard();  // can throw
   }
   mStrokeTexts.remove(text.getUuid());
+  setModified();
   emit strokeTextRemoved(text);
 }
 
@@ -419,7 +504,7 @@ void Board::removeStrokeText(BI_StrokeText& text) {
  ******************************************************************************/
 
 void Board::addHole(BI_Hole& hole) {
-  if ((mHoles.values().contains(&hole)) || (&hole.getBoard() != this)) {
+  if ((mHoles.value(hole.getUuid()) == &hole) || (&hole.getBoard() != this)) {
     throw LogicError(__FILE__, __LINE__);
   }
   if (mHoles.contains(hole.getUuid())) {
@@ -431,6 +516,7 @@ void Board::addHole(BI_Hole& hole) {
     hole.addToBoard();  // can throw
   }
   mHoles.insert(hole.getUuid(), &hole);
+  setModified();
   emit holeAdded(hole);
 }
 
@@ -442,6 +528,7 @@ void Board::removeHole(BI_Hole& hole) {
     hole.removeFromBoard();  // can throw
   }
   mHoles.remove(hole.getUuid());
+  setModified();
   emit holeRemoved(hole);
 }
 
@@ -514,6 +601,7 @@ void Board::copyFrom(const Board& other) {
   mCopperLayers = other.getCopperLayers();
   *mDesignRules = other.getDesignRules();
   *mFabricationOutputSettings = other.getFabricationOutputSettings();
+  setModified();
 
   // Copy device instances.
   QHash<const BI_Device*, BI_Device*> devMap;
@@ -638,6 +726,7 @@ void Board::addToProject() {
   }
 
   mIsAddedToProject = true;
+  mIsModified = true;  // The directory might not contain the board file yet.
   forceAirWiresRebuild();
   sgl.dismiss();
 }
@@ -664,8 +753,8 @@ void Board::removeFromProject() {
 }
 
 void Board::save() {
-  // Content.
-  {
+  // Content, only if modified since the last save.
+  if (mIsModified) {
     SExpression root = SExpression::createList("librepcb_board");
     root.appendChild(mUuid);
     root.ensureLineBreak();
@@ -730,6 +819,7 @@ void Board::save() {
     }
     root.ensureLineBreak();
     mDirectory->write("board.lp", root.toByteArray());
+    mIsModified = false;
   }
 
   // User settings.
@@ -90,9 +90,6 @@ public:
   const BoardDesignRuleCheckSettings& getDrcSettings() const noexcept {
     return *mDrcSettings;
   }
-  BoardFabricationOutputSettings& getFabricationOutputSettings() noexcept {
-    return *mFabricationOutputSettings;
-  }
   const BoardFabricationOutputSettings& getFabricationOutputSettings() const
       noexcept {
     return *mFabricationOutputSettings;
@@ -119,20 +116,36 @@ public:
   }
 
   // Setters
-  void setName(const ElementName& name) noexcept { mName = name; }
-  void setDefaultFontName(const QString& name) noexcept {
-    mDefaultFontFileName = name;
-  }
-  void setGridInterval(const PositiveLength& interval) noexcept {
-    mGridInterval = interval;
-  }
-  void setGridUnit(const LengthUnit& unit) noexcept { mGridUnit = unit; }
+  void setName(const ElementName& name) noexcept;
+  void setDefaultFontName(const QString& name) noexcept;
+  void setGridInterval(const PositiveLength& interval) noexcept;
+  void setGridUnit(const LengthUnit& unit) noexcept;
   void setInnerLayerCount(int count) noexcept;
   void setLayersVisibility(const QMap<QString, bool>& visibility) noexcept {
     mLayersVisibility = visibility;
   }
   void setDesignRules(const BoardDesignRules& rules) noexcept;
   void setDrcSettings(const BoardDesignRuleCheckSettings& settings) noexcept;
+  void setFabricationOutputSettings(
+      const BoardFabricationOutputSettings& settings) noexcept;
+
+  // Modification Tracking
+
+  /**
+   * @brief Check whether the board file needs to be serialized by #save()
+   *
+   * @return  True if the board was modified since the last #save() (or was
+   *          never saved since it has been created or loaded).
+   */
+  bool isModified() const noexcept { return mIsModified; }
+
+  /**
+   * @brief Mark the content of the board file as modified
+   *
+   * Must be called on every modification of data contained in the board
+   * file, i.e. by the board itself and by all its items.
+   */
+  void setModified() noexcept { mIsModified = true; }
 
   // DRC Message Approval Methods
   const QSet<SExpression>& getDrcMessageApprovals() const noexcept {
@@ -165,6 +178,8 @@ public:
   void addPlane(BI_Plane& plane);
   void removePlane(BI_Plane& plane);
   void rebuildAllPlanes() noexcept;
+  void rebuildPlanesInArea(const Point& dirtyMin,
+                           const Point& dirtyMax) noexcept;
 
   // Polygon Methods
   const QMap<Uuid, BI_Polygon*>& getPolygons() const noexcept {
@@ -241,6 +256,7 @@ private:
   const QString mDirectoryName;
   std::unique_ptr<TransactionalDirectory> mDirectory;
   bool mIsAddedToProject;
+  bool mIsModified;  ///< See #isModified()
 
   QScopedPointer<BoardDesignRules> mDesignRules;
   QScopedPointer<BoardDesignRuleCheckSettings> mDrcSettings;
@@ -0,0 +1,414 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "boardautorouter.h"
+
+#include "../../exceptions.h"
+#include "../../geometry/via.h"
+#include "../../types/layer.h"
+#include "../../utils/traceobstacleindex.h"
+#include "../circuit/netsignal.h"
+#include "board.h"
+#include "boardtraceobstaclesbuilder.h"
+#include "drc/boarddesignrulechecksettings.h"
+#include "items/bi_airwire.h"
+#include "items/bi_device.h"
+#include "items/bi_footprintpad.h"
+#include "items/bi_netline.h"
+#include "items/bi_netpoint.h"
+#include "items/bi_netsegment.h"
+#include "items/bi_via.h"
+
+#include <QtCore>
+
+#include <algorithm>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+BoardAutoRouter::BoardAutoRouter(Board& board,
+                                 const PositiveLength& traceWidth,
+                                 const PositiveLength& viaSize,
+                                 const PositiveLength& viaDrillDiameter,
+                                 const PositiveLength& gridInterval) noexcept
+  : mBoard(board),
+    mTraceWidth(traceWidth),
+    mViaSize(viaSize),
+    mViaDrillDiameter(viaDrillDiameter),
+    mGridInterval(gridInterval),
+    mClearance(board.getDrcSettings().getMinCopperCopperClearance()),
+    mLayers(),
+    mObstacles(),
+    mFixedObstacles(),
+    mConnections() {
+}
+
+BoardAutoRouter::~BoardAutoRouter() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+BoardAutoRouter::Result BoardAutoRouter::route() {
+  Result result{0, 0};
+
+  // Collect all copper of the board.
+  mLayers = mBoard.getCopperLayers().values().toVector();
+  std::sort(mLayers.begin(), mLayers.end(),
+            [](const Layer* a, const Layer* b) {
+              return a->getCopperNumber() < b->getCopperNumber();
+            });
+  mObstacles.clear();
+  mFixedObstacles.clear();
+  QVector<const TraceObstacleIndex*> obstacles;
+  QVector<const TraceObstacleIndex*> fixedObstacles;
+  BoardTraceObstaclesBuilder builder(mBoard);
+  foreach (const Layer* layer, mLayers) {
+    try {
+      mObstacles.push_back(builder.buildObstacles(*layer));  // can throw
+      mFixedObstacles.push_back(builder.buildObstacles(*layer));  // can throw
+    } catch (const Exception& e) {
+      mObstacles.clear();
+      mFixedObstacles.clear();
+      throw RuntimeError(
+          __FILE__, __LINE__,
+          QString("Failed to determine the obstacles on layer '%1': %2")
+              .arg(layer->getNameTr(), e.getMsg()));
+    }
+    obstacles.append(mObstacles.back().get());
+    fixedObstacles.append(mFixedObstacles.back().get());
+  }
+  const TracePathFinder finder(obstacles, mTraceWidth, mViaSize, mClearance,
+                               mGridInterval);
+  const TracePathFinder fixedFinder(fixedObstacles, mTraceWidth, mViaSize,
+                                    mClearance, mGridInterval);
+
+  // Collect all airwires to route, shortest first.
+  mBoard.forceAirWiresRebuild();
+  mConnections.clear();
+  foreach (const BI_AirWire* airWire, mBoard.getAirWires()) {
+    const BI_FootprintPad* pad1 =
+        dynamic_cast<const BI_FootprintPad*>(&airWire->getP1());
+    const BI_FootprintPad* pad2 =
+        dynamic_cast<const BI_FootprintPad*>(&airWire->getP2());
+    if (pad1 && pad2 && pad1->getCompSigInstNetSignal() &&
+        (pad1->getPosition() != pad2->getPosition())) {
+      mConnections.append(Connection{
+          pad1->getDevice().getPads().value(pad1->getLibPadUuid()),
+          pad2->getDevice().getPads().value(pad2->getLibPadUuid()),
+          pad1->getCompSigInstNetSignal()->getUuid(),
+          QVector<TracePathFinder::Vertex>(),
+          nullptr,
+          QVector<QPair<int, int>>(),
+      });
+    } else {
+      // Airwires to traces or vias are not supported yet.
+      ++result.failedAirWires;
+    }
+  }
+  std::sort(mConnections.begin(), mConnections.end(),
+            [](const Connection& a, const Connection& b) {
+              return (a.pad2->getPosition() - a.pad1->getPosition())
+                         .getLength() <
+                  (b.pad2->getPosition() - b.pad1->getPosition()).getLength();
+            });
+
+  // Route them.
+  for (Connection& connection : mConnections) {
+    Q_ASSERT(connection.pad1 && connection.pad2);
+    routeConnection(finder, connection);  // can throw
+  }
+
+  // Retry the failed connections by ripping up the connections in their way.
+  for (int pass = 0; pass < sMaxRipUpPasses; ++pass) {
+    bool improved = false;
+    for (int i = 0; i < mConnections.count(); ++i) {
+      if ((!mConnections.at(i).segment) &&
+          ripUpAndReroute(finder, fixedFinder, i)) {  // can throw
+        improved = true;
+      }
+    }
+    if (!improved) {
+      break;
+    }
+  }
+
+  foreach (const Connection& connection, mConnections) {
+    if (connection.segment) {
+      ++result.routedAirWires;
+    } else {
+      ++result.failedAirWires;
+    }
+  }
+  mConnections.clear();
+  mObstacles.clear();
+  mFixedObstacles.clear();
+  mBoard.forceAirWiresRebuild();
+  return result;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+bool BoardAutoRouter::findPath(const TracePathFinder& finder,
+                               const Connection& connection,
+                               QVector<TracePathFinder::Vertex>& path) const
+    noexcept {
+  QVector<bool> startLayers;
+  QVector<bool> goalLayers;
+  foreach (const Layer* layer, mLayers) {
+    startLayers.append(connection.pad1->isOnLayer(*layer));
+    goalLayers.append(connection.pad2->isOnLayer(*layer));
+  }
+  return finder.findPath(connection.pad1->getPosition(), startLayers,
+                         connection.pad2->getPosition(), goalLayers,
+                         connection.net, path);
+}
+
+bool BoardAutoRouter::routeConnection(const TracePathFinder& finder,
+                                      Connection& connection) {
+  QVector<TracePathFinder::Vertex> path;
+  if (!findPath(finder, connection, path)) {
+    return false;
+  }
+  addToBoard(connection, path);  // can throw
+  return true;
+}
+
+bool BoardAutoRouter::ripUpAndReroute(const TracePathFinder& finder,
+                                      const TracePathFinder& fixedFinder,
+                                      int index) {
+  // Find a path ignoring all connections routed so far. If there is none,
+  // ripping up does not help.
+  QVector<TracePathFinder::Vertex> path;
+  if (!findPath(fixedFinder, mConnections.at(index), path)) {
+    return false;
+  }
+
+  // Rip up the routed connections in the way, then route the failed
+  // connection along the found path.
+  const QVector<int> victims =
+      findConflictingConnections(mConnections.at(index), path);
+  QHash<int, QVector<TracePathFinder::Vertex>> oldPaths;
+  foreach (int victim, victims) {
+    oldPaths.insert(victim, mConnections.at(victim).path);
+    ripUp(mConnections[victim]);  // can throw
+  }
+  addToBoard(mConnections[index], path);  // can throw
+
+  // Route the ripped up connections again.
+  bool success = true;
+  foreach (int victim, victims) {
+    if (!routeConnection(finder, mConnections[victim])) {  // can throw
+      success = false;
+      break;
+    }
+  }
+
+  // Restore the previous state if any of them could not be routed anymore.
+  if (!success) {
+    ripUp(mConnections[index]);  // can throw
+    foreach (int victim, victims) {
+      if (mConnections.at(victim).segment) {
+        ripUp(mConnections[victim]);  // can throw
+      }
+    }
+    foreach (int victim, victims) {
+      addToBoard(mConnections[victim], oldPaths.value(victim));  // can throw
+    }
+  }
+  return success;
+}
+
+QVector<int> BoardAutoRouter::findConflictingConnections(
+    const Connection& connection,
+    const QVector<TracePathFinder::Vertex>& path) const noexcept {
+  // Put the path into separate obstacle indices.
+  std::vector<std::unique_ptr<TraceObstacleIndex>> pathObstacles;
+  for (int i = 0; i < mLayers.count(); ++i) {
+    pathObstacles.emplace_back(new TraceObstacleIndex());
+  }
+  const QVector<Stop> stops = getStops(path);
+  for (int i = 0; i < stops.count(); ++i) {
+    const Stop& stop = stops.at(i);
+    if (i > 0) {
+      pathObstacles.at(stop.layerIn)
+          ->addSegment(stops.at(i - 1).position, stop.position,
+                       positiveToUnsigned(mTraceWidth), connection.net);
+    }
+    if ((i > 0) && (i < (stops.count() - 1)) &&
+        (stop.layerIn != stop.layerOut)) {
+      for (auto& obstacles : pathObstacles) {
+        obstacles->addSegment(stop.position, stop.position,
+                              positiveToUnsigned(mViaSize), connection.net);
+      }
+    }
+  }
+
+  // Check all routed connections of other nets against it.
+  QVector<int> conflicts;
+  for (int i = 0; i < mConnections.count(); ++i) {
+    const Connection& other = mConnections.at(i);
+    if ((!other.segment) || (other.net == connection.net)) {
+      continue;
+    }
+    bool conflict = false;
+    foreach (const BI_NetLine* netLine, other.segment->getNetLines()) {
+      const int layer = mLayers.indexOf(&netLine->getLayer());
+      if ((layer >= 0) &&
+          (!pathObstacles.at(layer)->isFree(
+              netLine->getStartPoint().getPosition(),
+              netLine->getEndPoint().getPosition(), mTraceWidth, mClearance,
+              other.net))) {
+        conflict = true;
+      }
+    }
+    foreach (const BI_Via* via, other.segment->getVias()) {
+      for (const auto& obstacles : pathObstacles) {
+        if (!obstacles->isFree(via->getPosition(), via->getPosition(),
+                               mViaSize, mClearance, other.net)) {
+          conflict = true;
+        }
+      }
+    }
+    if (conflict) {
+      conflicts.append(i);
+    }
+  }
+  return conflicts;
+}
+
+void BoardAutoRouter::addToBoard(Connection& connection,
+                                 const QVector<TracePathFinder::Vertex>& path) {
+  const QVector<Stop> stops = getStops(path);
+  if (stops.count() < 2) {
+    return;
+  }
+
+  // Create the traces.
+  QScopedPointer<BI_NetSegment> segment(
+      new BI_NetSegment(mBoard, Uuid::createRandom(),
+                        connection.pad1->getCompSigInstNetSignal()));
+  QList<BI_Via*> vias;
+  QList<BI_NetPoint*> netPoints;
+  QList<BI_NetLine*> netLines;
+  BI_NetLineAnchor* previous = connection.pad1;
+  for (int i = 1; i < stops.count(); ++i) {
+    const Stop& stop = stops.at(i);
+    BI_NetLineAnchor* anchor = nullptr;
+    if (i == (stops.count() - 1)) {
+      anchor = connection.pad2;
+    } else if (stop.layerIn != stop.layerOut) {
+      BI_Via* via = new BI_Via(*segment,
+                               Via(Uuid::createRandom(), stop.position,
+                                   mViaSize, mViaDrillDiameter));
+      vias.append(via);
+      anchor = via;
+    } else {
+      BI_NetPoint* netPoint =
+          new BI_NetPoint(*segment, Uuid::createRandom(), stop.position);
+      netPoints.append(netPoint);
+      anchor = netPoint;
+    }
+    netLines.append(new BI_NetLine(*segment, Uuid::createRandom(), *previous,
+                                   *anchor, *mLayers.at(stop.layerIn),
+                                   mTraceWidth));
+    previous = anchor;
+  }
+  segment->addElements(vias, netPoints, netLines);  // can throw
+  mBoard.addNetSegment(*segment);  // can throw
+  connection.segment = segment.take();  // Now owned by the board.
+  connection.path = path;
+
+  // The new traces are obstacles for all the following connections.
+  foreach (const BI_Via* via, vias) {
+    for (int i = 0; i < mLayers.count(); ++i) {
+      const int id = mObstacles.at(i)->addSegment(
+          via->getPosition(), via->getPosition(), positiveToUnsigned(mViaSize),
+          connection.net);
+      connection.obstacles.append(qMakePair(i, id));
+    }
+  }
+  foreach (const BI_NetLine* netLine, netLines) {
+    const int layer = mLayers.indexOf(&netLine->getLayer());
+    const int id = mObstacles.at(layer)->addSegment(
+        netLine->getStartPoint().getPosition(),
+        netLine->getEndPoint().getPosition(), positiveToUnsigned(mTraceWidth),
+        connection.net);
+    connection.obstacles.append(qMakePair(layer, id));
+  }
+}
+
+void BoardAutoRouter::ripUp(Connection& connection) {
+  Q_ASSERT(connection.segment);
+  for (const auto& obstacle : connection.obstacles) {
+    mObstacles.at(obstacle.first)->remove(obstacle.second);
+  }
+  connection.obstacles.clear();
+  mBoard.removeNetSegment(*connection.segment);  // can throw
+  delete connection.segment;
+  connection.segment = nullptr;
+  connection.path.clear();
+}
+
+QVector<BoardAutoRouter::Stop> BoardAutoRouter::getStops(
+    const QVector<TracePathFinder::Vertex>& path) noexcept {
+  // Merge the grid steps into straight lines and determine where the layer
+  // changes.
+  QVector<Stop> stops;
+  foreach (const TracePathFinder::Vertex& vertex, path) {
+    if ((!stops.isEmpty()) && (stops.last().position == vertex.position)) {
+      stops.last().layerOut = vertex.layer;
+      continue;
+    }
+    if (stops.count() >= 2) {
+      const Stop& a = stops.at(stops.count() - 2);
+      const Stop& b = stops.last();
+      const Point d1 = b.position - a.position;
+      const Point d2 = vertex.position - b.position;
+      const qint64 cross = (d1.getX().toNm() * d2.getY().toNm()) -
+          (d1.getY().toNm() * d2.getX().toNm());
+      const qint64 dot = (d1.getX().toNm() * d2.getX().toNm()) +
+          (d1.getY().toNm() * d2.getY().toNm());
+      if ((a.layerOut == b.layerIn) && (b.layerIn == b.layerOut) &&
+          (b.layerOut == vertex.layer) && (cross == 0) && (dot > 0)) {
+        stops.removeLast();
+      }
+    }
+    stops.append(Stop{vertex.position, vertex.layer, vertex.layer});
+  }
+  return stops;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
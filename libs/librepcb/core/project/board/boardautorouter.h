@@ -0,0 +1,158 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_BOARDAUTOROUTER_H
+#define LIBREPCB_CORE_BOARDAUTOROUTER_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../../types/length.h"
+#include "../../utils/tracepathfinder.h"
+
+#include <QtCore>
+
+#include <memory>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class BI_FootprintPad;
+class BI_NetSegment;
+class Board;
+class Layer;
+class TraceObstacleIndex;
+
+/*******************************************************************************
+ *  Class BoardAutoRouter
+ ******************************************************************************/
+
+/**
+ * @brief Headless router to complete unrouted airwires of a board
+ *
+ * Every airwire between two footprint pads is routed with a maze search
+ * across all copper layers (see ::librepcb::TracePathFinder), changing layers
+ * by through-hole vias where needed. The minimum copper clearance of the DRC
+ * settings is kept to all copper of other nets (see
+ * ::librepcb::TraceObstacleIndex). Short airwires are routed first, and
+ * every routed connection immediately becomes an obstacle for the following
+ * ones.
+ *
+ * Afterwards, connections which could not be routed are retried with
+ * rip-up and reroute: if a path exists around the copper which was already
+ * on the board, the connections routed by this class in the way of that path
+ * are ripped up, the failed connection is routed, and the ripped up
+ * connections are routed again. If any of them cannot be routed anymore, the
+ * previous state is restored, so the number of routed connections never
+ * decreases. This is repeated up to #sMaxRipUpPasses times. The connections
+ * are routed one after another in a single thread.
+ *
+ * The created traces are added directly to the board as new
+ * ::librepcb::BI_NetSegment objects (i.e. not through the undo stack).
+ */
+class BoardAutoRouter final {
+public:
+  // Types
+  struct Result {
+    int routedAirWires;
+    int failedAirWires;
+  };
+
+  // Constructors / Destructor
+  BoardAutoRouter() = delete;
+  BoardAutoRouter(const BoardAutoRouter& other) = delete;
+  BoardAutoRouter(Board& board, const PositiveLength& traceWidth,
+                  const PositiveLength& viaSize,
+                  const PositiveLength& viaDrillDiameter,
+                  const PositiveLength& gridInterval) noexcept;
+  ~BoardAutoRouter() noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Route all airwires between pads
+   *
+   * @return Statistics about the routed airwires.
+   */
+  Result route();  // can throw
+
+  // Operator Overloadings
+  BoardAutoRouter& operator=(const BoardAutoRouter& rhs) = delete;
+
+private:  // Types
+  struct Connection {
+    BI_FootprintPad* pad1;
+    BI_FootprintPad* pad2;
+    tl::optional<Uuid> net;
+    QVector<TracePathFinder::Vertex> path;  ///< Empty if not routed
+    BI_NetSegment* segment;  ///< `nullptr` if not routed
+    QVector<QPair<int, int>> obstacles;  ///< Layer index and obstacle ID
+  };
+  struct Stop {
+    Point position;
+    int layerIn;
+    int layerOut;
+  };
+
+private:  // Methods
+  bool findPath(const TracePathFinder& finder, const Connection& connection,
+                QVector<TracePathFinder::Vertex>& path) const noexcept;
+  bool routeConnection(const TracePathFinder& finder, Connection& connection);
+  bool ripUpAndReroute(const TracePathFinder& finder,
+                       const TracePathFinder& fixedFinder, int index);
+  QVector<int> findConflictingConnections(
+      const Connection& connection,
+      const QVector<TracePathFinder::Vertex>& path) const noexcept;
+  void addToBoard(Connection& connection,
+                  const QVector<TracePathFinder::Vertex>& path);
+  void ripUp(Connection& connection);
+  static QVector<Stop> getStops(
+      const QVector<TracePathFinder::Vertex>& path) noexcept;
+
+private:  // Data
+  Board& mBoard;
+  PositiveLength mTraceWidth;
+  PositiveLength mViaSize;
+  PositiveLength mViaDrillDiameter;
+  PositiveLength mGridInterval;
+  UnsignedLength mClearance;
+  QVector<const Layer*> mLayers;
+
+  /// All obstacles, including the connections routed so far
+  std::vector<std::unique_ptr<TraceObstacleIndex>> mObstacles;
+
+  /// Only the obstacles which were on the board before routing
+  std::vector<std::unique_ptr<TraceObstacleIndex>> mFixedObstacles;
+
+  /// The connections to route, shortest first
+  QVector<Connection> mConnections;
+
+  /// Max. number of rip-up and reroute passes over the failed connections
+  static constexpr int sMaxRipUpPasses = 3;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
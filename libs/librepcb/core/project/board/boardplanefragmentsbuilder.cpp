@@ -37,8 +37,11 @@
 #include "items/bi_polygon.h"
 #include "items/bi_via.h"
 
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 
+#include <algorithm>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -64,9 +67,47 @@ QVector<Path> BoardPlaneFragmentsBuilder::buildFragments() noexcept {
     mResult.clear();
     addPlaneOutline();
     clipToBoardOutline();
-    subtractOtherObjects();
-    ensureMinimumWidth();
+    collectCutOuts();
+    subtractCutOuts();
+    flattenResult();
+    storeFragments();
+    if (!mPlane.getKeepOrphans()) {
+      removeOrphans();
+    }
+    return ClipperHelpers::convert(mResult);
+  } catch (const Exception& e) {
+    qCritical() << "Failed to build plane fragments, leaving plane empty:"
+                << e.getMsg();
+    mPlane.getFragmentsBuilderCache().fragments = tl::nullopt;
+    return QVector<Path>();
+  }
+}
+
+QVector<Path> BoardPlaneFragmentsBuilder::buildFragments(
+    const Point& dirtyMin, const Point& dirtyMax) noexcept {
+  if (!isCachedFragmentsValid()) {
+    return buildFragments();
+  }
+
+  try {
+    // The modified objects affect the plane up to the clearance around them.
+    const Length clearance = *mPlane.getMinClearance();
+    const ClipperLib::IntRect dirtyRect{
+        std::min(dirtyMin.getX(), dirtyMax.getX()).toNm() - clearance.toNm(),
+        std::min(dirtyMin.getY(), dirtyMax.getY()).toNm() - clearance.toNm(),
+        std::max(dirtyMin.getX(), dirtyMax.getX()).toNm() + clearance.toNm(),
+        std::max(dirtyMin.getY(), dirtyMax.getY()).toNm() + clearance.toNm(),
+    };
+
+    mResult.clear();
+    addPlaneOutline();
+    clipToBoardOutline();
+    collectCutOuts();
+    mResult = subtractCutOutsInTile(mResult, mCutOuts, dirtyRect,
+                                    *mPlane.getMinWidth());  // can throw
+    mergeWithCachedFragments(dirtyRect);
     flattenResult();
+    storeFragments();
     if (!mPlane.getKeepOrphans()) {
       removeOrphans();
     }
@@ -74,10 +115,50 @@ QVector<Path> BoardPlaneFragmentsBuilder::buildFragments() noexcept {
   } catch (const Exception& e) {
     qCritical() << "Failed to build plane fragments, leaving plane empty:"
                 << e.getMsg();
+    mPlane.getFragmentsBuilderCache().fragments = tl::nullopt;
     return QVector<Path>();
   }
 }
 
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+bool BoardPlaneFragmentsBuilder::differOnlyWithin(
+    const QVector<Path>& fragments1, const QVector<Path>& fragments2,
+    const Point& min, const Point& max) noexcept {
+  try {
+    ClipperLib::Paths diff;
+    ClipperHelpers::execute(
+        diff, ClipperHelpers::convert(fragments1, maxArcTolerance()),
+        ClipperHelpers::convert(fragments2, maxArcTolerance()),
+        ClipperLib::ctXor, ClipperLib::pftNonZero,
+        ClipperLib::pftNonZero);  // can throw
+    const ClipperLib::IntRect rect{min.getX().toNm(), min.getY().toNm(),
+                                   max.getX().toNm(), max.getY().toNm()};
+    ClipperLib::Paths outside;
+    ClipperHelpers::execute(outside, diff, ClipperLib::Paths{toPath(rect)},
+                            ClipperLib::ctDifference, ClipperLib::pftNonZero,
+                            ClipperLib::pftNonZero);  // can throw
+    return outside.empty();
+  } catch (const Exception& e) {
+    qCritical() << "Failed to compare plane fragments:" << e.getMsg();
+    return false;
+  }
+}
+
+ClipperLib::Paths BoardPlaneFragmentsBuilder::subtractCutOuts(
+    const ClipperLib::Paths& area, const ClipperLib::Paths& cutOuts,
+    const Length& minWidth, int tilesPerAxis) {
+  std::vector<CutOut> list;
+  for (const ClipperLib::Path& path : cutOuts) {
+    if (!path.empty()) {
+      list.push_back(CutOut{getBounds(path), path});
+    }
+  }
+  return subtractCutOutsTiled(area, list, minWidth, tilesPerAxis);
+}
+
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
@@ -89,13 +170,12 @@ void BoardPlaneFragmentsBuilder::addPlaneOutline() {
 
 void BoardPlaneFragmentsBuilder::clipToBoardOutline() {
   // determine board area
-  ClipperLib::Paths boardArea;
-  ClipperLib::Clipper boardAreaClipper;
+  ClipperLib::Paths boardOutlines;
   foreach (const BI_Polygon* polygon, mPlane.getBoard().getPolygons()) {
     if (polygon->getPolygon().getLayer() == Layer::boardOutlines()) {
       ClipperLib::Path path = ClipperHelpers::convert(
           polygon->getPolygon().getPath(), maxArcTolerance());
-      boardAreaClipper.AddPath(path, ClipperLib::ptSubject, true);
+      boardOutlines.push_back(path);
     }
   }
   foreach (const BI_Device* device, mPlane.getBoard().getDeviceInstances()) {
@@ -105,12 +185,14 @@ void BoardPlaneFragmentsBuilder::clipToBoardOutline() {
         Path path = transform.map(polygon.getPath());
         ClipperLib::Path clipperPath =
             ClipperHelpers::convert(path, maxArcTolerance());
-        boardAreaClipper.AddPath(clipperPath, ClipperLib::ptSubject, true);
+        boardOutlines.push_back(clipperPath);
       }
     }
   }
-  boardAreaClipper.Execute(ClipperLib::ctXor, boardArea, ClipperLib::pftEvenOdd,
-                           ClipperLib::pftEvenOdd);
+  ClipperLib::Paths boardArea;
+  ClipperHelpers::execute(boardArea, boardOutlines, ClipperLib::Paths(),
+                          ClipperLib::ctXor, ClipperLib::pftEvenOdd,
+                          ClipperLib::pftEvenOdd);  // can throw
 
   // perform clearance offset
   ClipperHelpers::offset(boardArea, -mPlane.getMinClearance(),
@@ -120,16 +202,13 @@ void BoardPlaneFragmentsBuilder::clipToBoardOutline() {
   if (boardArea.empty()) return;
 
   // clip result to board area
-  ClipperLib::Clipper clip;
-  clip.AddPaths(mResult, ClipperLib::ptSubject, true);
-  clip.AddPaths(boardArea, ClipperLib::ptClip, true);
-  clip.Execute(ClipperLib::ctIntersection, mResult, ClipperLib::pftNonZero,
-               ClipperLib::pftNonZero);
+  ClipperHelpers::execute(mResult, mResult, boardArea,
+                          ClipperLib::ctIntersection, ClipperLib::pftNonZero,
+                          ClipperLib::pftNonZero);  // can throw
 }
 
-void BoardPlaneFragmentsBuilder::subtractOtherObjects() {
-  ClipperLib::Clipper c;
-  c.AddPaths(mResult, ClipperLib::ptSubject, true);
+void BoardPlaneFragmentsBuilder::collectCutOuts() {
+  mCutOuts.clear();
 
   // subtract other planes
   foreach (const BI_Plane* plane, mPlane.getBoard().getPlanes()) {
@@ -141,7 +220,7 @@ void BoardPlaneFragmentsBuilder::subtractOtherObjects() {
         ClipperHelpers::convert(plane->getFragments(), maxArcTolerance());
     ClipperHelpers::offset(paths, *mPlane.getMinClearance(),
                            maxArcTolerance());  // can throw
-    c.AddPaths(paths, ClipperLib::ptClip, true);
+    addCutOuts(paths);
   }
 
   // subtract holes and pads from devices
@@ -153,26 +232,16 @@ void BoardPlaneFragmentsBuilder::subtractOtherObjects() {
       const NonEmptyPath path = transform.map(hole.getPath());
       const QVector<Path> areas = path->toOutlineStrokes(diameter);
       foreach (const Path& area, areas) {
-        c.AddPath(ClipperHelpers::convert(area, maxArcTolerance()),
-                  ClipperLib::ptClip, true);
+        addCutOut(ClipperHelpers::convert(area, maxArcTolerance()));
       }
     }
     foreach (const BI_FootprintPad* pad, device->getPads()) {
       if (!pad->isOnLayer(mPlane.getLayer())) continue;
-      const Transform padTransform(pad->getLibPad().getPosition(),
-                                   pad->getLibPad().getRotation());
-      if (pad->getCompSigInstNetSignal() == &mPlane.getNetSignal()) {
-        foreach (const PadGeometry& geometry,
-                 pad->getGeometries().value(&mPlane.getLayer())) {
-          foreach (const Path& outline, geometry.toOutlines()) {
-            ClipperLib::Path path = ClipperHelpers::convert(
-                transform.map(padTransform.map(outline)), maxArcTolerance());
-            mConnectedNetSignalAreas.push_back(path);
-          }
-        }
-      }
-      c.AddPaths(createPadCutOuts(transform, padTransform, *pad),
-                 ClipperLib::ptClip, true);
+      const Cache::PadEntry& entry = getPadEntry(*pad);  // can throw
+      mConnectedNetSignalAreas.insert(mConnectedNetSignalAreas.end(),
+                                      entry.connectedAreas.begin(),
+                                      entry.connectedAreas.end());
+      addCutOuts(entry.cutOuts);
     }
   }
 
@@ -183,8 +252,7 @@ void BoardPlaneFragmentsBuilder::subtractOtherObjects() {
     const NonEmptyPath path = hole->getHole().getPath();
     const QVector<Path> areas = path->toOutlineStrokes(diameter);
     foreach (const Path& area, areas) {
-      c.AddPath(ClipperHelpers::convert(area, maxArcTolerance()),
-                ClipperLib::ptClip, true);
+      addCutOut(ClipperHelpers::convert(area, maxArcTolerance()));
     }
   }
 
@@ -193,12 +261,11 @@ void BoardPlaneFragmentsBuilder::subtractOtherObjects() {
            mPlane.getBoard().getNetSegments()) {
     // subtract vias
     foreach (const BI_Via* via, netsegment->getVias()) {
-      if (netsegment->getNetSignal() == &mPlane.getNetSignal()) {
-        ClipperLib::Path path = ClipperHelpers::convert(
-            via->getVia().getSceneOutline(), maxArcTolerance());
-        mConnectedNetSignalAreas.push_back(path);
+      const Cache::ViaEntry& entry = getViaEntry(*via);
+      if (entry.connected) {
+        mConnectedNetSignalAreas.push_back(entry.connectedArea);
       }
-      c.AddPath(createViaCutOut(*via), ClipperLib::ptClip, true);
+      addCutOut(entry.cutOut);
     }
 
     // subtract netlines
@@ -212,53 +279,368 @@ void BoardPlaneFragmentsBuilder::subtractOtherObjects() {
         ClipperLib::Path path = ClipperHelpers::convert(
             netline->getSceneOutline(*mPlane.getMinClearance()),
             maxArcTolerance());
-        c.AddPath(path, ClipperLib::ptClip, true);
+        addCutOut(path);
       }
     }
   }
-
-  c.Execute(ClipperLib::ctDifference, mResult, ClipperLib::pftEvenOdd,
-            ClipperLib::pftNonZero);
 }
 
-void BoardPlaneFragmentsBuilder::ensureMinimumWidth() {
-  Length delta = mPlane.getMinWidth() / 2;
-  ClipperHelpers::offset(mResult, -delta, maxArcTolerance());  // can throw
-  ClipperHelpers::offset(mResult, delta, maxArcTolerance());  // can throw
+void BoardPlaneFragmentsBuilder::subtractCutOuts() {
+  // Tiling is only worth the overhead for planes with many cut-outs. The
+  // number of tiles is derived from the number of cut-outs only, the global
+  // thread pool then schedules the tiles on the available cores.
+  const int cutOuts = static_cast<int>(mCutOuts.size());
+  int tilesPerAxis = 1;
+  if (cutOuts >= sMinCutOutsForTiling) {
+    const qreal tiles = std::ceil(std::sqrt(cutOuts / qreal(sCutOutsPerTile)));
+    tilesPerAxis = std::min(static_cast<int>(tiles), sMaxTilesPerAxis);
+  }
+  mResult = subtractCutOutsTiled(mResult, mCutOuts, *mPlane.getMinWidth(),
+                                 tilesPerAxis);  // can throw
 }
 
 void BoardPlaneFragmentsBuilder::flattenResult() {
   // convert paths to tree
-  ClipperLib::PolyTree tree;
-  ClipperLib::Clipper c;
-  c.AddPaths(mResult, ClipperLib::ptSubject, true);
-  c.Execute(ClipperLib::ctXor, tree, ClipperLib::pftEvenOdd,
-            ClipperLib::pftEvenOdd);
+  std::unique_ptr<ClipperLib::PolyTree> tree = ClipperHelpers::executeToTree(
+      mResult, ClipperLib::Paths(), ClipperLib::ctXor, ClipperLib::pftEvenOdd,
+      ClipperLib::pftEvenOdd);  // can throw
 
   // convert tree to simple paths with cut-ins
-  mResult = ClipperHelpers::flattenTree(tree);  // can throw
+  mResult = ClipperHelpers::flattenTree(*tree);  // can throw
+}
+
+void BoardPlaneFragmentsBuilder::mergeWithCachedFragments(
+    const ClipperLib::IntRect& dirtyRect) {
+  // take the cached fragments only outside of the dirty area
+  const Cache& cache = mPlane.getFragmentsBuilderCache();
+  ClipperLib::Paths outside;
+  ClipperHelpers::execute(outside, cache.fragments->fragments,
+                          ClipperLib::Paths{toPath(dirtyRect)},
+                          ClipperLib::ctDifference, ClipperLib::pftNonZero,
+                          ClipperLib::pftNonZero);  // can throw
+
+  // stitch them together with the recalculated fragments inside of it
+  ClipperLib::Paths paths = mResult;
+  paths.insert(paths.end(), outside.begin(), outside.end());
+  ClipperHelpers::execute(mResult, paths, ClipperLib::Paths(),
+                          ClipperLib::ctUnion, ClipperLib::pftNonZero,
+                          ClipperLib::pftNonZero);  // can throw
+}
+
+void BoardPlaneFragmentsBuilder::storeFragments() {
+  mUsedCache.fragments = Cache::FragmentsEntry{
+      mPlane.getOutline(),
+      &mPlane.getLayer(),
+      &mPlane.getNetSignal(),
+      *mPlane.getMinWidth(),
+      *mPlane.getMinClearance(),
+      static_cast<int>(mPlane.getConnectStyle()),
+      mPlane.getPriority(),
+      mResult,
+  };
+  mPlane.getFragmentsBuilderCache() = std::move(mUsedCache);
 }
 
 void BoardPlaneFragmentsBuilder::removeOrphans() {
-  mResult.erase(std::remove_if(
-                    mResult.begin(), mResult.end(),
-                    [this](const ClipperLib::Path& p) {
-                      ClipperLib::Paths intersections;
-                      ClipperLib::Clipper c;
-                      c.AddPaths(mConnectedNetSignalAreas,
-                                 ClipperLib::ptSubject, true);
-                      c.AddPath(p, ClipperLib::ptClip, true);
-                      c.Execute(ClipperLib::ctIntersection, intersections,
-                                ClipperLib::pftNonZero, ClipperLib::pftNonZero);
-                      return intersections.empty();
-                    }),
-                mResult.end());
+  // Sort the connected areas by their left edge, so each fragment only needs
+  // to be intersected with the few areas overlapping its bounding box instead
+  // of with all of them.
+  struct Area {
+    ClipperLib::IntRect bounds;
+    const ClipperLib::Path* path;
+  };
+  std::vector<Area> areas;
+  areas.reserve(mConnectedNetSignalAreas.size());
+  for (const ClipperLib::Path& path : mConnectedNetSignalAreas) {
+    if (!path.empty()) {
+      areas.push_back(Area{getBounds(path), &path});
+    }
+  }
+  std::sort(areas.begin(), areas.end(), [](const Area& a, const Area& b) {
+    return a.bounds.left < b.bounds.left;
+  });
+
+  mResult.erase(
+      std::remove_if(
+          mResult.begin(), mResult.end(),
+          [&areas](const ClipperLib::Path& p) {
+            if (p.empty()) {
+              return true;
+            }
+            const ClipperLib::IntRect bounds = getBounds(p);
+            ClipperLib::Paths candidates;
+            for (const Area& area : areas) {
+              if (area.bounds.left > bounds.right) {
+                break;  // All following areas are even more to the right.
+              }
+              if ((area.bounds.right >= bounds.left) &&
+                  (area.bounds.top <= bounds.bottom) &&
+                  (area.bounds.bottom >= bounds.top)) {
+                candidates.push_back(*area.path);
+              }
+            }
+            if (candidates.empty()) {
+              return true;
+            }
+            ClipperLib::Paths intersections;
+            ClipperHelpers::execute(intersections, candidates,
+                                    ClipperLib::Paths{p},
+                                    ClipperLib::ctIntersection,
+                                    ClipperLib::pftNonZero,
+                                    ClipperLib::pftNonZero);  // can throw
+            return intersections.empty();
+          }),
+      mResult.end());
 }
 
 /*******************************************************************************
  *  Helper Methods
  ******************************************************************************/
 
+const BoardPlaneFragmentsBuilder::Cache::PadEntry&
+    BoardPlaneFragmentsBuilder::getPadEntry(const BI_FootprintPad& pad) {
+  const BI_Device& device = pad.getDevice();
+  const bool connected =
+      (pad.getCompSigInstNetSignal() == &mPlane.getNetSignal());
+  Cache::PadEntry entry{
+      device.getPosition(),
+      device.getRotation(),
+      device.getMirrored(),
+      pad.getLibPad().getPosition(),
+      pad.getLibPad().getRotation(),
+      pad.getGeometries().value(&mPlane.getLayer()),
+      mPlane.getMinClearance(),
+      connected,
+      (mPlane.getConnectStyle() == BI_Plane::ConnectStyle::None) ||
+          (!connected),
+      ClipperLib::Paths(),
+      ClipperLib::Paths(),
+  };
+
+  const Cache& cache = mPlane.getFragmentsBuilderCache();
+  auto it = cache.pads.find(&pad);
+  if ((it != cache.pads.end()) &&
+      (it->devicePosition == entry.devicePosition) &&
+      (it->deviceRotation == entry.deviceRotation) &&
+      (it->deviceMirrored == entry.deviceMirrored) &&
+      (it->padPosition == entry.padPosition) &&
+      (it->padRotation == entry.padRotation) &&
+      (it->geometries == entry.geometries) &&
+      (it->clearance == entry.clearance) &&
+      (it->connected == entry.connected) && (it->cutOut == entry.cutOut)) {
+    entry.connectedAreas = it->connectedAreas;
+    entry.cutOuts = it->cutOuts;
+  } else {
+    const Transform transform(device);
+    const Transform padTransform(pad.getLibPad().getPosition(),
+                                 pad.getLibPad().getRotation());
+    if (connected) {
+      foreach (const PadGeometry& geometry, entry.geometries) {
+        foreach (const Path& outline, geometry.toOutlines()) {
+          entry.connectedAreas.push_back(ClipperHelpers::convert(
+              transform.map(padTransform.map(outline)), maxArcTolerance()));
+        }
+      }
+    }
+    entry.cutOuts = createPadCutOuts(transform, padTransform, pad);
+  }
+  return *mUsedCache.pads.insert(&pad, entry);
+}
+
+const BoardPlaneFragmentsBuilder::Cache::ViaEntry&
+    BoardPlaneFragmentsBuilder::getViaEntry(const BI_Via& via) {
+  Cache::ViaEntry entry{
+      via.getPosition(),
+      via.getSize(),
+      mPlane.getMinClearance(),
+      via.getNetSegment().getNetSignal() == &mPlane.getNetSignal(),
+      ClipperLib::Path(),
+      ClipperLib::Path(),
+  };
+
+  const Cache& cache = mPlane.getFragmentsBuilderCache();
+  auto it = cache.vias.find(&via);
+  if ((it != cache.vias.end()) && (it->position == entry.position) &&
+      (it->size == entry.size) && (it->clearance == entry.clearance) &&
+      (it->connected == entry.connected)) {
+    entry.connectedArea = it->connectedArea;
+    entry.cutOut = it->cutOut;
+  } else {
+    if (entry.connected) {
+      entry.connectedArea = ClipperHelpers::convert(
+          via.getVia().getSceneOutline(), maxArcTolerance());
+    }
+    entry.cutOut = createViaCutOut(via);
+  }
+  return *mUsedCache.vias.insert(&via, entry);
+}
+
+void BoardPlaneFragmentsBuilder::addCutOut(const ClipperLib::Path& path) {
+  if (!path.empty()) {
+    mCutOuts.push_back(CutOut{getBounds(path), path});
+  }
+}
+
+void BoardPlaneFragmentsBuilder::addCutOuts(const ClipperLib::Paths& paths) {
+  for (const ClipperLib::Path& path : paths) {
+    addCutOut(path);
+  }
+}
+
+ClipperLib::Paths BoardPlaneFragmentsBuilder::subtractCutOutsTiled(
+    const ClipperLib::Paths& area, const std::vector<CutOut>& cutOuts,
+    const Length& minWidth, int tilesPerAxis) {
+  if ((tilesPerAxis < 2) || area.empty()) {
+    return subtractCutOutsInTile(area, cutOuts, tl::nullopt,
+                                 minWidth);  // can throw
+  }
+
+  // Split the area into tiles and process them in parallel. The tiles share
+  // their edges, so the results can be merged exactly afterwards.
+  ClipperLib::IntRect bounds = getBounds(area.front());
+  for (const ClipperLib::Path& path : area) {
+    const ClipperLib::IntRect pathBounds = getBounds(path);
+    bounds.left = std::min(bounds.left, pathBounds.left);
+    bounds.top = std::min(bounds.top, pathBounds.top);
+    bounds.right = std::max(bounds.right, pathBounds.right);
+    bounds.bottom = std::max(bounds.bottom, pathBounds.bottom);
+  }
+  const qint64 width = bounds.right - bounds.left;
+  const qint64 height = bounds.bottom - bounds.top;
+  struct TileResult {
+    ClipperLib::Paths paths;
+    QString error;
+  };
+  QList<QFuture<TileResult>> futures;
+  for (qint64 x = 0; x < tilesPerAxis; ++x) {
+    for (qint64 y = 0; y < tilesPerAxis; ++y) {
+      const ClipperLib::IntRect tile{
+          bounds.left + (width * x) / tilesPerAxis,
+          bounds.top + (height * y) / tilesPerAxis,
+          bounds.left + (width * (x + 1)) / tilesPerAxis,
+          bounds.top + (height * (y + 1)) / tilesPerAxis,
+      };
+      futures.append(QtConcurrent::run([&area, &cutOuts, tile, minWidth]() {
+        TileResult result;
+        try {
+          result.paths = subtractCutOutsInTile(area, cutOuts, tile, minWidth);
+        } catch (const Exception& e) {
+          result.error = e.getMsg();
+        }
+        return result;
+      }));
+    }
+  }
+
+  // Wait for all tiles before throwing, as they reference our data.
+  QList<TileResult> results;
+  for (QFuture<TileResult>& future : futures) {
+    results.append(future.result());
+  }
+  ClipperLib::Paths tiles;
+  foreach (const TileResult& result, results) {
+    if (!result.error.isEmpty()) {
+      throw RuntimeError(__FILE__, __LINE__, result.error);
+    }
+    tiles.insert(tiles.end(), result.paths.begin(), result.paths.end());
+  }
+  ClipperLib::Paths merged;
+  ClipperHelpers::execute(merged, tiles, ClipperLib::Paths(),
+                          ClipperLib::ctUnion, ClipperLib::pftNonZero,
+                          ClipperLib::pftNonZero);  // can throw
+  return merged;
+}
+
+ClipperLib::Paths BoardPlaneFragmentsBuilder::subtractCutOutsInTile(
+    const ClipperLib::Paths& area, const std::vector<CutOut>& cutOuts,
+    const tl::optional<ClipperLib::IntRect>& tile, const Length& minWidth) {
+  // Ensuring the minimum width depends on the plane area up to one minimum
+  // width around each point, so a margin around the tile is required to get
+  // the same result within the tile as without tiling.
+  tl::optional<ClipperLib::IntRect> region;
+  ClipperLib::Paths subject;
+  if (tile) {
+    const qint64 margin = minWidth.toNm() + maxArcTolerance()->toNm();
+    region = ClipperLib::IntRect{
+        tile->left - margin,
+        tile->top - margin,
+        tile->right + margin,
+        tile->bottom + margin,
+    };
+    ClipperHelpers::execute(subject, area, ClipperLib::Paths{toPath(*region)},
+                            ClipperLib::ctIntersection, ClipperLib::pftNonZero,
+                            ClipperLib::pftNonZero);  // can throw
+  } else {
+    subject = area;
+  }
+
+  // subtract cut-outs
+  ClipperLib::Paths clip;
+  for (const CutOut& cutOut : cutOuts) {
+    if ((!region) ||
+        ((cutOut.bounds.left <= region->right) &&
+         (cutOut.bounds.right >= region->left) &&
+         (cutOut.bounds.top <= region->bottom) &&
+         (cutOut.bounds.bottom >= region->top))) {
+      clip.push_back(cutOut.path);
+    }
+  }
+  ClipperLib::Paths result;
+  ClipperHelpers::execute(result, subject, clip, ClipperLib::ctDifference,
+                          ClipperLib::pftEvenOdd,
+                          ClipperLib::pftNonZero);  // can throw
+
+  // ensure minimum width
+  const Length delta = minWidth / 2;
+  ClipperHelpers::offset(result, -delta, maxArcTolerance());  // can throw
+  ClipperHelpers::offset(result, delta, maxArcTolerance());  // can throw
+
+  // clip to tile
+  if (tile) {
+    ClipperHelpers::execute(result, result, ClipperLib::Paths{toPath(*tile)},
+                            ClipperLib::ctIntersection, ClipperLib::pftNonZero,
+                            ClipperLib::pftNonZero);  // can throw
+  }
+  return result;
+}
+
+bool BoardPlaneFragmentsBuilder::isCachedFragmentsValid() const noexcept {
+  const tl::optional<Cache::FragmentsEntry>& entry =
+      mPlane.getFragmentsBuilderCache().fragments;
+  return entry && (entry->outline == mPlane.getOutline()) &&
+      (entry->layer == &mPlane.getLayer()) &&
+      (entry->netSignal == &mPlane.getNetSignal()) &&
+      (entry->minWidth == *mPlane.getMinWidth()) &&
+      (entry->minClearance == *mPlane.getMinClearance()) &&
+      (entry->connectStyle == static_cast<int>(mPlane.getConnectStyle())) &&
+      (entry->priority == mPlane.getPriority());
+}
+
+ClipperLib::IntRect BoardPlaneFragmentsBuilder::getBounds(
+    const ClipperLib::Path& path) noexcept {
+  ClipperLib::IntRect rect{0, 0, -1, -1};
+  if (!path.empty()) {
+    rect = {path.front().X, path.front().Y, path.front().X, path.front().Y};
+    for (const ClipperLib::IntPoint& p : path) {
+      rect.left = std::min(rect.left, p.X);
+      rect.top = std::min(rect.top, p.Y);
+      rect.right = std::max(rect.right, p.X);
+      rect.bottom = std::max(rect.bottom, p.Y);
+    }
+  }
+  return rect;
+}
+
+ClipperLib::Path BoardPlaneFragmentsBuilder::toPath(
+    const ClipperLib::IntRect& rect) noexcept {
+  return ClipperLib::Path{
+      ClipperLib::IntPoint(rect.left, rect.top),
+      ClipperLib::IntPoint(rect.right, rect.top),
+      ClipperLib::IntPoint(rect.right, rect.bottom),
+      ClipperLib::IntPoint(rect.left, rect.bottom),
+  };
+}
+
 ClipperLib::Paths BoardPlaneFragmentsBuilder::createPadCutOuts(
     const Transform& deviceTransform, const Transform& padTransform,
     const BI_FootprintPad& pad) const {
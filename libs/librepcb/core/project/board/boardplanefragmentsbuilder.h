@@ -23,8 +23,10 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+#include "../../geometry/padgeometry.h"
 #include "../../geometry/path.h"
 
+#include <optional/tl/optional.hpp>
 #include <polyclipping/clipper.hpp>
 
 #include <QtCore>
@@ -37,6 +39,8 @@ namespace librepcb {
 class BI_FootprintPad;
 class BI_Plane;
 class BI_Via;
+class Layer;
+class NetSignal;
 class Transform;
 
 /*******************************************************************************
@@ -48,6 +52,61 @@ class Transform;
  */
 class BoardPlaneFragmentsBuilder final {
 public:
+  // Types
+
+  /**
+   * @brief Connection shapes of pads and vias, kept across plane rebuilds
+   *
+   * Converting pad and via outlines to Clipper paths is the most expensive
+   * part of collecting the objects to subtract from a plane, while most of
+   * them do not change between two rebuilds. Thus the resulting paths are
+   * cached in the plane, together with all the input values they depend on.
+   * An entry is only reused if all these values are still the same, so no
+   * explicit invalidation is needed.
+   */
+  struct Cache {
+    struct PadEntry {
+      // Inputs
+      Point devicePosition;
+      Angle deviceRotation;
+      bool deviceMirrored;
+      Point padPosition;
+      Angle padRotation;
+      QList<PadGeometry> geometries;
+      UnsignedLength clearance;
+      bool connected;
+      bool cutOut;
+      // Outputs
+      ClipperLib::Paths connectedAreas;
+      ClipperLib::Paths cutOuts;
+    };
+    struct ViaEntry {
+      // Inputs
+      Point position;
+      PositiveLength size;
+      UnsignedLength clearance;
+      bool connected;
+      // Outputs
+      ClipperLib::Path connectedArea;
+      ClipperLib::Path cutOut;
+    };
+    struct FragmentsEntry {
+      // Inputs
+      Path outline;
+      const Layer* layer;
+      const NetSignal* netSignal;
+      Length minWidth;
+      Length minClearance;
+      int connectStyle;
+      int priority;
+      // Outputs
+      ClipperLib::Paths fragments;  ///< Flattened, but orphans not removed
+    };
+    QHash<const BI_FootprintPad*, PadEntry> pads;
+    QHash<const BI_Via*, ViaEntry> vias;
+    tl::optional<FragmentsEntry> fragments;
+  };
+
   // Constructors / Destructor
   BoardPlaneFragmentsBuilder() = delete;
   BoardPlaneFragmentsBuilder(const BoardPlaneFragmentsBuilder& other) = delete;
@@ -57,23 +116,122 @@ public:
   // General Methods
   QVector<Path> buildFragments() noexcept;
 
+  /**
+   * @brief Rebuild the fragments only within a given area
+   *
+   * Only the part of the plane around the given area is recalculated, the
+   * rest is taken from the fragments of the previous build, which are kept
+   * in the plane's cache. This is much faster than a full rebuild if only
+   * some objects in a small area have been modified.
+   *
+   * If there are no cached fragments yet, or the plane's settings have been
+   * changed since the last build, a full rebuild is done instead.
+   *
+   * @param dirtyMin  Lower left corner of the bounding rectangle of all
+   *                  modifications since the last build (including the
+   *                  old and new positions of moved objects).
+   * @param dirtyMax  Upper right corner of that bounding rectangle.
+   *
+   * @return The new fragments of the whole plane.
+   */
+  QVector<Path> buildFragments(const Point& dirtyMin,
+                               const Point& dirtyMax) noexcept;
+
+  // Static Methods
+
+  /**
+   * @brief Check whether two sets of fragments differ only within an area
+   *
+   * Used to determine whether planes with lower priority can still be
+   * rebuilt within an area after a plane has been rebuilt, since removing
+   * orphans may also modify the fragments outside of the rebuilt area.
+   *
+   * @param fragments1  The first set of fragments.
+   * @param fragments2  The second set of fragments.
+   * @param min         Lower left corner of the area.
+   * @param max         Upper right corner of the area.
+   *
+   * @return Whether all differences are within the area (false if the
+   *         comparison failed).
+   */
+  static bool differOnlyWithin(const QVector<Path>& fragments1,
+                               const QVector<Path>& fragments2,
+                               const Point& min, const Point& max) noexcept;
+
+
+  /**
+   * @brief Subtract cut-outs from an area and ensure the minimum width
+   *
+   * For planes with many cut-outs, the area is split into tiles which are
+   * processed in parallel. The result is the same as without tiling, except
+   * for rounding of vertices on the tile borders.
+   *
+   * @param area          The area to subtract the cut-outs from.
+   * @param cutOuts       The cut-outs to subtract.
+   * @param minWidth      The minimum width of the resulting fragments.
+   * @param tilesPerAxis  Number of tiles in each direction (1 = no tiling).
+   *
+   * @return The resulting area.
+   */
+  static ClipperLib::Paths subtractCutOuts(const ClipperLib::Paths& area,
+                                           const ClipperLib::Paths& cutOuts,
+                                           const Length& minWidth,
+                                           int tilesPerAxis);
+
   // Operator Overloadings
   BoardPlaneFragmentsBuilder& operator=(const BoardPlaneFragmentsBuilder& rhs) =
       delete;
 
+private:  // Types
+  struct CutOut {
+    ClipperLib::IntRect bounds;
+    ClipperLib::Path path;
+  };
+
 private:  // Methods
   void addPlaneOutline();
   void clipToBoardOutline();
-  void subtractOtherObjects();
-  void ensureMinimumWidth();
+  void collectCutOuts();
+  void subtractCutOuts();
   void flattenResult();
+  void mergeWithCachedFragments(const ClipperLib::IntRect& dirtyRect);
+  void storeFragments();
   void removeOrphans();
 
   // Helper Methods
+  const Cache::PadEntry& getPadEntry(const BI_FootprintPad& pad);
+  const Cache::ViaEntry& getViaEntry(const BI_Via& via);
   ClipperLib::Paths createPadCutOuts(const Transform& deviceTransform,
                                      const Transform& padTransform,
                                      const BI_FootprintPad& pad) const;
   ClipperLib::Path createViaCutOut(const BI_Via& via) const noexcept;
+  void addCutOut(const ClipperLib::Path& path);
+  void addCutOuts(const ClipperLib::Paths& paths);
+  bool isCachedFragmentsValid() const noexcept;
+  static ClipperLib::IntRect getBounds(const ClipperLib::Path& path) noexcept;
+  static ClipperLib::Path toPath(const ClipperLib::IntRect& rect) noexcept;
+
+  static ClipperLib::Paths subtractCutOutsTiled(
+      const ClipperLib::Paths& area, const std::vector<CutOut>& cutOuts,
+      const Length& minWidth, int tilesPerAxis);
+
+  /**
+   * @brief Subtract cut-outs from an area and ensure the minimum width
+   *
+   * Only accesses the passed data, thus it is safe to call it from worker
+   * threads.
+   *
+   * @param area      The area to subtract the cut-outs from.
+   * @param cutOuts   The cut-outs to subtract.
+   * @param tile      If set, the result is only calculated within this
+   *                  rectangle. Cut-outs not affecting it are skipped.
+   * @param minWidth  The minimum width of the resulting fragments.
+   *
+   * @return The resulting area.
+   */
+  static ClipperLib::Paths subtractCutOutsInTile(
+      const ClipperLib::Paths& area, const std::vector<CutOut>& cutOuts,
+      const tl::optional<ClipperLib::IntRect>& tile, const Length& minWidth);
 
   /**
    * Returns the maximum allowed arc tolerance when flattening arcs. Do not
@@ -84,10 +242,26 @@ private:  // Methods
     return PositiveLength(5000);
   }
 
+  /// Minimum number of cut-outs to split a plane into tiles which are
+  /// processed in parallel (for less cut-outs it is not worth the overhead)
+  static constexpr int sMinCutOutsForTiling = 1000;
+
+  /// Approximate number of cut-outs per tile. The tiling only depends on the
+  /// plane, not on the machine, so the result is always the same.
+  static constexpr int sCutOutsPerTile = 500;
+
+  /// Maximum number of tiles in each direction
+  static constexpr int sMaxTilesPerAxis = 8;
+
 private:  // Data
   BI_Plane& mPlane;
   ClipperLib::Paths mConnectedNetSignalAreas;
   ClipperLib::Paths mResult;
+  std::vector<CutOut> mCutOuts;
+
+  /// The cache entries used by the current build, replacing the plane's cache
+  /// afterwards (to get rid of entries of removed pads and vias)
+  Cache mUsedCache;
 };
 
 /*******************************************************************************
@@ -0,0 +1,156 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "boardtraceobstaclesbuilder.h"
+
+#include "../../geometry/circle.h"
+#include "../../geometry/polygon.h"
+#include "../../library/pkg/footprint.h"
+#include "../../utils/clipperhelpers.h"
+#include "../../utils/traceobstacleindex.h"
+#include "../../utils/transform.h"
+#include "../circuit/netsignal.h"
+#include "board.h"
+#include "drc/boardclipperpathgenerator.h"
+#include "items/bi_device.h"
+#include "items/bi_footprintpad.h"
+#include "items/bi_netline.h"
+#include "items/bi_netsegment.h"
+#include "items/bi_polygon.h"
+#include "items/bi_stroketext.h"
+#include "items/bi_via.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+BoardTraceObstaclesBuilder::BoardTraceObstaclesBuilder(Board& board) noexcept
+  : mBoard(board) {
+}
+
+BoardTraceObstaclesBuilder::~BoardTraceObstaclesBuilder() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+std::unique_ptr<TraceObstacleIndex> BoardTraceObstaclesBuilder::buildObstacles(
+    const Layer& layer, const BI_NetSegment* ignoredSegment) const {
+  std::unique_ptr<TraceObstacleIndex> index(new TraceObstacleIndex());
+  auto getNet = [](const NetSignal* netsignal) -> tl::optional<Uuid> {
+    if (netsignal) {
+      return netsignal->getUuid();
+    } else {
+      return tl::nullopt;
+    }
+  };
+  auto addAreas = [&index](const ClipperLib::Paths& paths,
+                           const tl::optional<Uuid>& net) {
+    // The united paths contain holes (e.g. of annular pads or unfilled
+    // polygons) as separate paths. Connect them to their outlines by cut-ins,
+    // otherwise each hole would be added as a filled area.
+    std::unique_ptr<ClipperLib::PolyTree> tree = ClipperHelpers::uniteToTree(
+        paths, ClipperLib::pftEvenOdd);  // can throw
+    const ClipperLib::Paths areas =
+        ClipperHelpers::flattenTree(*tree);  // can throw
+    for (const ClipperLib::Path& path : areas) {
+      index->addArea(path, net);
+    }
+  };
+
+  // Traces and vias.
+  foreach (const BI_NetSegment* segment, mBoard.getNetSegments()) {
+    if (segment == ignoredSegment) {
+      continue;
+    }
+    const tl::optional<Uuid> net = getNet(segment->getNetSignal());
+    foreach (const BI_Via* via, segment->getVias()) {
+      if (via->isOnLayer(layer)) {
+        index->addSegment(via->getPosition(), via->getPosition(),
+                          positiveToUnsigned(via->getSize()), net);
+      }
+    }
+    foreach (const BI_NetLine* netLine, segment->getNetLines()) {
+      if (netLine->getLayer() == layer) {
+        index->addSegment(netLine->getStartPoint().getPosition(),
+                          netLine->getEndPoint().getPosition(),
+                          positiveToUnsigned(netLine->getWidth()), net);
+      }
+    }
+  }
+
+  // Pads and other copper of devices.
+  foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+    const Transform transform(*device);
+    foreach (const BI_FootprintPad* pad, device->getPads()) {
+      if (pad->isOnLayer(layer) &&
+          ((!ignoredSegment) ||
+           (pad->getNetSegmentOfLines() != ignoredSegment))) {
+        BoardClipperPathGenerator gen(mBoard, maxArcTolerance());
+        gen.addPad(*pad, transform, layer);  // can throw
+        addAreas(gen.getPaths(), getNet(pad->getCompSigInstNetSignal()));
+      }
+    }
+    BoardClipperPathGenerator gen(mBoard, maxArcTolerance());
+    for (const Polygon& polygon : device->getLibFootprint().getPolygons()) {
+      if (transform.map(polygon.getLayer()) == layer) {
+        gen.addPolygon(polygon, transform);  // can throw
+      }
+    }
+    for (const Circle& circle : device->getLibFootprint().getCircles()) {
+      if (transform.map(circle.getLayer()) == layer) {
+        gen.addCircle(circle, transform);  // can throw
+      }
+    }
+    addAreas(gen.getPaths(), tl::nullopt);  // can throw
+  }
+
+  // Board polygons and texts.
+  BoardClipperPathGenerator gen(mBoard, maxArcTolerance());
+  foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
+    if (polygon->getPolygon().getLayer() == layer) {
+      gen.addPolygon(*polygon);  // can throw
+    }
+  }
+  foreach (const BI_StrokeText* strokeText, mBoard.getStrokeTexts()) {
+    if (strokeText->getTextObj().getLayer() == layer) {
+      gen.addStrokeText(*strokeText);  // can throw
+    }
+  }
+  addAreas(gen.getPaths(), tl::nullopt);  // can throw
+
+  return index;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
@@ -0,0 +1,106 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_BOARDTRACEOBSTACLESBUILDER_H
+#define LIBREPCB_CORE_BOARDTRACEOBSTACLESBUILDER_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../../types/length.h"
+
+#include <QtCore>
+
+#include <memory>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class BI_NetSegment;
+class Board;
+class Layer;
+class TraceObstacleIndex;
+
+/*******************************************************************************
+ *  Class BoardTraceObstaclesBuilder
+ ******************************************************************************/
+
+/**
+ * @brief Collects the copper of a board layer into a
+ *        ::librepcb::TraceObstacleIndex
+ *
+ * All traces, vias, pads, polygons, circles and stroke texts on the given
+ * layer are added, tagged with the UUID of their net (if any). Planes are
+ * not added since they are refilled around new traces anyway.
+ *
+ * A net segment can be excluded, together with all pads it is connected to.
+ * This is needed for traces without net: Since obstacles without net never
+ * match the net of a trace, the trace would otherwise collide with itself.
+ */
+class BoardTraceObstaclesBuilder final {
+public:
+  // Constructors / Destructor
+  BoardTraceObstaclesBuilder() = delete;
+  BoardTraceObstaclesBuilder(const BoardTraceObstaclesBuilder& other) = delete;
+  explicit BoardTraceObstaclesBuilder(Board& board) noexcept;
+  ~BoardTraceObstaclesBuilder() noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Build the obstacle index of a layer
+   *
+   * @param layer           The copper layer to collect the obstacles from.
+   * @param ignoredSegment  If not `nullptr`, the vias and traces of this net
+   *                        segment and the pads it is connected to are not
+   *                        added.
+   * @return The obstacle index.
+   *
+   * @throw Exception if the copper areas could not be determined.
+   */
+  std::unique_ptr<TraceObstacleIndex> buildObstacles(
+      const Layer& layer, const BI_NetSegment* ignoredSegment = nullptr) const;
+
+  // Operator Overloadings
+  BoardTraceObstaclesBuilder& operator=(const BoardTraceObstaclesBuilder& rhs) =
+      delete;
+
+private:  // Methods
+  /**
+   * Returns the maximum allowed arc tolerance when flattening arcs. Keep it
+   * in sync with the DRC, otherwise traces might be placed closer to pads
+   * than the DRC accepts.
+   */
+  static PositiveLength maxArcTolerance() noexcept {
+    return PositiveLength(5000);
+  }
+
+private:  // Data
+  Board& mBoard;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
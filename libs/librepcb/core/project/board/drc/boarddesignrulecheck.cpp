@@ -29,6 +29,7 @@
 #include "../../../library/pkg/footprint.h"
 #include "../../../library/pkg/footprintpad.h"
 #include "../../../library/pkg/packagepad.h"
+#include "../../../utils/clipperareaindex.h"
 #include "../../../utils/clipperhelpers.h"
 #include "../../../utils/toolbox.h"
 #include "../../../utils/transform.h"
@@ -52,11 +53,70 @@
 
 #include <QtCore>
 
+#include <algorithm>
+#include <functional>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
 namespace librepcb {
 
+/**
+ * Unsigned 64x64 bit multiplication with 128 bit result as {high, low} pair,
+ * thus results can be compared with the operators of std::pair
+ */
+static std::pair<quint64, quint64> multiply128(quint64 a, quint64 b) noexcept {
+  const quint64 mask = 0xFFFFFFFFu;
+  const quint64 ll = (a & mask) * (b & mask);
+  const quint64 lh = (a & mask) * (b >> 32);
+  const quint64 hl = (a >> 32) * (b & mask);
+  const quint64 hh = (a >> 32) * (b >> 32);
+  const quint64 mid = (ll >> 32) + (lh & mask) + (hl & mask);
+  return std::make_pair(hh + (lh >> 32) + (hl >> 32) + (mid >> 32),
+                        (mid << 32) | (ll & mask));
+}
+
+/**
+ * Sign of the cross product (b - a) x (p - a), i.e. on which side of the line
+ * a-b the point p is located. Requires coordinate differences below 2^31.
+ */
+static int orientation(const Point& a, const Point& b,
+                       const Point& p) noexcept {
+  const qint64 dx = b.getX().toNm() - a.getX().toNm();
+  const qint64 dy = b.getY().toNm() - a.getY().toNm();
+  const qint64 vx = p.getX().toNm() - a.getX().toNm();
+  const qint64 vy = p.getY().toNm() - a.getY().toNm();
+  const qint64 cross = dx * vy - dy * vx;
+  return (cross > 0) - (cross < 0);
+}
+
+/**
+ * Exact check whether the distance between the point p and the line segment
+ * a-b is less than r. Requires coordinate differences and r below 2^31.
+ */
+static bool isPointCloserToLineThan(const Point& p, const Point& a,
+                                    const Point& b, qint64 r) noexcept {
+  const qint64 dx = b.getX().toNm() - a.getX().toNm();
+  const qint64 dy = b.getY().toNm() - a.getY().toNm();
+  const qint64 vx = p.getX().toNm() - a.getX().toNm();
+  const qint64 vy = p.getY().toNm() - a.getY().toNm();
+  const qint64 dot = vx * dx + vy * dy;
+  const qint64 lengthSquared = dx * dx + dy * dy;
+  if (dot <= 0) {
+    return (vx * vx + vy * vy) < (r * r);  // Nearest to a.
+  } else if (dot >= lengthSquared) {
+    const qint64 wx = p.getX().toNm() - b.getX().toNm();
+    const qint64 wy = p.getY().toNm() - b.getY().toNm();
+    return (wx * wx + wy * wy) < (r * r);  // Nearest to b.
+  } else {
+    // Perpendicular distance: cross^2 / length^2 < r^2.
+    const quint64 cross = static_cast<quint64>(qAbs(dx * vy - dy * vx));
+    return multiply128(cross, cross) <
+        multiply128(static_cast<quint64>(r * r),
+                    static_cast<quint64>(lengthSquared));
+  }
+}
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -81,23 +141,35 @@ BoardDesignRuleCheck::~BoardDesignRuleCheck() noexcept {
  ******************************************************************************/
 
 void BoardDesignRuleCheck::execute(bool quick) {
+  prepare(quick);
+  runChecks();
+}
+
+void BoardDesignRuleCheck::prepare(bool quick) {
   emit started();
   emitProgress(2);
 
   mIgnorePlanes = quick;
   mProgressStatus.clear();
   mMessages.clear();
+  mCachedPaths.clear();
 
   if (!quick) {
     rebuildPlanes(12);  // 10%
+
+    // No check based on copper paths implemented yet, the missing connections
+    // check reports the airwires instead -> make sure they are up to date.
+    mBoard.forceAirWiresRebuild();
   }
+}
 
+void BoardDesignRuleCheck::runChecks() {
   checkMinimumCopperWidth(14);  // 2%
   checkCopperCopperClearances(24);  // 10%
   checkCopperBoardClearances(34);  // 10%
   checkCopperHoleClearances(44);  // 10%
 
-  if (!quick) {
+  if (!mIgnorePlanes) {
     checkDrillDrillClearances(49);  // 5%
     checkDrillBoardClearances(54);  // 5%
     checkMinimumPthAnnularRing(64);  // 10%
@@ -230,7 +302,9 @@ void BoardDesignRuleCheck::checkCopperCopperClearances(int progressEnd) {
     const Circle* circle;  // Only relevant if item is a BI_Device
     const Layer* layer;  // nullptr = THT
     const NetSignal* netSignal;  // nullptr = no net
-    ClipperLib::Paths areas;
+    ClipperLib::Paths areas;  // Determined by createAreas if set
+    std::function<ClipperLib::Paths()> createAreas;  // For lazy creation
+    tl::optional<Capsule> capsule;  // Only set for round & straight items
   };
   QVector<Item> items;
 
@@ -238,20 +312,32 @@ void BoardDesignRuleCheck::checkCopperCopperClearances(int progressEnd) {
   foreach (const BI_NetSegment* netSegment, mBoard.getNetSegments()) {
     // vias.
     foreach (const BI_Via* via, netSegment->getVias()) {
-      BoardClipperPathGenerator gen(mBoard, maxArcTolerance());
-      gen.addVia(*via, offset);
+      auto createAreas = [this, via, offset]() {
+        BoardClipperPathGenerator gen(mBoard, maxArcTolerance());
+        gen.addVia(*via, offset);
+        return gen.getPaths();
+      };
+      const Capsule capsule{via->getPosition(), via->getPosition(),
+                            (*via->getSize() / 2) + offset};
       items.append(Item{via, nullptr, nullptr, nullptr,
-                        via->getNetSegment().getNetSignal(), gen.getPaths()});
+                        via->getNetSegment().getNetSignal(),
+                        ClipperLib::Paths(), createAreas, capsule});
     }
 
     // Net lines.
     foreach (const BI_NetLine* netLine, netSegment->getNetLines()) {
       if (mBoard.getCopperLayers().contains(&netLine->getLayer())) {
-        BoardClipperPathGenerator gen(mBoard, maxArcTolerance());
-        gen.addNetLine(*netLine, offset);
+        auto createAreas = [this, netLine, offset]() {
+          BoardClipperPathGenerator gen(mBoard, maxArcTolerance());
+          gen.addNetLine(*netLine, offset);
+          return gen.getPaths();
+        };
+        const Capsule capsule{netLine->getStartPoint().getPosition(),
+                              netLine->getEndPoint().getPosition(),
+                              (*netLine->getWidth() / 2) + offset};
         items.append(Item{netLine, nullptr, nullptr, &netLine->getLayer(),
                           netLine->getNetSegment().getNetSignal(),
-                          gen.getPaths()});
+                          ClipperLib::Paths(), createAreas, capsule});
       }
     }
   }
@@ -265,7 +351,8 @@ void BoardDesignRuleCheck::checkCopperCopperClearances(int progressEnd) {
         ClipperLib::Paths paths = gen.getPaths();
         ClipperHelpers::offset(paths, offset, maxArcTolerance());
         items.append(Item{plane, nullptr, nullptr, &plane->getLayer(),
-                          &plane->getNetSignal(), paths});
+                          &plane->getNetSignal(), paths, nullptr,
+                          tl::nullopt});
       }
     }
   }
@@ -278,7 +365,8 @@ void BoardDesignRuleCheck::checkCopperCopperClearances(int progressEnd) {
       ClipperLib::Paths paths = gen.getPaths();
       ClipperHelpers::offset(paths, offset, maxArcTolerance());
       items.append(Item{polygon, nullptr, nullptr,
-                        &polygon->getPolygon().getLayer(), nullptr, paths});
+                        &polygon->getPolygon().getLayer(), nullptr, paths,
+                        nullptr, tl::nullopt});
     }
   }
 
@@ -290,7 +378,7 @@ void BoardDesignRuleCheck::checkCopperCopperClearances(int progressEnd) {
       gen.addStrokeText(*strokeText, offset);
       items.append(Item{strokeText, nullptr, nullptr,
                         &strokeText->getTextObj().getLayer(), nullptr,
-                        gen.getPaths()});
+                        gen.getPaths(), nullptr, tl::nullopt});
     }
   }
 
@@ -305,7 +393,8 @@ void BoardDesignRuleCheck::checkCopperCopperClearances(int progressEnd) {
           BoardClipperPathGenerator gen(mBoard, maxArcTolerance());
           gen.addPad(*pad, transform, *layer, offset);
           items.append(Item{pad, nullptr, nullptr, layer,
-                            pad->getCompSigInstNetSignal(), gen.getPaths()});
+                            pad->getCompSigInstNetSignal(), gen.getPaths(),
+                            nullptr, tl::nullopt});
         }
       }
     }
@@ -318,7 +407,7 @@ void BoardDesignRuleCheck::checkCopperCopperClearances(int progressEnd) {
         ClipperLib::Paths paths = gen.getPaths();
         ClipperHelpers::offset(paths, offset, maxArcTolerance());
         items.append(Item{device, &polygon, nullptr, &polygon.getLayer(),
-                          nullptr, paths});
+                          nullptr, paths, nullptr, tl::nullopt});
       }
     }
 
@@ -328,7 +417,7 @@ void BoardDesignRuleCheck::checkCopperCopperClearances(int progressEnd) {
         BoardClipperPathGenerator gen(mBoard, maxArcTolerance());
         gen.addCircle(circle, transform, offset);
         items.append(Item{device, nullptr, &circle, &circle.getLayer(), nullptr,
-                          gen.getPaths()});
+                          gen.getPaths(), nullptr, tl::nullopt});
       }
     }
 
@@ -340,29 +429,54 @@ void BoardDesignRuleCheck::checkCopperCopperClearances(int progressEnd) {
         gen.addStrokeText(*strokeText, offset);
         items.append(Item{strokeText, nullptr, nullptr,
                           &strokeText->getTextObj().getLayer(), nullptr,
-                          gen.getPaths()});
+                          gen.getPaths(), nullptr, tl::nullopt});
       }
     }
   }
 
-  // Now check for intersections.
-  auto lastItem = items.isEmpty() ? items.end() : std::prev(items.end());
-  for (auto it1 = items.begin(); it1 != lastItem; it1++) {
-    for (auto it2 = it1 + 1; it2 != items.end(); it2++) {
-      if (((it1->netSignal != it2->netSignal) || (!it1->netSignal) ||
-           (!it2->netSignal)) &&
-          ((!it1->layer) || (!it2->layer) || (it1->layer == it2->layer))) {
-        const std::unique_ptr<ClipperLib::PolyTree> intersections =
-            ClipperHelpers::intersect(it1->areas, it2->areas);
-        const ClipperLib::Paths paths =
-            ClipperHelpers::flattenTree(*intersections);
-        if (!paths.empty()) {
-          const QVector<Path> locations = ClipperHelpers::convert(paths);
-          emitMessage(std::make_shared<DrcMsgCopperCopperClearanceViolation>(
-              it1->layer, it1->netSignal, *it1->item, it1->polygon, it1->circle,
-              it2->layer, it2->netSignal, *it2->item, it2->polygon, it2->circle,
-              clearance, locations));
-        }
+  // Helper to get the areas of an item, creating them if not done yet.
+  auto getAreas = [](Item& item) -> const ClipperLib::Paths& {
+    if (item.createAreas) {
+      item.areas = item.createAreas();
+      item.createAreas = nullptr;
+    }
+    return item.areas;
+  };
+
+  // Broad phase: Find all pairs of items with overlapping bounding boxes.
+  // For round and straight items, the bounding box is determined without
+  // creating their areas.
+  std::vector<ClipperLib::IntRect> bounds;
+  bounds.reserve(items.count());
+  for (Item& item : items) {
+    bounds.push_back(item.capsule
+                         ? getCapsuleBounds(*item.capsule)
+                         : ClipperAreaIndex::getBounds(getAreas(item)));
+  }
+
+  // Narrow phase: For round and straight items, check the distance
+  // analytically first and skip the (expensive) polygon operations if they
+  // are far enough away from each other.
+  for (const auto& pair : findOverlappingBounds(bounds)) {
+    Item& item1 = items[pair.first];
+    Item& item2 = items[pair.second];
+    if (((item1.netSignal != item2.netSignal) || (!item1.netSignal) ||
+         (!item2.netSignal)) &&
+        ((!item1.layer) || (!item2.layer) || (item1.layer == item2.layer))) {
+      if (item1.capsule && item2.capsule &&
+          (!capsulesMayIntersect(*item1.capsule, *item2.capsule))) {
+        continue;
+      }
+      const std::unique_ptr<ClipperLib::PolyTree> intersections =
+          ClipperHelpers::intersect(getAreas(item1), getAreas(item2));
+      const ClipperLib::Paths paths =
+          ClipperHelpers::flattenTree(*intersections);
+      if (!paths.empty()) {
+        const QVector<Path> locations = ClipperHelpers::convert(paths);
+        emitMessage(std::make_shared<DrcMsgCopperCopperClearanceViolation>(
+            item1.layer, item1.netSignal, *item1.item, item1.polygon,
+            item1.circle, item2.layer, item2.netSignal, *item2.item,
+            item2.polygon, item2.circle, clearance, locations));
       }
     }
   }
@@ -378,15 +492,16 @@ void BoardDesignRuleCheck::checkCopperBoardClearances(int progressEnd) {
 
   emitStatus(tr("Check board clearances..."));
 
-  // Determine restricted area around board outline.
-  const ClipperLib::Paths restrictedArea = getBoardClearanceArea(clearance);
+  // Determine restricted area around board outline. It is indexed since
+  // it can be very complex, but each item only touches a small part of it.
+  const ClipperAreaIndex restrictedArea(getBoardClearanceArea(clearance));
 
   // Helper for the actual check.
   QVector<Path> locations;
   auto intersects = [&restrictedArea,
                      &locations](const ClipperLib::Paths& paths) {
     std::unique_ptr<ClipperLib::PolyTree> intersections =
-        ClipperHelpers::intersect(restrictedArea, paths);
+        restrictedArea.intersect(paths);
     locations =
         ClipperHelpers::convert(ClipperHelpers::flattenTree(*intersections));
     return (!locations.isEmpty());
@@ -519,11 +634,13 @@ void BoardDesignRuleCheck::checkCopperHoleClearances(int progressEnd) {
 
   emitStatus(tr("Check hole clearances..."));
 
-  // Determine tha areas where copper is available on *any* layer.
-  ClipperLib::Paths copperAreas;
+  // Determine tha areas where copper is available on *any* layer. They are
+  // indexed since each hole only touches a small part of them.
+  ClipperLib::Paths copperPaths;
   foreach (const Layer* layer, mBoard.getCopperLayers()) {
-    ClipperHelpers::unite(copperAreas, getCopperPaths(*layer, {}));
+    ClipperHelpers::unite(copperPaths, getCopperPaths(*layer, {}));
   }
+  const ClipperAreaIndex copperAreas(copperPaths);
 
   // Helper for the actual check.
   QVector<Path> locations;
@@ -532,7 +649,7 @@ void BoardDesignRuleCheck::checkCopperHoleClearances(int progressEnd) {
     BoardClipperPathGenerator gen(mBoard, maxArcTolerance());
     gen.addHole(hole, transform, clearance - *maxArcTolerance() - Length(1));
     std::unique_ptr<ClipperLib::PolyTree> intersections =
-        ClipperHelpers::intersect(copperAreas, gen.getPaths());
+        copperAreas.intersect(gen.getPaths());
     locations =
         ClipperHelpers::convert(ClipperHelpers::flattenTree(*intersections));
     return (!locations.isEmpty());
@@ -576,7 +693,10 @@ void BoardDesignRuleCheck::checkDrillDrillClearances(int progressEnd) {
   struct Item {
     const BI_Base* item;
     tl::optional<Uuid> hole;
-    ClipperLib::Paths areas;
+    NonEmptyPath path;
+    PositiveLength diameter;
+    ClipperLib::Paths areas;  // Lazy created, only if needed
+    tl::optional<Capsule> capsule;  // Only set for round & straight drills
   };
   QVector<Item> items;
 
@@ -584,11 +704,28 @@ void BoardDesignRuleCheck::checkDrillDrillClearances(int progressEnd) {
   auto addItem = [&diameterExpansion, &items](
                      const BI_Base& item, const Uuid& hole,
                      const NonEmptyPath& path, const PositiveLength& diameter) {
-    const QVector<Path> area =
-        path->toOutlineStrokes(diameter + diameterExpansion);
-    const ClipperLib::Paths paths =
-        ClipperHelpers::convert(area, maxArcTolerance());
-    items.append(Item{&item, hole, paths});
+    const PositiveLength expandedDiameter = diameter + diameterExpansion;
+    const QVector<Vertex>& vertices = path->getVertices();
+    tl::optional<Capsule> capsule;
+    if (vertices.count() == 1) {
+      capsule = Capsule{vertices.first().getPos(), vertices.first().getPos(),
+                        *expandedDiameter / 2};
+    } else if ((vertices.count() == 2) &&
+               (vertices.first().getAngle() == 0)) {
+      capsule = Capsule{vertices.first().getPos(), vertices.last().getPos(),
+                        *expandedDiameter / 2};
+    }
+    items.append(Item{&item, hole, path, expandedDiameter, ClipperLib::Paths(),
+                      capsule});
+  };
+
+  // Helper to get the areas of an item, creating them if not done yet.
+  auto getAreas = [](Item& item) -> const ClipperLib::Paths& {
+    if (item.areas.empty()) {
+      const QVector<Path> area = item.path->toOutlineStrokes(item.diameter);
+      item.areas = ClipperHelpers::convert(area, maxArcTolerance());
+    }
+    return item.areas;
   };
 
   // Vias.
@@ -627,21 +764,34 @@ void BoardDesignRuleCheck::checkDrillDrillClearances(int progressEnd) {
     }
   }
 
-  // Now check for intersections.
-  auto lastItem = items.isEmpty() ? items.end() : std::prev(items.end());
-  for (auto it1 = items.begin(); it1 != lastItem; it1++) {
-    for (auto it2 = it1 + 1; it2 != items.end(); it2++) {
-      const std::unique_ptr<ClipperLib::PolyTree> intersections =
-          ClipperHelpers::intersect(it1->areas, it2->areas);
-      const ClipperLib::Paths paths =
-          ClipperHelpers::flattenTree(*intersections);
-      if ((!paths.empty()) && it1->item && it1->hole && it2->item &&
-          it2->hole) {
-        const QVector<Path> locations = ClipperHelpers::convert(paths);
-        emitMessage(std::make_shared<DrcMsgDrillDrillClearanceViolation>(
-            *it1->item, *it1->hole, *it2->item, *it2->hole, clearance,
-            locations));
-      }
+  // Broad phase: Find all pairs of drills with overlapping bounding boxes.
+  std::vector<ClipperLib::IntRect> bounds;
+  bounds.reserve(items.count());
+  for (Item& item : items) {
+    bounds.push_back(item.capsule
+                         ? getCapsuleBounds(*item.capsule)
+                         : ClipperAreaIndex::getBounds(getAreas(item)));
+  }
+
+  // Narrow phase: For round drills and straight slots, check the distance
+  // analytically first and skip the (expensive) polygon operations if they
+  // are far enough away from each other.
+  for (const auto& pair : findOverlappingBounds(bounds)) {
+    Item& item1 = items[pair.first];
+    Item& item2 = items[pair.second];
+    if (item1.capsule && item2.capsule &&
+        (!capsulesMayIntersect(*item1.capsule, *item2.capsule))) {
+      continue;
+    }
+    const std::unique_ptr<ClipperLib::PolyTree> intersections =
+        ClipperHelpers::intersect(getAreas(item1), getAreas(item2));
+    const ClipperLib::Paths paths = ClipperHelpers::flattenTree(*intersections);
+    if ((!paths.empty()) && item1.item && item1.hole && item2.item &&
+        item2.hole) {
+      const QVector<Path> locations = ClipperHelpers::convert(paths);
+      emitMessage(std::make_shared<DrcMsgDrillDrillClearanceViolation>(
+          *item1.item, *item1.hole, *item2.item, *item2.hole, clearance,
+          locations));
     }
   }
 
@@ -657,7 +807,7 @@ void BoardDesignRuleCheck::checkDrillBoardClearances(int progressEnd) {
   emitStatus(tr("Check drill to board edge clearances..."));
 
   // Determine restricted area around board outline.
-  const ClipperLib::Paths restrictedArea = getBoardClearanceArea(clearance);
+  const ClipperAreaIndex restrictedArea(getBoardClearanceArea(clearance));
 
   // Helper for the actual check.
   QVector<Path> locations;
@@ -668,7 +818,7 @@ void BoardDesignRuleCheck::checkDrillBoardClearances(int progressEnd) {
     const ClipperLib::Paths paths =
         ClipperHelpers::convert(area, maxArcTolerance());
     std::unique_ptr<ClipperLib::PolyTree> intersections =
-        ClipperHelpers::intersect(restrictedArea, paths);
+        restrictedArea.intersect(paths);
     locations =
         ClipperHelpers::convert(ClipperHelpers::flattenTree(*intersections));
     return (!locations.isEmpty());
@@ -1025,29 +1175,43 @@ void BoardDesignRuleCheck::checkCourtyardClearances(int progressEnd) {
   emitStatus(tr("Check courtyard clearances..."));
 
   for (const Layer& layer : {Layer::topCourtyard(), Layer::botCourtyard()}) {
-    // determine device courtyard areas
-    QMap<const BI_Device*, ClipperLib::Paths> deviceCourtyards;
+    // Determine device courtyard areas. Keep them sorted by device pointer
+    // to get the same message order as when using a QMap.
+    struct Courtyard {
+      const BI_Device* device;
+      ClipperLib::Paths paths;
+    };
+    std::vector<Courtyard> courtyards;
     foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
-      deviceCourtyards.insert(device, getDeviceCourtyardPaths(*device, layer));
-    }
-
-    // check clearances
-    for (int i = 0; i < deviceCourtyards.count(); ++i) {
-      const BI_Device* dev1 = deviceCourtyards.keys()[i];
-      Q_ASSERT(dev1);
-      const ClipperLib::Paths& paths1 = deviceCourtyards[dev1];
-      for (int k = i + 1; k < deviceCourtyards.count(); ++k) {
-        const BI_Device* dev2 = deviceCourtyards.keys()[k];
-        Q_ASSERT(dev2);
-        const ClipperLib::Paths& paths2 = deviceCourtyards[dev2];
-        const std::unique_ptr<ClipperLib::PolyTree> intersections =
-            ClipperHelpers::intersect(paths1, paths2);
-        const QVector<Path> locations = ClipperHelpers::convert(
-            ClipperHelpers::flattenTree(*intersections));
-        if (!locations.isEmpty()) {
-          emitMessage(std::make_shared<DrcMsgCourtyardOverlap>(*dev1, *dev2,
-                                                               locations));
-        }
+      ClipperLib::Paths paths = getDeviceCourtyardPaths(*device, layer);
+      if (!paths.empty()) {
+        courtyards.push_back(Courtyard{device, std::move(paths)});
+      }
+    }
+    std::sort(courtyards.begin(), courtyards.end(),
+              [](const Courtyard& a, const Courtyard& b) {
+                return std::less<const BI_Device*>()(a.device, b.device);
+              });
+
+    // Broad phase: Find all pairs of courtyards with overlapping bounding
+    // boxes.
+    std::vector<ClipperLib::IntRect> bounds;
+    bounds.reserve(courtyards.size());
+    for (const Courtyard& courtyard : courtyards) {
+      bounds.push_back(ClipperAreaIndex::getBounds(courtyard.paths));
+    }
+
+    // Narrow phase: Exact intersection of the candidates.
+    for (const auto& pair : findOverlappingBounds(bounds)) {
+      const Courtyard& c1 = courtyards[pair.first];
+      const Courtyard& c2 = courtyards[pair.second];
+      const std::unique_ptr<ClipperLib::PolyTree> intersections =
+          ClipperHelpers::intersect(c1.paths, c2.paths);
+      const QVector<Path> locations = ClipperHelpers::convert(
+          ClipperHelpers::flattenTree(*intersections));
+      if (!locations.isEmpty()) {
+        emitMessage(std::make_shared<DrcMsgCourtyardOverlap>(
+            *c1.device, *c2.device, locations));
       }
     }
   }
@@ -1165,8 +1329,7 @@ void BoardDesignRuleCheck::checkForMissingConnections(int progressEnd) {
   emitStatus(tr("Check for missing connections..."));
 
   // No check based on copper paths implemented yet -> return existing airwires
-  // instead.
-  mBoard.forceAirWiresRebuild();
+  // instead (rebuilt in prepare()).
   foreach (const BI_AirWire* airWire, mBoard.getAirWires()) {
     const QVector<Path> locations{Path::obround(airWire->getP1().getPosition(),
                                                 airWire->getP2().getPosition(),
@@ -1221,6 +1384,83 @@ bool BoardDesignRuleCheck::requiresHoleSlotWarning(
   }
 }
 
+bool BoardDesignRuleCheck::capsulesMayIntersect(const Capsule& c1,
+                                                const Capsule& c2) noexcept {
+  // Take into account that the polygons used for the exact check are
+  // approximated with a tolerance of maxArcTolerance(), so the result of
+  // this check is consistent with the polygon operations.
+  const qint64 r = (c1.radius + c2.radius + (*maxArcTolerance() * 2)).toNm();
+
+  // The exact integer predicates below require all coordinate differences
+  // (and the distance) to be less than 2^31 to not overflow. Beyond that
+  // (i.e. more than 1m away from origin), just fall back to the exact
+  // polygon operations.
+  const qint64 limit = qint64(1) << 30;
+  for (const Point& p : {c1.p1, c1.p2, c2.p1, c2.p2}) {
+    if ((qAbs(p.getX().toNm()) >= limit) || (qAbs(p.getY().toNm()) >= limit)) {
+      return true;
+    }
+  }
+  if ((r < 0) || (r >= limit)) {
+    return true;
+  }
+
+  // Crossing lines always intersect, otherwise the shortest distance is
+  // between an end point and the other line.
+  const int o1 = orientation(c1.p1, c1.p2, c2.p1);
+  const int o2 = orientation(c1.p1, c1.p2, c2.p2);
+  const int o3 = orientation(c2.p1, c2.p2, c1.p1);
+  const int o4 = orientation(c2.p1, c2.p2, c1.p2);
+  if ((o1 * o2 < 0) && (o3 * o4 < 0)) {
+    return true;
+  }
+  return isPointCloserToLineThan(c1.p1, c2.p1, c2.p2, r) ||
+      isPointCloserToLineThan(c1.p2, c2.p1, c2.p2, r) ||
+      isPointCloserToLineThan(c2.p1, c1.p1, c1.p2, r) ||
+      isPointCloserToLineThan(c2.p2, c1.p1, c1.p2, r);
+}
+
+ClipperLib::IntRect BoardDesignRuleCheck::getCapsuleBounds(
+    const Capsule& capsule) noexcept {
+  // Expanded by maxArcTolerance() for consistency with capsulesMayIntersect().
+  const qint64 r = (capsule.radius + *maxArcTolerance()).toNm();
+  return ClipperLib::IntRect{
+      std::min(capsule.p1.getX(), capsule.p2.getX()).toNm() - r,
+      std::min(capsule.p1.getY(), capsule.p2.getY()).toNm() - r,
+      std::max(capsule.p1.getX(), capsule.p2.getX()).toNm() + r,
+      std::max(capsule.p1.getY(), capsule.p2.getY()).toNm() + r};
+}
+
+std::vector<std::pair<int, int>> BoardDesignRuleCheck::findOverlappingBounds(
+    const std::vector<ClipperLib::IntRect>& bounds) {
+  // Sweep along the X axis, skipping invalid (empty) rects.
+  std::vector<int> sweepOrder;
+  for (std::size_t i = 0; i < bounds.size(); ++i) {
+    if (bounds[i].left <= bounds[i].right) {
+      sweepOrder.push_back(static_cast<int>(i));
+    }
+  }
+  std::sort(sweepOrder.begin(), sweepOrder.end(), [&bounds](int a, int b) {
+    return bounds[a].left < bounds[b].left;
+  });
+  std::vector<std::pair<int, int>> pairs;
+  for (std::size_t i = 0; i < sweepOrder.size(); ++i) {
+    const ClipperLib::IntRect& r1 = bounds[sweepOrder[i]];
+    for (std::size_t k = i + 1; k < sweepOrder.size(); ++k) {
+      const ClipperLib::IntRect& r2 = bounds[sweepOrder[k]];
+      if (r2.left > r1.right) {
+        break;  // All following rects are further right.
+      }
+      if ((r1.top <= r2.bottom) && (r2.top <= r1.bottom)) {
+        pairs.push_back(std::make_pair(std::min(sweepOrder[i], sweepOrder[k]),
+                                       std::max(sweepOrder[i], sweepOrder[k])));
+      }
+    }
+  }
+  std::sort(pairs.begin(), pairs.end());  // Keep deterministic order.
+  return pairs;
+}
+
 ClipperLib::Paths BoardDesignRuleCheck::getBoardClearanceArea(
     const UnsignedLength& clearance) const {
   ClipperLib::Paths result;
@@ -1358,7 +1598,9 @@ void BoardDesignRuleCheck::emitProgress(int percent) noexcept {
 void BoardDesignRuleCheck::emitStatus(const QString& status) noexcept {
   mProgressStatus.append(status);
   emit progressStatus(status);
-  qApp->processEvents();
+  if (QThread::currentThread() == qApp->thread()) {
+    qApp->processEvents();  // Keep the UI responsive.
+  }
 }
 
 void BoardDesignRuleCheck::emitMessage(
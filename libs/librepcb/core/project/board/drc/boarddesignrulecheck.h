@@ -66,8 +66,33 @@ public:
   const RuleCheckMessageList& getMessages() const noexcept { return mMessages; }
 
   // General Methods
+
+  /**
+   * @brief Run the whole check (same as #prepare() followed by #runChecks())
+   *
+   * @param quick   If true, planes are not rebuilt and only the copper
+   *                related checks are executed.
+   */
   void execute(bool quick);
 
+  /**
+   * @brief Prepare the board for the check
+   *
+   * Rebuilds the planes and airwires of the board (unless `quick` is set), so
+   * this modifies the board and must be called from the main thread.
+   *
+   * @param quick   See #execute().
+   */
+  void prepare(bool quick);
+
+  /**
+   * @brief Run the checks after #prepare() has been called
+   *
+   * Only reads from the board, so the checks of different boards may run
+   * concurrently in worker threads once all boards are prepared.
+   */
+  void runChecks();
+
 signals:
   void started();
   void progressPercent(int percent);
@@ -75,6 +100,17 @@ signals:
   void progressMessage(const QString& msg);
   void finished();
 
+private:  // Types
+  /**
+   * Circle (p1 == p2) or straight line with round caps, allowing fast
+   * clearance checks without polygon operations
+   */
+  struct Capsule {
+    Point p1;
+    Point p2;
+    Length radius;
+  };
+
 private:  // Methods
   void rebuildPlanes(int progressEnd);
   void checkMinimumCopperWidth(int progressEnd);
@@ -107,6 +143,11 @@ private:  // Methods
   ClipperLib::Paths getDeviceCourtyardPaths(const BI_Device& device,
                                             const Layer& layer);
   QVector<Path> getDeviceLocation(const BI_Device& device) const;
+  static bool capsulesMayIntersect(const Capsule& c1,
+                                   const Capsule& c2) noexcept;
+  static ClipperLib::IntRect getCapsuleBounds(const Capsule& capsule) noexcept;
+  static std::vector<std::pair<int, int>> findOverlappingBounds(
+      const std::vector<ClipperLib::IntRect>& bounds);
   template <typename THole>
   QVector<Path> getHoleLocation(const THole& hole,
                                 const Transform& transform1 = Transform(),
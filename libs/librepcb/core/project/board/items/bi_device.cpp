@@ -202,7 +202,7 @@ StrokeTextList BI_Device::getDefaultStrokeTexts() const noexcept {
 }
 
 void BI_Device::addStrokeText(BI_StrokeText& text) {
-  if ((mStrokeTexts.values().contains(&text)) ||
+  if ((mStrokeTexts.value(text.getUuid()) == &text) ||
       (&text.getBoard() != &mBoard)) {
     throw LogicError(__FILE__, __LINE__);
   }
@@ -217,6 +217,7 @@ void BI_Device::addStrokeText(BI_StrokeText& text) {
     text.addToBoard();  // can throw
   }
   mStrokeTexts.insert(text.getUuid(), &text);
+  mBoard.setModified();
   emit strokeTextAdded(text);
 }
 
@@ -228,6 +229,7 @@ void BI_Device::removeStrokeText(BI_StrokeText& text) {
     text.removeFromBoard();  // can throw
   }
   mStrokeTexts.remove(text.getUuid());
+  mBoard.setModified();
   emit strokeTextRemoved(text);
 }
 
@@ -238,6 +240,7 @@ void BI_Device::removeStrokeText(BI_StrokeText& text) {
 void BI_Device::setPosition(const Point& pos) noexcept {
   if (pos != mPosition) {
     mPosition = pos;
+    mBoard.setModified();
     onEdited.notify(Event::PositionChanged);
   }
 }
@@ -245,6 +248,7 @@ void BI_Device::setPosition(const Point& pos) noexcept {
 void BI_Device::setRotation(const Angle& rot) noexcept {
   if (rot != mRotation) {
     mRotation = rot;
+    mBoard.setModified();
     onEdited.notify(Event::RotationChanged);
   }
 }
@@ -255,6 +259,7 @@ void BI_Device::setMirrored(bool mirror) {
       throw LogicError(__FILE__, __LINE__);
     }
     mMirrored = mirror;
+    mBoard.setModified();
     onEdited.notify(Event::MirroredChanged);
   }
 }
@@ -262,6 +267,7 @@ void BI_Device::setMirrored(bool mirror) {
 void BI_Device::setAttributes(const AttributeList& attributes) noexcept {
   if (attributes != mAttributes) {
     mAttributes = attributes;
+    mBoard.setModified();
     emit attributesChanged();
   }
 }
@@ -84,6 +84,7 @@ void BI_Hole::removeFromBoard() {
 
 void BI_Hole::holeEdited(const Hole& hole, Hole::Event event) noexcept {
   Q_UNUSED(hole);
+  mBoard.setModified();
 
   switch (event) {
     case Hole::Event::UuidChanged:
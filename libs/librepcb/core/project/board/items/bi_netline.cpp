@@ -147,12 +147,14 @@ void BI_NetLine::setLayer(const Layer& layer) {
     throw LogicError(__FILE__, __LINE__);
   }
   if (mTrace.setLayer(layer)) {
+    mBoard.setModified();
     onEdited.notify(Event::LayerChanged);
   }
 }
 
 void BI_NetLine::setWidth(const PositiveLength& width) noexcept {
   if (mTrace.setWidth(width)) {
+    mBoard.setModified();
     onEdited.notify(Event::WidthChanged);
   }
 }
@@ -65,6 +65,7 @@ TraceAnchor BI_NetPoint::toTraceAnchor() const noexcept {
 
 void BI_NetPoint::setPosition(const Point& position) noexcept {
   if (mJunction.setPosition(position)) {
+    mBoard.setModified();
     foreach (BI_NetLine* netLine, mRegisteredNetLines) {
       netLine->updatePositions();
     }
@@ -96,6 +96,7 @@ void BI_NetSegment::setNetSignal(NetSignal* netsignal) {
       sgl.dismiss();
     }
     mNetSignal = netsignal;
+    mBoard.setModified();
   }
 }
 
@@ -108,7 +109,8 @@ void BI_NetSegment::addElements(const QList<BI_Via*>& vias,
                                 const QList<BI_NetLine*>& netlines) {
   ScopeGuardList sgl(netpoints.count() + netlines.count());
   foreach (BI_Via* via, vias) {
-    if ((mVias.values().contains(via)) || (&via->getNetSegment() != this)) {
+    if ((mVias.value(via->getUuid()) == via) ||
+        (&via->getNetSegment() != this)) {
       throw LogicError(__FILE__, __LINE__);
     }
     if (mVias.contains(via->getUuid())) {
@@ -128,7 +130,7 @@ void BI_NetSegment::addElements(const QList<BI_Via*>& vias,
     });
   }
   foreach (BI_NetPoint* netpoint, netpoints) {
-    if ((mNetPoints.values().contains(netpoint)) ||
+    if ((mNetPoints.value(netpoint->getUuid()) == netpoint) ||
         (&netpoint->getNetSegment() != this)) {
       throw LogicError(__FILE__, __LINE__);
     }
@@ -150,7 +152,7 @@ void BI_NetSegment::addElements(const QList<BI_Via*>& vias,
     });
   }
   foreach (BI_NetLine* netline, netlines) {
-    if ((mNetLines.values().contains(netline)) ||
+    if ((mNetLines.value(netline->getUuid()) == netline) ||
         (&netline->getNetSegment() != this)) {
       throw LogicError(__FILE__, __LINE__);
     }
@@ -180,6 +182,7 @@ void BI_NetSegment::addElements(const QList<BI_Via*>& vias,
   }
 
   sgl.dismiss();
+  mBoard.setModified();
 
   emit elementsAdded(vias, netpoints, netlines);
 }
@@ -242,6 +245,7 @@ void BI_NetSegment::removeElements(const QList<BI_Via*>& vias,
   }
 
   sgl.dismiss();
+  mBoard.setModified();
 
   emit elementsRemoved(vias, netpoints, netlines);
 }
@@ -361,42 +365,34 @@ void BI_NetSegment::findAllConnectedNetPoints(
     const BI_NetLineAnchor& p, QSet<const BI_Via*>& vias,
     QSet<const BI_FootprintPad*>& pads, QSet<const BI_NetPoint*>& points) const
     noexcept {
-  if (const BI_Via* via = dynamic_cast<const BI_Via*>(&p)) {
-    if (vias.contains(via)) return;
-    vias.insert(via);
-    foreach (const BI_NetLine* netline, mNetLines) {
-      if (&netline->getStartPoint() == via) {
-        findAllConnectedNetPoints(netline->getEndPoint(), vias, pads, points);
-      }
-      if (&netline->getEndPoint() == via) {
-        findAllConnectedNetPoints(netline->getStartPoint(), vias, pads, points);
-      }
-    }
-  } else if (const BI_FootprintPad* pad =
-                 dynamic_cast<const BI_FootprintPad*>(&p)) {
-    if (pads.contains(pad)) return;
-    pads.insert(pad);
-    foreach (const BI_NetLine* netline, mNetLines) {
-      if (&netline->getStartPoint() == pad) {
-        findAllConnectedNetPoints(netline->getEndPoint(), vias, pads, points);
-      }
-      if (&netline->getEndPoint() == pad) {
-        findAllConnectedNetPoints(netline->getStartPoint(), vias, pads, points);
-      }
-    }
-  } else if (const BI_NetPoint* np = dynamic_cast<const BI_NetPoint*>(&p)) {
-    if (points.contains(np)) return;
-    points.insert(np);
-    foreach (const BI_NetLine* netline, mNetLines) {
-      if (&netline->getStartPoint() == np) {
-        findAllConnectedNetPoints(netline->getEndPoint(), vias, pads, points);
-      }
-      if (&netline->getEndPoint() == np) {
-        findAllConnectedNetPoints(netline->getStartPoint(), vias, pads, points);
-      }
+  // Determine the neighbors of all anchors once, since scanning all net lines
+  // for each visited anchor would be quadratic for large net segments.
+  QHash<const BI_NetLineAnchor*, QVector<const BI_NetLineAnchor*>> neighbors;
+  neighbors.reserve(mNetLines.count() * 2);
+  foreach (const BI_NetLine* netline, mNetLines) {
+    neighbors[&netline->getStartPoint()].append(&netline->getEndPoint());
+    neighbors[&netline->getEndPoint()].append(&netline->getStartPoint());
+  }
+
+  QVector<const BI_NetLineAnchor*> stack = {&p};
+  while (!stack.isEmpty()) {
+    const BI_NetLineAnchor* anchor = stack.takeLast();
+    if (const BI_Via* via = dynamic_cast<const BI_Via*>(anchor)) {
+      if (vias.contains(via)) continue;
+      vias.insert(via);
+    } else if (const BI_FootprintPad* pad =
+                   dynamic_cast<const BI_FootprintPad*>(anchor)) {
+      if (pads.contains(pad)) continue;
+      pads.insert(pad);
+    } else if (const BI_NetPoint* np =
+                   dynamic_cast<const BI_NetPoint*>(anchor)) {
+      if (points.contains(np)) continue;
+      points.insert(np);
+    } else {
+      Q_ASSERT(false);
+      continue;
     }
-  } else {
-    Q_ASSERT(false);
+    stack += neighbors.value(anchor);
   }
 }
 
@@ -55,7 +55,8 @@ BI_Plane::BI_Plane(Board& board, const Uuid& uuid, const Layer& layer,
     mConnectStyle(ConnectStyle::Solid),
     // mThermalGapWidth(100000), mThermalSpokeWidth(100000),
     mIsVisible(true),
-    mFragments() {
+    mFragments(),
+    mFragmentsBuilderCache() {
 }
 
 BI_Plane::~BI_Plane() noexcept {
@@ -68,6 +69,7 @@ BI_Plane::~BI_Plane() noexcept {
 void BI_Plane::setOutline(const Path& outline) noexcept {
   if (outline != mOutline) {
     mOutline = outline;
+    mBoard.setModified();
     onEdited.notify(Event::OutlineChanged);
   }
 }
@@ -75,6 +77,7 @@ void BI_Plane::setOutline(const Path& outline) noexcept {
 void BI_Plane::setLayer(const Layer& layer) noexcept {
   if (&layer != mLayer) {
     mLayer = &layer;
+    mBoard.setModified();
     onEdited.notify(Event::LayerChanged);
   }
 }
@@ -91,36 +94,42 @@ void BI_Plane::setNetSignal(NetSignal& netsignal) {
       sg.dismiss();
     }
     mNetSignal = &netsignal;
+    mBoard.setModified();
   }
 }
 
 void BI_Plane::setMinWidth(const UnsignedLength& minWidth) noexcept {
   if (minWidth != mMinWidth) {
     mMinWidth = minWidth;
+    mBoard.setModified();
   }
 }
 
 void BI_Plane::setMinClearance(const UnsignedLength& minClearance) noexcept {
   if (minClearance != mMinClearance) {
     mMinClearance = minClearance;
+    mBoard.setModified();
   }
 }
 
 void BI_Plane::setConnectStyle(BI_Plane::ConnectStyle style) noexcept {
   if (style != mConnectStyle) {
     mConnectStyle = style;
+    mBoard.setModified();
   }
 }
 
 void BI_Plane::setPriority(int priority) noexcept {
   if (priority != mPriority) {
     mPriority = priority;
+    mBoard.setModified();
   }
 }
 
 void BI_Plane::setKeepOrphans(bool keepOrphans) noexcept {
   if (keepOrphans != mKeepOrphans) {
     mKeepOrphans = keepOrphans;
+    mBoard.setModified();
   }
 }
 
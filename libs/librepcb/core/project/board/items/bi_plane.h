@@ -26,6 +26,7 @@
 #include "../../../exceptions.h"
 #include "../../../geometry/path.h"
 #include "../../../types/uuid.h"
+#include "../boardplanefragmentsbuilder.h"
 #include "bi_base.h"
 
 #include <librepcb/core/utils/signalslot.h>
@@ -93,6 +94,9 @@ public:
   // {return mThermalSpokeWidth;}
   const Path& getOutline() const noexcept { return mOutline; }
   const QVector<Path>& getFragments() const noexcept { return mFragments; }
+  BoardPlaneFragmentsBuilder::Cache& getFragmentsBuilderCache() noexcept {
+    return mFragmentsBuilderCache;
+  }
   bool isVisible() const noexcept { return mIsVisible; }
 
   // Setters
@@ -138,6 +142,7 @@ private:  // Data
   bool mIsVisible;  // volatile, not saved to file
 
   QVector<Path> mFragments;
+  BoardPlaneFragmentsBuilder::Cache mFragmentsBuilderCache;  // volatile
 };
 
 /*******************************************************************************
@@ -22,7 +22,7 @@
  ******************************************************************************/
 #include "bi_polygon.h"
 
-#include "../../../geometry/polygon.h"
+#include "../board.h"
 
 #include <QtCore>
 
@@ -36,7 +36,10 @@ namespace librepcb {
  ******************************************************************************/
 
 BI_Polygon::BI_Polygon(Board& board, const Polygon& polygon)
-  : BI_Base(board), mPolygon(new Polygon(polygon)) {
+  : BI_Base(board),
+    mPolygon(new Polygon(polygon)),
+    mOnEditedSlot(*this, &BI_Polygon::polygonEdited) {
+  mPolygon->onEdited.attach(mOnEditedSlot);
 }
 
 BI_Polygon::~BI_Polygon() noexcept {
@@ -68,6 +71,17 @@ void BI_Polygon::removeFromBoard() {
   BI_Base::removeFromBoard();
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void BI_Polygon::polygonEdited(const Polygon& polygon,
+                               Polygon::Event event) noexcept {
+  Q_UNUSED(polygon);
+  Q_UNUSED(event);
+  mBoard.setModified();
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -23,6 +23,7 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+#include "../../../geometry/polygon.h"
 #include "bi_base.h"
 
 #include <QtCore>
@@ -33,7 +34,6 @@
 namespace librepcb {
 
 class Board;
-class Polygon;
 class Uuid;
 
 /*******************************************************************************
@@ -65,8 +65,14 @@ public:
   // Operator Overloadings
   BI_Polygon& operator=(const BI_Polygon& rhs) = delete;
 
-private:
+private:  // Methods
+  void polygonEdited(const Polygon& polygon, Polygon::Event event) noexcept;
+
+private:  // Data
   QScopedPointer<Polygon> mPolygon;
+
+  // Slots
+  Polygon::OnEditedSlot mOnEditedSlot;
 };
 
 /*******************************************************************************
@@ -51,7 +51,8 @@ BI_StrokeText::BI_StrokeText(Board& board, const StrokeText& text)
   mTextObj->onEdited.attach(mOnStrokeTextEditedSlot);
 
   // Connect to the "attributes changed" signal of the board.
-  connect(&mBoard, &Board::attributesChanged, this, &BI_StrokeText::updateText);
+  connect(&mBoard, &Board::attributesChanged, this,
+          &BI_StrokeText::attributesChanged);
 
   updateText();
 }
@@ -90,7 +91,7 @@ void BI_StrokeText::setDevice(BI_Device* device) noexcept {
 
   if (mDevice) {
     disconnect(mDevice, &BI_Device::attributesChanged, this,
-               &BI_StrokeText::updateText);
+               &BI_StrokeText::attributesChanged);
   }
 
   mDevice = device;
@@ -98,7 +99,7 @@ void BI_StrokeText::setDevice(BI_Device* device) noexcept {
   // Text might need to be updated if device attributes have changed.
   if (mDevice) {
     connect(mDevice, &BI_Device::attributesChanged, this,
-            &BI_StrokeText::updateText);
+            &BI_StrokeText::attributesChanged);
   }
 
   updateText();
@@ -133,6 +134,7 @@ void BI_StrokeText::removeFromBoard() {
 void BI_StrokeText::strokeTextEdited(const StrokeText& text,
                                      StrokeText::Event event) noexcept {
   Q_UNUSED(text);
+  mBoard.setModified();
   switch (event) {
     case StrokeText::Event::LayerChanged: {
       onEdited.notify(Event::LayerNameChanged);
@@ -177,9 +179,18 @@ void BI_StrokeText::strokeTextEdited(const StrokeText& text,
   }
 }
 
+void BI_StrokeText::attributesChanged() noexcept {
+  // Only substitute again if any of the referenced attributes has changed.
+  if (AttributeSubstitutor::dependenciesChanged(mTextDependencies,
+                                                getAttributeProvider())) {
+    updateText();
+  }
+}
+
 void BI_StrokeText::updateText() noexcept {
-  const QString text = AttributeSubstitutor::substitute(mTextObj->getText(),
-                                                        getAttributeProvider());
+  mTextDependencies.clear();
+  const QString text = AttributeSubstitutor::substitute(
+      mTextObj->getText(), getAttributeProvider(), nullptr, &mTextDependencies);
   if (text != mText) {
     mText = text;
     onEdited.notify(Event::TextChanged);
@@ -23,6 +23,7 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+#include "../../../attribute/attributesubstitutor.h"
 #include "../../../geometry/stroketext.h"
 #include "../../../utils/signalslot.h"
 #include "bi_base.h"
@@ -92,6 +93,7 @@ public:
 private:  // Methods
   void strokeTextEdited(const StrokeText& text,
                         StrokeText::Event event) noexcept;
+  void attributesChanged() noexcept;
   void updateText() noexcept;
   void updatePaths() noexcept;
 
@@ -102,6 +104,7 @@ private:  // Data
 
   // Cached Attributes
   QString mText;
+  AttributeSubstitutor::Dependencies mTextDependencies;
   QVector<Path> mPaths;
 
   // Slots
@@ -72,6 +72,7 @@ TraceAnchor BI_Via::toTraceAnchor() const noexcept {
 
 void BI_Via::setPosition(const Point& position) noexcept {
   if (mVia.setPosition(position)) {
+    mBoard.setModified();
     foreach (BI_NetLine* netLine, mRegisteredNetLines) {
       netLine->updatePositions();
     }
@@ -84,6 +85,7 @@ void BI_Via::setPosition(const Point& position) noexcept {
 
 void BI_Via::setSize(const PositiveLength& size) noexcept {
   if (mVia.setSize(size)) {
+    mBoard.setModified();
     onEdited.notify(Event::SizeChanged);
     updateStopMaskOffset();
   }
@@ -91,6 +93,7 @@ void BI_Via::setSize(const PositiveLength& size) noexcept {
 
 void BI_Via::setDrillDiameter(const PositiveLength& diameter) noexcept {
   if (mVia.setDrillDiameter(diameter)) {
+    mBoard.setModified();
     onEdited.notify(Event::DrillDiameterChanged);
     updateStopMaskOffset();
   }
@@ -44,7 +44,8 @@ namespace librepcb {
 Circuit::Circuit(Project& project)
   : QObject(&project),
     mProject(project),
-    mDirectory(new TransactionalDirectory(project.getDirectory(), "circuit")) {
+    mDirectory(new TransactionalDirectory(project.getDirectory(), "circuit")),
+    mIsModified(true) {
 }
 
 Circuit::~Circuit() noexcept {
@@ -87,7 +88,7 @@ NetClass* Circuit::getNetClassByName(const ElementName& name) const noexcept {
 }
 
 void Circuit::addNetClass(NetClass& netclass) {
-  if ((mNetClasses.values().contains(&netclass)) ||
+  if ((mNetClasses.value(netclass.getUuid()) == &netclass) ||
       (&netclass.getCircuit() != this)) {
     throw LogicError(__FILE__, __LINE__);
   }
@@ -104,6 +105,7 @@ void Circuit::addNetClass(NetClass& netclass) {
   }
   netclass.addToCircuit();  // can throw
   mNetClasses.insert(netclass.getUuid(), &netclass);
+  setModified();
   emit netClassAdded(netclass);
 }
 
@@ -113,6 +115,7 @@ void Circuit::removeNetClass(NetClass& netclass) {
   }
   netclass.removeFromCircuit();  // can throw
   mNetClasses.remove(netclass.getUuid());
+  setModified();
   emit netClassRemoved(netclass);
 }
 
@@ -166,7 +169,7 @@ NetSignal* Circuit::getNetSignalWithMostElements() const noexcept {
 }
 
 void Circuit::addNetSignal(NetSignal& netsignal) {
-  if ((mNetSignals.values().contains(&netsignal)) ||
+  if ((mNetSignals.value(netsignal.getUuid()) == &netsignal) ||
       (&netsignal.getCircuit() != this)) {
     throw LogicError(__FILE__, __LINE__);
   }
@@ -183,6 +186,7 @@ void Circuit::addNetSignal(NetSignal& netsignal) {
   }
   netsignal.addToCircuit();  // can throw
   mNetSignals.insert(netsignal.getUuid(), &netsignal);
+  setModified();
   emit netSignalAdded(netsignal);
 }
 
@@ -192,6 +196,7 @@ void Circuit::removeNetSignal(NetSignal& netsignal) {
   }
   netsignal.removeFromCircuit();  // can throw
   mNetSignals.remove(netsignal.getUuid());
+  setModified();
   emit netSignalRemoved(netsignal);
 }
 
@@ -260,6 +265,7 @@ void Circuit::addComponentInstance(ComponentInstance& cmp) {
   // add to circuit
   cmp.addToCircuit();  // can throw
   mComponentInstances.insert(cmp.getUuid(), &cmp);
+  setModified();
   emit componentAdded(cmp);
 }
 
@@ -271,6 +277,7 @@ void Circuit::removeComponentInstance(ComponentInstance& cmp) {
   // remove from circuit
   cmp.removeFromCircuit();  // can throw
   mComponentInstances.remove(cmp.getUuid());
+  setModified();
   emit componentRemoved(cmp);
 }
 
@@ -111,6 +111,27 @@ public:
   void setComponentInstanceName(ComponentInstance& cmp,
                                 const CircuitIdentifier& newName);
 
+  // Modification Tracking
+
+  /**
+   * @brief Check whether the circuit file needs to be serialized on saving
+   *
+   * @return  True if the circuit was modified since the last call to
+   *          #setModified() with `false` (i.e. since the last save).
+   */
+  bool isModified() const noexcept { return mIsModified; }
+
+  /**
+   * @brief Mark the content of the circuit file as modified (or saved)
+   *
+   * Must be called on every modification of data contained in the circuit
+   * file, i.e. by the circuit itself and by all its items.
+   *
+   * @param modified  Whether the circuit is modified. Pass `false` only
+   *                  after the circuit has been serialized.
+   */
+  void setModified(bool modified = true) noexcept { mIsModified = modified; }
+
   // General Methods
 
   /**
@@ -138,6 +159,7 @@ private:
   // General
   Project& mProject;  ///< A reference to the Project object (from the ctor)
   QScopedPointer<TransactionalDirectory> mDirectory;
+  bool mIsModified;  ///< See #isModified()
 
   QMap<Uuid, NetClass*> mNetClasses;
   QMap<Uuid, NetSignal*> mNetSignals;
@@ -119,6 +119,7 @@ bool ComponentInstance::isUsed() const noexcept {
 void ComponentInstance::setName(const CircuitIdentifier& name) noexcept {
   if (name != mName) {
     mName = name;
+    mCircuit.setModified();
     emit attributesChanged();
   }
 }
@@ -126,6 +127,7 @@ void ComponentInstance::setName(const CircuitIdentifier& name) noexcept {
 void ComponentInstance::setValue(const QString& value) noexcept {
   if (value != mValue) {
     mValue = value;
+    mCircuit.setModified();
     emit attributesChanged();
   }
 }
@@ -134,6 +136,7 @@ void ComponentInstance::setAttributes(
     const AttributeList& attributes) noexcept {
   if (attributes != *mAttributes) {
     *mAttributes = attributes;
+    mCircuit.setModified();
     emit attributesChanged();
   }
 }
@@ -142,6 +145,7 @@ void ComponentInstance::setDefaultDeviceUuid(
     const tl::optional<Uuid>& device) noexcept {
   if (device != mDefaultDeviceUuid) {
     mDefaultDeviceUuid = device;
+    mCircuit.setModified();
     emit attributesChanged();
   }
 }
@@ -125,6 +125,7 @@ void ComponentSignalInstance::setNetSignal(NetSignal* netsignal) {
   NetSignal* old = mNetSignal;
   mNetSignal = netsignal;
   sgl.dismiss();
+  mCircuit.setModified();
   emit netSignalChanged(old, mNetSignal);
 }
 
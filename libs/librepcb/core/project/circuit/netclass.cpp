@@ -59,6 +59,7 @@ void NetClass::setName(const ElementName& name) noexcept {
     return;
   }
   mName = name;
+  mCircuit.setModified();
 }
 
 /*******************************************************************************
@@ -96,6 +96,7 @@ void NetSignal::setName(const CircuitIdentifier& name,
   }
   mName = name;
   mHasAutoName = isAutoName;
+  mCircuit.setModified();
   emit nameChanged(mName);
 }
 
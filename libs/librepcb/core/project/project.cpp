@@ -424,11 +424,14 @@ void Project::save() {
     mDirectory->write("project/settings.lp", root.toByteArray());
   }
 
-  // Circuit.
-  {
+  // Circuit, only if modified since the last save. Boards and schematics
+  // track their modifications the same way, see Board::save() and
+  // Schematic::save().
+  if (mCircuit->isModified()) {
     SExpression root = SExpression::createList("librepcb_circuit");
     mCircuit->serialize(root);
     mDirectory->write("circuit/circuit.lp", root.toByteArray());
+    mCircuit->setModified(false);
   }
 
   // ERC.
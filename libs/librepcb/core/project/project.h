@@ -447,6 +447,12 @@ public:
   /**
    * @brief Save the project to the transactional file system
    *
+   * The circuit, the schematics and the boards are only serialized if they
+   * were modified since the last call to this method, so saving again after
+   * a small modification only serializes the affected files. The first call
+   * after loading the project serializes all files (e.g. to upgrade the file
+   * format).
+   *
    * @throw Exception     If an error occurred.
    */
   void save();
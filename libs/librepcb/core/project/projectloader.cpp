@@ -440,29 +440,32 @@ void ProjectLoader::loadSchematicNetSegment(Schematic& s,
       new SI_NetSegment(s, deserialize<Uuid>(node.getChild("@0")), *netSignal);
   s.addNetSegment(*netSegment);
 
-  // Load net points.
+  // Load net points. They are also indexed by UUID since looking them up
+  // linearly for each net line would be quadratic for large net segments.
+  const QList<const SExpression*> netPointNodes = node.getChildren("junction");
   QList<SI_NetPoint*> netPoints;
-  foreach (const SExpression* child, node.getChildren("junction")) {
+  QHash<Uuid, SI_NetPoint*> netPointsByUuid;
+  netPoints.reserve(netPointNodes.count());
+  netPointsByUuid.reserve(netPointNodes.count());
+  foreach (const SExpression* child, netPointNodes) {
     SI_NetPoint* netpoint =
         new SI_NetPoint(*netSegment, deserialize<Uuid>(child->getChild("@0")),
                         Point(child->getChild("position")));
     netPoints.append(netpoint);
+    netPointsByUuid.insert(netpoint->getUuid(), netpoint);
   }
 
   // Load net lines.
+  const QList<const SExpression*> netLineNodes = node.getChildren("line");
   QList<SI_NetLine*> netLines;
-  foreach (const SExpression* child, node.getChildren("line")) {
-    auto parseAnchor = [&s, &netPoints](const SExpression& aNode) {
+  netLines.reserve(netLineNodes.count());
+  foreach (const SExpression* child, netLineNodes) {
+    auto parseAnchor = [&s, &netPointsByUuid](const SExpression& aNode) {
       SI_NetLineAnchor* anchor = nullptr;
       if (const SExpression* junctionNode = aNode.tryGetChild("junction")) {
         const Uuid netPointUuid =
             deserialize<Uuid>(junctionNode->getChild("@0"));
-        foreach (SI_NetPoint* netPoint, netPoints) {
-          if (netPoint->getUuid() == netPointUuid) {
-            anchor = netPoint;
-            break;
-          }
-        }
+        anchor = netPointsByUuid.value(netPointUuid, nullptr);
         if (!anchor) {
           throw RuntimeError(
               __FILE__, __LINE__,
@@ -544,8 +547,8 @@ void ProjectLoader::loadBoard(Project& p, const QString& relativeFilePath) {
     board->setDrcSettings(BoardDesignRuleCheckSettings(node));
     board->loadDrcMessageApprovals(approvalsVersion, approvals);
   }
-  board->getFabricationOutputSettings() = BoardFabricationOutputSettings(
-      root.getChild("fabrication_output_settings"));
+  board->setFabricationOutputSettings(BoardFabricationOutputSettings(
+      root.getChild("fabrication_output_settings")));
   p.addBoard(*board);
 
   foreach (const SExpression* node, root.getChildren("device")) {
@@ -615,36 +618,45 @@ void ProjectLoader::loadBoardNetSegment(Board& b, const SExpression& node) {
       new BI_NetSegment(b, deserialize<Uuid>(node.getChild("@0")), netSignal);
   b.addNetSegment(*netSegment);
 
-  // Load vias.
+  // Load vias. They are also indexed by UUID since looking them up linearly
+  // for each net line would be quadratic for large net segments.
+  const QList<const SExpression*> viaNodes = node.getChildren("via");
   QList<BI_Via*> vias;
-  foreach (const SExpression* child, node.getChildren("via")) {
+  QHash<Uuid, BI_Via*> viasByUuid;
+  vias.reserve(viaNodes.count());
+  viasByUuid.reserve(viaNodes.count());
+  foreach (const SExpression* child, viaNodes) {
     BI_Via* via = new BI_Via(*netSegment, Via(*child));
     vias.append(via);
+    viasByUuid.insert(via->getUuid(), via);
   }
 
   // Load net points.
+  const QList<const SExpression*> netPointNodes = node.getChildren("junction");
   QList<BI_NetPoint*> netPoints;
-  foreach (const SExpression* child, node.getChildren("junction")) {
+  QHash<Uuid, BI_NetPoint*> netPointsByUuid;
+  netPoints.reserve(netPointNodes.count());
+  netPointsByUuid.reserve(netPointNodes.count());
+  foreach (const SExpression* child, netPointNodes) {
     BI_NetPoint* netPoint =
         new BI_NetPoint(*netSegment, deserialize<Uuid>(child->getChild("@0")),
                         Point(child->getChild("position")));
     netPoints.append(netPoint);
+    netPointsByUuid.insert(netPoint->getUuid(), netPoint);
   }
 
   // Load net lines.
+  const QList<const SExpression*> netLineNodes = node.getChildren("trace");
   QList<BI_NetLine*> netLines;
-  foreach (const SExpression* child, node.getChildren("trace")) {
-    auto parseAnchor = [&b, &vias, &netPoints](const SExpression& aNode) {
+  netLines.reserve(netLineNodes.count());
+  foreach (const SExpression* child, netLineNodes) {
+    auto parseAnchor = [&b, &viasByUuid,
+                        &netPointsByUuid](const SExpression& aNode) {
       BI_NetLineAnchor* anchor = nullptr;
       if (const SExpression* junctionNode = aNode.tryGetChild("junction")) {
         const Uuid netPointUuid =
             deserialize<Uuid>(junctionNode->getChild("@0"));
-        foreach (BI_NetPoint* netPoint, netPoints) {
-          if (netPoint->getUuid() == netPointUuid) {
-            anchor = netPoint;
-            break;
-          }
-        }
+        anchor = netPointsByUuid.value(netPointUuid, nullptr);
         if (!anchor) {
           throw RuntimeError(
               __FILE__, __LINE__,
@@ -653,12 +665,7 @@ void ProjectLoader::loadBoardNetSegment(Board& b, const SExpression& node) {
         }
       } else if (const SExpression* viaNode = aNode.tryGetChild("via")) {
         const Uuid viaUuid = deserialize<Uuid>(viaNode->getChild("@0"));
-        foreach (BI_Via* via, vias) {
-          if (via->getUuid() == viaUuid) {
-            anchor = via;
-            break;
-          }
-        }
+        anchor = viasByUuid.value(viaUuid, nullptr);
         if (!anchor) {
           throw RuntimeError(__FILE__, __LINE__,
                              QString("Via '%1' does not exist in board.")
@@ -0,0 +1,351 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "projectsearchindex.h"
+
+#include "../library/dev/device.h"
+#include "../library/pkg/package.h"
+#include "board/board.h"
+#include "board/items/bi_device.h"
+#include "circuit/circuit.h"
+#include "circuit/componentinstance.h"
+#include "circuit/netsignal.h"
+#include "project.h"
+#include "schematic/items/si_netlabel.h"
+#include "schematic/items/si_netsegment.h"
+#include "schematic/schematic.h"
+
+#include <QtCore>
+
+#include <algorithm>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+ProjectSearchIndex::ProjectSearchIndex(Project& project) noexcept
+  : QObject(nullptr), mProject(project) {
+  Circuit& circuit = mProject.getCircuit();
+  foreach (ComponentInstance* component, circuit.getComponentInstances()) {
+    addComponent(*component);
+  }
+  foreach (NetSignal* netSignal, circuit.getNetSignals()) {
+    addNetSignal(*netSignal);
+  }
+  for (int i = 0; i < mProject.getSchematics().count(); ++i) {
+    addSchematic(i);
+  }
+  for (int i = 0; i < mProject.getBoards().count(); ++i) {
+    addBoard(i);
+  }
+  connect(&circuit, &Circuit::componentAdded, this,
+          &ProjectSearchIndex::addComponent);
+  connect(&circuit, &Circuit::componentRemoved, this,
+          &ProjectSearchIndex::removeComponent);
+  connect(&circuit, &Circuit::netSignalAdded, this,
+          &ProjectSearchIndex::addNetSignal);
+  connect(&circuit, &Circuit::netSignalRemoved, this,
+          &ProjectSearchIndex::removeNetSignal);
+  connect(&mProject, &Project::schematicAdded, this,
+          &ProjectSearchIndex::addSchematic);
+  connect(&mProject, &Project::schematicRemoved, this,
+          &ProjectSearchIndex::removeSchematic);
+  connect(&mProject, &Project::boardAdded, this,
+          &ProjectSearchIndex::addBoard);
+  connect(&mProject, &Project::boardRemoved, this,
+          &ProjectSearchIndex::removeBoard);
+}
+
+ProjectSearchIndex::~ProjectSearchIndex() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+QList<ProjectSearchIndex::Entry> ProjectSearchIndex::find(
+    const QString& term, Types types, bool substring) const noexcept {
+  const QString key = term.toLower();
+  QList<Entry> result;
+  if (substring) {
+    for (auto it = mEntries.begin(); it != mEntries.end(); ++it) {
+      if (it.key().contains(key) && types.testFlag(it->type)) {
+        result.append(it.value());
+      }
+    }
+  } else {
+    for (auto it = mEntries.lowerBound(key);
+         (it != mEntries.end()) && it.key().startsWith(key); ++it) {
+      if (types.testFlag(it->type)) {
+        result.append(it.value());
+      }
+    }
+  }
+  std::sort(result.begin(), result.end(), &ProjectSearchIndex::lessThan);
+  return result;
+}
+
+QStringList ProjectSearchIndex::getTexts(Types types) const noexcept {
+  const int mask = static_cast<int>(types);
+  auto it = mTextsCache.find(mask);
+  if (it == mTextsCache.end()) {
+    QList<Entry> entries;
+    foreach (const Entry& entry, mEntries) {
+      if (types.testFlag(entry.type)) {
+        entries.append(entry);
+      }
+    }
+    std::sort(entries.begin(), entries.end(), &ProjectSearchIndex::lessThan);
+    QStringList texts;
+    foreach (const Entry& entry, entries) {
+      if (texts.isEmpty() || (texts.last() != entry.text)) {
+        texts.append(entry.text);
+      }
+    }
+    it = mTextsCache.insert(mask, texts);
+  }
+  return *it;
+}
+
+QString ProjectSearchIndex::calcSortKey(const QString& text) noexcept {
+  const QString lower = text.toLower();
+  QString key;
+  key.reserve(lower.length() + 8);
+  int i = 0;
+  while (i < lower.length()) {
+    if (lower.at(i).isDigit()) {
+      // Skip leading zeros, then prefix the number with its length.
+      int start = i;
+      while ((start < lower.length() - 1) && (lower.at(start) == '0') &&
+             lower.at(start + 1).isDigit()) {
+        ++start;
+      }
+      int end = start;
+      while ((end < lower.length()) && lower.at(end).isDigit()) {
+        ++end;
+      }
+      // Clamp the length to keep the prefix at two digits (see docs).
+      const int length = std::min(end - start, 99);
+      key += QString::number(length).rightJustified(2, '0');
+      key += lower.midRef(start, end - start);
+      i = end;
+    } else {
+      key += lower.at(i);
+      ++i;
+    }
+  }
+  return key;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void ProjectSearchIndex::addComponent(ComponentInstance& component) noexcept {
+  addEntry(Entry{Type::ComponentName, *component.getName(), QString(),
+                 &component, nullptr, nullptr, nullptr});
+  const QString value = component.getValue(true).trimmed();
+  if (!value.isEmpty()) {
+    addEntry(Entry{Type::ComponentValue, value, QString(), &component, nullptr,
+                   nullptr, nullptr});
+  }
+  connect(&component, &ComponentInstance::attributesChanged, this,
+          [this, &component]() { updateComponent(component); });
+}
+
+void ProjectSearchIndex::removeComponent(
+    ComponentInstance& component) noexcept {
+  disconnect(&component, nullptr, this, nullptr);
+  removeEntries(&component);
+}
+
+void ProjectSearchIndex::updateComponent(
+    ComponentInstance& component) noexcept {
+  removeComponent(component);
+  addComponent(component);
+}
+
+void ProjectSearchIndex::addNetSignal(NetSignal& netSignal) noexcept {
+  addEntry(Entry{Type::NetSignalName, *netSignal.getName(), QString(), nullptr,
+                 &netSignal, nullptr, nullptr});
+  connect(&netSignal, &NetSignal::nameChanged, this,
+          [this, &netSignal]() { updateNetSignal(netSignal); });
+}
+
+void ProjectSearchIndex::removeNetSignal(NetSignal& netSignal) noexcept {
+  disconnect(&netSignal, nullptr, this, nullptr);
+  removeEntries(&netSignal);
+}
+
+void ProjectSearchIndex::updateNetSignal(NetSignal& netSignal) noexcept {
+  removeNetSignal(netSignal);
+  addNetSignal(netSignal);
+
+  // Net labels show the name of their net signal.
+  foreach (SI_NetSegment* netSegment, netSignal.getSchematicNetSegments()) {
+    foreach (SI_NetLabel* netLabel, netSegment->getNetLabels()) {
+      if (mKeys.contains(netLabel)) {
+        removeEntries(netLabel);
+        addNetLabel(*netLabel);
+      }
+    }
+  }
+}
+
+void ProjectSearchIndex::addSchematic(int index) noexcept {
+  Schematic* schematic = mProject.getSchematicByIndex(index);
+  Q_ASSERT(schematic);
+  mSchematics.insert(index, schematic);
+  foreach (SI_NetSegment* netSegment, schematic->getNetSegments()) {
+    addNetSegment(*netSegment);
+  }
+  connect(schematic, &Schematic::netSegmentAdded, this,
+          &ProjectSearchIndex::addNetSegment);
+  connect(schematic, &Schematic::netSegmentRemoved, this,
+          &ProjectSearchIndex::removeNetSegment);
+}
+
+void ProjectSearchIndex::removeSchematic(int index) noexcept {
+  // The schematic may be deleted right after this, but is still valid now.
+  Schematic* schematic = mSchematics.takeAt(index);
+  disconnect(schematic, nullptr, this, nullptr);
+  foreach (SI_NetSegment* netSegment, schematic->getNetSegments()) {
+    removeNetSegment(*netSegment);
+  }
+}
+
+void ProjectSearchIndex::addNetSegment(SI_NetSegment& netSegment) noexcept {
+  foreach (SI_NetLabel* netLabel, netSegment.getNetLabels()) {
+    addNetLabel(*netLabel);
+  }
+  connect(&netSegment, &SI_NetSegment::netLabelAdded, this,
+          &ProjectSearchIndex::addNetLabel);
+  connect(&netSegment, &SI_NetSegment::netLabelRemoved, this,
+          &ProjectSearchIndex::removeNetLabel);
+}
+
+void ProjectSearchIndex::removeNetSegment(SI_NetSegment& netSegment) noexcept {
+  disconnect(&netSegment, nullptr, this, nullptr);
+  foreach (SI_NetLabel* netLabel, netSegment.getNetLabels()) {
+    removeNetLabel(*netLabel);
+  }
+}
+
+void ProjectSearchIndex::addNetLabel(SI_NetLabel& netLabel) noexcept {
+  addEntry(Entry{Type::NetLabelName,
+                 *netLabel.getNetSignalOfNetSegment().getName(), QString(),
+                 nullptr, nullptr, &netLabel, nullptr});
+}
+
+void ProjectSearchIndex::removeNetLabel(SI_NetLabel& netLabel) noexcept {
+  removeEntries(&netLabel);
+}
+
+void ProjectSearchIndex::addBoard(int index) noexcept {
+  Board* board = mProject.getBoardByIndex(index);
+  Q_ASSERT(board);
+  mBoards.insert(index, board);
+  foreach (BI_Device* device, board->getDeviceInstances()) {
+    addDevice(*device);
+  }
+  connect(board, &Board::deviceAdded, this, &ProjectSearchIndex::addDevice);
+  connect(board, &Board::deviceRemoved, this,
+          &ProjectSearchIndex::removeDevice);
+}
+
+void ProjectSearchIndex::removeBoard(int index) noexcept {
+  // The board may be deleted right after this, but is still valid now.
+  Board* board = mBoards.takeAt(index);
+  disconnect(board, nullptr, this, nullptr);
+  foreach (BI_Device* device, board->getDeviceInstances()) {
+    removeDevice(*device);
+  }
+}
+
+void ProjectSearchIndex::addDevice(BI_Device& device) noexcept {
+  // The library elements of a device never change, so no need to update.
+  addEntry(Entry{Type::DeviceName,
+                 *device.getLibDevice().getNames().getDefaultValue(),
+                 QString(), nullptr, nullptr, nullptr, &device});
+  addEntry(Entry{Type::PackageName,
+                 *device.getLibPackage().getNames().getDefaultValue(),
+                 QString(), nullptr, nullptr, nullptr, &device});
+}
+
+void ProjectSearchIndex::removeDevice(BI_Device& device) noexcept {
+  removeEntries(&device);
+}
+
+void ProjectSearchIndex::addEntry(const Entry& entry) noexcept {
+  const QString key = entry.text.toLower();
+  auto it = mEntries.insert(key, entry);
+  it->sortKey = calcSortKey(entry.text);
+  mKeys[getObject(entry)].append(key);
+  mTextsCache.clear();
+}
+
+void ProjectSearchIndex::removeEntries(const QObject* obj) noexcept {
+  foreach (const QString& key, mKeys.take(obj)) {
+    auto it = mEntries.find(key);
+    while ((it != mEntries.end()) && (it.key() == key)) {
+      if (getObject(it.value()) == obj) {
+        it = mEntries.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  mTextsCache.clear();
+}
+
+const QObject* ProjectSearchIndex::getObject(const Entry& entry) noexcept {
+  if (entry.component) {
+    return entry.component;
+  } else if (entry.netSignal) {
+    return entry.netSignal;
+  } else if (entry.netLabel) {
+    return entry.netLabel;
+  } else {
+    return entry.device;
+  }
+}
+
+bool ProjectSearchIndex::lessThan(const Entry& a, const Entry& b) noexcept {
+  if (a.sortKey != b.sortKey) {
+    return a.sortKey < b.sortKey;
+  } else if (a.text != b.text) {
+    return a.text < b.text;
+  } else {
+    return a.type < b.type;
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
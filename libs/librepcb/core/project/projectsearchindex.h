@@ -0,0 +1,185 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_PROJECTSEARCHINDEX_H
+#define LIBREPCB_CORE_PROJECTSEARCHINDEX_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class BI_Device;
+class Board;
+class ComponentInstance;
+class NetSignal;
+class Project;
+class SI_NetLabel;
+class SI_NetSegment;
+class Schematic;
+
+/*******************************************************************************
+ *  Class ProjectSearchIndex
+ ******************************************************************************/
+
+/**
+ * @brief Index of the names of searchable objects in a project
+ *
+ * Contains the names and values of all component instances and the names of
+ * all net signals of the circuit, the net labels of all schematics and the
+ * library device and package names of all devices in all boards. The index
+ * is updated automatically when these objects are added, removed or
+ * modified, so looking up objects for the "go to" search of the editors is
+ * fast even in huge projects.
+ *
+ * Results are returned in natural sort order (e.g. "R2" before "R10"), using
+ * sort keys which are calculated only once when an object is indexed.
+ */
+class ProjectSearchIndex final : public QObject {
+  Q_OBJECT
+
+public:
+  // Types
+  enum Type {
+    ComponentName = (1 << 0),
+    ComponentValue = (1 << 1),
+    NetSignalName = (1 << 2),
+    NetLabelName = (1 << 3),
+    DeviceName = (1 << 4),
+    PackageName = (1 << 5),
+  };
+  Q_DECLARE_FLAGS(Types, Type)
+  struct Entry {
+    Type type;
+    QString text;
+    QString sortKey;
+    ComponentInstance* component;  ///< Only set for component names/values
+    NetSignal* netSignal;  ///< Only set for net signal names
+    SI_NetLabel* netLabel;  ///< Only set for net label names
+    BI_Device* device;  ///< Only set for device and package names
+  };
+
+  // Constructors / Destructor
+  ProjectSearchIndex() = delete;
+  ProjectSearchIndex(const ProjectSearchIndex& other) = delete;
+  explicit ProjectSearchIndex(Project& project) noexcept;
+  ~ProjectSearchIndex() noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Find entries by text (case insensitive)
+   *
+   * @param term        The text to search for.
+   * @param types       The types of entries to search for.
+   * @param substring   If true, entries containing the term anywhere match.
+   *                    If false, only entries starting with the term match.
+   *
+   * @return All matching entries in natural sort order.
+   */
+  QList<Entry> find(const QString& term, Types types,
+                    bool substring = false) const noexcept;
+
+  /**
+   * @brief Get all indexed texts of the given types, e.g. for auto completion
+   *
+   * @param types   The types of entries to return.
+   *
+   * @return All texts (without duplicates) in natural sort order.
+   */
+  QStringList getTexts(Types types) const noexcept;
+
+  /**
+   * @brief Calculate the key used for natural sorting of a text
+   *
+   * Comparing two keys with the usual string comparison gives the natural,
+   * case insensitive order of the corresponding texts. This is achieved by
+   * prefixing each sequence of digits with its length (two digits, without
+   * leading zeros of the number).
+   *
+   * @note The length prefix is clamped to 99, so numbers with more than 99
+   *       significant digits are sorted as if they had 99 digits, i.e.
+   *       lexicographically among each other, but still after all shorter
+   *       numbers.
+   *
+   * @param text    The text to calculate the key of.
+   *
+   * @return The sort key.
+   */
+  static QString calcSortKey(const QString& text) noexcept;
+
+  // Operator Overloadings
+  ProjectSearchIndex& operator=(const ProjectSearchIndex& rhs) = delete;
+
+private:  // Methods
+  void addComponent(ComponentInstance& component) noexcept;
+  void removeComponent(ComponentInstance& component) noexcept;
+  void updateComponent(ComponentInstance& component) noexcept;
+  void addNetSignal(NetSignal& netSignal) noexcept;
+  void removeNetSignal(NetSignal& netSignal) noexcept;
+  void updateNetSignal(NetSignal& netSignal) noexcept;
+  void addSchematic(int index) noexcept;
+  void removeSchematic(int index) noexcept;
+  void addNetSegment(SI_NetSegment& netSegment) noexcept;
+  void removeNetSegment(SI_NetSegment& netSegment) noexcept;
+  void addNetLabel(SI_NetLabel& netLabel) noexcept;
+  void removeNetLabel(SI_NetLabel& netLabel) noexcept;
+  void addBoard(int index) noexcept;
+  void removeBoard(int index) noexcept;
+  void addDevice(BI_Device& device) noexcept;
+  void removeDevice(BI_Device& device) noexcept;
+  void addEntry(const Entry& entry) noexcept;
+  void removeEntries(const QObject* obj) noexcept;
+  static const QObject* getObject(const Entry& entry) noexcept;
+  static bool lessThan(const Entry& a, const Entry& b) noexcept;
+
+private:  // Data
+  Project& mProject;
+
+  /// Indexed schematics, in the same order as in the project (to know which
+  /// one was removed when Project::schematicRemoved() is emitted)
+  QList<Schematic*> mSchematics;
+
+  /// Indexed boards, in the same order as in the project
+  QList<Board*> mBoards;
+
+  /// All entries, with the lowercase text as key (for prefix lookup)
+  QMultiMap<QString, Entry> mEntries;
+
+  /// The keys in #mEntries of each indexed object (for fast removal)
+  QHash<const QObject*, QStringList> mKeys;
+
+  /// Cache for #getTexts(), cleared whenever the index is modified
+  mutable QHash<int, QStringList> mTextsCache;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(librepcb::ProjectSearchIndex::Types)
+
+#endif
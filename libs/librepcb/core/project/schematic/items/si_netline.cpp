@@ -89,7 +89,9 @@ NetSignal& SI_NetLine::getNetSignalOfNetSegment() const noexcept {
  ******************************************************************************/
 
 void SI_NetLine::setWidth(const UnsignedLength& width) noexcept {
-  mNetLine.setWidth(width);
+  if (mNetLine.setWidth(width)) {
+    mSchematic.setModified();
+  }
 }
 
 /*******************************************************************************
@@ -149,6 +149,7 @@ void SI_NetSegment::setNetSignal(NetSignal& netsignal) {
       sg.dismiss();
     }
     mNetSignal = &netsignal;
+    mSchematic.setModified();
   }
 }
 
@@ -164,7 +165,7 @@ void SI_NetSegment::addNetPointsAndNetLines(
 
   ScopeGuardList sgl(netpoints.count() + netlines.count());
   foreach (SI_NetPoint* netpoint, netpoints) {
-    if ((mNetPoints.values().contains(netpoint)) ||
+    if ((mNetPoints.value(netpoint->getUuid()) == netpoint) ||
         (&netpoint->getNetSegment() != this)) {
       throw LogicError(__FILE__, __LINE__);
     }
@@ -182,7 +183,7 @@ void SI_NetSegment::addNetPointsAndNetLines(
     });
   }
   foreach (SI_NetLine* netline, netlines) {
-    if ((mNetLines.values().contains(netline)) ||
+    if ((mNetLines.value(netline->getUuid()) == netline) ||
         (&netline->getNetSegment() != this)) {
       throw LogicError(__FILE__, __LINE__);
     }
@@ -210,6 +211,7 @@ void SI_NetSegment::addNetPointsAndNetLines(
   updateAllNetLabelAnchors();
 
   sgl.dismiss();
+  mSchematic.setModified();
 
   emit netPointsAndNetLinesAdded(netpoints, netlines);
 }
@@ -254,6 +256,7 @@ void SI_NetSegment::removeNetPointsAndNetLines(
   updateAllNetLabelAnchors();
 
   sgl.dismiss();
+  mSchematic.setModified();
 
   emit netPointsAndNetLinesRemoved(netpoints, netlines);
 }
@@ -263,7 +266,8 @@ void SI_NetSegment::removeNetPointsAndNetLines(
  ******************************************************************************/
 
 void SI_NetSegment::addNetLabel(SI_NetLabel& netlabel) {
-  if ((!isAddedToSchematic()) || (mNetLabels.values().contains(&netlabel)) ||
+  if ((!isAddedToSchematic()) ||
+      (mNetLabels.value(netlabel.getUuid()) == &netlabel) ||
       (&netlabel.getNetSegment() != this)) {
     throw LogicError(__FILE__, __LINE__);
   }
@@ -275,6 +279,7 @@ void SI_NetSegment::addNetLabel(SI_NetLabel& netlabel) {
   }
   netlabel.addToSchematic();  // can throw
   mNetLabels.insert(netlabel.getUuid(), &netlabel);
+  mSchematic.setModified();
   emit netLabelAdded(netlabel);
 }
 
@@ -285,6 +290,7 @@ void SI_NetSegment::removeNetLabel(SI_NetLabel& netlabel) {
   }
   netlabel.removeFromSchematic();  // can throw
   mNetLabels.remove(netlabel.getUuid());
+  mSchematic.setModified();
   emit netLabelRemoved(netlabel);
 }
 
@@ -398,30 +404,30 @@ bool SI_NetSegment::areAllNetPointsConnectedTogether() const noexcept {
 void SI_NetSegment::findAllConnectedNetPoints(
     const SI_NetLineAnchor& p, QSet<const SI_SymbolPin*>& pins,
     QSet<const SI_NetPoint*>& points) const noexcept {
-  if (const SI_SymbolPin* pin = dynamic_cast<const SI_SymbolPin*>(&p)) {
-    if (pins.contains(pin)) return;
-    pins.insert(pin);
-    foreach (const SI_NetLine* netline, mNetLines) {
-      if (&netline->getStartPoint() == pin) {
-        findAllConnectedNetPoints(netline->getEndPoint(), pins, points);
-      }
-      if (&netline->getEndPoint() == pin) {
-        findAllConnectedNetPoints(netline->getStartPoint(), pins, points);
-      }
-    }
-  } else if (const SI_NetPoint* np = dynamic_cast<const SI_NetPoint*>(&p)) {
-    if (points.contains(np)) return;
-    points.insert(np);
-    foreach (const SI_NetLine* netline, mNetLines) {
-      if (&netline->getStartPoint() == np) {
-        findAllConnectedNetPoints(netline->getEndPoint(), pins, points);
-      }
-      if (&netline->getEndPoint() == np) {
-        findAllConnectedNetPoints(netline->getStartPoint(), pins, points);
-      }
+  // Determine the neighbors of all anchors once, since scanning all net lines
+  // for each visited anchor would be quadratic for large net segments.
+  QHash<const SI_NetLineAnchor*, QVector<const SI_NetLineAnchor*>> neighbors;
+  neighbors.reserve(mNetLines.count() * 2);
+  foreach (const SI_NetLine* netline, mNetLines) {
+    neighbors[&netline->getStartPoint()].append(&netline->getEndPoint());
+    neighbors[&netline->getEndPoint()].append(&netline->getStartPoint());
+  }
+
+  QVector<const SI_NetLineAnchor*> stack = {&p};
+  while (!stack.isEmpty()) {
+    const SI_NetLineAnchor* anchor = stack.takeLast();
+    if (const SI_SymbolPin* pin = dynamic_cast<const SI_SymbolPin*>(anchor)) {
+      if (pins.contains(pin)) continue;
+      pins.insert(pin);
+    } else if (const SI_NetPoint* np =
+                   dynamic_cast<const SI_NetPoint*>(anchor)) {
+      if (points.contains(np)) continue;
+      points.insert(np);
+    } else {
+      Q_ASSERT(false);
+      continue;
     }
-  } else {
-    Q_ASSERT(false);
+    stack += neighbors.value(anchor);
   }
 }
 
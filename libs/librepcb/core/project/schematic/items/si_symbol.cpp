@@ -129,6 +129,7 @@ QString SI_Symbol::getName() const noexcept {
 void SI_Symbol::setPosition(const Point& newPos) noexcept {
   if (newPos != mPosition) {
     mPosition = newPos;
+    mSchematic.setModified();
     onEdited.notify(Event::PositionChanged);
   }
 }
@@ -136,6 +137,7 @@ void SI_Symbol::setPosition(const Point& newPos) noexcept {
 void SI_Symbol::setRotation(const Angle& newRotation) noexcept {
   if (newRotation != mRotation) {
     mRotation = newRotation;
+    mSchematic.setModified();
     onEdited.notify(Event::RotationChanged);
   }
 }
@@ -143,6 +145,7 @@ void SI_Symbol::setRotation(const Angle& newRotation) noexcept {
 void SI_Symbol::setMirrored(bool newMirrored) noexcept {
   if (newMirrored != mMirrored) {
     mMirrored = newMirrored;
+    mSchematic.setModified();
     onEdited.notify(Event::MirroredChanged);
   }
 }
@@ -170,7 +173,7 @@ TextList SI_Symbol::getDefaultTexts() const noexcept {
 }
 
 void SI_Symbol::addText(SI_Text& text) {
-  if ((mTexts.values().contains(&text)) ||
+  if ((mTexts.value(text.getUuid()) == &text) ||
       (&text.getSchematic() != &mSchematic)) {
     throw LogicError(__FILE__, __LINE__);
   }
@@ -184,6 +187,7 @@ void SI_Symbol::addText(SI_Text& text) {
     text.addToSchematic();  // can throw
   }
   mTexts.insert(text.getUuid(), &text);
+  mSchematic.setModified();
   emit textAdded(text);
 }
 
@@ -195,6 +199,7 @@ void SI_Symbol::removeText(SI_Text& text) {
     text.removeFromSchematic();  // can throw
   }
   mTexts.remove(text.getUuid());
+  mSchematic.setModified();
   emit textRemoved(text);
 }
 
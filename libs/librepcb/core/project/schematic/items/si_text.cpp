@@ -49,7 +49,7 @@ SI_Text::SI_Text(Schematic& schematic, const Text& text)
 
   // Connect to the "attributes changed" signal of the schematic.
   connect(&mSchematic, &Schematic::attributesChanged, this,
-          &SI_Text::updateText);
+          &SI_Text::attributesChanged);
 
   updateText();
 }
@@ -68,14 +68,15 @@ void SI_Text::setSymbol(SI_Symbol* symbol) noexcept {
 
   if (mSymbol) {
     disconnect(mSymbol, &SI_Symbol::attributesChanged, this,
-               &SI_Text::updateText);
+               &SI_Text::attributesChanged);
   }
 
   mSymbol = symbol;
 
   // Text might need to be updated if symbol attributes have changed.
   if (mSymbol) {
-    connect(mSymbol, &SI_Symbol::attributesChanged, this, &SI_Text::updateText);
+    connect(mSymbol, &SI_Symbol::attributesChanged, this,
+            &SI_Text::attributesChanged);
   }
 
   updateText();
@@ -109,6 +110,7 @@ void SI_Text::removeFromSchematic() {
 
 void SI_Text::textEdited(const Text& text, Text::Event event) noexcept {
   Q_UNUSED(text);
+  mSchematic.setModified();
   switch (event) {
     case Text::Event::PositionChanged: {
       onEdited.notify(Event::PositionChanged);
@@ -127,9 +129,18 @@ void SI_Text::textEdited(const Text& text, Text::Event event) noexcept {
   }
 }
 
+void SI_Text::attributesChanged() noexcept {
+  // Only substitute again if any of the referenced attributes has changed.
+  if (AttributeSubstitutor::dependenciesChanged(mTextDependencies,
+                                                getAttributeProvider())) {
+    updateText();
+  }
+}
+
 void SI_Text::updateText() noexcept {
-  const QString text = AttributeSubstitutor::substitute(mTextObj.getText(),
-                                                        getAttributeProvider());
+  mTextDependencies.clear();
+  const QString text = AttributeSubstitutor::substitute(
+      mTextObj.getText(), getAttributeProvider(), nullptr, &mTextDependencies);
   if (text != mText) {
     mText = text;
     onEdited.notify(Event::TextChanged);
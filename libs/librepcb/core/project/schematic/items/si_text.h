@@ -23,6 +23,7 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+#include "../../../attribute/attributesubstitutor.h"
 #include "../../../geometry/text.h"
 #include "../../../utils/signalslot.h"
 #include "si_base.h"
@@ -85,6 +86,7 @@ public:
 
 private:  // Methods
   void textEdited(const Text& text, Text::Event event) noexcept;
+  void attributesChanged() noexcept;
   void updateText() noexcept;
 
 private:  // Attributes
@@ -93,6 +95,7 @@ private:  // Attributes
 
   // Cached Attributes
   QString mText;
+  AttributeSubstitutor::Dependencies mTextDependencies;
 
   // Slots
   Text::OnEditedSlot mOnTextEditedSlot;
@@ -59,6 +59,7 @@ Schematic::Schematic(Project& project,
     mDirectoryName(directoryName),
     mDirectory(std::move(directory)),
     mIsAddedToProject(false),
+    mIsModified(true),
     mUuid(uuid),
     mName(name),
     mGridInterval(2540000),
@@ -101,15 +102,26 @@ bool Schematic::isEmpty() const noexcept {
 
 void Schematic::setName(const ElementName& name) noexcept {
   mName = name;
+  setModified();
   emit mProject.attributesChanged();
 }
 
+void Schematic::setGridInterval(const PositiveLength& interval) noexcept {
+  mGridInterval = interval;
+  setModified();
+}
+
+void Schematic::setGridUnit(const LengthUnit& unit) noexcept {
+  mGridUnit = unit;
+  setModified();
+}
+
 /*******************************************************************************
  *  Symbol Methods
  ******************************************************************************/
 
 void Schematic::addSymbol(SI_Symbol& symbol) {
-  if ((!mIsAddedToProject) || (mSymbols.values().contains(&symbol)) ||
+  if ((!mIsAddedToProject) || (mSymbols.value(symbol.getUuid()) == &symbol) ||
       (&symbol.getSchematic() != this)) {
     throw LogicError(__FILE__, __LINE__);
   }
@@ -121,6 +133,7 @@ void Schematic::addSymbol(SI_Symbol& symbol) {
   }
   symbol.addToSchematic();  // can throw
   mSymbols.insert(symbol.getUuid(), &symbol);
+  setModified();
   emit symbolAdded(symbol);
 }
 
@@ -130,6 +143,7 @@ void Schematic::removeSymbol(SI_Symbol& symbol) {
   }
   symbol.removeFromSchematic();  // can throw
   mSymbols.remove(symbol.getUuid());
+  setModified();
   emit symbolRemoved(symbol);
 }
 
@@ -138,7 +152,8 @@ void Schematic::removeSymbol(SI_Symbol& symbol) {
  ******************************************************************************/
 
 void Schematic::addNetSegment(SI_NetSegment& netsegment) {
-  if ((!mIsAddedToProject) || (mNetSegments.values().contains(&netsegment)) ||
+  if ((!mIsAddedToProject) ||
+      (mNetSegments.value(netsegment.getUuid()) == &netsegment) ||
       (&netsegment.getSchematic() != this)) {
     throw LogicError(__FILE__, __LINE__);
   }
@@ -150,6 +165,7 @@ void Schematic::addNetSegment(SI_NetSegment& netsegment) {
   }
   netsegment.addToSchematic();  // can throw
   mNetSegments.insert(netsegment.getUuid(), &netsegment);
+  setModified();
   emit netSegmentAdded(netsegment);
 }
 
@@ -160,6 +176,7 @@ void Schematic::removeNetSegment(SI_NetSegment& netsegment) {
   }
   netsegment.removeFromSchematic();  // can throw
   mNetSegments.remove(netsegment.getUuid());
+  setModified();
   emit netSegmentRemoved(netsegment);
 }
 
@@ -168,7 +185,8 @@ void Schematic::removeNetSegment(SI_NetSegment& netsegment) {
  ******************************************************************************/
 
 void Schematic::addPolygon(SI_Polygon& polygon) {
-  if ((!mIsAddedToProject) || (mPolygons.values().contains(&polygon)) ||
+  if ((!mIsAddedToProject) ||
+      (mPolygons.value(polygon.getUuid()) == &polygon) ||
       (&polygon.getSchematic() != this)) {
     throw LogicError(__FILE__, __LINE__);
   }
@@ -180,6 +198,7 @@ void Schematic::addPolygon(SI_Polygon& polygon) {
   }
   polygon.addToSchematic();  // can throw
   mPolygons.insert(polygon.getUuid(), &polygon);
+  setModified();
   emit polygonAdded(polygon);
 }
 
@@ -190,6 +209,7 @@ void Schematic::removePolygon(SI_Polygon& polygon) {
   }
   polygon.removeFromSchematic();  // can throw
   mPolygons.remove(polygon.getUuid());
+  setModified();
   emit polygonRemoved(polygon);
 }
 
@@ -198,7 +218,7 @@ void Schematic::removePolygon(SI_Polygon& polygon) {
  ******************************************************************************/
 
 void Schematic::addText(SI_Text& text) {
-  if ((!mIsAddedToProject) || (mTexts.values().contains(&text)) ||
+  if ((!mIsAddedToProject) || (mTexts.value(text.getUuid()) == &text) ||
       (&text.getSchematic() != this)) {
     throw LogicError(__FILE__, __LINE__);
   }
@@ -209,6 +229,7 @@ void Schematic::addText(SI_Text& text) {
   }
   text.addToSchematic();  // can throw
   mTexts.insert(text.getUuid(), &text);
+  setModified();
   emit textAdded(text);
 }
 
@@ -218,6 +239,7 @@ void Schematic::removeText(SI_Text& text) {
   }
   text.removeFromSchematic();  // can throw
   mTexts.remove(text.getUuid());
+  setModified();
   emit textRemoved(text);
 }
 
@@ -257,6 +279,7 @@ void Schematic::addToProject() {
   }
 
   mIsAddedToProject = true;
+  mIsModified = true;  // The directory might not contain the file yet.
   sgl.dismiss();
 }
 
@@ -293,6 +316,10 @@ void Schematic::removeFromProject() {
 }
 
 void Schematic::save() {
+  if (!mIsModified) {
+    return;
+  }
+
   SExpression root = SExpression::createList("librepcb_schematic");
   root.appendChild(mUuid);
   root.ensureLineBreak();
@@ -323,6 +350,7 @@ void Schematic::save() {
   }
   root.ensureLineBreak();
   mDirectory->write("schematic.lp", root.toByteArray());
+  mIsModified = false;
 }
 
 void Schematic::updateAllNetLabelAnchors() noexcept {
@@ -100,10 +100,26 @@ public:
 
   // Setters: Attributes
   void setName(const ElementName& name) noexcept;
-  void setGridInterval(const PositiveLength& interval) noexcept {
-    mGridInterval = interval;
-  }
-  void setGridUnit(const LengthUnit& unit) noexcept { mGridUnit = unit; }
+  void setGridInterval(const PositiveLength& interval) noexcept;
+  void setGridUnit(const LengthUnit& unit) noexcept;
+
+  // Modification Tracking
+
+  /**
+   * @brief Check whether the schematic file needs to be serialized by #save()
+   *
+   * @return  True if the schematic was modified since the last #save() (or
+   *          was never saved since it has been created or loaded).
+   */
+  bool isModified() const noexcept { return mIsModified; }
+
+  /**
+   * @brief Mark the content of the schematic file as modified
+   *
+   * Must be called on every modification of data contained in the schematic
+   * file, i.e. by the schematic itself and by all its items.
+   */
+  void setModified() noexcept { mIsModified = true; }
 
   // Symbol Methods
   const QMap<Uuid, SI_Symbol*>& getSymbols() const noexcept { return mSymbols; }
@@ -166,6 +182,7 @@ private:
   const QString mDirectoryName;
   std::unique_ptr<TransactionalDirectory> mDirectory;
   bool mIsAddedToProject;
+  bool mIsModified;  ///< See #isModified()
 
   // Attributes
   Uuid mUuid;
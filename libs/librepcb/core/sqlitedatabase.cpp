@@ -131,6 +131,17 @@ void SQLiteDatabase::clearTable(const QString& table) {
   exec("DELETE FROM " % table);  // can throw
 }
 
+void SQLiteDatabase::setBulkLoadMode(bool enabled) {
+  exec(QString("PRAGMA synchronous = %1")
+           .arg(enabled ? "NORMAL" : "FULL"));  // can throw
+  exec(QString("PRAGMA temp_store = %1")
+           .arg(enabled ? "MEMORY" : "DEFAULT"));  // can throw
+}
+
+void SQLiteDatabase::analyze() {
+  exec("ANALYZE");  // can throw
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
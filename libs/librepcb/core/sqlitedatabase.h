@@ -72,6 +72,27 @@ public:
   void rollbackTransaction();
   void clearTable(const QString& table);
 
+  /**
+   * @brief Switch connection settings for (or back from) bulk loading
+   *
+   * When enabled, `PRAGMA synchronous` is relaxed from `FULL` to `NORMAL`
+   * (still safe against corruption in WAL mode, but without an fsync on
+   * every commit) and temporary tables and indices are kept in memory.
+   * Disabling restores the SQLite defaults.
+   *
+   * @note  Must not be called within a transaction.
+   *
+   * @param enabled   Whether to enable or disable the bulk load settings.
+   */
+  void setBulkLoadMode(bool enabled);
+
+  /**
+   * @brief Update the statistics used by the query planner (`ANALYZE`)
+   *
+   * Should be called after large amounts of data have been modified.
+   */
+  void analyze();
+
   // General Methods
   QSqlQuery prepareQuery(QString query,
                          const Replacements& replacements = {}) const;
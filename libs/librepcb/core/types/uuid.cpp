@@ -33,6 +33,50 @@
  ******************************************************************************/
 namespace librepcb {
 
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+Uuid::Uuid(const QString& str) noexcept : mHigh(0), mLow(0) {
+  // The string is already validated, so it consists of exactly 32 lowercase
+  // hex digits, separated by dashes.
+  int digits = 0;
+  for (const QChar& chr : str) {
+    const ushort c = chr.unicode();
+    quint64 value;
+    if ((c >= '0') && (c <= '9')) {
+      value = c - '0';
+    } else if ((c >= 'a') && (c <= 'f')) {
+      value = c - 'a' + 10;
+    } else {
+      continue;  // Dash.
+    }
+    quint64& half = (digits < 16) ? mHigh : mLow;
+    half = (half << 4) | value;
+    ++digits;
+  }
+  Q_ASSERT(digits == 32);
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+QString Uuid::toStr() const noexcept {
+  static const char digits[] = "0123456789abcdef";
+  QString str(36, Qt::Uninitialized);
+  QChar* data = str.data();
+  int pos = 0;
+  for (int i = 0; i < 32; ++i) {
+    if ((pos == 8) || (pos == 13) || (pos == 18) || (pos == 23)) {
+      data[pos++] = QChar('-');
+    }
+    const quint64 half = (i < 16) ? mHigh : mLow;
+    data[pos++] = QChar(digits[(half >> (60 - 4 * (i % 16))) & 0xF]);
+  }
+  return str;
+}
+
 /*******************************************************************************
  *  Static Methods
  ******************************************************************************/
@@ -50,6 +50,15 @@ namespace librepcb {
  * can be created (in opposite to QUuid which allows "Null UUIDs")! If you need
  * a nullable UUID, use tl::optional<librepcb::Uuid> instead.
  *
+ * @note Since UUIDs are used as keys in almost every container of boards,
+ * schematics and libraries, only the 128 bits are stored in binary form and
+ * the string is built on demand by #toStr(). Objects are thus small and
+ * cheap to copy, and comparisons and hashing only need two integer
+ * operations instead of processing 36 characters. Because the string is
+ * always lowercase with dashes at fixed positions, the binary order is
+ * identical to the string order, thus sorted containers (and the file output
+ * depending on them) keep exactly the same order as before.
+ *
  * @see https://de.wikipedia.org/wiki/Universally_Unique_Identifier
  * @see https://tools.ietf.org/html/rfc4122
  */
@@ -69,7 +78,8 @@ public:
    *
    * @param other     Another ::librepcb::Uuid object
    */
-  Uuid(const Uuid& other) noexcept : mUuid(other.mUuid) {}
+  Uuid(const Uuid& other) noexcept
+    : mHigh(other.mHigh), mLow(other.mLow) {}
 
   /**
    * @brief Destructor
@@ -81,9 +91,9 @@ public:
   /**
    * @brief Get the UUID as a string (without braces)
    *
-   * @return The UUID as a string
+   * @return The UUID as a string (built from the binary value)
    */
-  QString toStr() const noexcept { return mUuid; }
+  QString toStr() const noexcept;
 
   //@{
   /**
@@ -91,18 +101,24 @@ public:
    *
    * @param rhs   The other object to compare
    *
-   * @return Result of comparing the UUIDs as strings
+   * @return Result of comparing the UUIDs (same result as comparing them as
+   *         strings)
    */
   Uuid& operator=(const Uuid& rhs) noexcept {
-    mUuid = rhs.mUuid;
+    mHigh = rhs.mHigh;
+    mLow = rhs.mLow;
     return *this;
   }
-  bool operator==(const Uuid& rhs) const noexcept { return mUuid == rhs.mUuid; }
-  bool operator!=(const Uuid& rhs) const noexcept { return mUuid != rhs.mUuid; }
-  bool operator<(const Uuid& rhs) const noexcept { return mUuid < rhs.mUuid; }
-  bool operator>(const Uuid& rhs) const noexcept { return mUuid > rhs.mUuid; }
-  bool operator<=(const Uuid& rhs) const noexcept { return mUuid <= rhs.mUuid; }
-  bool operator>=(const Uuid& rhs) const noexcept { return mUuid >= rhs.mUuid; }
+  bool operator==(const Uuid& rhs) const noexcept {
+    return (mLow == rhs.mLow) && (mHigh == rhs.mHigh);
+  }
+  bool operator!=(const Uuid& rhs) const noexcept { return !(*this == rhs); }
+  bool operator<(const Uuid& rhs) const noexcept {
+    return (mHigh < rhs.mHigh) || ((mHigh == rhs.mHigh) && (mLow < rhs.mLow));
+  }
+  bool operator>(const Uuid& rhs) const noexcept { return rhs < *this; }
+  bool operator<=(const Uuid& rhs) const noexcept { return !(rhs < *this); }
+  bool operator>=(const Uuid& rhs) const noexcept { return !(*this < rhs); }
   //@}
 
   // Static Methods
@@ -150,12 +166,17 @@ private:  // Methods
   /**
    * @brief Constructor which creates a Uuid object from a string
    *
-   * @param str       The uuid as a string (lowercase and without braces)
+   * @param str       The uuid as a string (lowercase and without braces),
+   *                  must already be validated with #isValid()
    */
-  explicit Uuid(const QString& str) noexcept : mUuid(str) {}
+  explicit Uuid(const QString& str) noexcept;
 
 private:  // Data
-  QString mUuid;  ///< Guaranteed to always contain a valid UUID
+  // Guaranteed to always represent a valid UUID
+  quint64 mHigh;  ///< First 64 bits of the UUID
+  quint64 mLow;  ///< Last 64 bits of the UUID
+
+  friend uint qHash(const Uuid& key, uint seed) noexcept;
 };
 
 /*******************************************************************************
@@ -173,14 +194,15 @@ inline QDebug operator<<(QDebug stream, const Uuid& uuid) noexcept {
 }
 
 inline uint qHash(const Uuid& key, uint seed) noexcept {
-  return ::qHash(key.toStr(), seed);
+  // Random UUIDs are uniformly distributed, so no need to hash the string.
+  return ::qHash(key.mHigh ^ key.mLow, seed);
 }
 
 }  // namespace librepcb
 
 namespace tl {
 inline uint qHash(const optional<librepcb::Uuid>& key, uint seed) noexcept {
-  return ::qHash(key ? key->toStr() : QString(), seed);
+  return key ? librepcb::qHash(*key, seed) : ::qHash(QString(), seed);
 }
 }  // namespace tl
 
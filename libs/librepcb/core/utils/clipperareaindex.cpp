@@ -0,0 +1,177 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "clipperareaindex.h"
+
+#include "clipperhelpers.h"
+
+#include <QtCore>
+
+#include <algorithm>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+ClipperAreaIndex::ClipperAreaIndex(const ClipperLib::Paths& area,
+                                   int maxLeafVertices)
+  : mArea(area), mMaxLeafVertices(maxLeafVertices), mRoot(new Node()) {
+  build(*mRoot, mArea, 0);  // can throw
+}
+
+ClipperAreaIndex::~ClipperAreaIndex() noexcept {
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+ClipperLib::Paths ClipperAreaIndex::getAreaWithin(
+    const ClipperLib::IntRect& rect) const noexcept {
+  ClipperLib::Paths result;
+  collect(*mRoot, rect, result);
+  return result;
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+bool ClipperAreaIndex::intersects(const ClipperLib::Paths& paths) const {
+  const ClipperLib::Paths nearbyArea = getAreaWithin(getBounds(paths));
+  if (nearbyArea.empty()) {
+    return false;
+  }
+  std::unique_ptr<ClipperLib::PolyTree> intersections =
+      ClipperHelpers::intersect(nearbyArea, paths);  // can throw
+  return (intersections->Total() > 0);
+}
+
+std::unique_ptr<ClipperLib::PolyTree> ClipperAreaIndex::intersect(
+    const ClipperLib::Paths& paths) const {
+  if (!intersects(paths)) {  // can throw
+    return std::unique_ptr<ClipperLib::PolyTree>(new ClipperLib::PolyTree());
+  }
+
+  // Intersect with the whole area to get exactly the same result as without
+  // index, i.e. without splitting the intersections at tile boundaries.
+  return ClipperHelpers::intersect(mArea, paths);  // can throw
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+ClipperLib::IntRect ClipperAreaIndex::getBounds(
+    const ClipperLib::Paths& paths) noexcept {
+  ClipperLib::IntRect rect{0, 0, -1, -1};  // Invalid (empty) rect.
+  bool first = true;
+  for (const ClipperLib::Path& path : paths) {
+    for (const ClipperLib::IntPoint& p : path) {
+      if (first) {
+        rect = ClipperLib::IntRect{p.X, p.Y, p.X, p.Y};
+        first = false;
+      } else {
+        rect.left = std::min(rect.left, p.X);
+        rect.top = std::min(rect.top, p.Y);
+        rect.right = std::max(rect.right, p.X);
+        rect.bottom = std::max(rect.bottom, p.Y);
+      }
+    }
+  }
+  return rect;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void ClipperAreaIndex::build(Node& node, const ClipperLib::Paths& paths,
+                             int depth) {
+  node.bounds = getBounds(paths);
+
+  std::size_t vertexCount = 0;
+  for (const ClipperLib::Path& path : paths) {
+    vertexCount += path.size();
+  }
+  const ClipperLib::cInt width = node.bounds.right - node.bounds.left;
+  const ClipperLib::cInt height = node.bounds.bottom - node.bounds.top;
+  if ((vertexCount <= static_cast<std::size_t>(mMaxLeafVertices)) ||
+      (depth >= sMaxDepth) || (width < 2) || (height < 2)) {
+    node.paths = paths;
+    return;
+  }
+
+  // Split into quadrants. Adjacent quadrants share their boundary, so the
+  // clipped pieces together cover exactly the same area.
+  const ClipperLib::cInt midX = node.bounds.left + (width / 2);
+  const ClipperLib::cInt midY = node.bounds.top + (height / 2);
+  const ClipperLib::cInt xs[] = {node.bounds.left, midX, node.bounds.right};
+  const ClipperLib::cInt ys[] = {node.bounds.top, midY, node.bounds.bottom};
+  for (int ix = 0; ix < 2; ++ix) {
+    for (int iy = 0; iy < 2; ++iy) {
+      const ClipperLib::Paths quadrant{{
+          ClipperLib::IntPoint(xs[ix], ys[iy]),
+          ClipperLib::IntPoint(xs[ix + 1], ys[iy]),
+          ClipperLib::IntPoint(xs[ix + 1], ys[iy + 1]),
+          ClipperLib::IntPoint(xs[ix], ys[iy + 1]),
+      }};
+      std::unique_ptr<ClipperLib::PolyTree> tree =
+          ClipperHelpers::intersect(paths, quadrant);  // can throw
+      const ClipperLib::Paths pieces =
+          ClipperHelpers::treeToPaths(*tree);  // can throw
+      if (!pieces.empty()) {
+        node.children.emplace_back(new Node());
+        build(*node.children.back(), pieces, depth + 1);  // can throw
+      }
+    }
+  }
+}
+
+void ClipperAreaIndex::collect(const Node& node,
+                               const ClipperLib::IntRect& rect,
+                               ClipperLib::Paths& result) const noexcept {
+  if (!overlaps(node.bounds, rect)) {
+    return;
+  }
+  result.insert(result.end(), node.paths.begin(), node.paths.end());
+  for (const std::unique_ptr<Node>& child : node.children) {
+    collect(*child, rect, result);
+  }
+}
+
+bool ClipperAreaIndex::overlaps(const ClipperLib::IntRect& a,
+                                const ClipperLib::IntRect& b) noexcept {
+  return (a.left <= b.right) && (b.left <= a.right) && (a.top <= b.bottom) &&
+      (b.top <= a.bottom);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
@@ -0,0 +1,125 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_CLIPPERAREAINDEX_H
+#define LIBREPCB_CORE_CLIPPERAREAINDEX_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <polyclipping/clipper.hpp>
+
+#include <QtCore>
+
+#include <memory>
+#include <vector>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class ClipperAreaIndex
+ ******************************************************************************/
+
+/**
+ * @brief Spatial index for fast intersection tests against a large area
+ *
+ * Intersecting many small paths (e.g. pads or traces) with one large area
+ * (e.g. the board outline clearance area with thousands of vertices) is slow
+ * since Clipper has to process all vertices of the area for every test. This
+ * class recursively splits the area into quadrants (a quadtree) once, until
+ * each leaf contains only a few vertices. Intersection tests then only
+ * consider the leaves overlapping the bounding box of the tested paths.
+ *
+ * The area is interpreted with the even-odd fill rule, same as
+ * ::librepcb::ClipperHelpers::intersect().
+ */
+class ClipperAreaIndex final {
+public:
+  // Constructors / Destructor
+  ClipperAreaIndex() = delete;
+  ClipperAreaIndex(const ClipperAreaIndex& other) = delete;
+  explicit ClipperAreaIndex(const ClipperLib::Paths& area,
+                            int maxLeafVertices = 64);
+  ~ClipperAreaIndex() noexcept;
+
+  // Getters
+  const ClipperLib::Paths& getArea() const noexcept { return mArea; }
+  ClipperLib::Paths getAreaWithin(const ClipperLib::IntRect& rect) const
+      noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Check whether some paths intersect with the area
+   *
+   * @param paths   The paths to test.
+   * @return        Whether the intersection is not empty.
+   */
+  bool intersects(const ClipperLib::Paths& paths) const;
+
+  /**
+   * @brief Intersect some paths with the area
+   *
+   * @param paths   The paths to intersect with the area.
+   * @return        Exactly the same result as
+   *                ::librepcb::ClipperHelpers::intersect() with the whole
+   *                area, but much faster if there's no intersection.
+   */
+  std::unique_ptr<ClipperLib::PolyTree> intersect(
+      const ClipperLib::Paths& paths) const;
+
+  // Static Methods
+  static ClipperLib::IntRect getBounds(const ClipperLib::Paths& paths) noexcept;
+
+  // Operator Overloadings
+  ClipperAreaIndex& operator=(const ClipperAreaIndex& rhs) = delete;
+
+private:  // Types
+  struct Node {
+    ClipperLib::IntRect bounds;  ///< Bounding box of all paths in this node
+    ClipperLib::Paths paths;  ///< Only set for leaf nodes
+    std::vector<std::unique_ptr<Node>> children;
+  };
+
+private:  // Methods
+  void build(Node& node, const ClipperLib::Paths& paths, int depth);
+  void collect(const Node& node, const ClipperLib::IntRect& rect,
+               ClipperLib::Paths& result) const noexcept;
+  static bool overlaps(const ClipperLib::IntRect& a,
+                       const ClipperLib::IntRect& b) noexcept;
+
+private:  // Data
+  ClipperLib::Paths mArea;
+  int mMaxLeafVertices;
+  std::unique_ptr<Node> mRoot;
+
+  /// Limit the tree depth to avoid creating lots of tiny tiles
+  static constexpr int sMaxDepth = 10;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
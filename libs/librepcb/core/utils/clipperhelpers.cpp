@@ -33,6 +33,42 @@ namespace librepcb {
  *  General Methods
  ******************************************************************************/
 
+void ClipperHelpers::execute(ClipperLib::Paths& result,
+                             const ClipperLib::Paths& subject,
+                             const ClipperLib::Paths& clip,
+                             ClipperLib::ClipType type,
+                             ClipperLib::PolyFillType subjectFillType,
+                             ClipperLib::PolyFillType clipFillType) {
+  try {
+    ClipperLib::Clipper c;
+    c.AddPaths(subject, ClipperLib::ptSubject, true);
+    c.AddPaths(clip, ClipperLib::ptClip, true);
+    c.Execute(type, result, subjectFillType, clipFillType);
+  } catch (const std::exception& e) {
+    throw LogicError(__FILE__, __LINE__,
+                     QString("Failed to clip paths: %1").arg(e.what()));
+  }
+}
+
+std::unique_ptr<ClipperLib::PolyTree> ClipperHelpers::executeToTree(
+    const ClipperLib::Paths& subject, const ClipperLib::Paths& clip,
+    ClipperLib::ClipType type, ClipperLib::PolyFillType subjectFillType,
+    ClipperLib::PolyFillType clipFillType) {
+  try {
+    // Wrap the PolyTree object in a smart pointer since PolyTree cannot
+    // safely be copied (i.e. returned by value), it would lead to a crash!!!
+    std::unique_ptr<ClipperLib::PolyTree> result(new ClipperLib::PolyTree());
+    ClipperLib::Clipper c;
+    c.AddPaths(subject, ClipperLib::ptSubject, true);
+    c.AddPaths(clip, ClipperLib::ptClip, true);
+    c.Execute(type, *result, subjectFillType, clipFillType);
+    return result;
+  } catch (const std::exception& e) {
+    throw LogicError(__FILE__, __LINE__,
+                     QString("Failed to clip paths: %1").arg(e.what()));
+  }
+}
+
 void ClipperHelpers::unite(ClipperLib::Paths& paths,
                            ClipperLib::PolyFillType fillType) {
   try {
@@ -234,6 +270,12 @@ ClipperLib::Paths ClipperHelpers::flattenTree(
   return paths;
 }
 
+bool ClipperHelpers::contains(const ClipperLib::Path& path,
+                              const ClipperLib::IntPoint& point) noexcept {
+  // Returns 0 if outside, 1 if inside and -1 if on the path.
+  return ClipperLib::PointInPolygon(point, path) != 0;
+}
+
 /*******************************************************************************
  *  Conversion Methods
  ******************************************************************************/
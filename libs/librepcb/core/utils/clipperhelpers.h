@@ -52,6 +52,32 @@ public:
   ~ClipperHelpers() = delete;
 
   // General Methods
+
+  /**
+   * @brief Perform an arbitrary boolean operation
+   *
+   * All boolean operations on paths should go through this class (either
+   * this generic method or one of the specialized methods below) instead of
+   * using ClipperLib directly. This keeps the polygon engine exchangeable at
+   * a single place, and converts engine errors to our exceptions.
+   *
+   * @param result          Output paths (may be the same object as
+   *                        `subject` or `clip`).
+   * @param subject         Subject paths.
+   * @param clip            Clip paths.
+   * @param type            Type of the boolean operation.
+   * @param subjectFillType Fill type of the subject paths.
+   * @param clipFillType    Fill type of the clip paths.
+   */
+  static void execute(ClipperLib::Paths& result,
+                      const ClipperLib::Paths& subject,
+                      const ClipperLib::Paths& clip, ClipperLib::ClipType type,
+                      ClipperLib::PolyFillType subjectFillType,
+                      ClipperLib::PolyFillType clipFillType);
+  static std::unique_ptr<ClipperLib::PolyTree> executeToTree(
+      const ClipperLib::Paths& subject, const ClipperLib::Paths& clip,
+      ClipperLib::ClipType type, ClipperLib::PolyFillType subjectFillType,
+      ClipperLib::PolyFillType clipFillType);
   static void unite(ClipperLib::Paths& paths,
                     ClipperLib::PolyFillType fillType);
   static void unite(ClipperLib::Paths& subject, const ClipperLib::Path& clip);
@@ -74,6 +100,16 @@ public:
   static ClipperLib::Paths treeToPaths(const ClipperLib::PolyTree& tree);
   static ClipperLib::Paths flattenTree(const ClipperLib::PolyNode& node);
 
+  /**
+   * @brief Check whether a point lies within a closed path
+   *
+   * @param path    The closed path (orientation does not matter).
+   * @param point   The point to check.
+   * @return        Whether the point lies inside or on the path.
+   */
+  static bool contains(const ClipperLib::Path& path,
+                       const ClipperLib::IntPoint& point) noexcept;
+
   // Type Conversions
   static QVector<Path> convert(const ClipperLib::Paths& paths) noexcept;
   static Path convert(const ClipperLib::Path& path) noexcept;
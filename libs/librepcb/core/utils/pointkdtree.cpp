@@ -0,0 +1,147 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "pointkdtree.h"
+
+#include <QtCore>
+
+#include <algorithm>
+#include <limits>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+PointKdTree::PointKdTree() noexcept : mPoints() {
+}
+
+PointKdTree::PointKdTree(const PointKdTree& other) noexcept
+  : mPoints(other.mPoints) {
+}
+
+PointKdTree::PointKdTree(const QVector<Point>& points) noexcept
+  : mPoints(points) {
+  build(0, mPoints.count(), 0);
+}
+
+PointKdTree::~PointKdTree() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+tl::optional<Point> PointKdTree::findNearest(
+    const Point& pos, const tl::optional<UnsignedLength>& maxDistance) const
+    noexcept {
+  tl::optional<int> nearest;
+  qreal nearestDist2 = std::numeric_limits<qreal>::infinity();
+  if (maxDistance) {
+    // Note: Slightly increase the distance to make it inclusive.
+    const qreal max = (*maxDistance)->toNm() + 0.5;
+    nearestDist2 = max * max;
+  }
+  findNearest(0, mPoints.count(), 0, pos, nearest, nearestDist2);
+  if (nearest) {
+    return mPoints.at(*nearest);
+  } else {
+    return tl::nullopt;
+  }
+}
+
+/*******************************************************************************
+ *  Operator Overloadings
+ ******************************************************************************/
+
+PointKdTree& PointKdTree::operator=(const PointKdTree& rhs) noexcept {
+  mPoints = rhs.mPoints;
+  return *this;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void PointKdTree::build(int begin, int end, int depth) noexcept {
+  if ((end - begin) < 2) {
+    return;
+  }
+  const int mid = begin + ((end - begin) / 2);
+  const bool xAxis = ((depth % 2) == 0);
+  std::nth_element(mPoints.begin() + begin, mPoints.begin() + mid,
+                   mPoints.begin() + end,
+                   [xAxis](const Point& a, const Point& b) {
+                     return xAxis ? (a.getX() < b.getX())
+                                  : (a.getY() < b.getY());
+                   });
+  build(begin, mid, depth + 1);
+  build(mid + 1, end, depth + 1);
+}
+
+void PointKdTree::findNearest(int begin, int end, int depth, const Point& pos,
+                              tl::optional<int>& nearest,
+                              qreal& nearestDist2) const noexcept {
+  if (begin >= end) {
+    return;
+  }
+  const int mid = begin + ((end - begin) / 2);
+  const Point& p = mPoints.at(mid);
+  const qreal dist2 = distanceSquared(pos, p);
+  if (dist2 <= nearestDist2) {
+    nearest = mid;
+    nearestDist2 = dist2;
+  }
+
+  // Search the half containing the position first, then the other half only
+  // if it might contain a nearer point.
+  const bool xAxis = ((depth % 2) == 0);
+  const qreal delta = xAxis ? (pos.getX() - p.getX()).toNm()
+                            : (pos.getY() - p.getY()).toNm();
+  if (delta < 0) {
+    findNearest(begin, mid, depth + 1, pos, nearest, nearestDist2);
+    if ((delta * delta) <= nearestDist2) {
+      findNearest(mid + 1, end, depth + 1, pos, nearest, nearestDist2);
+    }
+  } else {
+    findNearest(mid + 1, end, depth + 1, pos, nearest, nearestDist2);
+    if ((delta * delta) <= nearestDist2) {
+      findNearest(begin, mid, depth + 1, pos, nearest, nearestDist2);
+    }
+  }
+}
+
+qreal PointKdTree::distanceSquared(const Point& p1, const Point& p2) noexcept {
+  const qreal dx = (p1.getX() - p2.getX()).toNm();
+  const qreal dy = (p1.getY() - p2.getY()).toNm();
+  return (dx * dx) + (dy * dy);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
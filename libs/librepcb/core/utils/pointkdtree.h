@@ -0,0 +1,100 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_POINTKDTREE_H
+#define LIBREPCB_CORE_POINTKDTREE_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../types/length.h"
+#include "../types/point.h"
+
+#include <optional/tl/optional.hpp>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class PointKdTree
+ ******************************************************************************/
+
+/**
+ * @brief Static 2D k-d tree for fast nearest neighbor queries
+ *
+ * The tree is built once from a list of points (O(n*log(n))) and is
+ * immutable afterwards. Each query then only takes O(log(n)) on average,
+ * compared to O(n) when comparing with every point.
+ *
+ * The tree is stored implicitly in a single array: Each range of points is
+ * partitioned around its median, alternating between X and Y axis.
+ */
+class PointKdTree final {
+public:
+  // Constructors / Destructor
+  PointKdTree() noexcept;
+  PointKdTree(const PointKdTree& other) noexcept;
+  explicit PointKdTree(const QVector<Point>& points) noexcept;
+  ~PointKdTree() noexcept;
+
+  // Getters
+  bool isEmpty() const noexcept { return mPoints.isEmpty(); }
+  int count() const noexcept { return mPoints.count(); }
+
+  // General Methods
+
+  /**
+   * @brief Find the point nearest to a given position
+   *
+   * @param pos           The position to search around.
+   * @param maxDistance   If set, only points within this distance (inclusive)
+   *                      are taken into account.
+   * @return              The nearest point, or `tl::nullopt` if there is no
+   *                      (matching) point.
+   */
+  tl::optional<Point> findNearest(
+      const Point& pos,
+      const tl::optional<UnsignedLength>& maxDistance = tl::nullopt) const
+      noexcept;
+
+  // Operator Overloadings
+  PointKdTree& operator=(const PointKdTree& rhs) noexcept;
+
+private:  // Methods
+  void build(int begin, int end, int depth) noexcept;
+  void findNearest(int begin, int end, int depth, const Point& pos,
+                   tl::optional<int>& nearest, qreal& nearestDist2) const
+      noexcept;
+  static qreal distanceSquared(const Point& p1, const Point& p2) noexcept;
+
+private:  // Data
+  QVector<Point> mPoints;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
@@ -26,6 +26,8 @@
 #include <QtCore>
 
 #include <functional>
+#include <initializer_list>
+#include <type_traits>
 
 /*******************************************************************************
  *  Namespace / Forward Declarations
@@ -35,6 +37,38 @@ namespace librepcb {
 template <typename Tsender, typename... Args>
 class Slot;
 
+/*******************************************************************************
+ *  Event Masks
+ ******************************************************************************/
+
+/**
+ * @brief Get the event mask bit of an enum value passed to a signal
+ *
+ * Values outside the range [0..63] map to all bits, i.e. they can't be
+ * filtered and are always delivered to all slots.
+ *
+ * @param event   The event value.
+ * @return The bit representing the event.
+ */
+template <typename T>
+inline typename std::enable_if<std::is_enum<T>::value, quint64>::type
+    signalEventBit(T event) noexcept {
+  const qint64 index = static_cast<qint64>(event);
+  return ((index >= 0) && (index < 64)) ? (quint64(1) << index)
+                                        : ~quint64(0);
+}
+
+/**
+ * @brief Overload for non-enum signal arguments, which can't be filtered
+ *
+ * @return All bits.
+ */
+template <typename T>
+inline typename std::enable_if<!std::is_enum<T>::value, quint64>::type
+    signalEventBit(const T&) noexcept {
+  return ~quint64(0);
+}
+
 /*******************************************************************************
  *  Class Signal
  ******************************************************************************/
@@ -55,6 +89,14 @@ class Slot;
  *   - Always synchronous, no queued connections are possible
  *   - No endless loop detection
  *
+ * If the first argument of the signal is an enum (typically an `Event`),
+ * slots can subscribe to specific events only with
+ * ::librepcb::Slot::setEventFilter(). Notifications which no attached slot is
+ * interested in return immediately, and the dispatching itself never
+ * allocates memory. Attaching and detaching slots takes constant time, so
+ * even signals with many slots (e.g. one per graphics item) can be torn down
+ * quickly. Note that the order in which slots are called is not specified.
+ *
  * @see ::librepcb::Slot
  *
  * @tparam Tsender  Type of the sender object
@@ -84,7 +126,9 @@ public:
    */
   ~Signal() noexcept {
     for (auto slot : mSlots) {
-      slot->mSignals.remove(this);
+      if (slot) {
+        slot->mSignals.remove(this);
+      }
     }
   }
 
@@ -93,7 +137,9 @@ public:
    *
    * @return Count of registered slots
    */
-  int getSlotCount() const noexcept { return mSlots.count(); }
+  int getSlotCount() const noexcept {
+    return mSlots.count() - mDetachedSlotsCount;
+  }
 
   /**
    * @brief Attach a slot
@@ -101,8 +147,10 @@ public:
    * @param slot  Reference to the slot to attach
    */
   void attach(Slot<Tsender, Args...>& slot) const noexcept {
-    slot.mSignals.insert(this);
-    mSlots.insert(&slot);
+    if (slot.mSignals.contains(this)) return;
+    slot.mSignals.insert(this, mSlots.count());
+    mSlots.append(&slot);
+    updateEventMask(slot.mEventMask, 1);
   }
 
   /**
@@ -111,8 +159,12 @@ public:
    * @param slot  Reference to the slot to detach
    */
   void detach(Slot<Tsender, Args...>& slot) const noexcept {
-    slot.mSignals.remove(this);
-    mSlots.remove(&slot);
+    auto it = slot.mSignals.find(this);
+    if (it != slot.mSignals.end()) {
+      const int index = it.value();
+      slot.mSignals.erase(it);
+      removeSlot(index);
+    }
   }
 
   /**
@@ -121,27 +173,116 @@ public:
    * @param args  Arguments passed to the slots
    */
   void notify(Args... args) noexcept {
-    // Note: A "foreach" loop with a Qt container first creates an implicitly
-    // shared copy of the container (see
-    // https://doc.qt.io/qt-5/containers.html#foreach). This is very important
-    // since the callback might modify the container while iterating over it!
-    // With std containers this would be much more complicated (or less
-    // efficient).
-    foreach (const auto& slot, mSlots) {
-      // Check existence of the slot again because we must not call it if it
-      // was detached (i.e. removed from the container) in the meantime.
-      if (mSlots.contains(slot)) {
+    const quint64 eventBits = getEventBits(args...);
+    if (!(mEventMask & eventBits)) {
+      return;  // No slot attached which is interested in this event.
+    }
+
+    // Note: The callbacks might attach or detach slots while iterating. Slots
+    // attached in the meantime are appended and thus not called since the
+    // iteration stops at the original count. Slots detached in the meantime
+    // are only replaced by nullptr and removed after the iteration.
+    ++mNotifyDepth;
+    const int count = mSlots.count();
+    for (int i = 0; i < count; ++i) {
+      const auto slot = mSlots.at(i);
+      if (slot && (slot->mEventMask & eventBits)) {
         slot->mCallback(mSender, args...);
       }
     }
+    if ((--mNotifyDepth == 0) && (mDetachedSlotsCount > 0)) {
+      removeDetachedSlots();
+    }
   }
 
   // Operator Overloadings
   Signal& operator=(Signal const& other) = delete;
 
 private:
+  static quint64 getEventBits() noexcept { return ~quint64(0); }
+  template <typename T, typename... Rest>
+  static quint64 getEventBits(const T& first, const Rest&...) noexcept {
+    return signalEventBit(first);
+  }
+
+  void removeSlot(int index) const noexcept {
+    Q_ASSERT((index >= 0) && (index < mSlots.count()) && mSlots.at(index));
+    updateEventMask(mSlots.at(index)->mEventMask, -1);
+    if (mNotifyDepth > 0) {
+      // Keep the indices stable while notifying, removed afterwards.
+      mSlots[index] = nullptr;
+      ++mDetachedSlotsCount;
+      return;
+    }
+    // Move the last slot into the gap to avoid shifting all following slots.
+    auto last = mSlots.last();
+    mSlots.removeLast();
+    if (index < mSlots.count()) {
+      mSlots[index] = last;
+      last->mSignals[this] = index;
+    }
+  }
+
+  void removeDetachedSlots() noexcept {
+    int count = 0;
+    for (int i = 0; i < mSlots.count(); ++i) {
+      if (auto slot = mSlots.at(i)) {
+        if (i != count) {
+          mSlots[count] = slot;
+          slot->mSignals[this] = count;
+        }
+        ++count;
+      }
+    }
+    mSlots.resize(count);
+    mDetachedSlotsCount = 0;
+  }
+
+  void updateEventMask(quint64 slotMask, int delta) const noexcept {
+    if (slotMask == ~quint64(0)) {
+      mFullEventMaskSlotsCount += delta;
+    } else {
+      if (mEventBitSlotsCount.isEmpty()) {
+        mEventBitSlotsCount.fill(0, 64);
+      }
+      for (int i = 0; i < 64; ++i) {
+        if (slotMask & (quint64(1) << i)) {
+          mEventBitSlotsCount[i] += delta;
+        }
+      }
+    }
+    mEventMask = 0;
+    if (mFullEventMaskSlotsCount > 0) {
+      mEventMask = ~quint64(0);
+    } else {
+      for (int i = 0; i < mEventBitSlotsCount.count(); ++i) {
+        if (mEventBitSlotsCount.at(i) > 0) {
+          mEventMask |= (quint64(1) << i);
+        }
+      }
+    }
+  }
+
   const Tsender& mSender;  ///< Reference to the sender object
-  mutable QSet<Slot<Tsender, Args...>*> mSlots;  ///< All attached slots
+
+  /// All attached slots (nullptr if detached while notifying)
+  mutable QVector<Slot<Tsender, Args...>*> mSlots;
+
+  /// Count of nullptr entries in #mSlots
+  mutable int mDetachedSlotsCount = 0;
+
+  /// Union of the event masks of all attached slots
+  mutable quint64 mEventMask = 0;
+
+  /// Count of attached slots which receive all events
+  mutable int mFullEventMaskSlotsCount = 0;
+
+  /// Count of attached slots per event bit (only for slots with a filter,
+  /// empty as long as there are no such slots)
+  mutable QVector<int> mEventBitSlotsCount;
+
+  /// Nesting depth of #notify() calls
+  int mNotifyDepth = 0;
 };
 
 /*******************************************************************************
@@ -218,21 +359,58 @@ public:
    * @brief Detach from all signals
    */
   void detachAll() noexcept {
-    for (auto signal : mSignals) {
-      signal->mSlots.remove(this);
+    // Note: Detaching only modifies the indices of other slots, so it is safe
+    // to iterate over our own signals meanwhile.
+    for (auto it = mSignals.begin(); it != mSignals.end(); ++it) {
+      it.key()->removeSlot(it.value());
     }
     mSignals.clear();
   }
 
+  /**
+   * @brief Only receive specific events
+   *
+   * Signals whose first argument is an enum will only call this slot for the
+   * given events. Other signals are not affected.
+   *
+   * @param events  The events to receive.
+   */
+  template <typename Tevent>
+  void setEventFilter(std::initializer_list<Tevent> events) noexcept {
+    static_assert(std::is_enum<Tevent>::value, "Events must be enums.");
+    quint64 mask = 0;
+    for (Tevent event : events) {
+      mask |= signalEventBit(event);
+    }
+    setEventMask(mask);
+  }
+
+  /**
+   * @brief Receive all events again
+   */
+  void clearEventFilter() noexcept { setEventMask(~quint64(0)); }
+
   // Operator Overloadings
   Slot& operator=(Slot const& other) = delete;
 
 private:
-  /// All signals this slot is attached to
-  QSet<const Signal<Tsender, Args...>*> mSignals;
+  void setEventMask(quint64 mask) noexcept {
+    for (auto it = mSignals.begin(); it != mSignals.end(); ++it) {
+      it.key()->updateEventMask(mEventMask, -1);
+      it.key()->updateEventMask(mask, 1);
+    }
+    mEventMask = mask;
+  }
+
+  /// All signals this slot is attached to, with the index of this slot in
+  /// the slots list of the signal
+  QHash<const Signal<Tsender, Args...>*, int> mSignals;
 
   /// The registered callback function
   std::function<void(const Tsender&, Args...)> mCallback;
+
+  /// The events this slot is interested in
+  quint64 mEventMask = ~quint64(0);
 };
 
 /*******************************************************************************
@@ -146,6 +146,31 @@ UnsignedLength Toolbox::shortestDistanceBetweenPointAndLine(
   return (p - np).getLength();
 }
 
+UnsignedLength Toolbox::shortestDistanceBetweenLines(const Point& a1,
+                                                     const Point& a2,
+                                                     const Point& b1,
+                                                     const Point& b2) noexcept {
+  // If the lines cross each other, the distance is zero.
+  auto orientation = [](const Point& p, const Point& q, const Point& r) {
+    const Point a = q - p;
+    const Point b = r - p;
+    const qreal cross = (a.getX().toMm() * b.getY().toMm()) -
+        (a.getY().toMm() * b.getX().toMm());
+    return (cross > 0) ? 1 : ((cross < 0) ? -1 : 0);
+  };
+  if ((orientation(a1, a2, b1) * orientation(a1, a2, b2) < 0) &&
+      (orientation(b1, b2, a1) * orientation(b1, b2, a2) < 0)) {
+    return UnsignedLength(0);
+  }
+
+  // Otherwise the shortest distance is between an end point and the other
+  // line (this also covers touching and collinear lines).
+  return std::min(std::min(shortestDistanceBetweenPointAndLine(a1, b1, b2),
+                           shortestDistanceBetweenPointAndLine(a2, b1, b2)),
+                  std::min(shortestDistanceBetweenPointAndLine(b1, a1, a2),
+                           shortestDistanceBetweenPointAndLine(b2, a1, a2)));
+}
+
 QString Toolbox::incrementNumberInString(QString string) noexcept {
   QRegularExpression regex("([0-9]+)(?!.*[0-9]+)");
   QRegularExpressionMatch match = regex.match(string);
@@ -221,6 +221,24 @@ public:
       const Point& p, const Point& l1, const Point& l2,
       Point* nearest = nullptr) noexcept;
 
+  /**
+   * @brief Calculate the shortest distance between two given lines
+   *
+   * @param a1        Start point of the first line
+   * @param a2        End point of the first line
+   * @param b1        Start point of the second line
+   * @param b2        End point of the second line
+   *
+   * @return Shortest distance between the given lines (0 if they intersect)
+   *
+   * @warning This method works with floating point numbers and thus the result
+   * may not be perfectly precise.
+   */
+  static UnsignedLength shortestDistanceBetweenLines(const Point& a1,
+                                                     const Point& a2,
+                                                     const Point& b1,
+                                                     const Point& b2) noexcept;
+
   /**
    * @brief Copy a string while incrementing its contained number
    *
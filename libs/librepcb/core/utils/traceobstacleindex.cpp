@@ -0,0 +1,266 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "traceobstacleindex.h"
+
+#include "clipperhelpers.h"
+#include "toolbox.h"
+
+#include <QtCore>
+
+#include <algorithm>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+TraceObstacleIndex::TraceObstacleIndex(const PositiveLength& cellSize) noexcept
+  : mCellSize(*cellSize),
+    mNextId(0),
+    mObstacles(),
+    mCells(),
+    mLargeObstacles() {
+}
+
+TraceObstacleIndex::~TraceObstacleIndex() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+int TraceObstacleIndex::addSegment(const Point& p1, const Point& p2,
+                                   const UnsignedLength& width,
+                                   const tl::optional<Uuid>& net) noexcept {
+  Obstacle obstacle;
+  obstacle.vertices = {p1, p2};
+  obstacle.radius = width / 2;
+  obstacle.net = net;
+  obstacle.min = Point(std::min(p1.getX(), p2.getX()) - obstacle.radius,
+                       std::min(p1.getY(), p2.getY()) - obstacle.radius);
+  obstacle.max = Point(std::max(p1.getX(), p2.getX()) + obstacle.radius,
+                       std::max(p1.getY(), p2.getY()) + obstacle.radius);
+  return add(obstacle);
+}
+
+int TraceObstacleIndex::addArea(const ClipperLib::Path& outline,
+                                const tl::optional<Uuid>& net) noexcept {
+  if (outline.empty()) {
+    return -1;
+  }
+
+  Obstacle obstacle;
+  obstacle.outline = outline;
+  obstacle.radius = Length(0);
+  obstacle.net = net;
+  obstacle.vertices.reserve(outline.size());
+  for (const ClipperLib::IntPoint& p : outline) {
+    obstacle.vertices.append(ClipperHelpers::convert(p));
+  }
+  obstacle.min = obstacle.max = obstacle.vertices.first();
+  foreach (const Point& p, obstacle.vertices) {
+    obstacle.min.setX(std::min(obstacle.min.getX(), p.getX()));
+    obstacle.min.setY(std::min(obstacle.min.getY(), p.getY()));
+    obstacle.max.setX(std::max(obstacle.max.getX(), p.getX()));
+    obstacle.max.setY(std::max(obstacle.max.getY(), p.getY()));
+  }
+  return add(obstacle);
+}
+
+void TraceObstacleIndex::remove(int id) noexcept {
+  auto it = mObstacles.find(id);
+  if (it == mObstacles.end()) {
+    return;
+  }
+
+  int x1, y1, x2, y2;
+  if (getCells(it->min, it->max, x1, y1, x2, y2)) {
+    for (int x = x1; x <= x2; ++x) {
+      for (int y = y1; y <= y2; ++y) {
+        auto cell = mCells.find(Cell(x, y));
+        if (cell != mCells.end()) {
+          cell->removeOne(id);
+          if (cell->isEmpty()) {
+            mCells.erase(cell);
+          }
+        }
+      }
+    }
+  } else {
+    mLargeObstacles.remove(id);
+  }
+  mObstacles.erase(it);
+}
+
+void TraceObstacleIndex::clear() noexcept {
+  mObstacles.clear();
+  mCells.clear();
+  mLargeObstacles.clear();
+}
+
+bool TraceObstacleIndex::isFree(const Point& p1, const Point& p2,
+                                const PositiveLength& width,
+                                const UnsignedLength& clearance,
+                                const tl::optional<Uuid>& net) const noexcept {
+  const Length margin = (width / 2) + clearance;
+  const Point min(std::min(p1.getX(), p2.getX()) - margin,
+                  std::min(p1.getY(), p2.getY()) - margin);
+  const Point max(std::max(p1.getX(), p2.getX()) + margin,
+                  std::max(p1.getY(), p2.getY()) + margin);
+
+  auto check = [&](int id) {
+    const Obstacle& obstacle = *mObstacles.constFind(id);
+    if (net && (obstacle.net == net)) {
+      return true;  // Same net.
+    }
+    if ((obstacle.max.getX() < min.getX()) ||
+        (obstacle.min.getX() > max.getX()) ||
+        (obstacle.max.getY() < min.getY()) ||
+        (obstacle.min.getY() > max.getY())) {
+      return true;  // Too far away.
+    }
+    return getDistance(obstacle, p1, p2) >= (obstacle.radius + margin);
+  };
+
+  int x1, y1, x2, y2;
+  if (getCells(min, max, x1, y1, x2, y2)) {
+    // Note: Obstacles may be registered in multiple cells, so they might
+    // be checked more than once. This is cheaper than deduplicating them.
+    for (int x = x1; x <= x2; ++x) {
+      for (int y = y1; y <= y2; ++y) {
+        foreach (int id, mCells.value(Cell(x, y))) {
+          if (!check(id)) {
+            return false;
+          }
+        }
+      }
+    }
+    foreach (int id, mLargeObstacles) {
+      if (!check(id)) {
+        return false;
+      }
+    }
+  } else {
+    for (auto it = mObstacles.begin(); it != mObstacles.end(); ++it) {
+      if (!check(it.key())) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+Point TraceObstacleIndex::findLastFreePoint(
+    const Point& p1, const Point& p2, const PositiveLength& width,
+    const UnsignedLength& clearance, const tl::optional<Uuid>& net) const
+    noexcept {
+  if (isFree(p1, p2, width, clearance, net) ||
+      (!isFree(p1, p1, width, clearance, net))) {
+    return p2;
+  }
+
+  // Binary search along the line until the resolution is below 1µm.
+  const Point delta = p2 - p1;
+  const qreal length = delta.getLength()->toNm();
+  auto pointAt = [&](qreal t) {
+    return p1 + Point(delta.getX().scaled(t), delta.getY().scaled(t));
+  };
+  qreal lower = 0;  // Always free.
+  qreal upper = 1;  // Always blocked.
+  while ((upper - lower) * length > 1000) {
+    const qreal t = (lower + upper) / 2;
+    if (isFree(p1, pointAt(t), width, clearance, net)) {
+      lower = t;
+    } else {
+      upper = t;
+    }
+  }
+  return pointAt(lower);
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+int TraceObstacleIndex::add(const Obstacle& obstacle) noexcept {
+  const int id = mNextId++;
+  mObstacles.insert(id, obstacle);
+  int x1, y1, x2, y2;
+  if (getCells(obstacle.min, obstacle.max, x1, y1, x2, y2)) {
+    for (int x = x1; x <= x2; ++x) {
+      for (int y = y1; y <= y2; ++y) {
+        mCells[Cell(x, y)].append(id);
+      }
+    }
+  } else {
+    mLargeObstacles.insert(id);
+  }
+  return id;
+}
+
+bool TraceObstacleIndex::getCells(const Point& min, const Point& max, int& x1,
+                                  int& y1, int& x2, int& y2) const noexcept {
+  const qreal size = mCellSize.toNm();
+  x1 = qFloor(min.getX().toNm() / size);
+  y1 = qFloor(min.getY().toNm() / size);
+  x2 = qFloor(max.getX().toNm() / size);
+  y2 = qFloor(max.getY().toNm() / size);
+  const qint64 cells = (qint64(x2) - x1 + 1) * (qint64(y2) - y1 + 1);
+  return cells <= sMaxCellsPerObstacle;
+}
+
+Length TraceObstacleIndex::getDistance(const Obstacle& obstacle,
+                                       const Point& p1,
+                                       const Point& p2) noexcept {
+  if (obstacle.outline.empty()) {
+    return *Toolbox::shortestDistanceBetweenLines(
+        obstacle.vertices.at(0), obstacle.vertices.at(1), p1, p2);
+  }
+
+  // If the trace starts or ends within the area, the distance is zero.
+  // Otherwise it is the distance to the nearest edge of the outline (which
+  // is zero too if the trace crosses the outline).
+  if (ClipperHelpers::contains(obstacle.outline, ClipperHelpers::convert(p1)) ||
+      ClipperHelpers::contains(obstacle.outline, ClipperHelpers::convert(p2))) {
+    return Length(0);
+  }
+  Length distance = Length::max();
+  for (int i = 0; i < obstacle.vertices.count(); ++i) {
+    const Point& v1 = obstacle.vertices.at(i);
+    const Point& v2 =
+        obstacle.vertices.at((i + 1) % obstacle.vertices.count());
+    distance = std::min(
+        distance, *Toolbox::shortestDistanceBetweenLines(v1, v2, p1, p2));
+  }
+  return distance;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
@@ -0,0 +1,184 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_TRACEOBSTACLEINDEX_H
+#define LIBREPCB_CORE_TRACEOBSTACLEINDEX_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../types/length.h"
+#include "../types/point.h"
+#include "../types/uuid.h"
+
+#include <optional/tl/optional.hpp>
+#include <polyclipping/clipper.hpp>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class TraceObstacleIndex
+ ******************************************************************************/
+
+/**
+ * @brief Spatial index of copper obstacles for interactive trace routing
+ *
+ * Obstacles are either round segments (traces, vias) or filled areas (pads,
+ * polygons). Each obstacle may belong to a net, so traces of the same net
+ * can pass through it (thus one index can be shared by all nets of a layer).
+ * They are stored in a uniform grid of buckets, so a query only
+ * needs to check the few obstacles close to the trace instead of the whole
+ * board. Obstacles can be added and removed at any time, so the index can be
+ * kept up to date incrementally while the board is modified.
+ *
+ * All distance calculations are done analytically (no Clipper operations),
+ * thus queries are fast enough to be executed on every mouse move.
+ */
+class TraceObstacleIndex final {
+public:
+  // Constructors / Destructor
+  TraceObstacleIndex(const TraceObstacleIndex& other) = delete;
+  explicit TraceObstacleIndex(
+      const PositiveLength& cellSize = PositiveLength(2000000)) noexcept;
+  ~TraceObstacleIndex() noexcept;
+
+  // Getters
+  bool isEmpty() const noexcept { return mObstacles.isEmpty(); }
+  int count() const noexcept { return mObstacles.count(); }
+
+  // General Methods
+
+  /**
+   * @brief Add a round segment (e.g. a trace or a via)
+   *
+   * @param p1      Start point.
+   * @param p2      End point (equal to `p1` for circles).
+   * @param width   Width (diameter) of the segment.
+   * @param net     UUID of the net the segment belongs to, if any.
+   * @return        ID of the added obstacle, see #remove().
+   */
+  int addSegment(const Point& p1, const Point& p2, const UnsignedLength& width,
+                 const tl::optional<Uuid>& net = tl::nullopt) noexcept;
+
+  /**
+   * @brief Add a filled area (e.g. a pad)
+   *
+   * @param outline The closed outline of the area. Empty paths are ignored.
+   *                Holes need to be connected to the outline by cut-ins
+   *                (see ::librepcb::ClipperHelpers::flattenTree()), otherwise
+   *                they are not excluded from the area.
+   * @param net     UUID of the net the area belongs to, if any.
+   * @return        ID of the added obstacle, see #remove().
+   */
+  int addArea(const ClipperLib::Path& outline,
+              const tl::optional<Uuid>& net = tl::nullopt) noexcept;
+
+  /**
+   * @brief Remove a previously added obstacle
+   *
+   * @param id      ID returned by #addSegment() or #addArea().
+   */
+  void remove(int id) noexcept;
+
+  /**
+   * @brief Remove all obstacles
+   */
+  void clear() noexcept;
+
+  /**
+   * @brief Check if a trace would keep the clearance to all obstacles
+   *
+   * @param p1        Start point of the trace.
+   * @param p2        End point of the trace.
+   * @param width     Width of the trace.
+   * @param clearance Minimum required clearance to the obstacles.
+   * @param net       UUID of the net of the trace, if any. Obstacles of the
+   *                  same net are ignored.
+   * @return          True if there is no clearance violation.
+   */
+  bool isFree(const Point& p1, const Point& p2, const PositiveLength& width,
+              const UnsignedLength& clearance,
+              const tl::optional<Uuid>& net = tl::nullopt) const noexcept;
+
+  /**
+   * @brief Find out how far a trace can be drawn without a clearance violation
+   *
+   * @param p1        Start point of the trace.
+   * @param p2        Desired end point of the trace.
+   * @param width     Width of the trace.
+   * @param clearance Minimum required clearance to the obstacles.
+   * @param net       UUID of the net of the trace, if any. Obstacles of the
+   *                  same net are ignored.
+   * @return          The point on the line `p1`-`p2` closest to `p2` which
+   *                  can be reached without a clearance violation. If `p1`
+   *                  itself is already in conflict with an obstacle, `p2` is
+   *                  returned since the trace could not be restricted in a
+   *                  meaningful way anyway.
+   */
+  Point findLastFreePoint(
+      const Point& p1, const Point& p2, const PositiveLength& width,
+      const UnsignedLength& clearance,
+      const tl::optional<Uuid>& net = tl::nullopt) const noexcept;
+
+  // Operator Overloadings
+  TraceObstacleIndex& operator=(const TraceObstacleIndex& rhs) = delete;
+
+private:  // Types
+  struct Obstacle {
+    QVector<Point> vertices;  ///< Segment end points or area outline
+    ClipperLib::Path outline;  ///< Only for areas (for inside test)
+    Length radius;  ///< Zero for areas
+    tl::optional<Uuid> net;  ///< Net of the obstacle, if any
+    Point min;  ///< Bounding box including radius
+    Point max;  ///< Bounding box including radius
+  };
+  typedef QPair<int, int> Cell;
+
+private:  // Methods
+  int add(const Obstacle& obstacle) noexcept;
+  bool getCells(const Point& min, const Point& max, int& x1, int& y1, int& x2,
+                int& y2) const noexcept;
+  static Length getDistance(const Obstacle& obstacle, const Point& p1,
+                            const Point& p2) noexcept;
+
+private:  // Data
+  Length mCellSize;
+  int mNextId;
+  QHash<int, Obstacle> mObstacles;
+  QHash<Cell, QVector<int>> mCells;
+
+  /// Obstacles covering too many cells, they are always checked
+  QSet<int> mLargeObstacles;
+
+  /// Max. number of cells an obstacle may cover before it is considered large
+  static constexpr int sMaxCellsPerObstacle = 256;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
@@ -0,0 +1,219 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "tracepathfinder.h"
+
+#include "traceobstacleindex.h"
+
+#include <QtCore>
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+TracePathFinder::TracePathFinder(
+    const QVector<const TraceObstacleIndex*>& layers,
+    const PositiveLength& traceWidth, const PositiveLength& viaSize,
+    const UnsignedLength& clearance,
+    const PositiveLength& gridInterval) noexcept
+  : mLayers(layers),
+    mTraceWidth(traceWidth),
+    mViaSize(viaSize),
+    mClearance(clearance),
+    mGridInterval(gridInterval),
+    mMaxDetour(50),
+    mMaxExpansions(200000),
+    mViaCost(10) {
+}
+
+TracePathFinder::~TracePathFinder() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+bool TracePathFinder::findPath(const Point& start,
+                               const QVector<bool>& startLayers,
+                               const Point& goal,
+                               const QVector<bool>& goalLayers,
+                               const tl::optional<Uuid>& net,
+                               QVector<Vertex>& path) const noexcept {
+  Q_ASSERT(startLayers.count() == mLayers.count());
+  Q_ASSERT(goalLayers.count() == mLayers.count());
+  const Length grid = *mGridInterval;
+
+  // The grid is aligned to the start point, with the search area limited to
+  // the bounding box of start and goal plus some space for detours.
+  const int goalX = qRound((goal.getX() - start.getX()).toNm() /
+                           static_cast<qreal>(grid.toNm()));
+  const int goalY = qRound((goal.getY() - start.getY()).toNm() /
+                           static_cast<qreal>(grid.toNm()));
+  const int minX = std::min(0, goalX) - mMaxDetour;
+  const int maxX = std::max(0, goalX) + mMaxDetour;
+  const int minY = std::min(0, goalY) - mMaxDetour;
+  const int maxY = std::max(0, goalY) + mMaxDetour;
+  if (((maxX - minX) > 0xFFFF) || ((maxY - minY) > 0xFFFF)) {
+    return false;  // Too far away for a maze search.
+  }
+  auto key = [&](int x, int y, int layer) {
+    return (static_cast<qint64>(layer) << 32) |
+        (static_cast<qint64>(x - minX) << 16) | static_cast<qint64>(y - minY);
+  };
+  auto position = [&](int x, int y) {
+    return start + Point(grid * x, grid * y);
+  };
+  auto heuristic = [&](int x, int y, int layer) {
+    const int dx = std::abs(goalX - x);
+    const int dy = std::abs(goalY - y);
+    return std::max(dx, dy) + (M_SQRT2 - 1) * std::min(dx, dy) +
+        (goalLayers.at(layer) ? 0 : mViaCost);
+  };
+
+  struct Node {
+    qreal estimate;
+    qreal cost;
+    int x;
+    int y;
+    int layer;
+    bool operator>(const Node& rhs) const noexcept {
+      return estimate > rhs.estimate;
+    }
+  };
+  std::priority_queue<Node, std::vector<Node>, std::greater<Node>> queue;
+  QHash<qint64, qreal> costs;
+  QHash<qint64, qint64> parents;
+  QHash<qint64, bool> viaFree;
+  auto visit = [&](int x, int y, int layer, qreal cost, qint64 parent) {
+    const qint64 k = key(x, y, layer);
+    auto it = costs.find(k);
+    if ((it == costs.end()) || (cost < *it)) {
+      costs.insert(k, cost);
+      if (parent >= 0) {
+        parents.insert(k, parent);
+      }
+      queue.push(Node{cost + heuristic(x, y, layer), cost, x, y, layer});
+    }
+  };
+  for (int i = 0; i < mLayers.count(); ++i) {
+    if (startLayers.at(i)) {
+      visit(0, 0, i, 0, -1);
+    }
+  }
+
+  int expansions = 0;
+  while ((!queue.empty()) && (expansions < mMaxExpansions)) {
+    const Node node = queue.top();
+    queue.pop();
+    const qint64 k = key(node.x, node.y, node.layer);
+    if (node.cost > costs.value(k)) {
+      continue;  // Outdated entry, node was reached on a cheaper path.
+    }
+    ++expansions;
+    const TraceObstacleIndex& obstacles = *mLayers.at(node.layer);
+    const Point pos = position(node.x, node.y);
+
+    // Goal reached?
+    if (goalLayers.at(node.layer) && (std::abs(goalX - node.x) <= 1) &&
+        (std::abs(goalY - node.y) <= 1) &&
+        obstacles.isFree(pos, goal, mTraceWidth, mClearance, net)) {
+      path = {Vertex{goal, node.layer}};
+      qint64 current = k;
+      while (true) {
+        const int layer = static_cast<int>(current >> 32);
+        const int x = static_cast<int>((current >> 16) & 0xFFFF) + minX;
+        const int y = static_cast<int>(current & 0xFFFF) + minY;
+        path.prepend(Vertex{position(x, y), layer});
+        auto parent = parents.find(current);
+        if (parent == parents.end()) {
+          break;
+        }
+        current = *parent;
+      }
+      return true;
+    }
+
+    // Continue on the same layer.
+    for (int dx = -1; dx <= 1; ++dx) {
+      for (int dy = -1; dy <= 1; ++dy) {
+        const int x = node.x + dx;
+        const int y = node.y + dy;
+        if (((dx == 0) && (dy == 0)) || (x < minX) || (x > maxX) ||
+            (y < minY) || (y > maxY)) {
+          continue;
+        }
+        if (obstacles.isFree(pos, position(x, y), mTraceWidth, mClearance,
+                             net)) {
+          const qreal step = ((dx != 0) && (dy != 0)) ? M_SQRT2 : 1;
+          visit(x, y, node.layer, node.cost + step, k);
+        }
+      }
+    }
+
+    // Change the layer with a via (but not at the start or goal point).
+    if ((mLayers.count() > 1) && ((node.x != 0) || (node.y != 0)) &&
+        (pos != goal)) {
+      const qint64 viaKey = key(node.x, node.y, 0);
+      auto it = viaFree.find(viaKey);
+      if (it == viaFree.end()) {
+        it = viaFree.insert(viaKey, isViaFree(pos, net));
+      }
+      if (*it) {
+        for (int i = 0; i < mLayers.count(); ++i) {
+          if (i != node.layer) {
+            visit(node.x, node.y, i, node.cost + mViaCost, k);
+          }
+        }
+      }
+    }
+  }
+  return false;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+bool TracePathFinder::isViaFree(const Point& pos,
+                                const tl::optional<Uuid>& net) const noexcept {
+  foreach (const TraceObstacleIndex* obstacles, mLayers) {
+    if (!obstacles->isFree(pos, pos, mViaSize, mClearance, net)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
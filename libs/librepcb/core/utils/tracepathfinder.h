@@ -0,0 +1,150 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_TRACEPATHFINDER_H
+#define LIBREPCB_CORE_TRACEPATHFINDER_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../types/length.h"
+#include "../types/point.h"
+#include "../types/uuid.h"
+
+#include <optional/tl/optional.hpp>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class TraceObstacleIndex;
+
+/*******************************************************************************
+ *  Class TracePathFinder
+ ******************************************************************************/
+
+/**
+ * @brief Finds collision-free trace paths through several copper layers
+ *
+ * The path is searched with an A* maze search on a grid (with 45° steps)
+ * aligned to the start point. Each layer is represented by a
+ * ::librepcb::TraceObstacleIndex, and layers can be changed by through-hole
+ * vias at any grid point where a via keeps the clearance on all layers.
+ *
+ * The obstacle indices are referenced, not copied, so obstacles added to
+ * them between two searches are taken into account.
+ */
+class TracePathFinder final {
+public:
+  // Types
+  struct Vertex {
+    Point position;
+    int layer;  ///< Index into the layers passed to the constructor
+  };
+
+  // Constructors / Destructor
+  TracePathFinder() = delete;
+  TracePathFinder(const TracePathFinder& other) = delete;
+  TracePathFinder(const QVector<const TraceObstacleIndex*>& layers,
+                  const PositiveLength& traceWidth,
+                  const PositiveLength& viaSize,
+                  const UnsignedLength& clearance,
+                  const PositiveLength& gridInterval) noexcept;
+  ~TracePathFinder() noexcept;
+
+  // Getters
+  int getMaxDetour() const noexcept { return mMaxDetour; }
+  int getMaxExpansions() const noexcept { return mMaxExpansions; }
+  int getViaCost() const noexcept { return mViaCost; }
+
+  // Setters
+
+  /**
+   * @brief Set how far a path may leave the bounding box of start and goal
+   *
+   * @param steps   Max. number of grid steps (default: 50).
+   */
+  void setMaxDetour(int steps) noexcept { mMaxDetour = steps; }
+
+  /**
+   * @brief Set after how many visited nodes a search gives up
+   *
+   * @param expansions  Max. number of visited nodes (default: 200000).
+   */
+  void setMaxExpansions(int expansions) noexcept {
+    mMaxExpansions = expansions;
+  }
+
+  /**
+   * @brief Set the cost of a layer change
+   *
+   * @param cost    Cost of a via, in grid steps (default: 10).
+   */
+  void setViaCost(int cost) noexcept { mViaCost = cost; }
+
+  // General Methods
+
+  /**
+   * @brief Search the cheapest path between two points
+   *
+   * @param start       Start point.
+   * @param startLayers For each layer, whether the path may start on it.
+   * @param goal        Goal point (does not need to be on the grid).
+   * @param goalLayers  For each layer, whether the path may end on it.
+   * @param net         UUID of the net of the trace, if any. Obstacles of the
+   *                    same net are ignored.
+   * @param path        The found path, starting at `start` and ending at
+   *                    `goal`. Consecutive vertices at the same position
+   *                    on different layers denote a via. Not modified if no
+   *                    path was found.
+   * @return            Whether a path was found within the configured limits.
+   */
+  bool findPath(const Point& start, const QVector<bool>& startLayers,
+                const Point& goal, const QVector<bool>& goalLayers,
+                const tl::optional<Uuid>& net, QVector<Vertex>& path) const
+      noexcept;
+
+  // Operator Overloadings
+  TracePathFinder& operator=(const TracePathFinder& rhs) = delete;
+
+private:  // Methods
+  bool isViaFree(const Point& pos, const tl::optional<Uuid>& net) const
+      noexcept;
+
+private:  // Data
+  QVector<const TraceObstacleIndex*> mLayers;
+  PositiveLength mTraceWidth;
+  PositiveLength mViaSize;
+  UnsignedLength mClearance;
+  PositiveLength mGridInterval;
+  int mMaxDetour;
+  int mMaxExpansions;
+  int mViaCost;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
@@ -35,6 +35,7 @@
 #include "../sqlitedatabase.h"
 #include "workspacelibrarydbwriter.h"
 #include "workspacelibraryscanner.h"
+#include "workspacelibrarywatcher.h"
 
 #include <QtCore>
 #include <QtSql>
@@ -89,6 +90,20 @@ WorkspaceLibraryDb::WorkspaceLibraryDb(const FilePath& librariesPath)
   connect(mLibraryScanner.data(), &WorkspaceLibraryScanner::scanFinished, this,
           &WorkspaceLibraryDb::scanFinished, Qt::QueuedConnection);
 
+  // watch for external modifications (e.g. by Git), the watched directories
+  // are determined by each full scan in the worker thread
+  mLibraryWatcher.reset(new WorkspaceLibraryWatcher(mLibrariesPath));
+  connect(mLibraryScanner.data(),
+          &WorkspaceLibraryScanner::libraryDirectoriesScanned,
+          mLibraryWatcher.data(),
+          &WorkspaceLibraryWatcher::setWatchedDirectories,
+          Qt::QueuedConnection);
+  connect(mLibraryWatcher.data(), &WorkspaceLibraryWatcher::librariesModified,
+          this, &WorkspaceLibraryDb::startLibraryRescan);
+  connect(mLibraryWatcher.data(), &WorkspaceLibraryWatcher::elementsModified,
+          mLibraryScanner.data(),
+          &WorkspaceLibraryScanner::startIncrementalScan);
+
   qDebug("Successfully loaded workspace library database.");
 }
 
@@ -411,6 +426,87 @@ QSet<Uuid> WorkspaceLibraryDb::getByCategory(const QString& elementsTable,
   return getUuidSet(query);
 }
 
+QList<WorkspaceLibraryDb::CategoryTreeEntry>
+    WorkspaceLibraryDb::getCategoryTree(const QString& categoriesTable,
+                                        const QStringList& localeOrder) const {
+  QSqlQuery query = mDb->prepareQuery(
+      "SELECT tree.uuid, tree.parent_uuid, tree.symbols, tree.packages, "
+      "tree.components, tree.devices, %categories.version, "
+      "%categories_tr.locale, %categories_tr.name, "
+      "%categories_tr.description "
+      "FROM %categories_tree AS tree "
+      "LEFT JOIN %categories ON %categories.uuid = tree.uuid "
+      "LEFT JOIN %categories_tr "
+      "ON %categories.id = %categories_tr.element_id",
+      {
+          {"%categories", categoriesTable},
+      });
+  mDb->exec(query);
+
+  // Since the query returns a row per category version and locale, collect
+  // the entries and the translations of the latest versions separately.
+  struct Translations {
+    tl::optional<Version> version;
+    QHash<QString, QString> names;  ///< Locale -> Name
+    QHash<QString, QString> descriptions;  ///< Locale -> Description
+  };
+  QList<CategoryTreeEntry> entries;
+  QSet<QPair<QString, QString>> entryKeys;
+  QHash<QString, Translations> translations;
+  while (query.next()) {
+    const QString uuid = query.value(0).toString();
+    const QString parent = query.value(1).toString();
+    if (!entryKeys.contains(qMakePair(uuid, parent))) {
+      entryKeys.insert(qMakePair(uuid, parent));
+      entries.append(CategoryTreeEntry{
+          uuid.isNull() ? tl::nullopt
+                        : tl::make_optional(Uuid::fromString(uuid)),
+          parent.isNull() ? tl::nullopt
+                          : tl::make_optional(Uuid::fromString(parent)),
+          QString(), QString(), query.value(2).toInt(),
+          query.value(3).toInt(), query.value(4).toInt(),
+          query.value(5).toInt()});  // can throw
+    }
+
+    const tl::optional<Version> version =
+        Version::tryFromString(query.value(6).toString());
+    const QString locale = query.value(7).toString();
+    if ((!version) || locale.isNull()) {
+      continue;  // No translations.
+    }
+    Translations& tr = translations[uuid];
+    if ((!tr.version) || (*version > *tr.version)) {
+      tr = Translations{version, {}, {}};
+    }
+    if (*version == *tr.version) {
+      const QString name = query.value(8).toString();
+      const QString description = query.value(9).toString();
+      if (!name.isNull()) tr.names.insert(locale, name);
+      if (!description.isNull()) tr.descriptions.insert(locale, description);
+    }
+  }
+
+  // Same locale fallback as in LocalizedDescriptionMap::value().
+  auto getValue = [&localeOrder](const QHash<QString, QString>& values)
+      -> QString {
+    foreach (const QString& locale, localeOrder) {
+      auto it = values.find(locale);
+      if (it != values.end()) {
+        return *it;
+      }
+    }
+    return values.value(QString(""));
+  };
+  for (CategoryTreeEntry& entry : entries) {
+    if (entry.uuid) {
+      const Translations tr = translations.value(entry.uuid->toStr());
+      entry.name = getValue(tr.names);
+      entry.description = getValue(tr.descriptions);
+    }
+  }
+  return entries;
+}
+
 QSet<Uuid> WorkspaceLibraryDb::getUuidSet(QSqlQuery& query) {
   QSet<Uuid> uuids;
   while (query.next()) {
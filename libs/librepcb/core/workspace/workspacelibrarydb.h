@@ -44,6 +44,7 @@ class PackageCategory;
 class SQLiteDatabase;
 class Symbol;
 class WorkspaceLibraryScanner;
+class WorkspaceLibraryWatcher;
 
 /*******************************************************************************
  *  Class WorkspaceLibraryDb
@@ -51,11 +52,35 @@ class WorkspaceLibraryScanner;
 
 /**
  * @brief The WorkspaceLibraryDb class
+ *
+ * The database is updated in a worker thread, either by a full rescan
+ * requested with #startLibraryRescan(), or automatically when the libraries
+ * directory is modified externally (e.g. by `git pull`). In the latter case,
+ * only the modified library elements are updated.
  */
 class WorkspaceLibraryDb final : public QObject {
   Q_OBJECT
 
 public:
+  // Types
+
+  /**
+   * @brief An entry of the category tree, see #getCategoryTree()
+   *
+   * The element counts include all elements of subcategories, each element
+   * (UUID) counted only once.
+   */
+  struct CategoryTreeEntry {
+    tl::optional<Uuid> uuid;  ///< tl::nullopt for elements without category
+    tl::optional<Uuid> parent;  ///< tl::nullopt for root categories
+    QString name;  ///< Name of the latest version, empty if not found
+    QString description;  ///< Description of the latest version
+    int symbols;  ///< Number of symbols in the category
+    int packages;  ///< Number of packages in the category
+    int components;  ///< Number of components in the category
+    int devices;  ///< Number of devices in the category
+  };
+
   // Constructors / Destructor
   WorkspaceLibraryDb() = delete;
   WorkspaceLibraryDb(const WorkspaceLibraryDb& other) = delete;
@@ -263,6 +288,33 @@ public:
     return getChilds(getTable<ElementType>(), parent);
   }
 
+  /**
+   * @brief Get the whole category tree including element counts
+   *
+   * Loads the tree which was materialized during the library scan with a
+   * single query. This is much faster than walking through the tree with
+   * #getChilds() and #getByCategory().
+   *
+   * @tparam ElementType  Type of the category.
+   *
+   * @param localeOrder   Locale order (highest priority first) for the
+   *                      returned names and descriptions.
+   *
+   * @return  All parent/child relations of the categories (a category is
+   *          contained multiple times if its versions have different parents),
+   *          including one entry without UUID containing the number of
+   *          elements with no (existent) category. Categories whose parent
+   *          does not exist are returned as root categories.
+   */
+  template <typename ElementType>
+  QList<CategoryTreeEntry> getCategoryTree(
+      const QStringList& localeOrder) const {
+    static_assert(std::is_same<ElementType, ComponentCategory>::value ||
+                      std::is_same<ElementType, PackageCategory>::value,
+                  "Unsupported ElementType");
+    return getCategoryTree(getTable<ElementType>(), localeOrder);
+  }
+
   /**
    * @brief Get elements of a specific category
    *
@@ -305,6 +357,9 @@ public:
 
   /**
    * @brief Rescan the whole library directory and update the SQLite database
+   *
+   * @note  Also updates the list of directories watched for external
+   *        modifications.
    */
   void startLibraryRescan() noexcept;
 
@@ -340,6 +395,8 @@ private:
   QSet<Uuid> getByCategory(const QString& elementsTable,
                            const QString& categoryTable,
                            const tl::optional<Uuid>& category, int limit) const;
+  QList<CategoryTreeEntry> getCategoryTree(
+      const QString& categoriesTable, const QStringList& localeOrder) const;
   static QSet<Uuid> getUuidSet(QSqlQuery& query);
   int getDbVersion() const noexcept;
   template <typename ElementType>
@@ -352,9 +409,10 @@ private:
   const FilePath mFilePath;  ///< Path to the SQLite database file.
   QScopedPointer<SQLiteDatabase> mDb;  ///< The SQLite database.
   QScopedPointer<WorkspaceLibraryScanner> mLibraryScanner;
+  QScopedPointer<WorkspaceLibraryWatcher> mLibraryWatcher;
 
   // Constants
-  static const int sCurrentDbVersion = 3;
+  static const int sCurrentDbVersion = 4;
 };
 
 /*******************************************************************************
@@ -22,6 +22,7 @@
  ******************************************************************************/
 #include "workspacelibrarydbwriter.h"
 
+#include "../exceptions.h"
 #include "../library/cat/componentcategory.h"
 #include "../library/cat/packagecategory.h"
 #include "../library/cmp/component.h"
@@ -47,7 +48,7 @@ namespace librepcb {
 
 WorkspaceLibraryDbWriter::WorkspaceLibraryDbWriter(
     const FilePath& librariesRoot, SQLiteDatabase& db)
-  : mLibrariesRoot(librariesRoot), mDb(db) {
+  : mLibrariesRoot(librariesRoot), mDb(db), mBulkLoad(false) {
 }
 
 WorkspaceLibraryDbWriter::~WorkspaceLibraryDbWriter() noexcept {
@@ -261,15 +262,71 @@ void WorkspaceLibraryDbWriter::createAllTables() {
       "UNIQUE(element_id, category_uuid)"
       ")");
 
+  // category trees, see updateCategoryTree()
+  queries << QString(
+      "CREATE TABLE IF NOT EXISTS component_categories_tree ("
+      "`id` INTEGER PRIMARY KEY NOT NULL, "
+      "`uuid` TEXT, "
+      "`parent_uuid` TEXT, "
+      "`symbols` INTEGER NOT NULL, "
+      "`packages` INTEGER NOT NULL, "
+      "`components` INTEGER NOT NULL, "
+      "`devices` INTEGER NOT NULL, "
+      "UNIQUE(uuid, parent_uuid)"
+      ")");
+  queries << QString(
+      "CREATE TABLE IF NOT EXISTS package_categories_tree ("
+      "`id` INTEGER PRIMARY KEY NOT NULL, "
+      "`uuid` TEXT, "
+      "`parent_uuid` TEXT, "
+      "`symbols` INTEGER NOT NULL, "
+      "`packages` INTEGER NOT NULL, "
+      "`components` INTEGER NOT NULL, "
+      "`devices` INTEGER NOT NULL, "
+      "UNIQUE(uuid, parent_uuid)"
+      ")");
+
   // execute queries
   foreach (const QString& string, queries) {
     QSqlQuery query = mDb.prepareQuery(string);
     mDb.exec(query);
   }
+
+  createAllIndices();
+}
+
+void WorkspaceLibraryDbWriter::createAllIndices() {
+  foreach (const auto& index, getIndices()) {
+    mDb.exec("CREATE INDEX IF NOT EXISTS " % index.first % " ON " %
+             index.second);
+  }
+}
+
+void WorkspaceLibraryDbWriter::beginBulkLoad() {
+  if (mBulkLoad) {
+    throw LogicError(__FILE__, __LINE__, "Bulk load already started.");
+  }
+  foreach (const auto& index, getIndices()) {
+    mDb.exec("DROP INDEX IF EXISTS " % index.first);
+  }
+  mBulkLoad = true;
+}
+
+void WorkspaceLibraryDbWriter::endBulkLoad() {
+  if (!mBulkLoad) {
+    throw LogicError(__FILE__, __LINE__, "Bulk load not started.");
+  }
+  for (auto it = mPendingRows.begin(); it != mPendingRows.end(); ++it) {
+    flushPendingRows(*it);
+  }
+  mPendingRows.clear();
+  mBulkLoad = false;
+  createAllIndices();
+  mDb.analyze();
 }
 
 void WorkspaceLibraryDbWriter::addInternalData(const QString& key, int value) {
-  QSqlQuery query = mDb.prepareQuery(
+  QSqlQuery& query = prepareQuery(
       "INSERT INTO internal (key, value_int) "
       "VALUES (:key, :version)");
   query.bindValue(":key", key);
@@ -281,7 +338,7 @@ int WorkspaceLibraryDbWriter::addLibrary(const FilePath& fp, const Uuid& uuid,
                                          const Version& version,
                                          bool deprecated,
                                          const QByteArray& iconPng) {
-  QSqlQuery query = mDb.prepareQuery(
+  QSqlQuery& query = prepareQuery(
       "INSERT INTO libraries "
       "(filepath, uuid, version, deprecated, icon_png) VALUES "
       "(:filepath, :uuid, :version, :deprecated, :icon_png)");
@@ -298,7 +355,7 @@ void WorkspaceLibraryDbWriter::updateLibrary(const FilePath& fp,
                                              const Version& version,
                                              bool deprecated,
                                              const QByteArray& iconPng) {
-  QSqlQuery query = mDb.prepareQuery(
+  QSqlQuery& query = prepareQuery(
       "UPDATE libraries "
       "SET uuid = :uuid, version = :version, deprecated = :deprecated, "
       "icon_png = :icon_png "
@@ -316,7 +373,7 @@ int WorkspaceLibraryDbWriter::addDevice(int libId, const FilePath& fp,
                                         const Version& version, bool deprecated,
                                         const Uuid& component,
                                         const Uuid& package) {
-  QSqlQuery query = mDb.prepareQuery(
+  QSqlQuery& query = prepareQuery(
       "INSERT INTO devices "
       "(library_id, filepath, uuid, version, deprecated, component_uuid, "
       "package_uuid) VALUES "
@@ -396,12 +453,95 @@ QString WorkspaceLibraryDbWriter::getCategoryTable<Device>() noexcept {
  *  Private Methods
  ******************************************************************************/
 
+QSqlQuery& WorkspaceLibraryDbWriter::prepareQuery(
+    const QString& query, const SQLiteDatabase::Replacements& replacements) {
+  QString sql = query;
+  for (auto it = replacements.begin(); it != replacements.end(); it++) {
+    sql.replace(it->first, it->second);
+  }
+  auto it = mQueries.find(sql);
+  if (it == mQueries.end()) {
+    it = mQueries.insert(sql, mDb.prepareQuery(sql));  // can throw
+  }
+  return *it;
+}
+
+void WorkspaceLibraryDbWriter::insertRow(const QString& table,
+                                         const QStringList& columns,
+                                         const QVariantList& values) {
+  Q_ASSERT(values.count() == columns.count());
+  if (mBulkLoad) {
+    PendingRows& rows = mPendingRows[table];
+    if (rows.values.count() + values.count() > sMaxBindValues) {
+      flushPendingRows(rows);  // can throw
+    }
+    rows.table = table;
+    rows.columns = columns;
+    rows.values.append(values);
+  } else {
+    PendingRows rows{table, columns, values};
+    flushPendingRows(rows);  // can throw
+  }
+}
+
+void WorkspaceLibraryDbWriter::flushPendingRows(PendingRows& rows) {
+  const int columnCount = rows.columns.count();
+  if ((columnCount == 0) || rows.values.isEmpty()) {
+    return;
+  }
+  QStringList placeholders;
+  for (int i = 0; i < columnCount; ++i) {
+    placeholders.append("?");
+  }
+  QStringList rowPlaceholders;
+  for (int i = 0; i < rows.values.count() / columnCount; ++i) {
+    rowPlaceholders.append("(" % placeholders.join(", ") % ")");
+  }
+  QSqlQuery& query = prepareQuery("INSERT INTO " % rows.table % " (" %
+                                  rows.columns.join(", ") % ") VALUES " %
+                                  rowPlaceholders.join(", "));  // can throw
+  for (int i = 0; i < rows.values.count(); ++i) {
+    query.bindValue(i, rows.values.at(i));
+  }
+  rows.values.clear();
+  mDb.exec(query);  // can throw
+}
+
+QVector<std::pair<QString, QString>> WorkspaceLibraryDbWriter::getIndices()
+    const noexcept {
+  QVector<std::pair<QString, QString>> indices;  // Name -> Definition
+  const QStringList categoryTables = {
+      getElementTable<ComponentCategory>(),
+      getElementTable<PackageCategory>(),
+  };
+  foreach (const QString& table, categoryTables) {
+    indices.append(std::make_pair(table + "_uuid", table + "(uuid)"));
+    indices.append(
+        std::make_pair(table + "_parent_uuid", table + "(parent_uuid)"));
+  }
+  const QStringList elementTables = {
+      getElementTable<Symbol>(),
+      getElementTable<Package>(),
+      getElementTable<Component>(),
+      getElementTable<Device>(),
+  };
+  foreach (const QString& table, elementTables) {
+    indices.append(std::make_pair(table + "_uuid", table + "(uuid)"));
+    indices.append(std::make_pair(table + "_cat_category_uuid",
+                                  table + "_cat(category_uuid)"));
+  }
+  indices.append(
+      std::make_pair(QString("devices_component_uuid"),
+                     QString("devices(component_uuid)")));
+  return indices;
+}
+
 int WorkspaceLibraryDbWriter::addElement(const QString& elementsTable,
                                          int libId, const FilePath& fp,
                                          const Uuid& uuid,
                                          const Version& version,
                                          bool deprecated) {
-  QSqlQuery query = mDb.prepareQuery(
+  QSqlQuery& query = prepareQuery(
       "INSERT INTO %elements "
       "(library_id, filepath, uuid, version, deprecated) VALUES "
       "(:library_id, :filepath, :uuid, :version, :deprecated)",
@@ -422,7 +562,7 @@ int WorkspaceLibraryDbWriter::addCategory(const QString& categoriesTable,
                                           const Version& version,
                                           bool deprecated,
                                           const tl::optional<Uuid>& parent) {
-  QSqlQuery query = mDb.prepareQuery(
+  QSqlQuery& query = prepareQuery(
       "INSERT INTO %categories "
       "(library_id, filepath, uuid, version, deprecated, parent_uuid) VALUES "
       "(:library_id, :filepath, :uuid, :version, :deprecated, :parent_uuid)",
@@ -441,7 +581,7 @@ int WorkspaceLibraryDbWriter::addCategory(const QString& categoriesTable,
 
 void WorkspaceLibraryDbWriter::removeElement(const QString& elementsTable,
                                              const FilePath& fp) {
-  QSqlQuery query = mDb.prepareQuery(
+  QSqlQuery& query = prepareQuery(
       "DELETE FROM %elements "
       "WHERE filepath = :filepath",
       {
@@ -455,26 +595,20 @@ void WorkspaceLibraryDbWriter::removeAllElements(const QString& elementsTable) {
   mDb.clearTable(elementsTable);
 }
 
-int WorkspaceLibraryDbWriter::addTranslation(
+void WorkspaceLibraryDbWriter::addTranslation(
     const QString& elementsTable, int elementId, const QString& locale,
     const tl::optional<ElementName>& name,
     const tl::optional<QString>& description,
     const tl::optional<QString>& keywords) {
-  QSqlQuery query = mDb.prepareQuery(
-      "INSERT INTO %elements_tr "
-      "(element_id, locale, name, description, keywords) VALUES "
-      "(:element_id, :locale, :name, :description, :keywords)",
-      {
-          {"%elements", elementsTable},
-      });
-  query.bindValue(":element_id", elementId);
-  query.bindValue(":locale", locale);
-  query.bindValue(":name", name ? **name : QVariant(QVariant::String));
-  query.bindValue(":description",
-                  description ? *description : QVariant(QVariant::String));
-  query.bindValue(":keywords",
-                  keywords ? *keywords : QVariant(QVariant::String));
-  return mDb.insert(query);
+  insertRow(elementsTable % "_tr",
+            {"element_id", "locale", "name", "description", "keywords"},
+            {
+                elementId,
+                locale,
+                name ? **name : QVariant(QVariant::String),
+                description ? *description : QVariant(QVariant::String),
+                keywords ? *keywords : QVariant(QVariant::String),
+            });
 }
 
 void WorkspaceLibraryDbWriter::removeAllTranslations(
@@ -482,19 +616,99 @@ void WorkspaceLibraryDbWriter::removeAllTranslations(
   mDb.clearTable(elementsTable % "_tr");
 }
 
-int WorkspaceLibraryDbWriter::addToCategory(const QString& elementsTable,
-                                            int elementId,
-                                            const Uuid& category) {
+void WorkspaceLibraryDbWriter::addToCategory(const QString& elementsTable,
+                                             int elementId,
+                                             const Uuid& category) {
+  insertRow(elementsTable % "_cat", {"element_id", "category_uuid"},
+            {elementId, category.toStr()});
+}
+
+void WorkspaceLibraryDbWriter::updateCategoryTree(
+    const QString& categoriesTable) {
+  // Element tables in the order of the count columns, with their category
+  // table.
+  const QVector<std::pair<QString, QString>> elementTables = {
+      std::make_pair(getElementTable<Symbol>(), getCategoryTable<Symbol>()),
+      std::make_pair(getElementTable<Package>(), getCategoryTable<Package>()),
+      std::make_pair(getElementTable<Component>(),
+                     getCategoryTable<Component>()),
+      std::make_pair(getElementTable<Device>(), getCategoryTable<Device>()),
+  };
+
+  // Determine all ancestors of each category (including itself) recursively.
+  // Using UNION instead of UNION ALL terminates on circular parent relations.
+  QString ctes =
+      "WITH RECURSIVE ancestors(uuid, ancestor_uuid) AS ("
+      "SELECT uuid, uuid FROM %categories "
+      "UNION "
+      "SELECT ancestors.uuid, %categories.parent_uuid FROM ancestors "
+      "INNER JOIN %categories "
+      "ON %categories.uuid = ancestors.ancestor_uuid "
+      "WHERE %categories.parent_uuid IS NOT NULL"
+      ")";
+  QStringList treeCounts;
+  QStringList treeJoins;
+  QStringList uncategorizedCounts;
+  foreach (const auto& pair, elementTables) {
+    const QString& table = pair.first;
+    if (pair.second != categoriesTable) {
+      treeCounts.append("0");
+      uncategorizedCounts.append("0");
+      continue;
+    }
+
+    // Elements counted for each category they are located in, directly or in
+    // any subcategory.
+    ctes += ", " % table % "_count(uuid, element_count) AS ("
+        "SELECT ancestors.ancestor_uuid, COUNT(DISTINCT " % table % ".uuid) "
+        "FROM " % table % " "
+        "INNER JOIN " % table % "_cat "
+        "ON " % table % ".id = " % table % "_cat.element_id "
+        "INNER JOIN ancestors "
+        "ON ancestors.uuid = " % table % "_cat.category_uuid "
+        "GROUP BY ancestors.ancestor_uuid"
+        ")";
+    treeCounts.append("IFNULL(" % table % "_count.element_count, 0)");
+    treeJoins.append("LEFT JOIN " % table % "_count ON " % table %
+                     "_count.uuid = children.uuid");
+
+    // Elements with no (existent) category, same as in
+    // WorkspaceLibraryDb::getByCategory().
+    uncategorizedCounts.append(
+        "(SELECT COUNT(*) FROM (SELECT " % table % ".uuid FROM " % table % " "
+        "LEFT JOIN " % table % "_cat "
+        "ON " % table % ".id = " % table % "_cat.element_id "
+        "LEFT JOIN %categories "
+        "ON " % table % "_cat.category_uuid = %categories.uuid "
+        "GROUP BY " % table % ".uuid "
+        "HAVING COUNT(%categories.uuid) = 0))");
+  }
+
+  const SQLiteDatabase::Replacements replacements = {
+      {"%categories", categoriesTable},
+  };
+  mDb.clearTable(categoriesTable % "_tree");
+
+  // Categories with a non-existent parent are root categories.
   QSqlQuery query = mDb.prepareQuery(
-      "INSERT INTO %elements_cat "
-      "(element_id, category_uuid) VALUES "
-      "(:element_id, :category_uuid)",
-      {
-          {"%elements", elementsTable},
-      });
-  query.bindValue(":element_id", elementId);
-  query.bindValue(":category_uuid", category.toStr());
-  return mDb.insert(query);
+      ctes % " INSERT INTO %categories_tree "
+             "(uuid, parent_uuid, symbols, packages, components, devices) "
+             "SELECT children.uuid, parents.uuid, " %
+          treeCounts.join(", ") %
+          " FROM %categories AS children "
+          "LEFT JOIN %categories AS parents "
+          "ON children.parent_uuid = parents.uuid " %
+          treeJoins.join(" ") % " GROUP BY children.uuid, parents.uuid",
+      replacements);
+  mDb.exec(query);
+
+  query = mDb.prepareQuery(
+      "INSERT INTO %categories_tree "
+      "(uuid, parent_uuid, symbols, packages, components, devices) "
+      "VALUES (NULL, NULL, " %
+          uncategorizedCounts.join(", ") % ")",
+      replacements);
+  mDb.exec(query);
 }
 
 QString WorkspaceLibraryDbWriter::filePathToString(const FilePath& fp) const
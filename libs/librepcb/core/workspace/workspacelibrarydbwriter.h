@@ -24,11 +24,13 @@
  *  Includes
  ******************************************************************************/
 #include "../fileio/filepath.h"
+#include "../sqlitedatabase.h"
 #include "../types/elementname.h"
 
 #include <optional/tl/optional.hpp>
 
 #include <QtCore>
+#include <QtSql>
 
 /*******************************************************************************
  *  Namespace / Forward Declarations
@@ -40,7 +42,6 @@ class ComponentCategory;
 class Device;
 class Package;
 class PackageCategory;
-class SQLiteDatabase;
 class Symbol;
 class Uuid;
 class Version;
@@ -51,6 +52,13 @@ class Version;
 
 /**
  * @brief Database write functions for ::librepcb::WorkspaceLibraryDb
+ *
+ * Prepared statements are cached and reused for the whole lifetime of the
+ * writer, thus the writer must be destroyed before the database.
+ *
+ * For (re-)populating the whole database, the bulk load mode should be used
+ * (see #beginBulkLoad() and #endBulkLoad()) which is much faster than adding
+ * each row with a separate `INSERT` statement.
  */
 class WorkspaceLibraryDbWriter final {
 public:
@@ -69,6 +77,35 @@ public:
    */
   void createAllTables();
 
+  /**
+   * @brief Create all indices (if not existing yet)
+   *
+   * Already called by #createAllTables() and #endBulkLoad().
+   */
+  void createAllIndices();
+
+  /**
+   * @brief Start loading lots of elements at once
+   *
+   * Drops all indices to avoid updating them for every inserted row, and
+   * queues translations and category assignments to insert them in
+   * multi-row `INSERT` statements. Must be called within a transaction,
+   * and #endBulkLoad() must be called before committing it, otherwise the
+   * queued rows are lost.
+   *
+   * @note  While in bulk load mode, the queued translations and category
+   *        assignments are not yet visible in the database.
+   */
+  void beginBulkLoad();
+
+  /**
+   * @brief Finish the bulk load started with #beginBulkLoad()
+   *
+   * Writes all queued rows, recreates the indices and updates the query
+   * planner statistics.
+   */
+  void endBulkLoad();
+
   /**
    * @brief Add an integer value to the "internal" table
    *
@@ -200,15 +237,14 @@ public:
    * @param name          Element name.
    * @param description   Eleemnt description.
    * @param keywords      Element keywords.
-   * @return ID of the added translation.
    */
   template <typename ElementType>
-  int addTranslation(int elementId, const QString& locale,
-                     const tl::optional<ElementName>& name,
-                     const tl::optional<QString>& description,
-                     const tl::optional<QString>& keywords) {
-    return addTranslation(getElementTable<ElementType>(), elementId, locale,
-                          name, description, keywords);
+  void addTranslation(int elementId, const QString& locale,
+                      const tl::optional<ElementName>& name,
+                      const tl::optional<QString>& description,
+                      const tl::optional<QString>& keywords) {
+    addTranslation(getElementTable<ElementType>(), elementId, locale, name,
+                   description, keywords);
   }
 
   /**
@@ -227,16 +263,37 @@ public:
    * @tparam ElementType  Type of element to add to the category.
    * @param elementId     ID of the element to add to the category.
    * @param category      Category UUID.
-   * @return ID of the added category.
    */
   template <typename ElementType>
-  int addToCategory(int elementId, const Uuid& category) {
+  void addToCategory(int elementId, const Uuid& category) {
     static_assert(std::is_same<ElementType, Symbol>::value ||
                       std::is_same<ElementType, Package>::value ||
                       std::is_same<ElementType, Component>::value ||
                       std::is_same<ElementType, Device>::value,
                   "Unsupported ElementType");
-    return addToCategory(getElementTable<ElementType>(), elementId, category);
+    addToCategory(getElementTable<ElementType>(), elementId, category);
+  }
+
+  /**
+   * @brief Rebuild the materialized category tree of a category type
+   *
+   * Stores all parent/child relations of the categories, together with the
+   * number of elements within each category (including its subcategories)
+   * into the table "<categories>_tree". In addition, an entry with a NULL
+   * UUID holds the number of elements without any (existent) category. This
+   * allows to load the whole tree with a single query.
+   *
+   * @note  Must be called after all elements and categories are added.
+   *
+   * @tparam ElementType  Type of category (::librepcb::ComponentCategory or
+   *                      ::librepcb::PackageCategory).
+   */
+  template <typename ElementType>
+  void updateCategoryTree() {
+    static_assert(std::is_same<ElementType, ComponentCategory>::value ||
+                      std::is_same<ElementType, PackageCategory>::value,
+                  "Unsupported ElementType");
+    updateCategoryTree(getElementTable<ElementType>());
   }
 
   // Helper Functions
@@ -264,7 +321,22 @@ public:
   WorkspaceLibraryDbWriter& operator=(const WorkspaceLibraryDbWriter& rhs) =
       delete;
 
+private:  // Types
+  struct PendingRows {
+    QString table;
+    QStringList columns;
+    QVariantList values;  ///< Values of all rows, row by row
+  };
+
 private:  // Methods
+  QSqlQuery& prepareQuery(
+      const QString& query,
+      const SQLiteDatabase::Replacements& replacements = {});
+  void insertRow(const QString& table, const QStringList& columns,
+                 const QVariantList& values);
+  void flushPendingRows(PendingRows& rows);
+  QVector<std::pair<QString, QString>> getIndices() const noexcept;
+  void updateCategoryTree(const QString& categoriesTable);
   int addElement(const QString& elementsTable, int libId, const FilePath& fp,
                  const Uuid& uuid, const Version& version, bool deprecated);
   int addCategory(const QString& categoriesTable, int libId, const FilePath& fp,
@@ -272,19 +344,25 @@ private:  // Methods
                   const tl::optional<Uuid>& parent);
   void removeElement(const QString& elementsTable, const FilePath& fp);
   void removeAllElements(const QString& elementsTable);
-  int addTranslation(const QString& elementsTable, int elementId,
-                     const QString& locale,
-                     const tl::optional<ElementName>& name,
-                     const tl::optional<QString>& description,
-                     const tl::optional<QString>& keywords);
+  void addTranslation(const QString& elementsTable, int elementId,
+                      const QString& locale,
+                      const tl::optional<ElementName>& name,
+                      const tl::optional<QString>& description,
+                      const tl::optional<QString>& keywords);
   void removeAllTranslations(const QString& elementsTable);
-  int addToCategory(const QString& elementsTable, int elementId,
-                    const Uuid& category);
+  void addToCategory(const QString& elementsTable, int elementId,
+                     const Uuid& category);
   QString filePathToString(const FilePath& fp) const noexcept;
 
 private:  // Data
   FilePath mLibrariesRoot;
   SQLiteDatabase& mDb;
+  QHash<QString, QSqlQuery> mQueries;  ///< Cached prepared statements
+  bool mBulkLoad;
+  QHash<QString, PendingRows> mPendingRows;  ///< Key: Table name
+
+  /// Maximum number of values per statement (SQLITE_MAX_VARIABLE_NUMBER)
+  static const int sMaxBindValues = 999;
 };
 
 /*******************************************************************************
@@ -52,7 +52,10 @@ WorkspaceLibraryScanner::WorkspaceLibraryScanner(
     mDbFilePath(dbFilePath),
     mSemaphore(0),
     mAbort(false),
-    mLastProgressPercent(100) {
+    mLastProgressPercent(100),
+    mMutex(),
+    mFullScanRequested(false),
+    mPendingElementsDirs() {
   connect(this, &WorkspaceLibraryScanner::scanProgressUpdate, this,
           [this](int percent) { mLastProgressPercent = percent; },
           Qt::QueuedConnection);
@@ -77,9 +80,26 @@ WorkspaceLibraryScanner::~WorkspaceLibraryScanner() noexcept {
  ******************************************************************************/
 
 void WorkspaceLibraryScanner::startScan() noexcept {
+  {
+    QMutexLocker lock(&mMutex);
+    mFullScanRequested = true;
+    mPendingElementsDirs.clear();  // Covered by the full scan.
+    mPendingModifiedElements.clear();  // Covered by the full scan.
+  }
   mSemaphore.release();
 }
 
+void WorkspaceLibraryScanner::startIncrementalScan(
+    const QSet<FilePath>& elementsDirs,
+    const QSet<FilePath>& modifiedElements) noexcept {
+  QMutexLocker lock(&mMutex);
+  if (!mFullScanRequested) {
+    mPendingElementsDirs.unite(elementsDirs);
+    mPendingModifiedElements.unite(modifiedElements);
+    mSemaphore.release();
+  }
+}
+
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
@@ -91,14 +111,40 @@ void WorkspaceLibraryScanner::run() noexcept {
     mSemaphore.acquire();
     if (mAbort) {
       break;
-    } else {
+    }
+
+    // Take all pending requests at once. Multiple requests might have been
+    // accumulated, so some semaphore releases may find nothing to do.
+    bool fullScan = false;
+    QSet<FilePath> elementsDirs;
+    QSet<FilePath> modifiedElements;
+    {
+      QMutexLocker lock(&mMutex);
+      fullScan = mFullScanRequested;
+      mFullScanRequested = false;
+      elementsDirs = mPendingElementsDirs;
+      mPendingElementsDirs.clear();
+      modifiedElements = mPendingModifiedElements;
+      mPendingModifiedElements.clear();
+    }
+    if (fullScan) {
       scan();
+    } else if ((!elementsDirs.isEmpty()) || (!modifiedElements.isEmpty())) {
+      scanElements(elementsDirs, modifiedElements);
     }
   }
 
   qDebug() << "Workspace library scanner thread stopped.";
 }
 
+bool WorkspaceLibraryScanner::isAbortRequested() noexcept {
+  if (mAbort) {
+    return true;
+  }
+  QMutexLocker lock(&mMutex);
+  return mFullScanRequested;
+}
+
 void WorkspaceLibraryScanner::scan() noexcept {
   try {
     QElapsedTimer timer;
@@ -109,11 +155,18 @@ void WorkspaceLibraryScanner::scan() noexcept {
 
     // open SQLite database
     SQLiteDatabase db(mDbFilePath);  // can throw
+    db.setBulkLoadMode(true);  // can throw
     WorkspaceLibraryDbWriter writer(mLibrariesPath, db);
 
-    // update list of libraries
+    // determine directories to watch for external modifications
     std::shared_ptr<TransactionalFileSystem> fs =
         TransactionalFileSystem::openRO(mLibrariesPath);
+    QStringList watchedDirs;
+    getLibraryDirectories(fs, "local", watchedDirs);
+    getLibraryDirectories(fs, "remote", watchedDirs);
+    emit libraryDirectoriesScanned(watchedDirs);
+
+    // update list of libraries
     QList<std::shared_ptr<Library>> libraries;
     getLibrariesOfDirectory(fs, "local", libraries);
     getLibrariesOfDirectory(fs, "remote", libraries);
@@ -126,6 +179,7 @@ void WorkspaceLibraryScanner::scan() noexcept {
 
     // begin database transaction
     SQLiteDatabase::TransactionScopeGuard transactionGuard(db);  // can throw
+    writer.beginBulkLoad();  // can throw
 
     // clear all tables
     writer.removeAllElements<ComponentCategory>();
@@ -142,34 +196,37 @@ void WorkspaceLibraryScanner::scan() noexcept {
       FilePath fp = lib->getDirectory().getAbsPath();
       Q_ASSERT(libIds.contains(fp));
       int libId = libIds[fp];
-      if (mAbort || (mSemaphore.available() > 0)) break;
+      if (isAbortRequested()) break;
       count += addElementsToDb<ComponentCategory>(
           writer, fs, fp, lib->searchForElements<ComponentCategory>(), libId);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
-      if (mAbort || (mSemaphore.available() > 0)) break;
+      if (isAbortRequested()) break;
       count += addElementsToDb<PackageCategory>(
           writer, fs, fp, lib->searchForElements<PackageCategory>(), libId);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
-      if (mAbort || (mSemaphore.available() > 0)) break;
+      if (isAbortRequested()) break;
       count += addElementsToDb<Symbol>(writer, fs, fp,
                                        lib->searchForElements<Symbol>(), libId);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
-      if (mAbort || (mSemaphore.available() > 0)) break;
+      if (isAbortRequested()) break;
       count += addElementsToDb<Package>(
           writer, fs, fp, lib->searchForElements<Package>(), libId);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
-      if (mAbort || (mSemaphore.available() > 0)) break;
+      if (isAbortRequested()) break;
       count += addElementsToDb<Component>(
           writer, fs, fp, lib->searchForElements<Component>(), libId);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
-      if (mAbort || (mSemaphore.available() > 0)) break;
+      if (isAbortRequested()) break;
       count += addElementsToDb<Device>(writer, fs, fp,
                                        lib->searchForElements<Device>(), libId);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
     }
 
     // commit transaction
-    if ((!mAbort) && (mSemaphore.available() == 0)) {
+    if (!isAbortRequested()) {
+      writer.endBulkLoad();  // can throw
+      writer.updateCategoryTree<ComponentCategory>();  // can throw
+      writer.updateCategoryTree<PackageCategory>();  // can throw
       transactionGuard.commit();  // can throw
       qDebug() << "Workspace library scan succeeded:" << count << "elements in"
                << timer.elapsed() << "ms.";
@@ -186,6 +243,86 @@ void WorkspaceLibraryScanner::scan() noexcept {
   emit scanFinished();
 }
 
+void WorkspaceLibraryScanner::scanElements(
+    const QSet<FilePath>& elementsDirs,
+    const QSet<FilePath>& modifiedElements) noexcept {
+  try {
+    QElapsedTimer timer;
+    timer.start();
+    emit scanStarted();
+    emit scanProgressUpdate(0);
+    qDebug() << "Start incremental workspace library scan of"
+             << elementsDirs.count() << "directories and"
+             << modifiedElements.count() << "elements in worker thread...";
+
+    // the element type directories of modified elements need to be updated
+    QSet<FilePath> dirs = elementsDirs;
+    foreach (const FilePath& elementDir, modifiedElements) {
+      dirs.insert(elementDir.getParentDir());
+    }
+
+    // open SQLite database
+    SQLiteDatabase db(mDbFilePath);  // can throw
+    WorkspaceLibraryDbWriter writer(mLibrariesPath, db);
+    std::shared_ptr<TransactionalFileSystem> fs =
+        TransactionalFileSystem::openRO(mLibrariesPath);
+    const QHash<FilePath, int> libIds = getLibraryIds(db);  // can throw
+
+    // update the elements within a single transaction
+    SQLiteDatabase::TransactionScopeGuard transactionGuard(db);  // can throw
+    int count = 0;
+    int processed = 0;
+    foreach (const FilePath& elementsDir, dirs) {
+      if (isAbortRequested()) break;  // The full scan will cover it.
+      const QString type = elementsDir.getFilename();
+      const int libId = libIds.value(elementsDir.getParentDir(), -1);
+      if (libId < 0) {
+        qWarning() << "Library of modified elements not found in database:"
+                   << elementsDir.toNative();
+      } else if (type == ComponentCategory::getShortElementName()) {
+        count += updateElementsInDb<ComponentCategory>(
+            db, writer, fs, elementsDir, modifiedElements, libId);
+      } else if (type == PackageCategory::getShortElementName()) {
+        count += updateElementsInDb<PackageCategory>(
+            db, writer, fs, elementsDir, modifiedElements, libId);
+      } else if (type == Symbol::getShortElementName()) {
+        count += updateElementsInDb<Symbol>(db, writer, fs, elementsDir,
+                                            modifiedElements, libId);
+      } else if (type == Package::getShortElementName()) {
+        count += updateElementsInDb<Package>(db, writer, fs, elementsDir,
+                                             modifiedElements, libId);
+      } else if (type == Component::getShortElementName()) {
+        count += updateElementsInDb<Component>(db, writer, fs, elementsDir,
+                                               modifiedElements, libId);
+      } else if (type == Device::getShortElementName()) {
+        count += updateElementsInDb<Device>(db, writer, fs, elementsDir,
+                                            modifiedElements, libId);
+      }
+      emit scanProgressUpdate(
+          qBound(0, (99 * (++processed)) / dirs.count(), 99));
+    }
+
+    // commit transaction, partial updates are valid as well
+    writer.updateCategoryTree<ComponentCategory>();  // can throw
+    writer.updateCategoryTree<PackageCategory>();  // can throw
+    transactionGuard.commit();  // can throw
+    qDebug() << "Incremental workspace library scan succeeded:" << count
+             << "elements in" << timer.elapsed() << "ms.";
+    emit scanSucceeded(count);
+
+    // watch added elements as well
+    QStringList watchedDirs;
+    getLibraryDirectories(fs, "local", watchedDirs);
+    getLibraryDirectories(fs, "remote", watchedDirs);
+    emit libraryDirectoriesScanned(watchedDirs);
+  } catch (const Exception& e) {
+    qDebug() << "Incremental workspace library scan failed:" << e.getMsg();
+    emit scanFailed(e.getMsg());
+  }
+  emit scanProgressUpdate(100);
+  emit scanFinished();
+}
+
 void WorkspaceLibraryScanner::getLibrariesOfDirectory(
     std::shared_ptr<TransactionalFileSystem> fs, const QString& root,
     QList<std::shared_ptr<Library>>& libs) noexcept {
@@ -209,6 +346,52 @@ void WorkspaceLibraryScanner::getLibrariesOfDirectory(
   }
 }
 
+void WorkspaceLibraryScanner::getLibraryDirectories(
+    std::shared_ptr<TransactionalFileSystem> fs, const QString& root,
+    QStringList& dirs) noexcept {
+  // Only the libraries, their element type directories (e.g. "sym") and the
+  // element directories are returned, not the subdirectories of elements.
+  static const QStringList elementTypes = {
+      ComponentCategory::getShortElementName(),
+      PackageCategory::getShortElementName(),
+      Symbol::getShortElementName(),
+      Package::getShortElementName(),
+      Component::getShortElementName(),
+      Device::getShortElementName(),
+  };
+  if (!fs->getAbsPath(root).isExistingDir()) {
+    return;
+  }
+  dirs.append(fs->getAbsPath(root).toStr());
+  foreach (const QString& name, fs->getDirs(root)) {
+    const QString libDir = root % "/" % name;
+    dirs.append(fs->getAbsPath(libDir).toStr());
+    foreach (const QString& type, fs->getDirs(libDir)) {
+      if (elementTypes.contains(type)) {
+        const QString elementsDir = libDir % "/" % type;
+        dirs.append(fs->getAbsPath(elementsDir).toStr());
+        foreach (const QString& element, fs->getDirs(elementsDir)) {
+          dirs.append(fs->getAbsPath(elementsDir % "/" % element).toStr());
+        }
+      }
+    }
+  }
+}
+
+QHash<FilePath, int> WorkspaceLibraryScanner::getLibraryIds(
+    SQLiteDatabase& db) {
+  QHash<FilePath, int> ids;
+  QSqlQuery query = db.prepareQuery("SELECT id, filepath FROM libraries");
+  db.exec(query);
+  while (query.next()) {
+    int id = query.value(0).toInt();
+    FilePath fp = mLibrariesPath.getPathTo(query.value(1).toString());
+    if (!fp.isValid()) throw LogicError(__FILE__, __LINE__);
+    ids.insert(fp, id);
+  }
+  return ids;
+}
+
 QHash<FilePath, int> WorkspaceLibraryScanner::updateLibraries(
     SQLiteDatabase& db, WorkspaceLibraryDbWriter& writer,
     const QList<std::shared_ptr<Library>>& libs) {
@@ -222,15 +405,7 @@ QHash<FilePath, int> WorkspaceLibraryScanner::updateLibraries(
   }
 
   // get IDs of existing libraries in DB
-  QHash<FilePath, int> dbLibIds;
-  QSqlQuery query = db.prepareQuery("SELECT id, filepath FROM libraries");
-  db.exec(query);
-  while (query.next()) {
-    int id = query.value(0).toInt();
-    FilePath fp = mLibrariesPath.getPathTo(query.value(1).toString());
-    if (!fp.isValid()) throw LogicError(__FILE__, __LINE__);
-    dbLibIds.insert(fp, id);
-  }
+  QHash<FilePath, int> dbLibIds = getLibraryIds(db);  // can throw
 
   // update existing and add new libraries to DB
   foreach (const std::shared_ptr<Library>& lib, libs) {
@@ -271,7 +446,7 @@ int WorkspaceLibraryScanner::addElementsToDb(
     const QStringList& dirs, int libId) {
   int count = 0;
   foreach (const QString& dirpath, dirs) {
-    if (mAbort || (mSemaphore.available() > 0)) break;
+    if (isAbortRequested()) break;
     FilePath absPath = libPath.getPathTo(dirpath);
     QString relPath = absPath.toRelative(fs->getAbsPath());
     try {
@@ -290,6 +465,60 @@ int WorkspaceLibraryScanner::addElementsToDb(
   return count;
 }
 
+template <typename ElementType>
+int WorkspaceLibraryScanner::updateElementsInDb(
+    SQLiteDatabase& db, WorkspaceLibraryDbWriter& writer,
+    std::shared_ptr<TransactionalFileSystem> fs, const FilePath& elementsDir,
+    const QSet<FilePath>& modifiedElements, int libId) {
+  const FilePath libPath = elementsDir.getParentDir();
+
+  // get elements of this directory which are currently in the database
+  QSet<QString> dbDirs;
+  QSqlQuery query = db.prepareQuery(
+      "SELECT filepath FROM " %
+      WorkspaceLibraryDbWriter::getElementTable<ElementType>() %
+      " WHERE library_id = :library_id");
+  query.bindValue(":library_id", libId);
+  db.exec(query);  // can throw
+  while (query.next()) {
+    const FilePath fp = mLibrariesPath.getPathTo(query.value(0).toString());
+    if (fp.getParentDir() == elementsDir) {
+      dbDirs.insert(fp.toRelative(libPath));
+    }
+  }
+
+  // get elements of this directory which currently exist on disk
+  QSet<QString> fsDirs;
+  foreach (const QString& name,
+           fs->getDirs(elementsDir.toRelative(mLibrariesPath))) {
+    fsDirs.insert(elementsDir.getFilename() % "/" % name);
+  }
+
+  // get modified elements of this directory
+  QSet<QString> modifiedDirs;
+  foreach (const FilePath& fp, modifiedElements) {
+    if (fp.getParentDir() == elementsDir) {
+      modifiedDirs.insert(fp.toRelative(libPath));
+    }
+  }
+
+  // Remove no longer existing elements and add new elements. Modified
+  // elements are removed and added again, all other elements which exist in
+  // both are not touched. Translations and categories are removed by the
+  // database.
+  const QSet<QString> reloadedDirs = dbDirs & fsDirs & modifiedDirs;
+  foreach (const QString& dir, (dbDirs - fsDirs) + reloadedDirs) {
+    writer.removeElement<ElementType>(libPath.getPathTo(dir));  // can throw
+  }
+  QStringList addedDirs;
+  foreach (const QString& dir, (fsDirs - dbDirs) + reloadedDirs) {
+    if (Library::isValidElementDirectory<ElementType>(libPath.getPathTo(dir))) {
+      addedDirs.append(dir);
+    }
+  }
+  return addElementsToDb<ElementType>(writer, fs, libPath, addedDirs, libId);
+}
+
 template <typename ElementType>
 int WorkspaceLibraryScanner::addElementToDb(WorkspaceLibraryDbWriter& writer,
                                             int libId,
@@ -46,6 +46,21 @@ class WorkspaceLibraryDbWriter;
 /**
  * @brief The WorkspaceLibraryScanner class
  *
+ * Supports two kinds of scans, both executed in the worker thread:
+ *
+ *   - #startScan(): Full rescan of all libraries, rebuilding the whole
+ *     database. Any running scan is aborted. Also reports the directories
+ *     to watch for external modifications with
+ *     #libraryDirectoriesScanned(), see ::librepcb::WorkspaceLibraryWatcher.
+ *   - #startIncrementalScan(): Only synchronizes the database rows of
+ *     elements added to or removed from the passed element type directories
+ *     (e.g. `local/MyLib.lplib/sym`), and reloads the passed modified
+ *     element directories. Requests are accumulated until the worker thread
+ *     picks them up, so many modified directories are updated within a
+ *     single transaction. Pointless if a full scan is already pending. Also
+ *     reports the directories to watch again, since elements might have been
+ *     added.
+ *
  * @warning Be very careful with dependencies to other objects as the #run()
  * method is executed in a separate thread! Keep the number of dependencies as
  * small as possible and consider thread synchronization and object lifetimes.
@@ -65,6 +80,8 @@ public:
 
   // General Methods
   void startScan() noexcept;
+  void startIncrementalScan(const QSet<FilePath>& elementsDirs,
+                            const QSet<FilePath>& modifiedElements) noexcept;
 
   // Operator Overloadings
   WorkspaceLibraryScanner& operator=(const WorkspaceLibraryScanner& rhs) =
@@ -72,6 +89,7 @@ public:
 
 signals:
   void scanStarted();
+  void libraryDirectoriesScanned(const QStringList& dirs);
   void scanLibraryListUpdated(int libraryCount);
   void scanProgressUpdate(int percent);
   void scanSucceeded(int elementCount);
@@ -80,10 +98,16 @@ signals:
 
 private:  // Methods
   void run() noexcept override;
+  bool isAbortRequested() noexcept;
   void scan() noexcept;
+  void scanElements(const QSet<FilePath>& elementsDirs,
+                    const QSet<FilePath>& modifiedElements) noexcept;
   void getLibrariesOfDirectory(std::shared_ptr<TransactionalFileSystem> fs,
                                const QString& root,
                                QList<std::shared_ptr<Library>>& libs) noexcept;
+  void getLibraryDirectories(std::shared_ptr<TransactionalFileSystem> fs,
+                             const QString& root, QStringList& dirs) noexcept;
+  QHash<FilePath, int> getLibraryIds(SQLiteDatabase& db);
   QHash<FilePath, int> updateLibraries(
       SQLiteDatabase& db, WorkspaceLibraryDbWriter& writer,
       const QList<std::shared_ptr<Library>>& libs);
@@ -93,6 +117,11 @@ private:  // Methods
                       const FilePath& libPath, const QStringList& dirs,
                       int libId);
   template <typename ElementType>
+  int updateElementsInDb(SQLiteDatabase& db, WorkspaceLibraryDbWriter& writer,
+                         std::shared_ptr<TransactionalFileSystem> fs,
+                         const FilePath& elementsDir,
+                         const QSet<FilePath>& modifiedElements, int libId);
+  template <typename ElementType>
   int addElementToDb(WorkspaceLibraryDbWriter& writer, int libId,
                      const ElementType& element);
   template <typename ElementType>
@@ -108,6 +137,12 @@ private:  // Data
   QSemaphore mSemaphore;
   volatile bool mAbort;
   int mLastProgressPercent;
+
+  // Scan requests, guarded by mMutex
+  QMutex mMutex;
+  bool mFullScanRequested;
+  QSet<FilePath> mPendingElementsDirs;
+  QSet<FilePath> mPendingModifiedElements;
 };
 
 /*******************************************************************************
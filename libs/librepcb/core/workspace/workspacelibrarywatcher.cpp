@@ -0,0 +1,135 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "workspacelibrarywatcher.h"
+
+#include "../utils/toolbox.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+WorkspaceLibraryWatcher::WorkspaceLibraryWatcher(const FilePath& librariesPath,
+                                                 QObject* parent) noexcept
+  : QObject(parent),
+    mLibrariesPath(librariesPath),
+    mWatcher(),
+    mTimer(),
+    mModifiedDirectories() {
+  mTimer.setSingleShot(true);
+  mTimer.setInterval(1000);
+  connect(&mTimer, &QTimer::timeout, this, &WorkspaceLibraryWatcher::flush);
+  connect(&mWatcher, &QFileSystemWatcher::directoryChanged, this,
+          &WorkspaceLibraryWatcher::directoryChanged);
+}
+
+WorkspaceLibraryWatcher::~WorkspaceLibraryWatcher() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void WorkspaceLibraryWatcher::setWatchedDirectories(
+    const QStringList& dirs) noexcept {
+  const QSet<QString> oldPaths = Toolbox::toSet(mWatcher.directories());
+  const QSet<QString> newPaths = Toolbox::toSet(dirs);
+  const QStringList removedPaths = (oldPaths - newPaths).values();
+  const QStringList addedPaths = (newPaths - oldPaths).values();
+  if (!removedPaths.isEmpty()) {
+    mWatcher.removePaths(removedPaths);
+  }
+  if (!addedPaths.isEmpty()) {
+    const QStringList failedPaths = mWatcher.addPaths(addedPaths);
+    if (!failedPaths.isEmpty()) {
+      qWarning() << "Failed to watch" << failedPaths.count() << "of"
+                 << dirs.count()
+                 << "workspace library directories, external modifications "
+                    "might not be detected.";
+    }
+  }
+  qDebug() << "Watching" << mWatcher.directories().count()
+           << "workspace library directories.";
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void WorkspaceLibraryWatcher::directoryChanged(const QString& path) noexcept {
+  mModifiedDirectories.insert(FilePath(path));
+  mTimer.start();  // (Re)start debounce timer.
+}
+
+void WorkspaceLibraryWatcher::flush() noexcept {
+  QSet<FilePath> elementsDirs;  // Directories like "sym" or "pkg".
+  QSet<FilePath> modifiedElements;  // Directories like "sym/<uuid>".
+  bool libsModified = false;
+  foreach (const FilePath& dir, mModifiedDirectories) {
+    const int depth = getDepth(dir);
+    if (depth < 0) {
+      continue;  // Outside of the libraries directory, should not happen.
+    } else if (depth < sElementsDepth) {
+      // Libraries added, removed or modified, needs a full rescan which
+      // also updates the watched directories.
+      libsModified = true;
+    } else if (depth == sElementsDepth) {
+      // Elements added, removed or renamed.
+      elementsDirs.insert(dir);
+    } else if (depth == sElementsDepth + 1) {
+      // Files of an element added, removed or replaced.
+      modifiedElements.insert(dir);
+    }
+  }
+  mModifiedDirectories.clear();
+
+  if (libsModified) {
+    // A full rescan also covers all modified elements.
+    qDebug() << "Workspace libraries modified externally.";
+    emit librariesModified();
+  } else if ((!elementsDirs.isEmpty()) || (!modifiedElements.isEmpty())) {
+    qDebug() << "Workspace library elements modified externally in"
+             << elementsDirs.count() << "directories and"
+             << modifiedElements.count() << "elements.";
+    emit elementsModified(elementsDirs, modifiedElements);
+  }
+}
+
+int WorkspaceLibraryWatcher::getDepth(const FilePath& dir) const noexcept {
+  if (!dir.isLocatedInDir(mLibrariesPath)) {
+    return -1;
+  }
+  return dir.toRelative(mLibrariesPath).count('/') + 1;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
@@ -0,0 +1,132 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_WORKSPACELIBRARYWATCHER_H
+#define LIBREPCB_CORE_WORKSPACELIBRARYWATCHER_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../fileio/filepath.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class WorkspaceLibraryWatcher
+ ******************************************************************************/
+
+/**
+ * @brief Watches the workspace libraries directory for external modifications
+ *
+ * The libraries, their element type directories (e.g.
+ * `local/MyLib.lplib/sym`) and the element directories are watched. The list
+ * of directories is determined by ::librepcb::WorkspaceLibraryScanner in its
+ * worker thread and passed to #setWatchedDirectories(). Modifications are
+ * collected and reported debounced, so a large number of modifications
+ * within a short time (e.g. a `git pull` of a library) is reported as a
+ * single batch:
+ *
+ *   - Element type directories with added, removed or renamed elements and
+ *     element directories with added, removed or replaced files are reported
+ *     with #elementsModified(), so only these elements need to be updated in
+ *     the library database.
+ *   - Modifications on the level of libraries (e.g. added or removed
+ *     libraries, modified library metadata) are reported with
+ *     #librariesModified() since they require a full library rescan.
+ *
+ * @note Only modifications of directory listings are detected (i.e. added,
+ * removed, renamed or replaced files). This covers Git and LibrePCB itself
+ * since both replace modified files, but not files overwritten in place.
+ */
+class WorkspaceLibraryWatcher final : public QObject {
+  Q_OBJECT
+
+public:
+  // Constructors / Destructor
+  WorkspaceLibraryWatcher() = delete;
+  WorkspaceLibraryWatcher(const WorkspaceLibraryWatcher& other) = delete;
+
+  /**
+   * @brief Constructor
+   *
+   * @param librariesPath   Path to the workspace libraries directory.
+   * @param parent          Parent QObject.
+   */
+  explicit WorkspaceLibraryWatcher(const FilePath& librariesPath,
+                                   QObject* parent = nullptr) noexcept;
+  ~WorkspaceLibraryWatcher() noexcept;
+
+  // Setters
+
+  /**
+   * @brief Set the time to wait for further modifications before reporting
+   *
+   * @param ms  Debounce interval in milliseconds.
+   */
+  void setDebounceInterval(int ms) noexcept { mTimer.setInterval(ms); }
+
+  // General Methods
+
+  /**
+   * @brief Replace the list of watched directories
+   *
+   * Only the difference to the currently watched directories is applied.
+   *
+   * @param dirs  Absolute paths of the library directories, their element
+   *              type directories and the element directories, as determined
+   *              by a library scan.
+   */
+  void setWatchedDirectories(const QStringList& dirs) noexcept;
+
+  // Operator Overloadings
+  WorkspaceLibraryWatcher& operator=(const WorkspaceLibraryWatcher& rhs) =
+      delete;
+
+signals:
+  void elementsModified(const QSet<FilePath>& elementsDirs,
+                        const QSet<FilePath>& modifiedElements);
+  void librariesModified();
+
+private:  // Methods
+  void directoryChanged(const QString& path) noexcept;
+  void flush() noexcept;
+  int getDepth(const FilePath& dir) const noexcept;
+
+private:  // Data
+  const FilePath mLibrariesPath;  ///< Path to workspace libraries directory.
+  QFileSystemWatcher mWatcher;
+  QTimer mTimer;  ///< Debounce timer.
+  QSet<FilePath> mModifiedDirectories;  ///< Not yet reported modifications.
+
+  /// Depth of element type directories, relative to #mLibrariesPath
+  static const int sElementsDepth = 3;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
@@ -23,6 +23,7 @@
 #include "boardclipboarddata.h"
 
 #include <librepcb/core/application.h>
+#include <librepcb/core/exceptions.h>
 #include <librepcb/core/fileio/transactionaldirectory.h>
 #include <librepcb/core/fileio/transactionalfilesystem.h>
 #include <librepcb/core/project/circuit/netsignal.h>
@@ -36,6 +37,61 @@
 namespace librepcb {
 namespace editor {
 
+/*******************************************************************************
+ *  Class BoardClipboardData::LazyMimeData
+ ******************************************************************************/
+
+/**
+ * @brief QMimeData holding a ::librepcb::editor::BoardClipboardData by
+ *        reference, serializing it only when its content is requested
+ */
+class BoardClipboardData::LazyMimeData final : public QMimeData {
+public:
+  // Constructors / Destructor
+  LazyMimeData() = delete;
+  LazyMimeData(const LazyMimeData& other) = delete;
+  explicit LazyMimeData(const std::shared_ptr<const BoardClipboardData>& data)
+    : QMimeData(), mData(data) {}
+  ~LazyMimeData() noexcept {}
+
+  // Getters
+  const std::shared_ptr<const BoardClipboardData>& getData() const noexcept {
+    return mData;
+  }
+
+  // Inherited from QMimeData
+  QStringList formats() const override {
+    return {getMimeType(), "application/zip", "text/plain"};
+  }
+
+  // Operator Overloadings
+  LazyMimeData& operator=(const LazyMimeData& rhs) = delete;
+
+protected:
+  QVariant retrieveData(const QString& mimeType,
+                        QVariant::Type preferredType) const override {
+    Q_UNUSED(preferredType);
+    if (!mSerialized) {
+      try {
+        mSerialized = mData->toMimeData();  // can throw
+      } catch (const Exception& e) {
+        qCritical() << "Failed to serialize board clipboard data:"
+                    << e.getMsg();
+        return QVariant();
+      }
+    }
+    if (mSerialized->hasFormat(mimeType)) {
+      return mSerialized->data(mimeType);
+    } else {
+      return QVariant();
+    }
+  }
+
+private:
+  std::shared_ptr<const BoardClipboardData> mData;
+  mutable std::unique_ptr<QMimeData> mSerialized;
+};
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -100,6 +156,12 @@ std::unique_ptr<TransactionalDirectory> BoardClipboardData::getDirectory(
       new TransactionalDirectory(mFileSystem, path));
 }
 
+std::unique_ptr<const TransactionalDirectory> BoardClipboardData::getDirectory(
+    const QString& path) const noexcept {
+  return std::unique_ptr<const TransactionalDirectory>(
+      new TransactionalDirectory(mFileSystem, path));
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
@@ -142,12 +204,22 @@ std::unique_ptr<QMimeData> BoardClipboardData::toMimeData() const {
   return data;
 }
 
-std::unique_ptr<BoardClipboardData> BoardClipboardData::fromMimeData(
+std::unique_ptr<QMimeData> BoardClipboardData::toLazyMimeData(
+    const std::shared_ptr<const BoardClipboardData>& data) {
+  Q_ASSERT(data);
+  return std::unique_ptr<QMimeData>(new LazyMimeData(data));
+}
+
+std::shared_ptr<const BoardClipboardData> BoardClipboardData::fromMimeData(
     const QMimeData* mime) {
+  // Fast path: Data copied within this application instance.
+  if (const LazyMimeData* lazy = dynamic_cast<const LazyMimeData*>(mime)) {
+    return lazy->getData();
+  }
+
   QByteArray content = mime ? mime->data(getMimeType()) : QByteArray();
   if (!content.isNull()) {
-    return std::unique_ptr<BoardClipboardData>(
-        new BoardClipboardData(content));  // can throw
+    return std::make_shared<BoardClipboardData>(content);  // can throw
   } else {
     return nullptr;
   }
@@ -59,6 +59,16 @@ namespace editor {
 
 /**
  * @brief The BoardClipboardData class
+ *
+ * To make copy & paste of large selections within the same application
+ * instance fast, #toLazyMimeData() wraps a shared pointer to the object
+ * itself into the clipboard instead of serializing it. #fromMimeData() then
+ * returns that very same object again, so no serialization, ZIP compression
+ * and parsing is needed at all. The S-Expression/ZIP representation is only
+ * generated when another process requests the clipboard content.
+ *
+ * @note  Objects retrieved with #fromMimeData() might therefore be shared
+ *        with the clipboard and must not be modified.
  */
 class BoardClipboardData final {
 public:
@@ -246,30 +256,77 @@ public:
   bool isEmpty() const noexcept;
   std::unique_ptr<TransactionalDirectory> getDirectory(
       const QString& path = "") noexcept;
+  std::unique_ptr<const TransactionalDirectory> getDirectory(
+      const QString& path = "") const noexcept;
   const Uuid& getBoardUuid() const noexcept { return mBoardUuid; }
   const Point& getCursorPos() const noexcept { return mCursorPos; }
   SerializableObjectList<Device, Device>& getDevices() noexcept {
     return mDevices;
   }
+  const SerializableObjectList<Device, Device>& getDevices() const noexcept {
+    return mDevices;
+  }
   SerializableObjectList<NetSegment, NetSegment>& getNetSegments() noexcept {
     return mNetSegments;
   }
+  const SerializableObjectList<NetSegment, NetSegment>& getNetSegments() const
+      noexcept {
+    return mNetSegments;
+  }
   SerializableObjectList<Plane, Plane>& getPlanes() noexcept { return mPlanes; }
+  const SerializableObjectList<Plane, Plane>& getPlanes() const noexcept {
+    return mPlanes;
+  }
   PolygonList& getPolygons() noexcept { return mPolygons; }
+  const PolygonList& getPolygons() const noexcept { return mPolygons; }
   StrokeTextList& getStrokeTexts() noexcept { return mStrokeTexts; }
+  const StrokeTextList& getStrokeTexts() const noexcept { return mStrokeTexts; }
   HoleList& getHoles() noexcept { return mHoles; }
+  const HoleList& getHoles() const noexcept { return mHoles; }
   QMap<std::pair<Uuid, Uuid>, Point>& getPadPositions() noexcept {
     return mPadPositions;
   }
+  const QMap<std::pair<Uuid, Uuid>, Point>& getPadPositions() const noexcept {
+    return mPadPositions;
+  }
 
   // General Methods
+
+  /**
+   * @brief Serialize the data into a new QMimeData object
+   *
+   * @return MIME data containing the serialized clipboard content.
+   */
   std::unique_ptr<QMimeData> toMimeData() const;
-  static std::unique_ptr<BoardClipboardData> fromMimeData(
+
+  /**
+   * @brief Create a QMimeData object which is serialized only on demand
+   *
+   * @param data    The clipboard data to put into the MIME data. Must not be
+   *                modified anymore afterwards.
+   * @return MIME data holding a reference to the passed object.
+   */
+  static std::unique_ptr<QMimeData> toLazyMimeData(
+      const std::shared_ptr<const BoardClipboardData>& data);
+
+  /**
+   * @brief Get the clipboard data from a QMimeData object
+   *
+   * @param mime    The MIME data to get the content from.
+   * @return If the MIME data was created with #toLazyMimeData(), the
+   *         referenced object is returned as-is. Otherwise the MIME data is
+   *         deserialized into a new object. If it doesn't contain board
+   *         clipboard data at all, `nullptr` is returned.
+   */
+  static std::shared_ptr<const BoardClipboardData> fromMimeData(
       const QMimeData* mime);
 
   // Operator Overloadings
   BoardClipboardData& operator=(const BoardClipboardData& rhs) = delete;
 
+private:  // Types
+  class LazyMimeData;
+
 private:  // Methods
   static QString getMimeType() noexcept;
 
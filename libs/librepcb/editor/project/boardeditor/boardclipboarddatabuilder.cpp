@@ -83,18 +83,24 @@ std::unique_ptr<BoardClipboardData> BoardClipboardDataBuilder::generate(
   query.addNetPointsOfNetLines();
 
   // Add devices
+  QSet<Uuid> copiedLibDevices;
+  QSet<Uuid> copiedLibPackages;
   foreach (BI_Device* device, query.getDeviceInstances()) {
-    // Copy library device
-    std::unique_ptr<TransactionalDirectory> devDir =
-        data->getDirectory("dev/" % device->getLibDevice().getUuid().toStr());
-    if (devDir->getFiles().isEmpty()) {
+    // Copy library device (only once per library element)
+    const Uuid libDevUuid = device->getLibDevice().getUuid();
+    if (!copiedLibDevices.contains(libDevUuid)) {
+      std::unique_ptr<TransactionalDirectory> devDir =
+          data->getDirectory("dev/" % libDevUuid.toStr());
       device->getLibDevice().getDirectory().copyTo(*devDir);
+      copiedLibDevices.insert(libDevUuid);
     }
-    // Copy library package
-    std::unique_ptr<TransactionalDirectory> pkgDir =
-        data->getDirectory("pkg/" % device->getLibPackage().getUuid().toStr());
-    if (pkgDir->getFiles().isEmpty()) {
+    // Copy library package (only once per library element)
+    const Uuid libPkgUuid = device->getLibPackage().getUuid();
+    if (!copiedLibPackages.contains(libPkgUuid)) {
+      std::unique_ptr<TransactionalDirectory> pkgDir =
+          data->getDirectory("pkg/" % libPkgUuid.toStr());
       device->getLibPackage().getDirectory().copyTo(*pkgDir);
+      copiedLibPackages.insert(libPkgUuid);
     }
     // Create list of stroke texts
     StrokeTextList strokeTexts;
@@ -63,9 +63,9 @@
 #include <librepcb/core/project/circuit/circuit.h>
 #include <librepcb/core/project/circuit/componentinstance.h>
 #include <librepcb/core/project/project.h>
+#include <librepcb/core/project/projectsearchindex.h>
 #include <librepcb/core/types/layer.h>
 #include <librepcb/core/utils/scopeguard.h>
-#include <librepcb/core/utils/toolbox.h>
 #include <librepcb/core/workspace/workspace.h>
 #include <librepcb/core/workspace/workspacelibrarydb.h>
 #include <librepcb/core/workspace/workspacesettings.h>
@@ -1249,39 +1249,45 @@ void BoardEditor::clearDrcMarker() noexcept {
   mUi->graphicsView->setSceneRectMarker(QRectF());
 }
 
-QList<BI_Device*> BoardEditor::getSearchCandidates() noexcept {
-  QList<BI_Device*> candidates;
-  if (Board* board = getActiveBoard()) {
-    candidates += board->getDeviceInstances().values();
-  }
-  return candidates;
-}
-
 QStringList BoardEditor::getSearchToolBarCompleterList() noexcept {
-  QStringList list;
-  foreach (const BI_Device* device, getSearchCandidates()) {
-    list.append(*device->getComponentInstance().getName());
-  }
-  return list;
+  return mProjectEditor.getSearchIndex().getTexts(
+      ProjectSearchIndex::ComponentName | ProjectSearchIndex::NetSignalName |
+      ProjectSearchIndex::DeviceName | ProjectSearchIndex::PackageName);
 }
 
 void BoardEditor::goToDevice(const QString& name, int index) noexcept {
+  // The search index returns the results in natural order already.
+  Board* board = getActiveBoard();
   QList<BI_Device*> deviceCandidates;
-  foreach (BI_Device* device, getSearchCandidates()) {
-    if (device->getComponentInstance().getName()->startsWith(
-            name, Qt::CaseInsensitive)) {
-      deviceCandidates.append(device);
+  QSet<const BI_Device*> devices;  // Avoid duplicates.
+  QSet<const NetSignal*> netSignals;
+  foreach (const ProjectSearchIndex::Entry& entry,
+           mProjectEditor.getSearchIndex().find(
+               name,
+               ProjectSearchIndex::ComponentName |
+                   ProjectSearchIndex::NetSignalName |
+                   ProjectSearchIndex::DeviceName |
+                   ProjectSearchIndex::PackageName)) {
+    BI_Device* device = entry.device;
+    if (entry.component && board) {
+      device = board->getDeviceInstanceByComponentUuid(
+          entry.component->getUuid());
+    }
+    if (device) {
+      if ((&device->getBoard() == board) && (!devices.contains(device))) {
+        deviceCandidates.append(device);
+        devices.insert(device);
+      }
+    } else if (entry.netSignal) {
+      netSignals.insert(entry.netSignal);
     }
   }
 
-  // Sort by name for a natural order of results.
-  Toolbox::sortNumeric(
-      deviceCandidates,
-      [](const QCollator& cmp, const BI_Device* a, const BI_Device* b) {
-        return cmp(*a->getComponentInstance().getName(),
-                   *b->getComponentInstance().getName());
-      },
-      Qt::CaseInsensitive, false);
+  // If only net signals match, highlight them.
+  if (deviceCandidates.isEmpty() && (!netSignals.isEmpty())) {
+    mProjectEditor.setHighlightedNetSignals(netSignals);
+    return;
+  }
 
   if ((!deviceCandidates.isEmpty()) && mGraphicsScene) {
     mGraphicsScene->clearSelection();
@@ -148,7 +148,6 @@ private:
   void setDrcMessageApproved(const RuleCheckMessage& msg,
                              bool approved) noexcept;
   void clearDrcMarker() noexcept;
-  QList<BI_Device*> getSearchCandidates() noexcept;
   QStringList getSearchToolBarCompleterList() noexcept;
   void goToDevice(const QString& name, int index) noexcept;
   void newBoard() noexcept;
@@ -44,14 +44,18 @@
 
 #include <librepcb/core/library/pkg/footprintpad.h>
 #include <librepcb/core/project/board/board.h>
+#include <librepcb/core/project/board/boardtraceobstaclesbuilder.h>
+#include <librepcb/core/project/board/drc/boarddesignrulechecksettings.h>
 #include <librepcb/core/project/board/items/bi_footprintpad.h>
 #include <librepcb/core/project/board/items/bi_netline.h>
 #include <librepcb/core/project/board/items/bi_netpoint.h>
 #include <librepcb/core/project/board/items/bi_netsegment.h>
 #include <librepcb/core/project/circuit/circuit.h>
+#include <librepcb/core/project/circuit/netsignal.h>
 #include <librepcb/core/project/project.h>
 #include <librepcb/core/types/layer.h>
 #include <librepcb/core/utils/toolbox.h>
+#include <librepcb/core/utils/traceobstacleindex.h>
 
 #include <QtCore>
 
@@ -84,6 +88,10 @@ BoardEditorState_DrawTrace::BoardEditorState_DrawTrace(
     mCurrentWidth(500000),
     mCurrentAutoWidth(false),
     mCurrentSnapActive(true),
+    mStopAtObstacles(false),
+    mObstacleIndex(),
+    mObstacleIndexLayer(nullptr),
+    mObstacleIndexSegment(nullptr),
     mFixedStartAnchor(nullptr),
     mCurrentNetSegment(nullptr),
     mPositioningNetLine1(nullptr),
@@ -161,6 +169,18 @@ bool BoardEditorState_DrawTrace::entry() noexcept {
   mContext.commandToolBar.addWidget(std::move(autoWidthCheckBox));
   mContext.commandToolBar.addSeparator();
 
+  // Add the stop at obstacles checkbox to the toolbar
+  std::unique_ptr<QCheckBox> stopAtObstaclesCheckBox(
+      new QCheckBox(tr("Stop at Obstacles")));
+  stopAtObstaclesCheckBox->setToolTip(
+      tr("Do not draw traces closer to other nets than the minimum copper "
+         "clearance configured in the DRC settings"));
+  stopAtObstaclesCheckBox->setChecked(mStopAtObstacles);
+  connect(stopAtObstaclesCheckBox.get(), &QCheckBox::toggled, this,
+          &BoardEditorState_DrawTrace::stopAtObstaclesToggled);
+  mContext.commandToolBar.addWidget(std::move(stopAtObstaclesCheckBox));
+  mContext.commandToolBar.addSeparator();
+
   // Add the layers combobox to the toolbar
   mContext.commandToolBar.addLabel(tr("Layer:"), 10);
   mLayerComboBox = new GraphicsLayerComboBox();
@@ -246,6 +266,11 @@ bool BoardEditorState_DrawTrace::exit() noexcept {
   // Abort the currently active command
   if (!abortPositioning(true)) return false;
 
+  // Release memory of the obstacle index
+  mObstacleIndex.reset();
+  mObstacleIndexLayer = nullptr;
+  mObstacleIndexSegment = nullptr;
+
   // Remove actions / widgets from the "command" toolbar
   mContext.commandToolBar.clear();
 
@@ -326,6 +351,7 @@ bool BoardEditorState_DrawTrace::processGraphicsSceneLeftMouseButtonPressed(
     // Start adding netpoints/netlines
     Point pos = Point::fromPx(e.scenePos());
     mCursorPos = pos;
+    mObstacleIndex.reset();  // The board might have been modified meanwhile.
     startPositioning(scene->getBoard(), pos);
     return true;
   }
@@ -787,8 +813,47 @@ void BoardEditorState_DrawTrace::updateNetpointPositions() noexcept {
     }
   }
 
-  mPositioningNetPoint1->setPosition(calcMiddlePointPos(
-      mFixedStartAnchor->getPosition(), mTargetPos, mCurrentWireMode));
+  const Point startPos = mFixedStartAnchor->getPosition();
+  Point middlePos = calcMiddlePointPos(startPos, mTargetPos, mCurrentWireMode);
+  if (mStopAtObstacles) {
+    // Shorten the trace to end right before the first obstacle of another
+    // net, if any.
+    const Layer& layer = mPositioningNetLine1->getLayer();
+    if ((!mObstacleIndex) || (mObstacleIndexLayer != &layer) ||
+        (mObstacleIndexSegment != mCurrentNetSegment)) {
+      try {
+        updateObstacleIndex(scene->getBoard(), layer);  // can throw
+      } catch (const Exception& e) {
+        // Continue without obstacles, but don't retry on every mouse move.
+        mObstacleIndex.reset(new TraceObstacleIndex());
+        mObstacleIndexLayer = &layer;
+        mObstacleIndexSegment = mCurrentNetSegment;
+        QMessageBox::critical(parentWidget(), tr("Error"), e.getMsg());
+      }
+    }
+    const UnsignedLength clearance =
+        scene->getBoard().getDrcSettings().getMinCopperCopperClearance();
+    const NetSignal* netsignal = mCurrentNetSegment->getNetSignal();
+    const tl::optional<Uuid> net = netsignal
+        ? tl::make_optional(netsignal->getUuid())
+        : tl::optional<Uuid>();
+    const Point freeMiddlePos = mObstacleIndex->findLastFreePoint(
+        startPos, middlePos, mCurrentWidth, clearance, net);
+    if (freeMiddlePos != middlePos) {
+      middlePos = freeMiddlePos;
+      mTargetPos = freeMiddlePos;
+      isOnVia = false;
+    } else {
+      const Point freeTargetPos = mObstacleIndex->findLastFreePoint(
+          middlePos, mTargetPos, mCurrentWidth, clearance, net);
+      if (freeTargetPos != mTargetPos) {
+        mTargetPos = freeTargetPos;
+        isOnVia = false;
+      }
+    }
+  }
+
+  mPositioningNetPoint1->setPosition(middlePos);
   if (mPositioningNetPoint2) {
     mPositioningNetPoint2->setPosition(mTargetPos);
   }
@@ -848,6 +913,16 @@ void BoardEditorState_DrawTrace::showVia(bool isVisible) noexcept {
   }
 }
 
+void BoardEditorState_DrawTrace::updateObstacleIndex(Board& board,
+                                                     const Layer& layer) {
+  // Ignore the current net segment, otherwise traces without net would
+  // collide with themselves.
+  mObstacleIndex = BoardTraceObstaclesBuilder(board).buildObstacles(
+      layer, mCurrentNetSegment);  // can throw
+  mObstacleIndexLayer = &layer;
+  mObstacleIndexSegment = mCurrentNetSegment;
+}
+
 BI_NetLineAnchor* BoardEditorState_DrawTrace::combineAnchors(
     BI_NetLineAnchor& a, BI_NetLineAnchor& b) {
   BI_NetPoint* removePoint = nullptr;
@@ -945,6 +1020,12 @@ void BoardEditorState_DrawTrace::wireAutoWidthEditToggled(
   mCurrentAutoWidth = checked;
 }
 
+void BoardEditorState_DrawTrace::stopAtObstaclesToggled(
+    const bool checked) noexcept {
+  mStopAtObstacles = checked;
+  updateNetpointPositions();
+}
+
 Point BoardEditorState_DrawTrace::calcMiddlePointPos(const Point& p1,
                                                      const Point p2,
                                                      WireMode mode) const
@@ -43,6 +43,7 @@ class BI_NetSegment;
 class BI_Via;
 class Layer;
 class NetSignal;
+class TraceObstacleIndex;
 
 namespace editor {
 
@@ -168,6 +169,26 @@ private:
    */
   void showVia(bool isVisible) noexcept;
 
+  /**
+   * @brief (Re-)build the spatial index of obstacles for the current trace
+   *
+   * See ::librepcb::BoardTraceObstaclesBuilder for details.
+   *
+   * @note The index is not updated incrementally when the board is modified.
+   *       Instead, it is discarded whenever a new trace is started and
+   *       rebuilt lazily for the layer of the trace (i.e. once per drawn
+   *       trace and whenever the layer or net segment is changed). While
+   *       drawing a trace, only the trace itself modifies the board, and the
+   *       current net segment is not added to the index.
+   *
+   * @param board The board to collect the obstacles from.
+   * @param layer The copper layer of the current trace.
+   *
+   * @throw Exception if the obstacles could not be determined. The current
+   *        index is kept in this case.
+   */
+  void updateObstacleIndex(Board& board, const Layer& layer);
+
   BI_NetLineAnchor* combineAnchors(BI_NetLineAnchor& a, BI_NetLineAnchor& b);
 
   // Callback Functions for the Gui elements
@@ -177,6 +198,7 @@ private:
   void drillDiameterEditValueChanged(const PositiveLength& value) noexcept;
   void wireWidthEditValueChanged(const PositiveLength& value) noexcept;
   void wireAutoWidthEditToggled(const bool checked) noexcept;
+  void stopAtObstaclesToggled(const bool checked) noexcept;
 
   /**
    * @brief Calculate the 'middle point' of two point,
@@ -205,6 +227,10 @@ private:
   PositiveLength mCurrentWidth;  ///< the current wire width
   bool mCurrentAutoWidth;  ///< automatically adjust wire width
   bool mCurrentSnapActive;  ///< the current active snap to target
+  bool mStopAtObstacles;  ///< stop traces before clearance violations
+  std::unique_ptr<TraceObstacleIndex> mObstacleIndex;  ///< lazily built
+  const Layer* mObstacleIndexLayer;  ///< layer of mObstacleIndex
+  const BI_NetSegment* mObstacleIndexSegment;  ///< ignored by mObstacleIndex
   BI_NetLineAnchor* mFixedStartAnchor;  ///< the fixed netline anchor (start
                                         ///< point of the line)
   BI_NetSegment* mCurrentNetSegment;  ///< the net segment that is currently
@@ -268,7 +268,7 @@ bool BoardEditorState_Select::processPaste() noexcept {
       (!mCmdPolygonEdit) && (!mCmdPlaneEdit) && (scene)) {
     try {
       // Get board data from clipboard.
-      std::unique_ptr<BoardClipboardData> data =
+      std::shared_ptr<const BoardClipboardData> data =
           BoardClipboardData::fromMimeData(
               qApp->clipboard()->mimeData());  // can throw
 
@@ -279,17 +279,20 @@ bool BoardEditorState_Select::processPaste() noexcept {
             FootprintClipboardData::fromMimeData(
                 qApp->clipboard()->mimeData());  // can throw
         if (footprintData) {
-          data.reset(new BoardClipboardData(footprintData->getFootprintUuid(),
-                                            footprintData->getCursorPos()));
-          data->getPolygons().append(footprintData->getPolygons());
-          data->getStrokeTexts().append(footprintData->getStrokeTexts());
-          data->getHoles().append(footprintData->getHoles());
+          std::shared_ptr<BoardClipboardData> boardData =
+              std::make_shared<BoardClipboardData>(
+                  footprintData->getFootprintUuid(),
+                  footprintData->getCursorPos());
+          boardData->getPolygons().append(footprintData->getPolygons());
+          boardData->getStrokeTexts().append(footprintData->getStrokeTexts());
+          boardData->getHoles().append(footprintData->getHoles());
+          data = boardData;
         }
       }
 
       // If there is something to paste, start the paste tool.
       if (data) {
-        return startPaste(*scene, std::move(data), tl::nullopt);  // can throw
+        return startPaste(*scene, data, tl::nullopt);  // can throw
       }
     } catch (const Exception& e) {
       QMessageBox::critical(parentWidget(), tr("Error"), e.getMsg());
@@ -1201,8 +1204,9 @@ bool BoardEditorState_Select::copySelectedItemsToClipboard() noexcept {
     Point cursorPos = mContext.editorGraphicsView.mapGlobalPosToScenePos(
         QCursor::pos(), true, false);
     BoardClipboardDataBuilder builder(*scene);
-    std::unique_ptr<BoardClipboardData> data = builder.generate(cursorPos);
-    qApp->clipboard()->setMimeData(data->toMimeData().release());
+    std::shared_ptr<BoardClipboardData> data = builder.generate(cursorPos);
+    qApp->clipboard()->setMimeData(
+        BoardClipboardData::toLazyMimeData(data).release());
   } catch (const Exception& e) {
     QMessageBox::critical(parentWidget(), tr("Error"), e.getMsg());
   }
@@ -1210,7 +1214,7 @@ bool BoardEditorState_Select::copySelectedItemsToClipboard() noexcept {
 }
 
 bool BoardEditorState_Select::startPaste(
-    BoardGraphicsScene& scene, std::unique_ptr<BoardClipboardData> data,
+    BoardGraphicsScene& scene, std::shared_ptr<const BoardClipboardData> data,
     const tl::optional<Point>& fixedPosition) {
   Q_ASSERT(data);
 
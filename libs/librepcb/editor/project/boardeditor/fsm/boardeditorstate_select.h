@@ -134,7 +134,7 @@ private:  // Methods
                               const Point& pos) noexcept;
   bool copySelectedItemsToClipboard() noexcept;
   bool startPaste(BoardGraphicsScene& scene,
-                  std::unique_ptr<BoardClipboardData> data,
+                  std::shared_ptr<const BoardClipboardData> data,
                   const tl::optional<Point>& fixedPosition);
   bool abortCommand(bool showErrMsgBox) noexcept;
   bool findPolygonVerticesAtPosition(const Point& pos) noexcept;
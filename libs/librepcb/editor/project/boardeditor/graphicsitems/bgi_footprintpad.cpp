@@ -65,6 +65,7 @@ BGI_FootprintPad::BGI_FootprintPad(BI_FootprintPad& pad,
   updateLayer();
 
   mPad.onEdited.attach(mOnPadEditedSlot);
+  mOnDeviceEditedSlot.setEventFilter({BGI_Device::Event::SelectionChanged});
   if (auto ptr = mDeviceGraphicsItem.lock()) {
     ptr->onEdited.attach(mOnDeviceEditedSlot);
   }
@@ -73,6 +73,9 @@ UnplacedComponentsDock::UnplacedComponentsDock(ProjectEditor& editor,
     mNextPosition(),
     mLastDeviceOfComponent(),
     mLastFootprintOfPackage(),
+    mCollator(),
+    mDeviceCountOfComponent(),
+    mFootprintCountOfPackage(),
     mCurrentDevices(),
     mSelectedComponent(nullptr),
     mSelectedDeviceUuid(),
@@ -85,6 +88,12 @@ UnplacedComponentsDock::UnplacedComponentsDock(ProjectEditor& editor,
     mPreviewGraphicsItem(nullptr) {
   mUi->setupUi(this);
 
+  // Same collator settings as Toolbox::sortNumeric() to keep the list sorted
+  // when inserting single items.
+  mCollator.setNumericMode(true);
+  mCollator.setCaseSensitivity(Qt::CaseInsensitive);
+  mCollator.setIgnorePunctuation(false);
+
   // Setup graphics view.
   const Theme& theme =
       mProjectEditor.getWorkspace().getSettings().themes.getActive();
@@ -101,11 +110,17 @@ UnplacedComponentsDock::UnplacedComponentsDock(ProjectEditor& editor,
       clientSettings.value("unplaced_components_dock/splitter_state")
           .toByteArray());
 
-  // Update components list each time a component gets added or removed.
+  // Update components list each time a component gets added, removed or
+  // modified.
   connect(&mProject.getCircuit(), &Circuit::componentAdded, this,
-          &UnplacedComponentsDock::updateComponentsList);
+          &UnplacedComponentsDock::circuitComponentAdded);
   connect(&mProject.getCircuit(), &Circuit::componentRemoved, this,
-          &UnplacedComponentsDock::updateComponentsList);
+          &UnplacedComponentsDock::circuitComponentRemoved);
+  foreach (ComponentInstance* cmp,
+           mProject.getCircuit().getComponentInstances()) {
+    connect(cmp, &ComponentInstance::attributesChanged, this,
+            [this, cmp]() { componentAttributesChanged(*cmp); });
+  }
   updateComponentsList();
 
   // Connect UI events to methods.
@@ -157,19 +172,24 @@ int UnplacedComponentsDock::getUnplacedComponentsCount() const noexcept {
 void UnplacedComponentsDock::setBoard(Board* board) {
   if (mBoard) {
     disconnect(mBoard, &Board::deviceAdded, this,
-               &UnplacedComponentsDock::updateComponentsList);
+               &UnplacedComponentsDock::boardDeviceAdded);
     disconnect(mBoard, &Board::deviceRemoved, this,
-               &UnplacedComponentsDock::updateComponentsList);
+               &UnplacedComponentsDock::boardDeviceRemoved);
     mBoard = nullptr;
+    mDeviceCountOfComponent.clear();
+    mFootprintCountOfPackage.clear();
     updateComponentsList();
   }
 
   if (board) {
     mBoard = board;
     connect(mBoard, &Board::deviceAdded, this,
-            &UnplacedComponentsDock::updateComponentsList);
+            &UnplacedComponentsDock::boardDeviceAdded);
     connect(mBoard, &Board::deviceRemoved, this,
-            &UnplacedComponentsDock::updateComponentsList);
+            &UnplacedComponentsDock::boardDeviceRemoved);
+    foreach (const BI_Device* device, mBoard->getDeviceInstances()) {
+      updateDeviceStatistics(*device, 1);
+    }
     mNextPosition =
         Point::fromMm(0, -20).mappedToGrid(mBoard->getGridInterval());
     updateComponentsList();
@@ -183,7 +203,6 @@ void UnplacedComponentsDock::setBoard(Board* board) {
 void UnplacedComponentsDock::updateComponentsList() noexcept {
   if (mDisableListUpdate) return;
 
-  bool hasPreselectedDevices = false;
   int selectedIndex = mUi->lstUnplacedComponents->currentRow();
   setSelectedComponentInstance(nullptr);
   mUi->lstUnplacedComponents->clear();
@@ -191,45 +210,19 @@ void UnplacedComponentsDock::updateComponentsList() noexcept {
   if (mBoard) {
     QList<ComponentInstance*> componentsList =
         mProject.getCircuit().getComponentInstances().values();
-    const QMap<Uuid, BI_Device*> boardDeviceList = mBoard->getDeviceInstances();
 
     // Sort components manually using numeric sort.
-    Toolbox::sortNumeric(componentsList,
-                         [](const QCollator& cmp, const ComponentInstance* lhs,
-                            const ComponentInstance* rhs) {
-                           return cmp(*lhs->getName(), *rhs->getName());
-                         },
-                         Qt::CaseInsensitive, false);
+    std::sort(componentsList.begin(), componentsList.end(),
+              [this](const ComponentInstance* lhs,
+                     const ComponentInstance* rhs) {
+                return mCollator(*lhs->getName(), *rhs->getName());
+              });
 
+    // Since the components are sorted, each item gets appended to the end.
     foreach (ComponentInstance* component, componentsList) {
-      if (boardDeviceList.contains(component->getUuid())) continue;
-      if (component->getLibComponent().isSchematicOnly()) continue;
-      bool hasPreSelectedDevice = component->getDefaultDeviceUuid().has_value();
-
-      // Add component to list.
-      QString value = component->getValue(true)
-                          .split("\n", QString::SkipEmptyParts)
-                          .join("|");
-      QString libCmpName = *component->getLibComponent().getNames().value(
-          mProject.getLocaleOrder());
-      QStringList text = {*component->getName() % ":"};
-      if (hasPreSelectedDevice) {
-        text += "✔";
-        hasPreselectedDevices = true;
-      }
-      text += value;
-      text += libCmpName;
-      QListWidgetItem* item =
-          new QListWidgetItem(text.join(" "), mUi->lstUnplacedComponents);
-      item->setData(Qt::UserRole, component->getUuid().toStr());
-      QStringList tooltip;
-      tooltip += tr("Designator") % ": " % *component->getName();
-      tooltip += tr("Value") % ": " % value;
-      tooltip += tr("Component") % ": " % libCmpName;
-      if (hasPreSelectedDevice) {
-        tooltip += "✔ " % tr("Device is already pre-selected in schematics.");
+      if (isComponentUnplaced(*component)) {
+        addComponentListItem(*component);
       }
-      item->setToolTip(tooltip.join("\n"));
     }
 
     if (mUi->lstUnplacedComponents->count() > 0) {
@@ -238,6 +231,18 @@ void UnplacedComponentsDock::updateComponentsList() noexcept {
     }
   }
 
+  updateListActions();
+}
+
+void UnplacedComponentsDock::updateListActions() noexcept {
+  bool hasPreselectedDevices = false;
+  for (int i = 0; i < mUi->lstUnplacedComponents->count(); ++i) {
+    if (mUi->lstUnplacedComponents->item(i)->data(Qt::UserRole + 2).toBool()) {
+      hasPreselectedDevices = true;
+      break;
+    }
+  }
+
   if (hasPreselectedDevices) {
     mUi->btnAddAll->setVisible(false);
     mUi->btnAddPreSelected->setVisible(true);
@@ -252,6 +257,195 @@ void UnplacedComponentsDock::updateComponentsList() noexcept {
   emit unplacedComponentsCountChanged(getUnplacedComponentsCount());
 }
 
+void UnplacedComponentsDock::addComponentListItem(
+    ComponentInstance& cmp) noexcept {
+  // Binary search for the insert position to keep the list sorted.
+  int first = 0;
+  int last = mUi->lstUnplacedComponents->count();
+  while (first < last) {
+    int middle = (first + last) / 2;
+    QString name =
+        mUi->lstUnplacedComponents->item(middle)->data(Qt::UserRole + 1)
+            .toString();
+    if (mCollator.compare(name, *cmp.getName()) <= 0) {
+      first = middle + 1;
+    } else {
+      last = middle;
+    }
+  }
+
+  QListWidgetItem* item = new QListWidgetItem();
+  item->setData(Qt::UserRole, cmp.getUuid().toStr());
+  updateComponentListItem(*item, cmp);
+  mUi->lstUnplacedComponents->insertItem(first, item);
+}
+
+void UnplacedComponentsDock::updateComponentListItem(
+    QListWidgetItem& item, const ComponentInstance& cmp) const noexcept {
+  bool hasPreSelectedDevice = cmp.getDefaultDeviceUuid().has_value();
+  QString value =
+      cmp.getValue(true).split("\n", QString::SkipEmptyParts).join("|");
+  QString libCmpName =
+      *cmp.getLibComponent().getNames().value(mProject.getLocaleOrder());
+  QStringList text = {*cmp.getName() % ":"};
+  if (hasPreSelectedDevice) {
+    text += "✔";
+  }
+  text += value;
+  text += libCmpName;
+  QStringList tooltip;
+  tooltip += tr("Designator") % ": " % *cmp.getName();
+  tooltip += tr("Value") % ": " % value;
+  tooltip += tr("Component") % ": " % libCmpName;
+  if (hasPreSelectedDevice) {
+    tooltip += "✔ " % tr("Device is already pre-selected in schematics.");
+  }
+
+  item.setText(text.join(" "));
+  item.setData(Qt::UserRole + 1, *cmp.getName());
+  item.setData(Qt::UserRole + 2, hasPreSelectedDevice);
+  item.setToolTip(tooltip.join("\n"));
+}
+
+void UnplacedComponentsDock::removeComponentListItem(
+    const Uuid& cmpUuid) noexcept {
+  int index = findComponentListItem(cmpUuid);
+  if (index >= 0) {
+    // Note: If it was the current item, QListWidget selects another one.
+    delete mUi->lstUnplacedComponents->takeItem(index);
+  }
+}
+
+int UnplacedComponentsDock::findComponentListItem(const Uuid& cmpUuid) const
+    noexcept {
+  const QString uuidStr = cmpUuid.toStr();
+
+  // Fast path: Binary search by the component name.
+  if (const ComponentInstance* cmp =
+          mProject.getCircuit().getComponentInstanceByUuid(cmpUuid)) {
+    int first = 0;
+    int last = mUi->lstUnplacedComponents->count();
+    while (first < last) {
+      int middle = (first + last) / 2;
+      QString name =
+          mUi->lstUnplacedComponents->item(middle)->data(Qt::UserRole + 1)
+              .toString();
+      if (mCollator.compare(name, *cmp->getName()) < 0) {
+        first = middle + 1;
+      } else {
+        last = middle;
+      }
+    }
+    for (int i = first; i < mUi->lstUnplacedComponents->count(); ++i) {
+      const QListWidgetItem* item = mUi->lstUnplacedComponents->item(i);
+      if (item->data(Qt::UserRole).toString() == uuidStr) {
+        return i;
+      } else if (mCollator.compare(item->data(Qt::UserRole + 1).toString(),
+                                   *cmp->getName()) != 0) {
+        break;
+      }
+    }
+  }
+
+  // Slow path: The component has been renamed or removed in the meantime.
+  for (int i = 0; i < mUi->lstUnplacedComponents->count(); ++i) {
+    if (mUi->lstUnplacedComponents->item(i)->data(Qt::UserRole).toString() ==
+        uuidStr) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+bool UnplacedComponentsDock::isComponentUnplaced(
+    const ComponentInstance& cmp) const noexcept {
+  return mBoard && (!cmp.getLibComponent().isSchematicOnly()) &&
+      (!mBoard->getDeviceInstanceByComponentUuid(cmp.getUuid()));
+}
+
+void UnplacedComponentsDock::circuitComponentAdded(
+    ComponentInstance& cmp) noexcept {
+  connect(&cmp, &ComponentInstance::attributesChanged, this,
+          [this, &cmp]() { componentAttributesChanged(cmp); });
+  if (mDisableListUpdate) return;
+
+  if (isComponentUnplaced(cmp)) {
+    addComponentListItem(cmp);
+    updateListActions();
+  }
+}
+
+void UnplacedComponentsDock::circuitComponentRemoved(
+    ComponentInstance& cmp) noexcept {
+  disconnect(&cmp, nullptr, this, nullptr);
+  if (mDisableListUpdate) return;
+
+  removeComponentListItem(cmp.getUuid());
+  updateListActions();
+}
+
+void UnplacedComponentsDock::componentAttributesChanged(
+    ComponentInstance& cmp) noexcept {
+  if (mDisableListUpdate) return;
+
+  const int index = findComponentListItem(cmp.getUuid());
+  if (index < 0) return;  // Not listed, e.g. because it is placed already.
+
+  QListWidgetItem* item = mUi->lstUnplacedComponents->item(index);
+  if (item->data(Qt::UserRole + 1).toString() == *cmp.getName()) {
+    // The position in the sorted list is still correct.
+    updateComponentListItem(*item, cmp);
+  } else {
+    // Renamed, so move the item to keep the list sorted.
+    const bool isCurrent = (mUi->lstUnplacedComponents->currentRow() == index);
+    removeComponentListItem(cmp.getUuid());
+    addComponentListItem(cmp);
+    if (isCurrent) {
+      mUi->lstUnplacedComponents->setCurrentRow(
+          findComponentListItem(cmp.getUuid()));
+    }
+  }
+  updateListActions();
+}
+
+void UnplacedComponentsDock::boardDeviceAdded(BI_Device& device) noexcept {
+  updateDeviceStatistics(device, 1);
+  if (mDisableListUpdate) return;
+
+  removeComponentListItem(device.getComponentInstanceUuid());
+  updateListActions();
+}
+
+void UnplacedComponentsDock::boardDeviceRemoved(BI_Device& device) noexcept {
+  updateDeviceStatistics(device, -1);
+  if (mDisableListUpdate) return;
+
+  if (isComponentUnplaced(device.getComponentInstance())) {
+    addComponentListItem(device.getComponentInstance());
+    updateListActions();
+  }
+}
+
+void UnplacedComponentsDock::updateDeviceStatistics(const BI_Device& device,
+                                                    int delta) noexcept {
+  const Uuid cmpUuid =
+      device.getComponentInstance().getLibComponent().getUuid();
+  const Uuid devUuid = device.getLibDevice().getUuid();
+  QHash<Uuid, int>& devCounts = mDeviceCountOfComponent[cmpUuid];
+  devCounts[devUuid] += delta;
+  if (devCounts.value(devUuid) <= 0) {
+    devCounts.remove(devUuid);
+  }
+
+  const Uuid pkgUuid = device.getLibPackage().getUuid();
+  const Uuid fptUuid = device.getLibFootprint().getUuid();
+  QHash<Uuid, int>& fptCounts = mFootprintCountOfPackage[pkgUuid];
+  fptCounts[fptUuid] += delta;
+  if (fptCounts.value(fptUuid) <= 0) {
+    fptCounts.remove(fptUuid);
+  }
+}
+
 void UnplacedComponentsDock::currentComponentListItemChanged(
     QListWidgetItem* current, QListWidgetItem* previous) noexcept {
   Q_UNUSED(previous);
@@ -453,10 +647,10 @@ void UnplacedComponentsDock::addSelectedDeviceToBoard() noexcept {
         mSelectedComponent->getLibComponent().getUuid(), *mSelectedDeviceUuid);
     mLastFootprintOfPackage.insert(mSelectedPackage->getUuid(),
                                    *mSelectedFootprintUuid);
+    // Note: The list gets updated through the Board::deviceAdded() signal.
     emit addDeviceTriggered(*mSelectedComponent, *mSelectedDeviceUuid,
                             *mSelectedFootprintUuid);
   }
-  updateComponentsList();
 }
 
 void UnplacedComponentsDock::addSimilarDevicesToBoard() noexcept {
@@ -497,6 +691,9 @@ void UnplacedComponentsDock::autoAddDevicesToBoard(
   QScopedPointer<UndoCommandGroup> cmd(
       new UndoCommandGroup(tr("Add devices to board")));
 
+  // Query the library only once per library component.
+  DevicesCache devicesCache;
+
   for (int i = 0; i < mUi->lstUnplacedComponents->count(); i++) {
     tl::optional<Uuid> componentUuid = Uuid::tryFromString(
         mUi->lstUnplacedComponents->item(i)->data(Qt::UserRole).toString());
@@ -508,7 +705,7 @@ void UnplacedComponentsDock::autoAddDevicesToBoard(
         ((!libCmpUuidFilter) ||
          (component->getLibComponent().getUuid() == *libCmpUuidFilter))) {
       std::pair<QList<DeviceMetadata>, int> devices =
-          getAvailableDevices(*component);
+          getAvailableDevices(*component, &devicesCache);
       if ((devices.second >= 0) && (devices.second < devices.first.count())) {
         const DeviceMetadata& dev = devices.first.at(devices.second);
         tl::optional<Uuid> fptUuid = getSuggestedFootprint(dev.packageUuid);
@@ -527,6 +724,8 @@ void UnplacedComponentsDock::autoAddDevicesToBoard(
     }
   }
 
+  // Suspend the per-device list updates while executing the command, the
+  // caller rebuilds the list only once afterwards.
   mDisableListUpdate = true;
   try {
     mProjectEditor.getUndoStack().execCmd(cmd.take());
@@ -537,26 +736,88 @@ void UnplacedComponentsDock::autoAddDevicesToBoard(
 }
 
 std::pair<QList<UnplacedComponentsDock::DeviceMetadata>, int>
-    UnplacedComponentsDock::getAvailableDevices(ComponentInstance& cmp) const
+    UnplacedComponentsDock::getAvailableDevices(ComponentInstance& cmp,
+                                                DevicesCache* cache) const
     noexcept {
-  QList<DeviceMetadata> devices;
   Uuid cmpUuid = cmp.getLibComponent().getUuid();
+  QList<DeviceMetadata> devices;
+  if (cache && cache->contains(cmpUuid)) {
+    devices = cache->value(cmpUuid);
+  } else {
+    devices = getLibraryDevices(cmpUuid);
+    if (cache) {
+      cache->insert(cmpUuid, devices);
+    }
+  }
+  for (DeviceMetadata& device : devices) {
+    device.selectedInSchematic =
+        device.deviceUuid == cmp.getDefaultDeviceUuid();
+  }
+
+  // Prio 1: Use the device chosen in the schematic.
+  if (tl::optional<Uuid> dev = cmp.getDefaultDeviceUuid()) {
+    for (int i = 0; i < devices.count(); ++i) {
+      if (devices.at(i).deviceUuid == *dev) {
+        return std::make_pair(devices, i);
+      }
+    }
+    qWarning() << "Selected device" << *dev
+               << "not found in library, will use another device...";
+  }
+
+  // Prio 2: Use the device already used for the same component before.
+  auto lastDeviceIterator = mLastDeviceOfComponent.find(cmpUuid);
+  if ((lastDeviceIterator != mLastDeviceOfComponent.end())) {
+    for (int i = 0; i < devices.count(); ++i) {
+      if (devices.at(i).deviceUuid == *lastDeviceIterator) {
+        return std::make_pair(devices, i);
+      }
+    }
+  }
+
+  // Prio 3: Use the most used device in the current board.
+  const QHash<Uuid, int> devOccurences = mDeviceCountOfComponent.value(cmpUuid);
+  auto maxCountIt =
+      std::max_element(devOccurences.constBegin(), devOccurences.constEnd());
+  if (maxCountIt != devOccurences.constEnd()) {
+    for (int i = 0; i < devices.count(); ++i) {
+      if (devOccurences.value(devices.at(i).deviceUuid) == (*maxCountIt)) {
+        return std::make_pair(devices, i);
+      }
+    }
+  }
+
+  // Prio 4: Use the first device found in the project library.
+  for (int i = 0; i < devices.count(); ++i) {
+    if (devices.at(i).inProjectLibrary) {
+      return std::make_pair(devices, i);
+    }
+  }
+
+  // Prio 5: Use the first device found in the workspace library.
+  return std::make_pair(devices, devices.isEmpty() ? -1 : 0);
+}
+
+QList<UnplacedComponentsDock::DeviceMetadata>
+    UnplacedComponentsDock::getLibraryDevices(const Uuid& libCmpUuid) const
+    noexcept {
+  QList<DeviceMetadata> devices;
   QStringList localeOrder = mProject.getLocaleOrder();
 
   // Get matching devices in project library.
   QHash<Uuid, Device*> prjLibDev =
-      mProject.getLibrary().getDevicesOfComponent(cmpUuid);
+      mProject.getLibrary().getDevicesOfComponent(libCmpUuid);
   for (auto i = prjLibDev.constBegin(); i != prjLibDev.constEnd(); ++i) {
     devices.append(
         DeviceMetadata{i.key(), *i.value()->getNames().value(localeOrder),
-                       i.value()->getPackageUuid(), QString(), false});
+                       i.value()->getPackageUuid(), QString(), false, true});
   }
 
   // Get matching devices in workspace library.
   try {
     QSet<Uuid> wsLibDev =
         mProjectEditor.getWorkspace().getLibraryDb().getComponentDevices(
-            cmpUuid);  // can throw
+            libCmpUuid);  // can throw
     wsLibDev -= Toolbox::toSet(prjLibDev.keys());
     foreach (const Uuid& deviceUuid, wsLibDev) {
       // Get device metadata.
@@ -573,8 +834,8 @@ std::pair<QList<UnplacedComponentsDock::DeviceMetadata>, int>
           devFp, nullptr,
           &pkgUuid);  // can throw
 
-      devices.append(
-          DeviceMetadata{deviceUuid, devName, pkgUuid, QString(), false});
+      devices.append(DeviceMetadata{deviceUuid, devName, pkgUuid, QString(),
+                                    false, false});
     }
   } catch (const Exception& e) {
     qCritical() << "Failed to list devices in unplaced components dock:"
@@ -601,8 +862,6 @@ std::pair<QList<UnplacedComponentsDock::DeviceMetadata>, int>
                     << e.getMsg();
       }
     }
-    device.selectedInSchematic =
-        device.deviceUuid == cmp.getDefaultDeviceUuid();
   }
 
   // Sort by device name, using numeric sort.
@@ -612,57 +871,7 @@ std::pair<QList<UnplacedComponentsDock::DeviceMetadata>, int>
                          return cmp(lhs.deviceName, rhs.deviceName);
                        },
                        Qt::CaseInsensitive, false);
-
-  // Prio 1: Use the device chosen in the schematic.
-  if (tl::optional<Uuid> dev = cmp.getDefaultDeviceUuid()) {
-    for (int i = 0; i < devices.count(); ++i) {
-      if (devices.at(i).deviceUuid == *dev) {
-        return std::make_pair(devices, i);
-      }
-    }
-    qWarning() << "Selected device" << *dev
-               << "not found in library, will use another device...";
-  }
-
-  // Prio 2: Use the device already used for the same component before.
-  auto lastDeviceIterator = mLastDeviceOfComponent.find(cmpUuid);
-  if ((lastDeviceIterator != mLastDeviceOfComponent.end())) {
-    for (int i = 0; i < devices.count(); ++i) {
-      if (devices.at(i).deviceUuid == *lastDeviceIterator) {
-        return std::make_pair(devices, i);
-      }
-    }
-  }
-
-  // Prio 3: Use the most used device in the current board.
-  Q_ASSERT(mBoard);
-  QHash<Uuid, int> devOccurences;
-  foreach (const BI_Device* device, mBoard->getDeviceInstances()) {
-    Q_ASSERT(device);
-    if (device->getComponentInstance().getLibComponent().getUuid() ==
-        cmp.getLibComponent().getUuid()) {
-      ++devOccurences[device->getLibDevice().getUuid()];
-    }
-  }
-  auto maxCountIt =
-      std::max_element(devOccurences.constBegin(), devOccurences.constEnd());
-  if (maxCountIt != devOccurences.constEnd()) {
-    for (int i = 0; i < devices.count(); ++i) {
-      if (devOccurences.value(devices.at(i).deviceUuid) == (*maxCountIt)) {
-        return std::make_pair(devices, i);
-      }
-    }
-  }
-
-  // Prio 4: Use the first device found in the project library.
-  for (int i = 0; i < devices.count(); ++i) {
-    if (prjLibDev.contains(devices.at(i).deviceUuid)) {
-      return std::make_pair(devices, i);
-    }
-  }
-
-  // Prio 5: Use the first device found in the workspace library.
-  return std::make_pair(devices, devices.isEmpty() ? -1 : 0);
+  return devices;
 }
 
 tl::optional<Uuid> UnplacedComponentsDock::getSuggestedFootprint(
@@ -674,14 +883,8 @@ tl::optional<Uuid> UnplacedComponentsDock::getSuggestedFootprint(
   }
 
   // Prio 2: Use the most used footprint in the current board.
-  Q_ASSERT(mBoard);
-  QHash<Uuid, int> fptOccurences;
-  foreach (const BI_Device* device, mBoard->getDeviceInstances()) {
-    Q_ASSERT(device);
-    if (device->getLibPackage().getUuid() == libPkgUuid) {
-      ++fptOccurences[device->getLibFootprint().getUuid()];
-    }
-  }
+  const QHash<Uuid, int> fptOccurences =
+      mFootprintCountOfPackage.value(libPkgUuid);
   auto maxCountIt =
       std::max_element(fptOccurences.constBegin(), fptOccurences.constEnd());
   if (maxCountIt != fptOccurences.constEnd()) {
@@ -34,6 +34,7 @@
  ******************************************************************************/
 namespace librepcb {
 
+class BI_Device;
 class Board;
 class ComponentInstance;
 class Device;
@@ -77,8 +78,15 @@ class UnplacedComponentsDock final : public QDockWidget {
 
     /// Whether this device is pre-selected in schematics
     bool selectedInSchematic;
+
+    /// Whether this device is contained in the project library
+    bool inProjectLibrary;
   };
 
+  /// Cache of the available devices per library component UUID, used to
+  /// avoid repeated library queries when placing many devices at once
+  typedef QHash<Uuid, QList<DeviceMetadata>> DevicesCache;
+
 public:
   // Constructors / Destructor
   UnplacedComponentsDock() = delete;
@@ -103,6 +111,19 @@ signals:
 
 private:  // Methods
   void updateComponentsList() noexcept;
+  void updateListActions() noexcept;
+  void addComponentListItem(ComponentInstance& cmp) noexcept;
+  void updateComponentListItem(QListWidgetItem& item,
+                               const ComponentInstance& cmp) const noexcept;
+  void removeComponentListItem(const Uuid& cmpUuid) noexcept;
+  int findComponentListItem(const Uuid& cmpUuid) const noexcept;
+  bool isComponentUnplaced(const ComponentInstance& cmp) const noexcept;
+  void circuitComponentAdded(ComponentInstance& cmp) noexcept;
+  void circuitComponentRemoved(ComponentInstance& cmp) noexcept;
+  void componentAttributesChanged(ComponentInstance& cmp) noexcept;
+  void boardDeviceAdded(BI_Device& device) noexcept;
+  void boardDeviceRemoved(BI_Device& device) noexcept;
+  void updateDeviceStatistics(const BI_Device& device, int delta) noexcept;
   void currentComponentListItemChanged(QListWidgetItem* current,
                                        QListWidgetItem* previous) noexcept;
   void currentDeviceIndexChanged(int index) noexcept;
@@ -124,13 +145,17 @@ private:  // Methods
   /**
    * @brief Get all available devices for a specific component instance
    *
-   * @param cmp   The desired component instance.
+   * @param cmp     The desired component instance.
+   * @param cache   If not `nullptr`, the library query results are looked up
+   *                in and stored to this cache.
    *
    * @return  Metadata of all available devices, and the list index of the
    *          best match / most relevant device.
    */
   std::pair<QList<DeviceMetadata>, int> getAvailableDevices(
-      ComponentInstance& cmp) const noexcept;
+      ComponentInstance& cmp, DevicesCache* cache = nullptr) const noexcept;
+  QList<DeviceMetadata> getLibraryDevices(const Uuid& libCmpUuid) const
+      noexcept;
   tl::optional<Uuid> getSuggestedFootprint(const Uuid& libPkgUuid) const
       noexcept;
 
@@ -145,6 +170,11 @@ private:  // Data
   Point mNextPosition;
   QHash<Uuid, Uuid> mLastDeviceOfComponent;
   QHash<Uuid, Uuid> mLastFootprintOfPackage;
+  QCollator mCollator;
+
+  // Usage statistics of the current board, updated incrementally
+  QHash<Uuid, QHash<Uuid, int>> mDeviceCountOfComponent;  ///< cmp -> dev -> n
+  QHash<Uuid, QHash<Uuid, int>> mFootprintCountOfPackage;  ///< pkg -> fpt -> n
   QList<DeviceMetadata> mCurrentDevices;
 
   // Current selection
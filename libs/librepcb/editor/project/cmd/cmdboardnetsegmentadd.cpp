@@ -22,6 +22,8 @@
  ******************************************************************************/
 #include "cmdboardnetsegmentadd.h"
 
+#include "../../undostack.h"
+
 #include <librepcb/core/project/board/board.h>
 #include <librepcb/core/project/board/items/bi_netsegment.h>
 
@@ -73,10 +75,24 @@ bool CmdBoardNetSegmentAdd::performExecute() {
 
 void CmdBoardNetSegmentAdd::performUndo() {
   mBoard.removeNetSegment(*mNetSegment);  // can throw
+  scheduleAirWiresRebuild();
 }
 
 void CmdBoardNetSegmentAdd::performRedo() {
   mBoard.addNetSegment(*mNetSegment);  // can throw
+  scheduleAirWiresRebuild();
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void CmdBoardNetSegmentAdd::scheduleAirWiresRebuild() noexcept {
+  // Rebuild only once if many net segments are added within a command group
+  // (e.g. when pasting), and only after their elements have been added.
+  Board& board = mBoard;
+  UndoStack::deferSideEffect(board, "rebuild_air_wires",
+                             [&board]() { board.triggerAirWiresRebuild(); });
 }
 
 /*******************************************************************************
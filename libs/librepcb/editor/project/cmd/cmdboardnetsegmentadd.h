@@ -67,6 +67,8 @@ private:
   /// @copydoc ::librepcb::editor::UndoCommand::performRedo()
   void performRedo() override;
 
+  void scheduleAirWiresRebuild() noexcept;
+
   // Private Member Variables
 
   Board& mBoard;
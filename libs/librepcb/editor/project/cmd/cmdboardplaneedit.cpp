@@ -22,11 +22,15 @@
  ******************************************************************************/
 #include "cmdboardplaneedit.h"
 
+#include "../../undostack.h"
+
 #include <librepcb/core/project/board/board.h>
 #include <librepcb/core/types/layer.h>
 
 #include <QtCore>
 
+#include <algorithm>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -169,7 +173,7 @@ void CmdBoardPlaneEdit::performUndo() {
   mPlane.setKeepOrphans(mOldKeepOrphans);
 
   // rebuild all planes to see the changes
-  if (mDoRebuildOnChanges) mPlane.getBoard().rebuildAllPlanes();
+  if (mDoRebuildOnChanges) scheduleRebuildPlanes();
 }
 
 void CmdBoardPlaneEdit::performRedo() {
@@ -183,7 +187,55 @@ void CmdBoardPlaneEdit::performRedo() {
   mPlane.setKeepOrphans(mNewKeepOrphans);
 
   // rebuild all planes to see the changes
-  if (mDoRebuildOnChanges) mPlane.getBoard().rebuildAllPlanes();
+  if (mDoRebuildOnChanges) scheduleRebuildPlanes();
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void CmdBoardPlaneEdit::scheduleRebuildPlanes() noexcept {
+  Board& board = mPlane.getBoard();
+  const bool onlyOutlineModified = (mNewLayer == mOldLayer) &&
+      (mNewNetSignal == mOldNetSignal) && (mNewMinWidth == mOldMinWidth) &&
+      (mNewMinClearance == mOldMinClearance) &&
+      (mNewConnectStyle == mOldConnectStyle) &&
+      (mNewPriority == mOldPriority) && (mNewKeepOrphans == mOldKeepOrphans);
+  if (onlyOutlineModified) {
+    // Other planes are only affected around the old and new outline, so
+    // rebuilding them within that area is enough (usually much faster).
+    const PositiveLength tolerance(5000);
+    Point min(Length::max(), Length::max());
+    Point max(Length::min(), Length::min());
+    for (const Path* outline : {&mOldOutline, &mNewOutline}) {
+      for (const Vertex& vertex :
+           outline->flattenedArcs(tolerance).getVertices()) {
+        const Point& pos = vertex.getPos();
+        min.setX(std::min(min.getX(), pos.getX()));
+        min.setY(std::min(min.getY(), pos.getY()));
+        max.setX(std::max(max.getX(), pos.getX()));
+        max.setY(std::max(max.getY(), pos.getY()));
+      }
+    }
+    if (min.getX() <= max.getX()) {
+      min -= Point(*tolerance, *tolerance);
+      max += Point(*tolerance, *tolerance);
+      // Different areas are rebuilt one after another, identical ones once.
+      const QString name = QString("rebuild_planes_in_area_%1_%2_%3_%4")
+                               .arg(min.getX().toNm())
+                               .arg(min.getY().toNm())
+                               .arg(max.getX().toNm())
+                               .arg(max.getY().toNm());
+      UndoStack::deferSideEffect(board, name, [&board, min, max]() {
+        board.rebuildPlanesInArea(min, max);
+      });
+      return;
+    }
+  }
+
+  // Rebuild only once if many planes are modified within a command group.
+  UndoStack::deferSideEffect(board, "rebuild_all_planes",
+                             [&board]() { board.rebuildAllPlanes(); });
 }
 
 /*******************************************************************************
@@ -80,6 +80,8 @@ private:
   /// @copydoc ::librepcb::editor::UndoCommand::performRedo()
   void performRedo() override;
 
+  void scheduleRebuildPlanes() noexcept;
+
   // Private Member Variables
 
   // Attributes from the constructor
@@ -22,6 +22,8 @@
  ******************************************************************************/
 #include "cmddeviceinstanceadd.h"
 
+#include "../../undostack.h"
+
 #include <librepcb/core/project/board/board.h>
 #include <librepcb/core/project/board/items/bi_device.h>
 
@@ -55,10 +57,23 @@ bool CmdDeviceInstanceAdd::performExecute() {
 
 void CmdDeviceInstanceAdd::performUndo() {
   mDeviceInstance.getBoard().removeDeviceInstance(mDeviceInstance);
+  scheduleAirWiresRebuild();
 }
 
 void CmdDeviceInstanceAdd::performRedo() {
   mDeviceInstance.getBoard().addDeviceInstance(mDeviceInstance);
+  scheduleAirWiresRebuild();
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void CmdDeviceInstanceAdd::scheduleAirWiresRebuild() noexcept {
+  // Rebuild only once if many devices are added within a command group.
+  Board& board = mDeviceInstance.getBoard();
+  UndoStack::deferSideEffect(board, "rebuild_air_wires",
+                             [&board]() { board.triggerAirWiresRebuild(); });
 }
 
 /*******************************************************************************
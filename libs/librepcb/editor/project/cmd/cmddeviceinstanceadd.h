@@ -64,6 +64,8 @@ private:  // Methods
   /// @copydoc ::librepcb::editor::UndoCommand::performRedo()
   void performRedo() override;
 
+  void scheduleAirWiresRebuild() noexcept;
+
 private:  // Data
   BI_Device& mDeviceInstance;
 };
@@ -45,6 +45,7 @@
 #include "../boardeditor/graphicsitems/bgi_via.h"
 #include "cmdremoveboarditems.h"
 
+#include <librepcb/core/fileio/transactionaldirectory.h>
 #include <librepcb/core/library/dev/device.h>
 #include <librepcb/core/library/pkg/package.h>
 #include <librepcb/core/project/board/board.h>
@@ -77,9 +78,9 @@ namespace editor {
  *  Constructors / Destructor
  ******************************************************************************/
 
-CmdPasteBoardItems::CmdPasteBoardItems(BoardGraphicsScene& scene,
-                                       std::unique_ptr<BoardClipboardData> data,
-                                       const Point& posOffset) noexcept
+CmdPasteBoardItems::CmdPasteBoardItems(
+    BoardGraphicsScene& scene, std::shared_ptr<const BoardClipboardData> data,
+    const Point& posOffset) noexcept
   : UndoCommandGroup(tr("Paste Board Elements")),
     mScene(scene),
     mBoard(mScene.getBoard()),
@@ -130,8 +131,10 @@ bool CmdPasteBoardItems::performExecute() {
             mProject.getLibrary().getDevice(dev.libDeviceUuid)) {
       pgkUuid = libDev->getPackageUuid();
     } else {
-      std::unique_ptr<Device> newLibDev =
-          Device::open(mData->getDirectory("dev/" % dev.libDeviceUuid.toStr()));
+      std::unique_ptr<TransactionalDirectory> dir(new TransactionalDirectory());
+      mData->getDirectory("dev/" % dev.libDeviceUuid.toStr())
+          ->copyTo(*dir);  // can throw
+      std::unique_ptr<Device> newLibDev = Device::open(std::move(dir));
       pgkUuid = newLibDev->getPackageUuid();
       execNewChildCmd(new CmdProjectLibraryAddElement<Device>(
           mProject.getLibrary(), *newLibDev.release()));
@@ -140,8 +143,10 @@ bool CmdPasteBoardItems::performExecute() {
 
     // Copy new package to project library, if not existing already
     if (!mProject.getLibrary().getPackage(*pgkUuid)) {
-      std::unique_ptr<Package> newLibPgk =
-          Package::open(mData->getDirectory("pkg/" % pgkUuid->toStr()));
+      std::unique_ptr<TransactionalDirectory> dir(new TransactionalDirectory());
+      mData->getDirectory("pkg/" % pgkUuid->toStr())
+          ->copyTo(*dir);  // can throw
+      std::unique_ptr<Package> newLibPgk = Package::open(std::move(dir));
       execNewChildCmd(new CmdProjectLibraryAddElement<Package>(
           mProject.getLibrary(), *newLibPgk.release()));
     }
@@ -58,7 +58,7 @@ public:
   CmdPasteBoardItems() = delete;
   CmdPasteBoardItems(const CmdPasteBoardItems& other) = delete;
   CmdPasteBoardItems(BoardGraphicsScene& scene,
-                     std::unique_ptr<BoardClipboardData> data,
+                     std::shared_ptr<const BoardClipboardData> data,
                      const Point& posOffset) noexcept;
   ~CmdPasteBoardItems() noexcept;
 
@@ -75,7 +75,7 @@ private:  // Data
   BoardGraphicsScene& mScene;
   Board& mBoard;
   Project& mProject;
-  std::unique_ptr<BoardClipboardData> mData;
+  std::shared_ptr<const BoardClipboardData> mData;  ///< Might be shared
   Point mPosOffset;
 };
 
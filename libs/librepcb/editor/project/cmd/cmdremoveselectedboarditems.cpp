@@ -22,6 +22,7 @@
  ******************************************************************************/
 #include "cmdremoveselectedboarditems.h"
 
+#include "../../undostack.h"
 #include "../boardeditor/boardgraphicsscene.h"
 #include "../boardeditor/boardselectionquery.h"
 #include "cmdremoveboarditems.h"
@@ -44,7 +45,9 @@ namespace editor {
 
 CmdRemoveSelectedBoardItems::CmdRemoveSelectedBoardItems(
     BoardGraphicsScene& scene) noexcept
-  : UndoCommand(tr("Remove Board Items")), mScene(scene) {
+  : UndoCommand(tr("Remove Board Items")),
+    mScene(scene),
+    mPlanesRemoved(false) {
 }
 
 CmdRemoveSelectedBoardItems::~CmdRemoveSelectedBoardItems() noexcept {
@@ -79,15 +82,38 @@ bool CmdRemoveSelectedBoardItems::performExecute() {
   mWrappedCommand->removePolygons(query.getPolygons());
   mWrappedCommand->removeStrokeTexts(query.getStrokeTexts());
   mWrappedCommand->removeHoles(query.getHoles());
-  return mWrappedCommand->execute();
+  mPlanesRemoved = !query.getPlanes().isEmpty();
+  const bool modified = mWrappedCommand->execute();  // can throw
+  scheduleSideEffects();
+  return modified;
 }
 
 void CmdRemoveSelectedBoardItems::performUndo() {
-  mWrappedCommand->undo();
+  mWrappedCommand->undo();  // can throw
+  scheduleSideEffects();
 }
 
 void CmdRemoveSelectedBoardItems::performRedo() {
-  mWrappedCommand->redo();
+  mWrappedCommand->redo();  // can throw
+  scheduleSideEffects();
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void CmdRemoveSelectedBoardItems::scheduleSideEffects() noexcept {
+  // Executed once after all removed items have been processed, no matter how
+  // many net segments or devices are affected. Other planes may extend into
+  // the area of removed planes, which also affects the air wires, so the
+  // planes are rebuilt first.
+  Board& board = mScene.getBoard();
+  if (mPlanesRemoved) {
+    UndoStack::deferSideEffect(board, "rebuild_all_planes",
+                               [&board]() { board.rebuildAllPlanes(); });
+  }
+  UndoStack::deferSideEffect(board, "rebuild_air_wires",
+                             [&board]() { board.triggerAirWiresRebuild(); });
 }
 
 /*******************************************************************************
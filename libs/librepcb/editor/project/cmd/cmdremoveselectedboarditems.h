@@ -65,9 +65,12 @@ private:  // Methods
   /// @copydoc ::librepcb::editor::UndoCommand::performRedo()
   void performRedo() override;
 
+  void scheduleSideEffects() noexcept;
+
 private:  // Data
   BoardGraphicsScene& mScene;
   QScopedPointer<CmdRemoveBoardItems> mWrappedCommand;
+  bool mPlanesRemoved;
 };
 
 /*******************************************************************************
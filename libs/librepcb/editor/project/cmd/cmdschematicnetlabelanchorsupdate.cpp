@@ -22,6 +22,8 @@
  ******************************************************************************/
 #include "cmdschematicnetlabelanchorsupdate.h"
 
+#include "../../undostack.h"
+
 #include <librepcb/core/project/schematic/schematic.h>
 
 #include <QtCore>
@@ -55,11 +57,25 @@ bool CmdSchematicNetLabelAnchorsUpdate::performExecute() {
 }
 
 void CmdSchematicNetLabelAnchorsUpdate::performUndo() {
-  mSchematic.updateAllNetLabelAnchors();
+  scheduleUpdate();
 }
 
 void CmdSchematicNetLabelAnchorsUpdate::performRedo() {
-  mSchematic.updateAllNetLabelAnchors();
+  scheduleUpdate();
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void CmdSchematicNetLabelAnchorsUpdate::scheduleUpdate() noexcept {
+  // Update only once if this command is contained multiple times in a command
+  // group, and only after all other commands of the group are executed.
+  Schematic& schematic = mSchematic;
+  UndoStack::deferSideEffect(schematic, "update_all_net_label_anchors",
+                             [&schematic]() {
+                               schematic.updateAllNetLabelAnchors();
+                             });
 }
 
 /*******************************************************************************
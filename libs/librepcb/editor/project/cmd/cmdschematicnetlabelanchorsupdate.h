@@ -64,6 +64,8 @@ private:
   /// @copydoc ::librepcb::editor::UndoCommand::performRedo()
   void performRedo() override;
 
+  void scheduleUpdate() noexcept;
+
   // Private Member Variables
   Schematic& mSchematic;
 };
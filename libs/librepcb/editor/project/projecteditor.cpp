@@ -32,6 +32,7 @@
 #include <librepcb/core/fileio/transactionalfilesystem.h>
 #include <librepcb/core/project/erc/electricalrulecheck.h>
 #include <librepcb/core/project/project.h>
+#include <librepcb/core/project/projectsearchindex.h>
 #include <librepcb/core/workspace/workspace.h>
 #include <librepcb/core/workspace/workspacesettings.h>
 
@@ -54,6 +55,7 @@ ProjectEditor::ProjectEditor(
     mWorkspace(workspace),
     mProject(project),
     mHighlightedNetSignals(new QSet<const NetSignal*>()),
+    mSearchIndex(new ProjectSearchIndex(project)),
     mUndoStack(nullptr),
     mSchematicEditor(nullptr),
     mBoardEditor(nullptr),
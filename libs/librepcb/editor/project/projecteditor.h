@@ -45,6 +45,7 @@ class FilePath;
 class LengthUnit;
 class NetSignal;
 class Project;
+class ProjectSearchIndex;
 class Workspace;
 
 namespace editor {
@@ -93,6 +94,13 @@ public:
    */
   UndoStack& getUndoStack() const noexcept { return *mUndoStack; }
 
+  /**
+   * @brief Get the index of searchable objects in the project
+   *
+   * @return A reference to the ProjectSearchIndex object
+   */
+  ProjectSearchIndex& getSearchIndex() const noexcept { return *mSearchIndex; }
+
   // General Methods
 
   /**
@@ -265,6 +273,9 @@ private:  // Data
 
   std::shared_ptr<QSet<const NetSignal*>> mHighlightedNetSignals;
 
+  /// Index of searchable objects, shared by the schematic and board editor
+  QScopedPointer<ProjectSearchIndex> mSearchIndex;
+
   UndoStack* mUndoStack;  ///< See @ref doc_project_undostack
   SchematicEditor* mSchematicEditor;  ///< The schematic editor (GUI)
   BoardEditor* mBoardEditor;  ///< The board editor (GUI)
@@ -97,6 +97,7 @@ SGI_SymbolPin::SGI_SymbolPin(SI_SymbolPin& pin,
   updateHighlightedState();
 
   mPin.onEdited.attach(mOnPinEditedSlot);
+  mOnSymbolEditedSlot.setEventFilter({SGI_Symbol::Event::SelectionChanged});
   if (auto ptr = mSymbolGraphicsItem.lock()) {
     ptr->onEdited.attach(mOnSymbolEditedSlot);
   }
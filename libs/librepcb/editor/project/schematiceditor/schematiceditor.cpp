@@ -42,6 +42,7 @@
 #include "../projecteditor.h"
 #include "../projectsetupdialog.h"
 #include "fsm/schematiceditorfsm.h"
+#include "graphicsitems/sgi_netlabel.h"
 #include "graphicsitems/sgi_symbol.h"
 #include "schematicgraphicsscene.h"
 #include "schematicpagesdock.h"
@@ -50,10 +51,11 @@
 #include <librepcb/core/project/circuit/circuit.h>
 #include <librepcb/core/project/circuit/componentinstance.h>
 #include <librepcb/core/project/project.h>
+#include <librepcb/core/project/projectsearchindex.h>
+#include <librepcb/core/project/schematic/items/si_netlabel.h>
 #include <librepcb/core/project/schematic/items/si_symbol.h>
 #include <librepcb/core/project/schematic/schematic.h>
 #include <librepcb/core/project/schematic/schematicpainter.h>
-#include <librepcb/core/utils/toolbox.h>
 #include <librepcb/core/workspace/theme.h>
 #include <librepcb/core/workspace/workspace.h>
 #include <librepcb/core/workspace/workspacelibrarydb.h>
@@ -1070,54 +1072,69 @@ void SchematicEditor::renameSchematic(int index) noexcept {
   }
 }
 
-QList<SI_Symbol*> SchematicEditor::getSearchCandidates() noexcept {
-  QList<SI_Symbol*> candidates;
-  foreach (const Schematic* schematic, mProject.getSchematics()) {
-    Q_ASSERT(schematic);
-    candidates += schematic->getSymbols().values();
-  }
-  return candidates;
-}
-
 QStringList SchematicEditor::getSearchToolBarCompleterList() noexcept {
-  QStringList list;
-  foreach (SI_Symbol* symbol, getSearchCandidates()) {
-    list.append(symbol->getName());
-  }
-  return list;
+  return mProjectEditor.getSearchIndex().getTexts(
+      ProjectSearchIndex::ComponentName | ProjectSearchIndex::NetSignalName);
 }
 
 void SchematicEditor::goToSymbol(const QString& name, int index) noexcept {
+  // The search index returns the results in natural order already.
   QList<SI_Symbol*> symbolCandidates;
-  foreach (SI_Symbol* symbol, getSearchCandidates()) {
-    if (symbol->getName().startsWith(name, Qt::CaseInsensitive)) {
-      symbolCandidates.append(symbol);
+  QList<SI_NetLabel*> netLabelCandidates;
+  QSet<const NetSignal*> netSignals;
+  foreach (const ProjectSearchIndex::Entry& entry,
+           mProjectEditor.getSearchIndex().find(
+               name,
+               ProjectSearchIndex::ComponentName |
+                   ProjectSearchIndex::NetSignalName |
+                   ProjectSearchIndex::NetLabelName)) {
+    if (entry.component) {
+      QList<SI_Symbol*> symbols = entry.component->getSymbols().values();
+      std::sort(symbols.begin(), symbols.end(),
+                [](const SI_Symbol* lhs, const SI_Symbol* rhs) {
+                  return ProjectSearchIndex::calcSortKey(lhs->getName()) <
+                      ProjectSearchIndex::calcSortKey(rhs->getName());
+                });
+      symbolCandidates += symbols;
+    } else if (entry.netLabel) {
+      netLabelCandidates.append(entry.netLabel);
+      netSignals.insert(&entry.netLabel->getNetSignalOfNetSegment());
+    } else if (entry.netSignal) {
+      netSignals.insert(entry.netSignal);
     }
   }
 
-  // Sort by name for a natural order of results.
-  Toolbox::sortNumeric(
-      symbolCandidates,
-      [](const QCollator& cmp, const SI_Symbol* lhs, const SI_Symbol* rhs) {
-        return cmp(lhs->getName(), rhs->getName());
-      },
-      Qt::CaseInsensitive, false);
+  // If only net signals match, highlight them and go to their net labels.
+  if (symbolCandidates.isEmpty() && (!netSignals.isEmpty())) {
+    mProjectEditor.setHighlightedNetSignals(netSignals);
+  }
 
-  if (symbolCandidates.count()) {
+  const int count = symbolCandidates.isEmpty() ? netLabelCandidates.count()
+                                               : symbolCandidates.count();
+  if (count > 0) {
     while (index < 0) {
-      index += symbolCandidates.count();
+      index += count;
     }
-    index %= symbolCandidates.count();
-    SI_Symbol* symbol = symbolCandidates[index];
-    Schematic& schematic = symbol->getSchematic();
+    index %= count;
+    SI_Symbol* symbol =
+        symbolCandidates.isEmpty() ? nullptr : symbolCandidates[index];
+    SI_NetLabel* netLabel = symbol ? nullptr : netLabelCandidates[index];
+    Schematic& schematic =
+        symbol ? symbol->getSchematic() : netLabel->getSchematic();
     if (setActiveSchematicIndex(mProject.getSchematics().indexOf(&schematic)) &&
         mGraphicsScene) {
       mGraphicsScene->clearSelection();
-      if (auto item = mGraphicsScene->getSymbols().value(symbol)) {
+      QGraphicsItem* item = symbol
+          ? static_cast<QGraphicsItem*>(
+                mGraphicsScene->getSymbols().value(symbol).get())
+          : static_cast<QGraphicsItem*>(
+                mGraphicsScene->getNetLabels().value(netLabel).get());
+      if (item) {
         item->setSelected(true);
-        QRectF rect = item->mapRectToScene(item->childrenBoundingRect());
-        // Zoom to a rectangle relative to the maximum symbol dimension. The
-        // symbol is 1/4th of the screen.
+        QRectF rect = item->mapRectToScene(
+            symbol ? item->childrenBoundingRect() : item->boundingRect());
+        // Zoom to a rectangle relative to the maximum item dimension. The
+        // item is 1/4th of the screen.
         qreal margin =
             1.5f * std::max(rect.size().width(), rect.size().height());
         rect.adjust(-margin, -margin, margin, margin);
@@ -135,7 +135,6 @@ private:
   void addSchematic() noexcept;
   void removeSchematic(int index) noexcept;
   void renameSchematic(int index) noexcept;
-  QList<SI_Symbol*> getSearchCandidates() noexcept;
   QStringList getSearchToolBarCompleterList() noexcept;
   void goToSymbol(const QString& name, int index) noexcept;
   void updateEmptySchematicMessage() noexcept;
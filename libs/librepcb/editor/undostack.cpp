@@ -36,6 +36,51 @@
 namespace librepcb {
 namespace editor {
 
+/*******************************************************************************
+ *  Class UndoStack::SideEffectsScope
+ ******************************************************************************/
+
+namespace {
+
+// The stack whose operation is currently in progress, if any. Commands are
+// only executed in the GUI thread, so no locking is needed.
+UndoStack* sActiveStack = nullptr;
+
+void executeSideEffect(const QString& name,
+                       const std::function<void()>& action) noexcept {
+  try {
+    action();
+  } catch (const Exception& e) {
+    qCritical() << "Failed to execute side effect" << name << ":"
+                << e.getMsg();
+  } catch (const std::exception& e) {
+    qCritical() << "Failed to execute side effect" << name << ":" << e.what();
+  }
+}
+
+}  // namespace
+
+class UndoStack::SideEffectsScope final {
+public:
+  explicit SideEffectsScope(UndoStack& stack) noexcept
+    : mStack(stack), mPreviousStack(sActiveStack) {
+    sActiveStack = &mStack;
+    ++mStack.mSideEffectsScopeDepth;
+  }
+  SideEffectsScope(const SideEffectsScope& other) = delete;
+  ~SideEffectsScope() noexcept {
+    Q_ASSERT(mStack.mSideEffectsScopeDepth > 0);
+    --mStack.mSideEffectsScopeDepth;
+    sActiveStack = mPreviousStack;
+    mStack.flushSideEffects();
+  }
+  SideEffectsScope& operator=(const SideEffectsScope& rhs) = delete;
+
+private:
+  UndoStack& mStack;
+  UndoStack* mPreviousStack;
+};
+
 /*******************************************************************************
  *  Class UndoStackTransaction
  ******************************************************************************/
@@ -80,7 +125,9 @@ UndoStack::UndoStack() noexcept
   : QObject(nullptr),
     mCurrentIndex(0),
     mCleanIndex(0),
-    mActiveCommandGroup(nullptr) {
+    mActiveCommandGroup(nullptr),
+    mSideEffects(),
+    mSideEffectsScopeDepth(0) {
 }
 
 UndoStack::~UndoStack() noexcept {
@@ -157,6 +204,7 @@ bool UndoStack::execCmd(UndoCommand* cmd, bool forceKeepCmd) {
   // make sure "cmd" is deleted when going out of scope (e.g. because of an
   // exception)
   QScopedPointer<UndoCommand> cmdScopeGuard(cmd);
+  SideEffectsScope sideEffectsScope(*this);
 
   if (isCommandGroupActive()) {
     throw RuntimeError(
@@ -221,6 +269,7 @@ bool UndoStack::appendToCmdGroup(UndoCommand* cmd) {
   // make sure "cmd" is deleted when going out of scope (e.g. because of an
   // exception)
   QScopedPointer<UndoCommand> cmdScopeGuard(cmd);
+  SideEffectsScope sideEffectsScope(*this);
 
   if (!isCommandGroupActive()) {
     throw LogicError(__FILE__, __LINE__, tr("No command group active!"));
@@ -252,8 +301,10 @@ bool UndoStack::commitCmdGroup() {
   }
 
   // To finish the active command group, we only need to reset the pointer to
-  // the currently active command group
+  // the currently active command group. This also executes all side effects
+  // deferred since the group has been started.
   mActiveCommandGroup = nullptr;
+  flushSideEffects();
 
   // emit signals
   emit canUndoChanged(canUndo());
@@ -269,6 +320,7 @@ void UndoStack::abortCmdGroup() {
   Q_ASSERT(mActiveCommandGroup);
   Q_ASSERT(mCommands.last() == mActiveCommandGroup);
 
+  SideEffectsScope sideEffectsScope(*this);
   try {
     mActiveCommandGroup->undo();  // can throw (but should usually not)
     mActiveCommandGroup = nullptr;
@@ -295,6 +347,7 @@ void UndoStack::undo() {
     return;  // if a command group is active, undo() is not allowed
   }
 
+  SideEffectsScope sideEffectsScope(*this);
   try {
     mCommands[mCurrentIndex - 1]->undo();  // can throw (but should usually not)
     mCurrentIndex--;
@@ -317,6 +370,7 @@ void UndoStack::redo() {
     return;
   }
 
+  SideEffectsScope sideEffectsScope(*this);
   try {
     mCommands[mCurrentIndex]->redo();  // can throw (but should usually not)
     mCurrentIndex++;
@@ -334,6 +388,22 @@ void UndoStack::redo() {
   emit stateModified();
 }
 
+void UndoStack::deferSideEffect(QObject& object, const QString& name,
+                                const std::function<void()>& action) noexcept {
+  if (!sActiveStack) {
+    executeSideEffect(name, action);
+    return;
+  }
+
+  QVector<SideEffect>& sideEffects = sActiveStack->mSideEffects;
+  foreach (const SideEffect& sideEffect, sideEffects) {
+    if ((sideEffect.object == &object) && (sideEffect.name == name)) {
+      return;  // Already scheduled.
+    }
+  }
+  sideEffects.append(SideEffect{&object, name, action});
+}
+
 void UndoStack::clear() noexcept {
   if (mCommands.isEmpty()) {
     return;
@@ -365,6 +435,26 @@ void UndoStack::clear() noexcept {
   emit cleanChanged(true);
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void UndoStack::flushSideEffects() noexcept {
+  if ((mSideEffectsScopeDepth > 0) || isCommandGroupActive()) {
+    return;
+  }
+
+  // Side effects deferred by the actions themselves are executed immediately
+  // since no operation of this stack is in progress anymore.
+  QVector<SideEffect> sideEffects;
+  std::swap(sideEffects, mSideEffects);
+  for (const SideEffect& sideEffect : sideEffects) {
+    if (sideEffect.object) {  // Skip if the object has been destroyed.
+      executeSideEffect(sideEffect.name, sideEffect.action);
+    }
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -25,6 +25,8 @@
  ******************************************************************************/
 #include <QtCore>
 
+#include <functional>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -282,6 +284,29 @@ public:
    */
   void redo();
 
+  /**
+   * @brief Defer a side effect of a command until the undo stack operation
+   *        has finished
+   *
+   * Command groups and transactions often trigger the same expensive
+   * follow-up work (e.g. rebuilding all planes) once per child command. Side
+   * effects registered with this method while an undo stack operation
+   * (execute, undo, redo) is in progress are collected and executed only
+   * once when the outermost operation has finished. For command groups (and
+   * thus transactions), they are collected from #beginCmdGroup() until
+   * #commitCmdGroup() or #abortCmdGroup(), so they are executed once per
+   * group instead of once per appended command. Outside of any undo stack
+   * operation, the action is executed immediately.
+   *
+   * @param object    The object the side effect is applied to. If it gets
+   *                  destroyed in the meantime, the action is discarded.
+   * @param name      Name of the side effect. Together with `object`, it
+   *                  identifies duplicates, of which only the first is kept.
+   * @param action    The action to execute.
+   */
+  static void deferSideEffect(QObject& object, const QString& name,
+                              const std::function<void()>& action) noexcept;
+
   /**
    * @brief Clear the whole stack (delete all UndoCommand objects)
    *
@@ -301,6 +326,29 @@ signals:
   void stateModified();
 
 private:
+  /**
+   * @brief A side effect collected by #deferSideEffect()
+   */
+  struct SideEffect {
+    QPointer<QObject> object;
+    QString name;
+    std::function<void()> action;
+  };
+
+  /**
+   * @brief RAII helper to mark an undo stack operation as in progress
+   *
+   * When the outermost instance gets destroyed and no command group is
+   * active, all side effects collected with #deferSideEffect() are executed.
+   */
+  class SideEffectsScope;
+
+  /**
+   * @brief Execute all deferred side effects, unless an operation is still in
+   *        progress or a command group is active
+   */
+  void flushSideEffects() noexcept;
+
   /**
    * @brief This list holds all commands of the undo stack
    *
@@ -334,6 +382,19 @@ private:
    * nullptr.
    */
   UndoCommandGroup* mActiveCommandGroup;
+
+  /**
+   * @brief Side effects deferred until the current operation has finished
+   *
+   * See #deferSideEffect().
+   */
+  QVector<SideEffect> mSideEffects;
+
+  /**
+   * @brief Number of currently active ::librepcb::editor::UndoStack::
+   *        SideEffectsScope objects of this stack
+   */
+  int mSideEffectsScopeDepth;
 };
 
 /*******************************************************************************
@@ -50,6 +50,8 @@
 #include <QtCore>
 #include <QtWidgets>
 
+#include <algorithm>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -66,6 +68,7 @@ MeasureTool::MeasureTool(GraphicsView& view, const LengthUnit& unit,
     mView(&view),
     mUnit(unit),
     mSnapCandidates(),
+    mLazySnapCandidates(),
     mLastScenePos(),
     mCursorPos(),
     mCursorSnapped(false),
@@ -81,90 +84,105 @@ MeasureTool::~MeasureTool() noexcept {
  ******************************************************************************/
 
 void MeasureTool::setSymbol(const Symbol* symbol) noexcept {
-  mSnapCandidates.clear();
+  QSet<Point> candidates;
   if (symbol) {
-    mSnapCandidates |= snapCandidatesFromSymbol(*symbol, Transform());
+    candidates |= snapCandidatesFromSymbol(*symbol, Transform());
   }
+  setSnapCandidates(candidates);
 }
 
 void MeasureTool::setFootprint(const Footprint* footprint) noexcept {
-  mSnapCandidates.clear();
+  QSet<Point> candidates;
   if (footprint) {
-    mSnapCandidates |= snapCandidatesFromFootprint(*footprint, Transform());
+    candidates |= snapCandidatesFromFootprint(*footprint, Transform());
   }
+  setSnapCandidates(candidates);
 }
 
 void MeasureTool::setSchematic(const Schematic* schematic) noexcept {
-  mSnapCandidates.clear();
+  QSet<Point> candidates;
   if (schematic) {
     foreach (const SI_Symbol* symbol, schematic->getSymbols()) {
-      mSnapCandidates.insert(symbol->getPosition());
-      mSnapCandidates |=
+      candidates.insert(symbol->getPosition());
+      candidates |=
           snapCandidatesFromSymbol(symbol->getLibSymbol(), Transform(*symbol));
     }
     foreach (const SI_NetSegment* segment, schematic->getNetSegments()) {
       foreach (const SI_NetPoint* netpoint, segment->getNetPoints()) {
-        mSnapCandidates.insert(netpoint->getPosition());
+        candidates.insert(netpoint->getPosition());
       }
       foreach (const SI_NetLabel* netlabel, segment->getNetLabels()) {
-        mSnapCandidates.insert(netlabel->getPosition());
+        candidates.insert(netlabel->getPosition());
       }
     }
     foreach (const SI_Polygon* polygon, schematic->getPolygons()) {
-      mSnapCandidates |=
-          snapCandidatesFromPath(polygon->getPolygon().getPath());
+      candidates |= snapCandidatesFromPath(polygon->getPolygon().getPath());
     }
     foreach (const SI_Text* text, schematic->getTexts()) {
-      mSnapCandidates.insert(text->getPosition());
+      candidates.insert(text->getPosition());
     }
   }
+  setSnapCandidates(candidates);
 }
 
 void MeasureTool::setBoard(const Board* board) noexcept {
-  mSnapCandidates.clear();
+  QSet<Point> candidates;
+  QVector<LazySnapCandidates> lazyCandidates;
   if (board) {
     foreach (const BI_Device* device, board->getDeviceInstances()) {
-      mSnapCandidates.insert(device->getPosition());
-      mSnapCandidates |= snapCandidatesFromFootprint(device->getLibFootprint(),
-                                                     Transform(*device));
+      candidates.insert(device->getPosition());
+      candidates |= snapCandidatesFromFootprint(device->getLibFootprint(),
+                                                Transform(*device));
     }
     foreach (const BI_NetSegment* segment, board->getNetSegments()) {
       foreach (const BI_NetPoint* netpoint, segment->getNetPoints()) {
-        mSnapCandidates.insert(netpoint->getPosition());
+        candidates.insert(netpoint->getPosition());
       }
       foreach (const BI_Via* via, segment->getVias()) {
-        mSnapCandidates.insert(via->getPosition());
+        candidates.insert(via->getPosition());
         Path path = via->getVia().getOutline();
         path.addVertex(Point(via->getSize() / 2, 0));
         path.addVertex(Point(-via->getSize() / 2, 0));
         path.addVertex(Point(0, via->getSize() / 2));
         path.addVertex(Point(0, -via->getSize() / 2));
-        mSnapCandidates |=
+        candidates |=
             snapCandidatesFromPath(path.translated(via->getPosition()));
-        mSnapCandidates |= snapCandidatesFromCircle(via->getPosition(),
-                                                    *via->getDrillDiameter());
+        candidates |= snapCandidatesFromCircle(via->getPosition(),
+                                               *via->getDrillDiameter());
       }
     }
     foreach (const BI_Plane* plane, board->getPlanes()) {
-      mSnapCandidates |= snapCandidatesFromPath(plane->getOutline());
+      candidates |= snapCandidatesFromPath(plane->getOutline());
       foreach (const Path& fragment, plane->getFragments()) {
-        mSnapCandidates |= snapCandidatesFromPath(fragment);
+        if (!fragment.getVertices().isEmpty()) {
+          Point min = fragment.getVertices().first().getPos();
+          Point max = min;
+          for (const Vertex& vertex : fragment.getVertices()) {
+            min.setX(std::min(min.getX(), vertex.getPos().getX()));
+            min.setY(std::min(min.getY(), vertex.getPos().getY()));
+            max.setX(std::max(max.getX(), vertex.getPos().getX()));
+            max.setY(std::max(max.getY(), vertex.getPos().getY()));
+          }
+          lazyCandidates.append(
+              LazySnapCandidates{fragment, min, max, nullptr});
+        }
       }
     }
     foreach (const BI_Polygon* polygon, board->getPolygons()) {
-      mSnapCandidates |=
-          snapCandidatesFromPath(polygon->getPolygon().getPath());
+      candidates |= snapCandidatesFromPath(polygon->getPolygon().getPath());
     }
     foreach (const BI_StrokeText* text, board->getStrokeTexts()) {
-      mSnapCandidates.insert(text->getPosition());
+      candidates.insert(text->getPosition());
     }
     foreach (const BI_Hole* hole, board->getHoles()) {
       foreach (const Vertex& vertex, hole->getHole().getPath()->getVertices()) {
-        mSnapCandidates |= snapCandidatesFromCircle(
+        candidates |= snapCandidatesFromCircle(
             vertex.getPos(), *hole->getHole().getDiameter());
       }
     }
   }
+  setSnapCandidates(candidates);
+  mLazySnapCandidates = lazyCandidates;
 }
 
 void MeasureTool::enter() noexcept {
@@ -374,6 +392,36 @@ QSet<Point> MeasureTool::snapCandidatesFromCircle(
   return candidates;
 }
 
+void MeasureTool::setSnapCandidates(const QSet<Point>& candidates) noexcept {
+  mSnapCandidates = PointKdTree(candidates.values().toVector());
+  mLazySnapCandidates.clear();
+}
+
+tl::optional<Point> MeasureTool::findSnapCandidate(
+    const Point& pos, const UnsignedLength& maxDistance) noexcept {
+  tl::optional<Point> nearest = mSnapCandidates.findNearest(pos, maxDistance);
+  UnsignedLength distance =
+      nearest ? (pos - *nearest).getLength() : maxDistance;
+  for (LazySnapCandidates& lazy : mLazySnapCandidates) {
+    if ((pos.getX() < lazy.min.getX() - *distance) ||
+        (pos.getX() > lazy.max.getX() + *distance) ||
+        (pos.getY() < lazy.min.getY() - *distance) ||
+        (pos.getY() > lazy.max.getY() + *distance)) {
+      continue;  // Path is too far away.
+    }
+    if (!lazy.index) {
+      lazy.index = std::make_shared<PointKdTree>(
+          snapCandidatesFromPath(lazy.path).values().toVector());
+    }
+    if (tl::optional<Point> candidate =
+            lazy.index->findNearest(pos, distance)) {
+      nearest = candidate;
+      distance = (pos - *candidate).getLength();
+    }
+  }
+  return nearest;
+}
+
 void MeasureTool::updateCursorPosition(
     Qt::KeyboardModifiers modifiers) noexcept {
   if (!mView) {
@@ -383,20 +431,11 @@ void MeasureTool::updateCursorPosition(
   mCursorPos = mLastScenePos;
   mCursorSnapped = false;
   if (!modifiers.testFlag(Qt::ShiftModifier)) {
-    Point nearestCandidate;
-    Length nearestDistance(-1);
-    foreach (const Point& candidate, mSnapCandidates) {
-      const UnsignedLength distance = (mCursorPos - candidate).getLength();
-      if ((nearestDistance < 0) || (distance < nearestDistance)) {
-        nearestCandidate = candidate;
-        nearestDistance = *distance;
-      }
-    }
-
     const Point posOnGrid = mCursorPos.mappedToGrid(mView->getGridInterval());
-    const Length gridDistance = *(mCursorPos - posOnGrid).getLength();
-    if ((nearestDistance >= 0) && (nearestDistance <= gridDistance)) {
-      mCursorPos = nearestCandidate;
+    const UnsignedLength gridDistance = (mCursorPos - posOnGrid).getLength();
+    if (tl::optional<Point> candidate =
+            findSnapCandidate(mCursorPos, gridDistance)) {
+      mCursorPos = *candidate;
       mCursorSnapped = true;
     } else {
       mCursorPos = posOnGrid;
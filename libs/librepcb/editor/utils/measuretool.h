@@ -23,13 +23,17 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+#include <librepcb/core/geometry/path.h>
 #include <librepcb/core/types/lengthunit.h>
 #include <librepcb/core/types/point.h>
+#include <librepcb/core/utils/pointkdtree.h>
 #include <optional/tl/optional.hpp>
 
 #include <QtCore>
 #include <QtWidgets>
 
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -37,7 +41,6 @@ namespace librepcb {
 
 class Board;
 class Footprint;
-class Path;
 class Schematic;
 class Symbol;
 class Transform;
@@ -88,6 +91,19 @@ public:
 signals:
   void statusBarMessageChanged(const QString& message, int timeoutMs = -1);
 
+private:  // Types
+  /**
+   * Snap candidates of a path which are indexed only when the cursor comes
+   * close to the path. Used for plane fragments since they might consist of
+   * millions of vertices.
+   */
+  struct LazySnapCandidates {
+    Path path;
+    Point min;  ///< Bottom left corner of the bounding box
+    Point max;  ///< Top right corner of the bounding box
+    std::shared_ptr<const PointKdTree> index;  ///< nullptr if not built yet
+  };
+
 private:  // Methods
   static QSet<Point> snapCandidatesFromSymbol(
       const Symbol& symbol, const Transform& transform) noexcept;
@@ -96,6 +112,10 @@ private:  // Methods
   static QSet<Point> snapCandidatesFromPath(const Path& path) noexcept;
   static QSet<Point> snapCandidatesFromCircle(const Point& center,
                                               const Length& diameter) noexcept;
+  void setSnapCandidates(const QSet<Point>& candidates) noexcept;
+  tl::optional<Point> findSnapCandidate(const Point& pos,
+                                        const UnsignedLength& maxDistance)
+      noexcept;
   void updateCursorPosition(Qt::KeyboardModifiers modifiers) noexcept;
   void updateRulerPositions() noexcept;
   void updateStatusBarMessage() noexcept;
@@ -103,7 +123,8 @@ private:  // Methods
 private:  // Data
   QPointer<GraphicsView> mView;
   LengthUnit mUnit;
-  QSet<Point> mSnapCandidates;
+  PointKdTree mSnapCandidates;
+  QVector<LazySnapCandidates> mLazySnapCandidates;
   Point mLastScenePos;
   Point mCursorPos;
   bool mCursorSnapped;
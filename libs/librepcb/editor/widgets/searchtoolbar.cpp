@@ -22,8 +22,6 @@
  ******************************************************************************/
 #include "searchtoolbar.h"
 
-#include <librepcb/core/utils/toolbox.h>
-
 #include <QtCore>
 #include <QtWidgets>
 
@@ -94,9 +92,8 @@ void SearchToolBar::findPrevious() noexcept {
  ******************************************************************************/
 
 void SearchToolBar::updateCompleter() noexcept {
-  QStringList list =
+  const QStringList list =
       mCompleterListFunction ? mCompleterListFunction() : QStringList();
-  Toolbox::sortNumeric(list, Qt::CaseInsensitive, false);
 
   QCompleter* completer = new QCompleter(list);
   completer->setCaseSensitivity(Qt::CaseInsensitive);
@@ -45,6 +45,7 @@ class SearchToolBar final : public QToolBar {
   Q_OBJECT
 
 public:
+  /// Function returning the completer items, already sorted
   typedef std::function<QStringList()> CompleterListFunction;
 
   // Constructors / Destructor
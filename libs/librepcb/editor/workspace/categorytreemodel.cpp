@@ -137,23 +137,38 @@ void CategoryTreeModel::update() noexcept {
   QElapsedTimer t;
   t.start();
 
-  // Determine new items.
-  QVector<std::shared_ptr<Item>> items = getChilds(nullptr);
-
-  // Add virtual category for library elements with no category assigned.
+  // Load the whole tree at once, indexed by parent.
+  QMultiHash<tl::optional<Uuid>, Entry> entries;
+  tl::optional<Entry> uncategorized;
   try {
-    if (containsItems(tl::nullopt)) {
-      items.append(std::shared_ptr<Item>(
-          new Item{std::weak_ptr<Item>(),
-                   tl::nullopt,
-                   tr("(Without Category)"),
-                   tr("All library elements without a category"),
-                   {}}));
+    const QList<Entry> tree = listPackageCategories()
+        ? mLibrary.getCategoryTree<PackageCategory>(mLocaleOrder)
+        : mLibrary.getCategoryTree<ComponentCategory>(mLocaleOrder);
+    foreach (const Entry& entry, tree) {
+      if (entry.uuid) {
+        entries.insert(entry.parent, entry);
+      } else {
+        uncategorized = entry;
+      }
     }
   } catch (const Exception& e) {
     qCritical() << "Failed to update category tree model:" << e.getMsg();
   }
 
+  // Determine new items.
+  QSet<Uuid> ancestors;
+  QVector<std::shared_ptr<Item>> items = getChilds(nullptr, entries, ancestors);
+
+  // Add virtual category for library elements with no category assigned.
+  if (uncategorized && containsItems(*uncategorized)) {
+    items.append(std::shared_ptr<Item>(
+        new Item{std::weak_ptr<Item>(),
+                 tl::nullopt,
+                 tr("(Without Category)"),
+                 tr("All library elements without a category"),
+                 {}}));
+  }
+
   // Update tree with new items in a way which keeps the selection in views.
   updateModelItem(mRootItem, items);
 
@@ -161,35 +176,25 @@ void CategoryTreeModel::update() noexcept {
 }
 
 QVector<std::shared_ptr<CategoryTreeModel::Item>> CategoryTreeModel::getChilds(
-    std::shared_ptr<Item> parent) const noexcept {
+    std::shared_ptr<Item> parent,
+    const QMultiHash<tl::optional<Uuid>, Entry>& entries,
+    QSet<Uuid>& ancestors) const noexcept {
   QVector<std::shared_ptr<Item>> childs;
   tl::optional<Uuid> parentUuid = parent ? parent->uuid : tl::nullopt;
-  try {
-    QSet<Uuid> uuids = listPackageCategories()
-        ? mLibrary.getChilds<PackageCategory>(parentUuid)
-        : mLibrary.getChilds<ComponentCategory>(parentUuid);
-    foreach (const Uuid& uuid, uuids) {
-      std::shared_ptr<Item> child(
-          new Item{parent, uuid, QString(), QString(), {}});
-      child->childs = getChilds(child);
-      if (!child->childs.isEmpty() || listAll() || containsItems(uuid)) {
-        FilePath fp = listPackageCategories()
-            ? mLibrary.getLatest<PackageCategory>(uuid)
-            : mLibrary.getLatest<ComponentCategory>(uuid);
-        if (fp.isValid()) {
-          if (listPackageCategories()) {
-            mLibrary.getTranslations<PackageCategory>(
-                fp, mLocaleOrder, &child->text, &child->tooltip);
-          } else {
-            mLibrary.getTranslations<ComponentCategory>(
-                fp, mLocaleOrder, &child->text, &child->tooltip);
-          }
-        }
-        childs.append(child);
-      }
+  for (auto it = entries.find(parentUuid);
+       (it != entries.end()) && (it.key() == parentUuid); ++it) {
+    const Entry& entry = it.value();
+    if (ancestors.contains(*entry.uuid)) {
+      continue;  // Avoid endless recursion on circular parent relations.
+    }
+    std::shared_ptr<Item> child(new Item{parent, entry.uuid, entry.name,
+                                         entry.description, {}});
+    ancestors.insert(*entry.uuid);
+    child->childs = getChilds(child, entries, ancestors);
+    ancestors.remove(*entry.uuid);
+    if (!child->childs.isEmpty() || listAll() || containsItems(entry)) {
+      childs.append(child);
     }
-  } catch (const Exception& e) {
-    qCritical() << "Failed to update category tree model items:" << e.getMsg();
   }
 
   // Sort items by text.
@@ -204,23 +209,20 @@ QVector<std::shared_ptr<CategoryTreeModel::Item>> CategoryTreeModel::getChilds(
   return childs;
 }
 
-bool CategoryTreeModel::containsItems(const tl::optional<Uuid>& uuid) const {
+bool CategoryTreeModel::containsItems(const Entry& entry) const noexcept {
   if (listPackageCategories()) {
-    if (mFilters.testFlag(Filter::PkgCatWithPackages) &&
-        (mLibrary.getByCategory<Package>(uuid, 1).count() > 0)) {
+    if (mFilters.testFlag(Filter::PkgCatWithPackages) && (entry.packages > 0)) {
       return true;
     }
   } else {
-    if (mFilters.testFlag(Filter::CmpCatWithSymbols) &&
-        (mLibrary.getByCategory<Symbol>(uuid, 1).count() > 0)) {
+    if (mFilters.testFlag(Filter::CmpCatWithSymbols) && (entry.symbols > 0)) {
       return true;
     }
     if (mFilters.testFlag(Filter::CmpCatWithComponents) &&
-        (mLibrary.getByCategory<Component>(uuid, 1).count() > 0)) {
+        (entry.components > 0)) {
       return true;
     }
-    if (mFilters.testFlag(Filter::CmpCatWithDevices) &&
-        (mLibrary.getByCategory<Device>(uuid, 1).count() > 0)) {
+    if (mFilters.testFlag(Filter::CmpCatWithDevices) && (entry.devices > 0)) {
       return true;
     }
   }
@@ -24,6 +24,7 @@
  *  Includes
  ******************************************************************************/
 #include <librepcb/core/types/uuid.h>
+#include <librepcb/core/workspace/workspacelibrarydb.h>
 
 #include <QtCore>
 
@@ -33,9 +34,6 @@
  *  Namespace / Forward Declarations
  ******************************************************************************/
 namespace librepcb {
-
-class WorkspaceLibraryDb;
-
 namespace editor {
 
 /*******************************************************************************
@@ -53,6 +51,7 @@ class CategoryTreeModel final : public QAbstractItemModel {
     QString tooltip;
     QVector<std::shared_ptr<Item>> childs;
   };
+  typedef WorkspaceLibraryDb::CategoryTreeEntry Entry;
 
 public:
   // Types
@@ -102,9 +101,11 @@ public:
 
 private:  // Methods
   void update() noexcept;
-  QVector<std::shared_ptr<Item>> getChilds(std::shared_ptr<Item> parent) const
-      noexcept;
-  bool containsItems(const tl::optional<Uuid>& uuid) const;
+  QVector<std::shared_ptr<Item>> getChilds(
+      std::shared_ptr<Item> parent,
+      const QMultiHash<tl::optional<Uuid>, Entry>& entries,
+      QSet<Uuid>& ancestors) const noexcept;
+  bool containsItems(const Entry& entry) const noexcept;
   bool listAll() const noexcept;
   bool listPackageCategories() const noexcept;
   void updateModelItem(
@@ -27,6 +27,10 @@ Options:
                                      file containing custom settings. If not
                                      set, the settings from the boards will be
                                      used instead.
+  --autoroute                        Route all airwires between pads of the
+                                     boards automatically before running the DRC
+                                     or exports. Pass '--save' to save the
+                                     modified project to disk.
   --export-schematics <file>         Export schematics to given file(s).
                                      Existing files will be overwritten.
                                      Supported file extensions: pdf, svg, ***
@@ -0,0 +1,246 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/core/algorithm/delaunaytriangulation.h>
+
+#include <QtCore>
+
+#include <algorithm>
+#include <random>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class DelaunayTriangulationTest : public ::testing::Test {
+protected:
+  typedef DelaunayTriangulation::Edge Edge;
+
+  static QVector<Point> randomPoints(int count, qint64 range) noexcept {
+    std::mt19937_64 generator(42);
+    std::uniform_int_distribution<qint64> distribution(-range, range);
+    QVector<Point> points;
+    for (int i = 0; i < count; ++i) {
+      points.append(Point(distribution(generator), distribution(generator)));
+    }
+    return points;
+  }
+
+  static bool isCcw(const Point& a, const Point& b, const Point& c) noexcept {
+    const Point ab = b - a;
+    const Point ac = c - a;
+    return (ab.getX().toNm() * ac.getY().toNm()) >
+        (ab.getY().toNm() * ac.getX().toNm());
+  }
+
+  static bool isInCircle(const Point& a, const Point& b, const Point& c,
+                         const Point& d) noexcept {
+    // Only free of overflows for small coordinates, which is fine for tests.
+    const qint64 adx = (a - d).getX().toNm(), ady = (a - d).getY().toNm();
+    const qint64 bdx = (b - d).getX().toNm(), bdy = (b - d).getY().toNm();
+    const qint64 cdx = (c - d).getX().toNm(), cdy = (c - d).getY().toNm();
+    return ((adx * adx + ady * ady) * (bdx * cdy - cdx * bdy) +
+            (bdx * bdx + bdy * bdy) * (cdx * ady - adx * cdy) +
+            (cdx * cdx + cdy * cdy) * (adx * bdy - bdx * ady)) > 0;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(DelaunayTriangulationTest, testEmpty) {
+  EXPECT_EQ(QVector<Edge>{}, DelaunayTriangulation::triangulate({}));
+}
+
+TEST_F(DelaunayTriangulationTest, testOnePoint) {
+  EXPECT_EQ(QVector<Edge>{},
+            DelaunayTriangulation::triangulate({Point(100, 200)}));
+}
+
+TEST_F(DelaunayTriangulationTest, testTwoPoints) {
+  QVector<Point> points = {Point(300, 400), Point(100, 200)};
+  QVector<Edge> expected = {{0, 1}};
+  EXPECT_EQ(expected, DelaunayTriangulation::triangulate(points));
+}
+
+TEST_F(DelaunayTriangulationTest, testDuplicatePoints) {
+  QVector<Point> points = {
+      Point(100, 200),
+      Point(0, 0),
+      Point(100, 200),
+      Point(100, 200),
+  };
+  QVector<Edge> expected = {{0, 1}, {0, 2}, {0, 3}};
+  EXPECT_EQ(expected, DelaunayTriangulation::triangulate(points));
+}
+
+TEST_F(DelaunayTriangulationTest, testCollinearPoints) {
+  QVector<Point> points;
+  for (int i = 0; i < 100; ++i) {
+    points.append(Point(((i * 37) % 100) * 3000, ((i * 37) % 100) * 5000));
+  }
+  QVector<Edge> edges = DelaunayTriangulation::triangulate(points);
+  EXPECT_EQ(99, edges.count());
+  foreach (const Edge& edge, edges) {
+    const Point diff = points.at(edge.second) - points.at(edge.first);
+    EXPECT_EQ(3000, std::abs(diff.getX().toNm())) << edge.first << edge.second;
+  }
+}
+
+TEST_F(DelaunayTriangulationTest, testSquare) {
+  // Cocircular points, exactly one of the two diagonals must be added.
+  QVector<Point> points = {
+      Point(0, 0),
+      Point(1000, 0),
+      Point(1000, 1000),
+      Point(0, 1000),
+  };
+  QVector<Edge> edges = DelaunayTriangulation::triangulate(points);
+  EXPECT_EQ(5, edges.count());
+  EXPECT_NE(edges.contains({0, 2}), edges.contains({1, 3}));
+}
+
+TEST_F(DelaunayTriangulationTest, testGrid) {
+  // A triangulation of n points with h points on the convex hull has
+  // 3n-3-h edges.
+  QVector<Point> points;
+  for (int x = 0; x < 20; ++x) {
+    for (int y = 0; y < 20; ++y) {
+      points.append(Point(x * 2540000, y * 2540000));
+    }
+  }
+  EXPECT_EQ(3 * 400 - 3 - 76,
+            DelaunayTriangulation::triangulate(points).count());
+}
+
+TEST_F(DelaunayTriangulationTest, testHugeCoordinates) {
+  QVector<Point> points = randomPoints(1000, Length::max().toNm());
+  points.append(Point(Length::min(), Length::min()));
+  points.append(Point(Length::max(), Length::max()));
+  QVector<Edge> edges = DelaunayTriangulation::triangulate(points);
+
+  // All points must be connected.
+  QVector<int> groups;
+  for (int i = 0; i < points.count(); ++i) {
+    groups.append(i);
+  }
+  foreach (const Edge& edge, edges) {
+    const int oldGroup = groups.at(edge.second);
+    const int newGroup = groups.at(edge.first);
+    std::replace(groups.begin(), groups.end(), oldGroup, newGroup);
+  }
+  EXPECT_EQ(points.count(), groups.count(groups.first()));
+}
+
+TEST_F(DelaunayTriangulationTest, testDelaunayProperty) {
+  const QVector<Point> points = randomPoints(300, 10000);
+  const QVector<Edge> edges = DelaunayTriangulation::triangulate(points);
+  QSet<QPair<int, int>> edgeSet;
+  QVector<QVector<int>> neighbors(points.count());
+  foreach (const Edge& edge, edges) {
+    EXPECT_LT(edge.first, edge.second);
+    edgeSet.insert(qMakePair(edge.first, edge.second));
+    neighbors[edge.first].append(edge.second);
+  }
+  EXPECT_EQ(edges.count(), edgeSet.count());
+
+  // Circumcircles of all faces must not contain any point.
+  int faces = 0;
+  for (int a = 0; a < points.count(); ++a) {
+    foreach (int b, neighbors.at(a)) {
+      foreach (int c, neighbors.at(b)) {
+        if (!edgeSet.contains(qMakePair(a, c))) {
+          continue;
+        }
+        const Point& pa = points.at(a);
+        Point pb = points.at(b);
+        Point pc = points.at(c);
+        if (!isCcw(pa, pb, pc)) {
+          std::swap(pb, pc);
+        }
+        if (!isCcw(pa, pb, pc)) {
+          continue;
+        }
+        bool isFace = true;
+        foreach (const Point& p, points) {
+          if (isCcw(pa, pb, p) && isCcw(pb, pc, p) && isCcw(pc, pa, p)) {
+            isFace = false;
+          }
+        }
+        if (isFace) {
+          ++faces;
+          foreach (const Point& p, points) {
+            EXPECT_FALSE(isInCircle(pa, pb, pc, p))
+                << a << "/" << b << "/" << c;
+          }
+        }
+      }
+    }
+  }
+
+  // Every edge is either on the convex hull or shared by two faces.
+  const int hullEdges = 2 * edges.count() - 3 * faces;
+  EXPECT_GT(hullEdges, 2);
+  EXPECT_EQ(3 * points.count() - 3 - hullEdges, edges.count());
+}
+
+TEST_F(DelaunayTriangulationTest, testParallelResultIsDeterministic) {
+  const QVector<Point> points = randomPoints(5000, 100000000);
+  const QVector<Edge> expected =
+      DelaunayTriangulation::triangulate(points, points.count() + 1);
+  EXPECT_EQ(expected, DelaunayTriangulation::triangulate(points, 4));
+  EXPECT_EQ(expected, DelaunayTriangulation::triangulate(points, 100));
+}
+
+// Not run by default, use --gtest_also_run_disabled_tests to run it.
+TEST_F(DelaunayTriangulationTest, DISABLED_benchmarkTriangulate) {
+  const QVector<Point> points = randomPoints(100000, 250000000);
+  QElapsedTimer timer;
+  timer.start();
+  const QVector<Edge> sequential =
+      DelaunayTriangulation::triangulate(points, points.count() + 1);
+  qInfo() << "Sequential triangulation of" << points.count()
+          << "points:" << timer.elapsed() << "ms";
+
+  timer.restart();
+  const QVector<Edge> parallel = DelaunayTriangulation::triangulate(points);
+  qInfo() << "Parallel triangulation of" << points.count()
+          << "points:" << timer.elapsed() << "ms";
+
+  EXPECT_EQ(sequential, parallel);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -25,6 +25,7 @@
 
 #include <gtest/gtest.h>
 #include <librepcb/core/attribute/attributesubstitutor.h>
+#include <librepcb/core/utils/toolbox.h>
 
 #include <QtCore>
 
@@ -63,6 +64,37 @@ TEST_P(AttributeSubstitutorTest, testData) {
       << "Actual value: '" << qPrintable(output) << "'";
 }
 
+TEST(AttributeSubstitutorDependenciesTest, testLiteral) {
+  AttributeProviderDummy ap;
+  AttributeSubstitutor::Dependencies deps;
+  AttributeSubstitutor::substitute("Hello {KEY_1}", &ap, nullptr, &deps);
+  EXPECT_TRUE(deps.isEmpty());
+  EXPECT_FALSE(AttributeSubstitutor::dependenciesChanged(deps, &ap));
+}
+
+TEST(AttributeSubstitutorDependenciesTest, testRecursive) {
+  AttributeProviderDummy ap;
+  AttributeSubstitutor::Dependencies deps;
+  QString output =
+      AttributeSubstitutor::substitute("{{FOO or KEY_5}}", &ap, nullptr, &deps);
+  EXPECT_EQ("Recursive Recursive Normal value value value",
+            output.toStdString());
+  EXPECT_EQ((QSet<QString>{"FOO", "KEY_5", "KEY_4", "KEY_1"}),
+            Toolbox::toSet(deps.keys()));
+  EXPECT_EQ("", deps.value("FOO").toStdString());
+  EXPECT_EQ("Normal value", deps.value("KEY_1").toStdString());
+  EXPECT_FALSE(AttributeSubstitutor::dependenciesChanged(deps, &ap));
+
+  // simulate a modified attribute value
+  deps.insert("KEY_1", "Old value");
+  EXPECT_TRUE(AttributeSubstitutor::dependenciesChanged(deps, &ap));
+
+  // simulate a removed attribute
+  deps.insert("KEY_1", "Normal value");
+  deps.insert("KEY_9", "Old value");
+  EXPECT_TRUE(AttributeSubstitutor::dependenciesChanged(deps, &ap));
+}
+
 /*******************************************************************************
  *  Test Data
  ******************************************************************************/
@@ -163,6 +163,31 @@ TEST_F(TransactionalFileSystemTest, testWriteIsDelayedUntilSave) {
   EXPECT_EQ("content", FileUtils::readFile(fp));
 }
 
+TEST_F(TransactionalFileSystemTest, testWriteUnchangedFileIsSkipped) {
+  FilePath fp = mPopulatedDir.getPathTo("1/1a.txt");
+  TransactionalFileSystem fs(mPopulatedDir, true);
+  fs.write(fp.toRelative(mPopulatedDir), "modified");
+  fs.write(fp.toRelative(mPopulatedDir), "1a");  // Same as on disk.
+  EXPECT_EQ("1a", fs.read(fp.toRelative(mPopulatedDir)));
+  EXPECT_TRUE(fs.checkForModifications().isEmpty());
+
+  // Modify the file externally to verify it is not written anymore.
+  FileUtils::writeFile(fp, "external");
+  fs.save();
+  EXPECT_EQ("external", FileUtils::readFile(fp));
+}
+
+TEST_F(TransactionalFileSystemTest, testWriteUnchangedRemovedFile) {
+  FilePath fp = mPopulatedDir.getPathTo("1/1a.txt");
+  TransactionalFileSystem fs(mPopulatedDir, true);
+  fs.removeDirRecursively("1");
+  fs.write(fp.toRelative(mPopulatedDir), "1a");  // Same as on disk.
+  EXPECT_TRUE(fs.fileExists(fp.toRelative(mPopulatedDir)));
+  fs.save();
+  EXPECT_EQ("1a", FileUtils::readFile(fp));
+  EXPECT_FALSE(mPopulatedDir.getPathTo("1/1b.txt").isExistingFile());
+}
+
 TEST_F(TransactionalFileSystemTest, testRemoveExistingFile) {
   FilePath fp = mPopulatedDir.getPathTo("1/1a.txt");
   TransactionalFileSystem fs(mPopulatedDir, true);
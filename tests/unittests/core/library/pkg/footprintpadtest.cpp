@@ -127,6 +127,25 @@ TEST_F(FootprintPadTest, testSerializeAndDeserialize) {
   EXPECT_EQ(sexpr1.toByteArray(), sexpr2.toByteArray());
 }
 
+TEST_F(FootprintPadTest, testGeometryUpdatedOnChange) {
+  FootprintPad obj(Uuid::createRandom(), tl::nullopt, Point(0, 0), Angle(0),
+                   FootprintPad::Shape::RoundedRect, PositiveLength(100),
+                   PositiveLength(200), UnsignedLimitedRatio(Ratio::percent0()),
+                   Path(), MaskConfig::automatic(), MaskConfig::automatic(),
+                   FootprintPad::ComponentSide::Top, PadHoleList{});
+  const QVector<Path> outlines = obj.getGeometry().toOutlines();
+  EXPECT_EQ(Length(100), obj.getGeometry().getWidth());
+  EXPECT_EQ(Length(200), obj.getGeometry().getHeight());
+
+  obj.setWidth(PositiveLength(300));
+  EXPECT_EQ(Length(300), obj.getGeometry().getWidth());
+  EXPECT_NE(outlines, obj.getGeometry().toOutlines());
+
+  obj.getHoles().append(std::make_shared<PadHole>(
+      Uuid::createRandom(), PositiveLength(50), makeNonEmptyPath(Point(0, 0))));
+  EXPECT_EQ(1, obj.getGeometry().getHoles().count());
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -0,0 +1,271 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/geometry/polygon.h>
+#include <librepcb/core/library/cmp/component.h>
+#include <librepcb/core/library/dev/device.h>
+#include <librepcb/core/library/pkg/footprint.h>
+#include <librepcb/core/library/pkg/package.h>
+#include <librepcb/core/project/board/board.h>
+#include <librepcb/core/project/board/boardautorouter.h>
+#include <librepcb/core/project/board/items/bi_device.h>
+#include <librepcb/core/project/board/items/bi_netline.h>
+#include <librepcb/core/project/board/items/bi_netpoint.h>
+#include <librepcb/core/project/board/items/bi_netsegment.h>
+#include <librepcb/core/project/board/items/bi_polygon.h>
+#include <librepcb/core/project/circuit/circuit.h>
+#include <librepcb/core/project/circuit/componentinstance.h>
+#include <librepcb/core/project/circuit/componentsignalinstance.h>
+#include <librepcb/core/project/circuit/netclass.h>
+#include <librepcb/core/project/circuit/netsignal.h>
+#include <librepcb/core/project/project.h>
+#include <librepcb/core/project/projectlibrary.h>
+#include <librepcb/core/types/layer.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+/**
+ * @brief Routes small boards with single-pad SMT devices (1x1mm on top)
+ */
+class BoardAutoRouterTest : public ::testing::Test {
+protected:
+  FilePath mProjectDir;
+  std::unique_ptr<Project> mProject;
+  Board* mBoard;
+  Component* mComponent;
+  Device* mDevice;
+  Uuid mSignalUuid;
+  Uuid mSymbolVariantUuid;
+  Uuid mFootprintUuid;
+  int mDeviceCount;
+
+  BoardAutoRouterTest()
+    : mBoard(nullptr),
+      mComponent(nullptr),
+      mDevice(nullptr),
+      mSignalUuid(Uuid::createRandom()),
+      mSymbolVariantUuid(Uuid::createRandom()),
+      mFootprintUuid(Uuid::createRandom()),
+      mDeviceCount(0) {
+    mProjectDir = FilePath::getRandomTempPath();
+    mProject = Project::create(
+        std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory(
+            TransactionalFileSystem::openRW(mProjectDir))),
+        "project.lpp");
+    mBoard = new Board(
+        *mProject,
+        std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory()),
+        "board", Uuid::createRandom(), ElementName("Board"));
+    mProject->addBoard(*mBoard);
+
+    // Library elements.
+    const Version version = Version::fromString("0.1");
+    mComponent = new Component(Uuid::createRandom(), version, "",
+                               ElementName("Component"), "", "");
+    mComponent->getSignals().append(std::make_shared<ComponentSignal>(
+        mSignalUuid, CircuitIdentifier("1"), SignalRole::passive(), QString(),
+        false, false, false));
+    mComponent->getSymbolVariants().append(
+        std::make_shared<ComponentSymbolVariant>(mSymbolVariantUuid, "",
+                                                 ElementName("default"), ""));
+    mProject->getLibrary().addComponent(*mComponent);
+    Package* package =
+        new Package(Uuid::createRandom(), version, "", ElementName("Package"),
+                    "", "", Package::AssemblyType::Smt);
+    const Uuid padUuid = Uuid::createRandom();
+    package->getPads().append(
+        std::make_shared<PackagePad>(padUuid, CircuitIdentifier("1")));
+    std::shared_ptr<Footprint> footprint = std::make_shared<Footprint>(
+        mFootprintUuid, ElementName("default"), "");
+    footprint->getPads().append(std::make_shared<FootprintPad>(
+        padUuid, padUuid, Point(0, 0), Angle::deg0(),
+        FootprintPad::Shape::RoundedRect, PositiveLength(1000000),
+        PositiveLength(1000000), UnsignedLimitedRatio(Ratio::percent0()),
+        Path(), MaskConfig::off(), MaskConfig::off(),
+        FootprintPad::ComponentSide::Top, PadHoleList()));
+    package->getFootprints().append(footprint);
+    mProject->getLibrary().addPackage(*package);
+    mDevice = new Device(Uuid::createRandom(), version, "",
+                         ElementName("Device"), "", "", mComponent->getUuid(),
+                         package->getUuid());
+    mDevice->getPadSignalMap().append(
+        std::make_shared<DevicePadSignalMapItem>(padUuid, mSignalUuid));
+    mProject->getLibrary().addDevice(*mDevice);
+  }
+
+  virtual ~BoardAutoRouterTest() {
+    mProject.reset();
+    QDir(mProjectDir.toStr()).removeRecursively();
+  }
+
+  NetSignal& addNetSignal(const QString& name) {
+    Circuit& circuit = mProject->getCircuit();
+    NetSignal* netSignal =
+        new NetSignal(circuit, Uuid::createRandom(),
+                      *circuit.getNetClasses().first(),
+                      CircuitIdentifier(name), false);
+    circuit.addNetSignal(*netSignal);
+    return *netSignal;
+  }
+
+  BI_Device& addDevice(NetSignal& netSignal, const Point& pos) {
+    Circuit& circuit = mProject->getCircuit();
+    ComponentInstance* cmp = new ComponentInstance(
+        circuit, Uuid::createRandom(), *mComponent, mSymbolVariantUuid,
+        CircuitIdentifier(QString("U%1").arg(++mDeviceCount)),
+        mDevice->getUuid());
+    circuit.addComponentInstance(*cmp);
+    cmp->getSignalInstance(mSignalUuid)->setNetSignal(&netSignal);
+    BI_Device* device =
+        new BI_Device(*mBoard, *cmp, mDevice->getUuid(), mFootprintUuid, pos,
+                      Angle::deg0(), false, false);
+    mBoard->addDeviceInstance(*device);
+    return *device;
+  }
+
+  void addWall(const Point& p1, const Point& p2) {
+    BI_NetSegment* segment =
+        new BI_NetSegment(*mBoard, Uuid::createRandom(), nullptr);
+    BI_NetPoint* np1 = new BI_NetPoint(*segment, Uuid::createRandom(), p1);
+    BI_NetPoint* np2 = new BI_NetPoint(*segment, Uuid::createRandom(), p2);
+    BI_NetLine* netLine =
+        new BI_NetLine(*segment, Uuid::createRandom(), *np1, *np2,
+                       Layer::topCopper(), PositiveLength(200000));
+    segment->addElements({}, {np1, np2}, {netLine});
+    mBoard->addNetSegment(*segment);
+  }
+
+  BoardAutoRouter::Result route() {
+    BoardAutoRouter router(*mBoard, PositiveLength(200000),
+                           PositiveLength(600000), PositiveLength(300000),
+                           PositiveLength(250000));
+    return router.route();
+  }
+
+  QList<BI_NetSegment*> getSegmentsOfNet(const NetSignal& netSignal) const {
+    QList<BI_NetSegment*> segments;
+    foreach (BI_NetSegment* segment, mBoard->getNetSegments()) {
+      if (segment->getNetSignal() == &netSignal) {
+        segments.append(segment);
+      }
+    }
+    return segments;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(BoardAutoRouterTest, testStraightConnection) {
+  NetSignal& net = addNetSignal("N");
+  addDevice(net, Point(0, 0));
+  addDevice(net, Point(10000000, 0));
+
+  const BoardAutoRouter::Result result = route();
+  EXPECT_EQ(1, result.routedAirWires);
+  EXPECT_EQ(0, result.failedAirWires);
+  EXPECT_TRUE(mBoard->getAirWires().isEmpty());
+  const QList<BI_NetSegment*> segments = getSegmentsOfNet(net);
+  ASSERT_EQ(1, segments.count());
+  EXPECT_EQ(0, segments.first()->getVias().count());
+  EXPECT_EQ(1, segments.first()->getNetLines().count());
+}
+
+TEST_F(BoardAutoRouterTest, testLayerChangeAroundBlockedPath) {
+  // The wall on the top layer is too long to route around it, so the
+  // connection needs to change to the bottom layer and back.
+  NetSignal& net = addNetSignal("N");
+  addDevice(net, Point(0, 0));
+  addDevice(net, Point(10000000, 0));
+  addWall(Point(5000000, -30000000), Point(5000000, 30000000));
+
+  const BoardAutoRouter::Result result = route();
+  EXPECT_EQ(1, result.routedAirWires);
+  EXPECT_EQ(0, result.failedAirWires);
+  EXPECT_TRUE(mBoard->getAirWires().isEmpty());
+  const QList<BI_NetSegment*> segments = getSegmentsOfNet(net);
+  ASSERT_EQ(1, segments.count());
+  EXPECT_EQ(2, segments.first()->getVias().count());
+  bool crossesWall = false;
+  foreach (const BI_NetLine* netLine, segments.first()->getNetLines()) {
+    const Length x1 = netLine->getStartPoint().getPosition().getX();
+    const Length x2 = netLine->getEndPoint().getPosition().getX();
+    if ((netLine->getLayer() == Layer::topCopper()) &&
+        (std::min(x1, x2) < Length(5500000)) &&
+        (std::max(x1, x2) > Length(4500000))) {
+      crossesWall = true;
+    }
+  }
+  EXPECT_FALSE(crossesWall);
+}
+
+TEST_F(BoardAutoRouterTest, testRipUpAndReroute) {
+  // Only the top layer is usable.
+  BI_Polygon* polygon = new BI_Polygon(
+      *mBoard,
+      Polygon(Uuid::createRandom(), Layer::botCopper(), UnsignedLength(0),
+              true, false,
+              Path::rect(Point(-50000000, -50000000),
+                         Point(50000000, 50000000))));
+  mBoard->addPolygon(*polygon);
+
+  // Horizontal wall with a gap at x=2mm.
+  addWall(Point(-30000000, 0), Point(1500000, 0));
+  addWall(Point(2500000, 0), Point(30000000, 0));
+
+  // The shorter connection A is routed first, straight along y=1mm, which
+  // blocks the connection B through the gap. A needs to be ripped up and
+  // rerouted around the upper pad of B.
+  NetSignal& netA = addNetSignal("A");
+  addDevice(netA, Point(0, 1000000));
+  addDevice(netA, Point(4000000, 1000000));
+  NetSignal& netB = addNetSignal("B");
+  addDevice(netB, Point(2000000, -3000000));
+  addDevice(netB, Point(2000000, 3000000));
+
+  const BoardAutoRouter::Result result = route();
+  EXPECT_EQ(2, result.routedAirWires);
+  EXPECT_EQ(0, result.failedAirWires);
+  EXPECT_TRUE(mBoard->getAirWires().isEmpty());
+  EXPECT_EQ(1, getSegmentsOfNet(netA).count());
+  EXPECT_EQ(1, getSegmentsOfNet(netB).count());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -25,10 +25,14 @@
 #include <librepcb/core/fileio/fileutils.h>
 #include <librepcb/core/fileio/transactionalfilesystem.h>
 #include <librepcb/core/project/board/board.h>
+#include <librepcb/core/project/board/boardplanefragmentsbuilder.h>
+#include <librepcb/core/project/board/items/bi_netsegment.h>
 #include <librepcb/core/project/board/items/bi_plane.h>
+#include <librepcb/core/project/board/items/bi_via.h>
 #include <librepcb/core/project/project.h>
 #include <librepcb/core/project/projectloader.h>
 #include <librepcb/core/serialization/sexpression.h>
+#include <librepcb/core/utils/clipperhelpers.h>
 
 #include <QtCore>
 
@@ -50,13 +54,50 @@ namespace tests {
  * with the expected paths of all plane fragments. This test then re-calculates
  * all plane fragments and compares them with the expected fragments.
  */
-class BoardPlaneFragmentsBuilderTest : public ::testing::Test {};
+class BoardPlaneFragmentsBuilderTest : public ::testing::Test {
+protected:
+  static double getDifferenceArea(
+      const QVector<Path>& a, const QVector<Path>& b,
+      const tl::optional<Path>& clipArea = tl::nullopt) {
+    ClipperLib::Paths diff;
+    ClipperLib::Clipper c;
+    c.AddPaths(ClipperHelpers::convert(a, PositiveLength(5000)),
+               ClipperLib::ptSubject, true);
+    c.AddPaths(ClipperHelpers::convert(b, PositiveLength(5000)),
+               ClipperLib::ptClip, true);
+    c.Execute(ClipperLib::ctXor, diff, ClipperLib::pftNonZero,
+              ClipperLib::pftNonZero);
+    if (clipArea) {
+      ClipperLib::Clipper c2;
+      c2.AddPaths(diff, ClipperLib::ptSubject, true);
+      c2.AddPath(ClipperHelpers::convert(*clipArea, PositiveLength(5000)),
+                 ClipperLib::ptClip, true);
+      c2.Execute(ClipperLib::ctIntersection, diff, ClipperLib::pftNonZero,
+                 ClipperLib::pftNonZero);
+    }
+    double area = 0;
+    for (const ClipperLib::Path& path : diff) {
+      area += std::abs(ClipperLib::Area(path));
+    }
+    return area;
+  }
+
+  static ClipperLib::Path rect(qint64 left, qint64 top, qint64 right,
+                               qint64 bottom) {
+    return ClipperLib::Path{
+        ClipperLib::IntPoint(left, top),
+        ClipperLib::IntPoint(right, top),
+        ClipperLib::IntPoint(right, bottom),
+        ClipperLib::IntPoint(left, bottom),
+    };
+  }
+};
 
 /*******************************************************************************
  *  Test Methods
  ******************************************************************************/
 
-TEST(BoardPlaneFragmentsBuilderTest, testFragments) {
+TEST_F(BoardPlaneFragmentsBuilderTest, testFragments) {
   FilePath testDataDir(
       TEST_DATA_DIR
       "/unittests/librepcbproject/BoardPlaneFragmentsBuilderTest");
@@ -107,6 +148,161 @@ TEST(BoardPlaneFragmentsBuilderTest, testFragments) {
   EXPECT_EQ(expected.toStdString(), actual.toStdString());
 }
 
+TEST_F(BoardPlaneFragmentsBuilderTest, testRebuildWithCache) {
+  // open project from test data directory
+  FilePath projectFp(TEST_DATA_DIR "/projects/Nested Planes/project.lpp");
+  std::shared_ptr<TransactionalFileSystem> projectFs =
+      TransactionalFileSystem::openRO(projectFp.getParentDir());
+  ProjectLoader loader;
+  std::unique_ptr<Project> project =
+      loader.open(std::unique_ptr<TransactionalDirectory>(
+                      new TransactionalDirectory(projectFs)),
+                  projectFp.getFilename());  // can throw
+
+  // build planes without cache
+  Board* board = project->getBoards().first();
+  board->rebuildAllPlanes();
+  QMap<Uuid, QVector<Path>> expected;
+  foreach (const BI_Plane* plane, board->getPlanes()) {
+    expected.insert(plane->getUuid(), plane->getFragments());
+  }
+
+  // rebuild planes, now with the pad and via shapes taken from the cache
+  board->rebuildAllPlanes();
+  foreach (const BI_Plane* plane, board->getPlanes()) {
+    EXPECT_EQ(expected.value(plane->getUuid()), plane->getFragments());
+  }
+}
+
+TEST_F(BoardPlaneFragmentsBuilderTest, testRebuildInArea) {
+  // open project from test data directory
+  FilePath projectFp(TEST_DATA_DIR "/projects/Nested Planes/project.lpp");
+  std::shared_ptr<TransactionalFileSystem> projectFs =
+      TransactionalFileSystem::openRO(projectFp.getParentDir());
+  ProjectLoader loader;
+  std::unique_ptr<Project> project =
+      loader.open(std::unique_ptr<TransactionalDirectory>(
+                      new TransactionalDirectory(projectFs)),
+                  projectFp.getFilename());  // can throw
+  Board* board = project->getBoards().first();
+  board->rebuildAllPlanes();
+
+  // move a via and rebuild only the area around its old and new position
+  BI_Via* via = nullptr;
+  foreach (BI_NetSegment* segment, board->getNetSegments()) {
+    if (!segment->getVias().isEmpty()) {
+      via = segment->getVias().first();
+      break;
+    }
+  }
+  ASSERT_NE(nullptr, via);
+  const Point oldPos = via->getPosition();
+  const Point newPos = oldPos + Point(1000000, 500000);
+  const Point radius(*via->getSize(), *via->getSize());
+  via->setPosition(newPos);
+  board->rebuildPlanesInArea(oldPos - radius, newPos + radius);
+  QMap<Uuid, QVector<Path>> actual;
+  foreach (const BI_Plane* plane, board->getPlanes()) {
+    actual.insert(plane->getUuid(), plane->getFragments());
+  }
+
+  // the result must cover the same area as a full rebuild
+  board->rebuildAllPlanes();
+  foreach (const BI_Plane* plane, board->getPlanes()) {
+    const QVector<Path> stitched = actual.value(plane->getUuid());
+
+    // within the dirty area, the result must be exactly the same
+    const Path dirtyArea = Path::rect(oldPos - radius, newPos + radius);
+    EXPECT_EQ(0.0, getDifferenceArea(stitched, plane->getFragments(),
+                                     dirtyArea));
+
+    // the recalculated area (the dirty area plus the plane clearance) is
+    // stitched into the cached fragments, where the vertices on the seam
+    // might be off by 1nm due to rounding
+    const Point clearance(*plane->getMinClearance(),
+                          *plane->getMinClearance());
+    const Point size = newPos - oldPos + (radius + clearance) * 2;
+    const qreal seamLength = (size.getX() + size.getY()).toNm() * 2;
+    EXPECT_LE(getDifferenceArea(stitched, plane->getFragments()),
+              seamLength);  // 1nm x seam length
+  }
+}
+
+TEST_F(BoardPlaneFragmentsBuilderTest, testDifferOnlyWithin) {
+  const QVector<Path> oldFragments{
+      Path::rect(Point(0, 0), Point(10000000, 10000000)),
+      Path::rect(Point(20000000, 0), Point(30000000, 10000000)),
+  };
+  const Point min(-1000000, -1000000);
+  const Point max(11000000, 11000000);
+
+  // identical fragments
+  EXPECT_TRUE(BoardPlaneFragmentsBuilder::differOnlyWithin(
+      oldFragments, oldFragments, min, max));
+
+  // fragment modified within the area
+  QVector<Path> newFragments = oldFragments;
+  newFragments[0] = Path::rect(Point(0, 0), Point(5000000, 10000000));
+  EXPECT_TRUE(BoardPlaneFragmentsBuilder::differOnlyWithin(
+      oldFragments, newFragments, min, max));
+
+  // fragment outside of the area removed (e.g. as an orphan)
+  newFragments.removeLast();
+  EXPECT_FALSE(BoardPlaneFragmentsBuilder::differOnlyWithin(
+      oldFragments, newFragments, min, max));
+
+  // fragment modified across the border of the area
+  newFragments = oldFragments;
+  newFragments[0] = Path::rect(Point(0, 0), Point(15000000, 10000000));
+  EXPECT_FALSE(BoardPlaneFragmentsBuilder::differOnlyWithin(
+      oldFragments, newFragments, min, max));
+}
+
+TEST_F(BoardPlaneFragmentsBuilderTest, testSubtractCutOutsTiled) {
+  // 10x10mm area with a grid of 0.8mm cut-outs, many of them crossing the
+  // tile borders, and a thin diagonal cut-out crossing all tiles.
+  const ClipperLib::Paths area{rect(0, 0, 10000000, 10000000)};
+  ClipperLib::Paths cutOuts;
+  for (qint64 x = 500000; x < 10000000; x += 1500000) {
+    for (qint64 y = 500000; y < 10000000; y += 1500000) {
+      cutOuts.push_back(rect(x - 400000, y - 400000, x + 400000, y + 400000));
+    }
+  }
+  cutOuts.push_back(ClipperLib::Path{
+      ClipperLib::IntPoint(1000000, 1200000),
+      ClipperLib::IntPoint(1200000, 1000000),
+      ClipperLib::IntPoint(9000000, 8800000),
+      ClipperLib::IntPoint(8800000, 9000000),
+  });
+  const Length minWidth(300000);
+
+  const ClipperLib::Paths untiled =
+      BoardPlaneFragmentsBuilder::subtractCutOuts(area, cutOuts, minWidth, 1);
+  ASSERT_FALSE(untiled.empty());
+  for (int tilesPerAxis = 2; tilesPerAxis <= 4; ++tilesPerAxis) {
+    const ClipperLib::Paths tiled = BoardPlaneFragmentsBuilder::subtractCutOuts(
+        area, cutOuts, minWidth, tilesPerAxis);
+    // vertices on the tile borders might be off by 1nm due to rounding
+    const qreal tileBordersLength = (tilesPerAxis - 1) * 2 * 10000000;
+    EXPECT_LE(getDifferenceArea(ClipperHelpers::convert(untiled),
+                                ClipperHelpers::convert(tiled)),
+              tileBordersLength)
+        << tilesPerAxis << " tiles per axis";
+  }
+}
+
+TEST_F(BoardPlaneFragmentsBuilderTest, testSubtractCutOutsTiledError) {
+  // a cut-out outside of the coordinate range supported by Clipper makes
+  // some tiles fail, which must be reported after all tiles have finished
+  const ClipperLib::Paths area{rect(0, 0, 10000000, 10000000)};
+  const ClipperLib::Paths cutOuts{
+      rect(1000000, 1000000, qint64(1) << 62, 2000000),
+  };
+  EXPECT_THROW(BoardPlaneFragmentsBuilder::subtractCutOuts(
+                   area, cutOuts, Length(300000), 3),
+               Exception);
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -0,0 +1,210 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/geometry/polygon.h>
+#include <librepcb/core/geometry/via.h>
+#include <librepcb/core/project/board/board.h>
+#include <librepcb/core/project/board/boardtraceobstaclesbuilder.h>
+#include <librepcb/core/project/board/items/bi_netline.h>
+#include <librepcb/core/project/board/items/bi_netpoint.h>
+#include <librepcb/core/project/board/items/bi_netsegment.h>
+#include <librepcb/core/project/board/items/bi_polygon.h>
+#include <librepcb/core/project/board/items/bi_via.h>
+#include <librepcb/core/project/circuit/circuit.h>
+#include <librepcb/core/project/circuit/netclass.h>
+#include <librepcb/core/project/circuit/netsignal.h>
+#include <librepcb/core/project/project.h>
+#include <librepcb/core/types/layer.h>
+#include <librepcb/core/utils/traceobstacleindex.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class BoardTraceObstaclesBuilderTest : public ::testing::Test {
+protected:
+  FilePath mProjectDir;
+  std::unique_ptr<Project> mProject;
+  Board* mBoard;
+
+  BoardTraceObstaclesBuilderTest() : mBoard(nullptr) {
+    mProjectDir = FilePath::getRandomTempPath();
+    mProject = Project::create(
+        std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory(
+            TransactionalFileSystem::openRW(mProjectDir))),
+        "project.lpp");
+    mBoard = new Board(
+        *mProject,
+        std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory()),
+        "board", Uuid::createRandom(), ElementName("Board"));
+    mProject->addBoard(*mBoard);
+  }
+
+  virtual ~BoardTraceObstaclesBuilderTest() {
+    mProject.reset();
+    QDir(mProjectDir.toStr()).removeRecursively();
+  }
+
+  NetSignal& addNetSignal(const QString& name) {
+    Circuit& circuit = mProject->getCircuit();
+    NetSignal* netSignal =
+        new NetSignal(circuit, Uuid::createRandom(),
+                      *circuit.getNetClasses().first(),
+                      CircuitIdentifier(name), false);
+    circuit.addNetSignal(*netSignal);
+    return *netSignal;
+  }
+
+  BI_NetSegment& addTrace(NetSignal* netSignal, const Point& p1,
+                          const Point& p2) {
+    BI_NetSegment* segment =
+        new BI_NetSegment(*mBoard, Uuid::createRandom(), netSignal);
+    BI_NetPoint* np1 = new BI_NetPoint(*segment, Uuid::createRandom(), p1);
+    BI_NetPoint* np2 = new BI_NetPoint(*segment, Uuid::createRandom(), p2);
+    BI_NetLine* netLine =
+        new BI_NetLine(*segment, Uuid::createRandom(), *np1, *np2,
+                       Layer::topCopper(), PositiveLength(200000));
+    segment->addElements({}, {np1, np2}, {netLine});
+    mBoard->addNetSegment(*segment);
+    return *segment;
+  }
+
+  BI_NetSegment& addVia(NetSignal* netSignal, const Point& pos) {
+    BI_NetSegment* segment =
+        new BI_NetSegment(*mBoard, Uuid::createRandom(), netSignal);
+    BI_Via* via =
+        new BI_Via(*segment,
+                   Via(Uuid::createRandom(), pos, PositiveLength(700000),
+                       PositiveLength(300000)));
+    segment->addElements({via}, {}, {});
+    mBoard->addNetSegment(*segment);
+    return *segment;
+  }
+
+  static bool isFree(const TraceObstacleIndex& index, const Point& p1,
+                     const Point& p2,
+                     const tl::optional<Uuid>& net = tl::nullopt) {
+    return index.isFree(p1, p2, PositiveLength(200000),
+                        UnsignedLength(200000), net);
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(BoardTraceObstaclesBuilderTest, testEmptyBoard) {
+  BoardTraceObstaclesBuilder builder(*mBoard);
+  EXPECT_TRUE(builder.buildObstacles(Layer::topCopper())->isEmpty());
+}
+
+TEST_F(BoardTraceObstaclesBuilderTest, testTraces) {
+  NetSignal& gnd = addNetSignal("GND");
+  NetSignal& vcc = addNetSignal("VCC");
+  addTrace(&gnd, Point(0, 0), Point(10000000, 0));
+
+  BoardTraceObstaclesBuilder builder(*mBoard);
+  std::unique_ptr<TraceObstacleIndex> top =
+      builder.buildObstacles(Layer::topCopper());
+  std::unique_ptr<TraceObstacleIndex> bot =
+      builder.buildObstacles(Layer::botCopper());
+  EXPECT_EQ(1, top->count());
+  EXPECT_EQ(0, bot->count());
+
+  // Crossing the trace is only allowed for its own net.
+  const Point p1(5000000, -5000000);
+  const Point p2(5000000, 5000000);
+  EXPECT_TRUE(isFree(*top, p1, p2, gnd.getUuid()));
+  EXPECT_FALSE(isFree(*top, p1, p2, vcc.getUuid()));
+  EXPECT_FALSE(isFree(*top, p1, p2));
+}
+
+TEST_F(BoardTraceObstaclesBuilderTest, testViasAreOnAllLayers) {
+  addVia(&addNetSignal("GND"), Point(0, 0));
+
+  BoardTraceObstaclesBuilder builder(*mBoard);
+  EXPECT_EQ(1, builder.buildObstacles(Layer::topCopper())->count());
+  EXPECT_EQ(1, builder.buildObstacles(Layer::botCopper())->count());
+}
+
+TEST_F(BoardTraceObstaclesBuilderTest, testIgnoredSegmentWithoutNet) {
+  // Without net, a trace collides with all copper, including its own.
+  BI_NetSegment& segment = addTrace(nullptr, Point(0, 0), Point(5000000, 0));
+  addTrace(nullptr, Point(8000000, -5000000), Point(8000000, 5000000));
+  const Point start(5000000, 0);
+  const Point end(10000000, 0);
+
+  BoardTraceObstaclesBuilder builder(*mBoard);
+  std::unique_ptr<TraceObstacleIndex> all =
+      builder.buildObstacles(Layer::topCopper());
+  EXPECT_EQ(2, all->count());
+  EXPECT_FALSE(isFree(*all, start, Point(6000000, 0)));
+
+  // When ignoring the own segment, the trace can be continued up to the
+  // other segment without net.
+  std::unique_ptr<TraceObstacleIndex> others =
+      builder.buildObstacles(Layer::topCopper(), &segment);
+  EXPECT_EQ(1, others->count());
+  EXPECT_TRUE(isFree(*others, start, Point(6000000, 0)));
+  EXPECT_FALSE(isFree(*others, start, end));
+  const Point lastFree = others->findLastFreePoint(
+      start, end, PositiveLength(200000), UnsignedLength(200000));
+  EXPECT_GT(lastFree.getX(), Length(6000000));
+  EXPECT_LT(lastFree.getX(), Length(8000000));
+}
+
+TEST_F(BoardTraceObstaclesBuilderTest, testInsideOfUnfilledPolygonIsFree) {
+  BI_Polygon* polygon = new BI_Polygon(
+      *mBoard,
+      Polygon(Uuid::createRandom(), Layer::topCopper(), UnsignedLength(200000),
+              false, false,
+              Path::rect(Point(0, 0), Point(10000000, 10000000))));
+  mBoard->addPolygon(*polygon);
+
+  BoardTraceObstaclesBuilder builder(*mBoard);
+  std::unique_ptr<TraceObstacleIndex> index =
+      builder.buildObstacles(Layer::topCopper());
+  EXPECT_EQ(1, index->count());  // Not an additional area for the hole.
+  EXPECT_TRUE(isFree(*index, Point(3000000, 5000000), Point(7000000, 5000000)));
+  EXPECT_TRUE(
+      isFree(*index, Point(-3000000, 5000000), Point(-1000000, 5000000)));
+  EXPECT_FALSE(
+      isFree(*index, Point(-3000000, 5000000), Point(3000000, 5000000)));
+  EXPECT_FALSE(isFree(*index, Point(3000000, 300000), Point(7000000, 300000)));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
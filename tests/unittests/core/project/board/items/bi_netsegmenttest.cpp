@@ -0,0 +1,135 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/exceptions.h>
+#include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/project/board/board.h>
+#include <librepcb/core/project/board/items/bi_netline.h>
+#include <librepcb/core/project/board/items/bi_netpoint.h>
+#include <librepcb/core/project/board/items/bi_netsegment.h>
+#include <librepcb/core/project/project.h>
+#include <librepcb/core/types/layer.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class BI_NetSegmentTest : public ::testing::Test {
+protected:
+  FilePath mProjectDir;
+  std::unique_ptr<Project> mProject;
+  Board* mBoard;
+
+  BI_NetSegmentTest() : mBoard(nullptr) {
+    mProjectDir = FilePath::getRandomTempPath();
+    mProject = Project::create(
+        std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory(
+            TransactionalFileSystem::openRW(mProjectDir))),
+        "project.lpp");
+    mBoard = new Board(
+        *mProject,
+        std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory()),
+        "board", Uuid::createRandom(), ElementName("Board"));
+    mProject->addBoard(*mBoard);
+  }
+
+  virtual ~BI_NetSegmentTest() {
+    mProject.reset();
+    QDir(mProjectDir.toStr()).removeRecursively();
+  }
+
+  /**
+   * @brief Add net points and traces between them to a net segment
+   *
+   * @param segment   The net segment to add the elements to.
+   * @param count     Number of net points to add (along the X axis).
+   * @param connected If false, the trace in the middle is omitted.
+   */
+  void addChain(BI_NetSegment& segment, int count, bool connected) {
+    QList<BI_NetPoint*> netPoints;
+    QList<BI_NetLine*> netLines;
+    for (int i = 0; i < count; ++i) {
+      const Point pos(Length(i * qint64(100000)), Length(0));
+      netPoints.append(new BI_NetPoint(segment, Uuid::createRandom(), pos));
+      if ((i > 0) && (connected || (i != (count / 2)))) {
+        netLines.append(new BI_NetLine(
+            segment, Uuid::createRandom(), *netPoints.at(i - 1),
+            *netPoints.at(i), Layer::topCopper(), PositiveLength(100000)));
+      }
+    }
+    segment.addElements({}, netPoints, netLines);  // can throw
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(BI_NetSegmentTest, testAddConnectedElements) {
+  BI_NetSegment* segment =
+      new BI_NetSegment(*mBoard, Uuid::createRandom(), nullptr);
+  addChain(*segment, 4, true);
+  EXPECT_EQ(4, segment->getNetPoints().count());
+  EXPECT_EQ(3, segment->getNetLines().count());
+  mBoard->addNetSegment(*segment);
+}
+
+TEST_F(BI_NetSegmentTest, testAddUnconnectedElementsThrows) {
+  BI_NetSegment* segment =
+      new BI_NetSegment(*mBoard, Uuid::createRandom(), nullptr);
+  EXPECT_THROW(addChain(*segment, 4, false), LogicError);
+  EXPECT_EQ(0, segment->getNetPoints().count());
+  EXPECT_EQ(0, segment->getNetLines().count());
+  delete segment;
+}
+
+TEST_F(BI_NetSegmentTest, testAddLongChain) {
+  // The connectivity check must neither be quadratic nor recursive, so a long
+  // chain must neither take ages nor overflow the stack.
+  BI_NetSegment* segment =
+      new BI_NetSegment(*mBoard, Uuid::createRandom(), nullptr);
+  addChain(*segment, 100000, true);
+  EXPECT_EQ(100000, segment->getNetPoints().count());
+  EXPECT_EQ(99999, segment->getNetLines().count());
+  mBoard->addNetSegment(*segment);
+
+  BI_NetSegment* unconnected =
+      new BI_NetSegment(*mBoard, Uuid::createRandom(), nullptr);
+  EXPECT_THROW(addChain(*unconnected, 100000, false), LogicError);
+  delete unconnected;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
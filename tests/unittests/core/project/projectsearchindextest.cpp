@@ -0,0 +1,262 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/library/cmp/component.h>
+#include <librepcb/core/library/dev/device.h>
+#include <librepcb/core/library/pkg/footprint.h>
+#include <librepcb/core/library/pkg/package.h>
+#include <librepcb/core/project/board/board.h>
+#include <librepcb/core/project/board/items/bi_device.h>
+#include <librepcb/core/project/circuit/circuit.h>
+#include <librepcb/core/project/circuit/componentinstance.h>
+#include <librepcb/core/project/circuit/netclass.h>
+#include <librepcb/core/project/circuit/netsignal.h>
+#include <librepcb/core/project/project.h>
+#include <librepcb/core/project/projectlibrary.h>
+#include <librepcb/core/project/projectsearchindex.h>
+#include <librepcb/core/project/schematic/items/si_netlabel.h>
+#include <librepcb/core/project/schematic/items/si_netsegment.h>
+#include <librepcb/core/project/schematic/schematic.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class ProjectSearchIndexTest : public ::testing::Test {
+protected:
+  FilePath mProjectDir;
+  std::unique_ptr<Project> mProject;
+
+  ProjectSearchIndexTest() {
+    mProjectDir = FilePath::getRandomTempPath();
+    mProject = Project::create(
+        std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory(
+            TransactionalFileSystem::openRW(mProjectDir))),
+        "project.lpp");
+  }
+
+  virtual ~ProjectSearchIndexTest() {
+    mProject.reset();
+    QDir(mProjectDir.toStr()).removeRecursively();
+  }
+
+  NetSignal& addNetSignal(const QString& name) {
+    Circuit& circuit = mProject->getCircuit();
+    NetSignal* netSignal =
+        new NetSignal(circuit, Uuid::createRandom(),
+                      *circuit.getNetClasses().first(),
+                      CircuitIdentifier(name), false);
+    circuit.addNetSignal(*netSignal);
+    return *netSignal;
+  }
+
+  static QStringList getTexts(const QList<ProjectSearchIndex::Entry>& list) {
+    QStringList texts;
+    foreach (const ProjectSearchIndex::Entry& entry, list) {
+      texts.append(entry.text);
+    }
+    return texts;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(ProjectSearchIndexTest, testCalcSortKey) {
+  QStringList texts = {"R10", "r2", "R1", "C1", "R02", "R1A", "R"};
+  std::stable_sort(texts.begin(), texts.end(),
+                   [](const QString& a, const QString& b) {
+                     return ProjectSearchIndex::calcSortKey(a) <
+                         ProjectSearchIndex::calcSortKey(b);
+                   });
+  EXPECT_EQ(QStringList({"C1", "R", "R1", "R1A", "r2", "R02", "R10"}), texts);
+}
+
+TEST_F(ProjectSearchIndexTest, testCalcSortKeyLongNumbers) {
+  // The length prefix is clamped to 99, so numbers with 99 or more digits
+  // still sort after all shorter numbers.
+  const QString n99 = "X" + QString(99, '1');
+  const QString n120 = "X" + QString(120, '1');
+  EXPECT_LT(ProjectSearchIndex::calcSortKey("X98"),
+            ProjectSearchIndex::calcSortKey(n99));
+  EXPECT_LT(ProjectSearchIndex::calcSortKey("X" + QString(98, '9')),
+            ProjectSearchIndex::calcSortKey(n99));
+  EXPECT_LT(ProjectSearchIndex::calcSortKey(n99),
+            ProjectSearchIndex::calcSortKey(n120));
+}
+
+TEST_F(ProjectSearchIndexTest, testFind) {
+  addNetSignal("GND");
+  addNetSignal("N10");
+  addNetSignal("N9");
+  ProjectSearchIndex index(*mProject);
+  addNetSignal("n1");  // added after index creation
+
+  EXPECT_EQ(QStringList({"n1", "N9", "N10"}),
+            getTexts(index.find("N", ProjectSearchIndex::NetSignalName)));
+  EXPECT_EQ(QStringList({"N10"}),
+            getTexts(index.find("N1", ProjectSearchIndex::NetSignalName)));
+  EXPECT_EQ(QStringList({"n1", "N10"}),
+            getTexts(index.find("1", ProjectSearchIndex::NetSignalName, true)));
+  EXPECT_EQ(QStringList(),
+            getTexts(index.find("N", ProjectSearchIndex::ComponentName)));
+  EXPECT_EQ(QStringList({"GND", "n1", "N9", "N10"}),
+            index.getTexts(ProjectSearchIndex::NetSignalName));
+}
+
+TEST_F(ProjectSearchIndexTest, testUpdate) {
+  NetSignal& gnd = addNetSignal("GND");
+  NetSignal& vcc = addNetSignal("VCC");
+  ProjectSearchIndex index(*mProject);
+  EXPECT_EQ(QStringList({"GND", "VCC"}),
+            index.getTexts(ProjectSearchIndex::NetSignalName));
+
+  mProject->getCircuit().setNetSignalName(gnd, CircuitIdentifier("AGND"),
+                                          false);
+  EXPECT_EQ(QStringList({"AGND", "VCC"}),
+            index.getTexts(ProjectSearchIndex::NetSignalName));
+  EXPECT_EQ(QStringList(),
+            getTexts(index.find("G", ProjectSearchIndex::NetSignalName)));
+
+  mProject->getCircuit().removeNetSignal(vcc);
+  delete &vcc;
+  EXPECT_EQ(QStringList({"AGND"}),
+            index.getTexts(ProjectSearchIndex::NetSignalName));
+}
+
+TEST_F(ProjectSearchIndexTest, testNetLabels) {
+  NetSignal& netSignal = addNetSignal("CLK");
+  Schematic* schematic = new Schematic(
+      *mProject,
+      std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory()),
+      "schematic", Uuid::createRandom(), ElementName("Schematic"));
+  mProject->addSchematic(*schematic);
+  SI_NetSegment* netSegment =
+      new SI_NetSegment(*schematic, Uuid::createRandom(), netSignal);
+  schematic->addNetSegment(*netSegment);
+  SI_NetLabel* netLabel1 = new SI_NetLabel(
+      *netSegment,
+      NetLabel(Uuid::createRandom(), Point(0, 0), Angle::deg0(), false));
+  netSegment->addNetLabel(*netLabel1);
+  ProjectSearchIndex index(*mProject);
+  SI_NetLabel* netLabel2 = new SI_NetLabel(
+      *netSegment,
+      NetLabel(Uuid::createRandom(), Point(0, 0), Angle::deg0(), false));
+  netSegment->addNetLabel(*netLabel2);  // added after index creation
+
+  QList<ProjectSearchIndex::Entry> entries =
+      index.find("c", ProjectSearchIndex::NetLabelName);
+  ASSERT_EQ(2, entries.count());
+  EXPECT_EQ("CLK", entries.at(0).text);
+  EXPECT_FALSE(entries.at(0).netSignal);
+  EXPECT_EQ(QSet<SI_NetLabel*>({netLabel1, netLabel2}),
+            QSet<SI_NetLabel*>({entries.at(0).netLabel,
+                                entries.at(1).netLabel}));
+
+  // Renaming the net signal renames its net labels.
+  mProject->getCircuit().setNetSignalName(netSignal, CircuitIdentifier("SCK"),
+                                          false);
+  EXPECT_EQ(0, index.find("c", ProjectSearchIndex::NetLabelName).count());
+  EXPECT_EQ(2, index.find("s", ProjectSearchIndex::NetLabelName).count());
+
+  netSegment->removeNetLabel(*netLabel2);
+  delete netLabel2;
+  entries = index.find("s", ProjectSearchIndex::NetLabelName);
+  ASSERT_EQ(1, entries.count());
+  EXPECT_EQ(netLabel1, entries.first().netLabel);
+
+  // Removing the whole net segment removes its net labels.
+  schematic->removeNetSegment(*netSegment);
+  EXPECT_EQ(0, index.find("s", ProjectSearchIndex::NetLabelName).count());
+  delete netSegment;
+}
+
+TEST_F(ProjectSearchIndexTest, testDevices) {
+  const Version version = Version::fromString("0.1");
+  Component* component = new Component(Uuid::createRandom(), version, "",
+                                       ElementName("Component"), "", "");
+  const Uuid symbolVariantUuid = Uuid::createRandom();
+  component->getSymbolVariants().append(
+      std::make_shared<ComponentSymbolVariant>(symbolVariantUuid, "",
+                                               ElementName("default"), ""));
+  mProject->getLibrary().addComponent(*component);
+  Package* package =
+      new Package(Uuid::createRandom(), version, "", ElementName("SOT23"), "",
+                  "", Package::AssemblyType::Smt);
+  const Uuid footprintUuid = Uuid::createRandom();
+  package->getFootprints().append(std::make_shared<Footprint>(
+      footprintUuid, ElementName("default"), ""));
+  mProject->getLibrary().addPackage(*package);
+  Device* device = new Device(Uuid::createRandom(), version, "",
+                              ElementName("BC847"), "", "",
+                              component->getUuid(), package->getUuid());
+  mProject->getLibrary().addDevice(*device);
+
+  Circuit& circuit = mProject->getCircuit();
+  ComponentInstance* cmp = new ComponentInstance(
+      circuit, Uuid::createRandom(), *component, symbolVariantUuid,
+      CircuitIdentifier("Q1"), device->getUuid());
+  circuit.addComponentInstance(*cmp);
+  ProjectSearchIndex index(*mProject);
+  Board* board = new Board(
+      *mProject,
+      std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory()),
+      "board", Uuid::createRandom(), ElementName("Board"));
+  mProject->addBoard(*board);  // added after index creation
+  BI_Device* bi = new BI_Device(*board, *cmp, device->getUuid(), footprintUuid,
+                                Point(0, 0), Angle::deg0(), false, false);
+  board->addDeviceInstance(*bi);
+
+  QList<ProjectSearchIndex::Entry> entries =
+      index.find("bc", ProjectSearchIndex::DeviceName);
+  ASSERT_EQ(1, entries.count());
+  EXPECT_EQ("BC847", entries.first().text);
+  EXPECT_EQ(bi, entries.first().device);
+  EXPECT_FALSE(entries.first().component);
+  entries = index.find("23", ProjectSearchIndex::PackageName, true);
+  ASSERT_EQ(1, entries.count());
+  EXPECT_EQ(bi, entries.first().device);
+
+  // Removing the board removes its devices.
+  mProject->removeBoard(*board, true);
+  EXPECT_EQ(QStringList(),
+            index.getTexts(ProjectSearchIndex::DeviceName |
+                           ProjectSearchIndex::PackageName));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -21,9 +21,13 @@
  *  Includes
  ******************************************************************************/
 #include <gtest/gtest.h>
+#include <librepcb/core/fileio/fileutils.h>
 #include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/project/board/board.h>
+#include <librepcb/core/project/circuit/circuit.h>
 #include <librepcb/core/project/project.h>
 #include <librepcb/core/project/projectloader.h>
+#include <librepcb/core/project/schematic/schematic.h>
 
 #include <QtCore>
 
@@ -140,6 +144,53 @@ TEST_F(ProjectTest, testSave) {
   }
 }
 
+TEST_F(ProjectTest, testSaveOnlyModifiedFiles) {
+  // create new project with a schematic and a board
+  std::unique_ptr<Project> project =
+      Project::create(createDir(), mProjectFile.getFilename());
+  Schematic* schematic = new Schematic(
+      *project,
+      std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory()),
+      "schematic", Uuid::createRandom(), ElementName("Schematic"));
+  project->addSchematic(*schematic);
+  Board* board = new Board(
+      *project,
+      std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory()),
+      "board", Uuid::createRandom(), ElementName("Board"));
+  project->addBoard(*board);
+  EXPECT_TRUE(project->getCircuit().isModified());
+  EXPECT_TRUE(schematic->isModified());
+  EXPECT_TRUE(board->isModified());
+
+  // save project
+  project->save();
+  project->getDirectory().getFileSystem()->save();
+  EXPECT_FALSE(project->getCircuit().isModified());
+  EXPECT_FALSE(schematic->isModified());
+  EXPECT_FALSE(board->isModified());
+
+  // modify the files on disk to detect whether they are written again
+  const FilePath circuitFp = mProjectDir.getPathTo("circuit/circuit.lp");
+  const FilePath schematicFp =
+      mProjectDir.getPathTo("schematics/schematic/schematic.lp");
+  const FilePath boardFp = mProjectDir.getPathTo("boards/board/board.lp");
+  FileUtils::writeFile(circuitFp, "untouched");
+  FileUtils::writeFile(schematicFp, "untouched");
+  FileUtils::writeFile(boardFp, "untouched");
+
+  // modify only the board and save project
+  board->setGridUnit(LengthUnit::inches());
+  EXPECT_FALSE(project->getCircuit().isModified());
+  EXPECT_FALSE(schematic->isModified());
+  EXPECT_TRUE(board->isModified());
+  project->save();
+  project->getDirectory().getFileSystem()->save();
+  EXPECT_FALSE(board->isModified());
+  EXPECT_EQ("untouched", FileUtils::readFile(circuitFp));
+  EXPECT_EQ("untouched", FileUtils::readFile(schematicFp));
+  EXPECT_TRUE(FileUtils::readFile(boardFp).contains("inch"));
+}
+
 TEST_F(ProjectTest, testIfLastModifiedDateTimeIsUpdatedOnSave) {
   // create new project
   std::unique_ptr<Project> project =
@@ -134,6 +134,22 @@ TEST_F(SQLiteDatabaseTest, testTransactionScopeGuardRollback) {
   EXPECT_THROW(db.clearTable("test"), Exception);
 }
 
+TEST_F(SQLiteDatabaseTest, testBulkLoadMode) {
+  SQLiteDatabase db(mTempDbFilePath);
+  auto getPragma = [&db](const QString& pragma) {
+    QSqlQuery query = db.prepareQuery("PRAGMA " % pragma);
+    db.exec(query);
+    EXPECT_TRUE(query.first());
+    return query.value(0).toInt();
+  };
+  db.setBulkLoadMode(true);
+  EXPECT_EQ(1, getPragma("synchronous"));  // NORMAL
+  EXPECT_EQ(2, getPragma("temp_store"));  // MEMORY
+  db.setBulkLoadMode(false);
+  EXPECT_EQ(2, getPragma("synchronous"));  // FULL
+  EXPECT_EQ(0, getPragma("temp_store"));  // DEFAULT
+}
+
 TEST_F(SQLiteDatabaseTest, testMultipleInstancesInSameThread) {
   SQLiteDatabase db1(mTempDbFilePath);
   SQLiteDatabase db2(mTempDbFilePath);
@@ -73,6 +73,11 @@ TEST_P(UuidTest, testToStr) {
   }
 }
 
+TEST(UuidTest, testSize) {
+  // Only the binary value is stored, the string is built on demand.
+  EXPECT_EQ(16U, sizeof(Uuid));
+}
+
 TEST_P(UuidTest, testOperatorAssign) {
   const UuidTestData& data = GetParam();
 
@@ -180,6 +185,47 @@ TEST_P(UuidTest, testTryFromString) {
   }
 }
 
+TEST_P(UuidTest, testOperatorComparisonsMatchStringOrder) {
+  const UuidTestData& data = GetParam();
+
+  if (data.valid) {
+    Uuid uuid1 = Uuid::fromString(data.uuid);
+    // Compare against UUIDs which differ only in the first or last digit, to
+    // cover both halves of the binary representation.
+    QList<Uuid> others;
+    for (const QString& digit : {"0", "7", "f"}) {
+      QString first = data.uuid;
+      first.replace(0, 1, digit);
+      QString last = data.uuid;
+      last.replace(35, 1, digit);
+      others << Uuid::fromString(first) << Uuid::fromString(last);
+    }
+    foreach (const Uuid& uuid2, others) {
+      EXPECT_EQ(uuid1.toStr() == uuid2.toStr(), uuid1 == uuid2);
+      EXPECT_EQ(uuid1.toStr() != uuid2.toStr(), uuid1 != uuid2);
+      EXPECT_EQ(uuid1.toStr() < uuid2.toStr(), uuid1 < uuid2);
+      EXPECT_EQ(uuid1.toStr() > uuid2.toStr(), uuid1 > uuid2);
+      EXPECT_EQ(uuid1.toStr() <= uuid2.toStr(), uuid1 <= uuid2);
+      EXPECT_EQ(uuid1.toStr() >= uuid2.toStr(), uuid1 >= uuid2);
+    }
+  }
+}
+
+TEST_P(UuidTest, testHash) {
+  const UuidTestData& data = GetParam();
+
+  if (data.valid) {
+    Uuid uuid1 = Uuid::fromString(data.uuid);
+    Uuid uuid2 = Uuid::fromString(data.uuid);
+    EXPECT_EQ(qHash(uuid1, 0), qHash(uuid2, 0));
+    EXPECT_EQ(qHash(uuid1, 42), qHash(uuid2, 42));
+    EXPECT_EQ(qHash(tl::make_optional(uuid1), 42),
+              qHash(tl::make_optional(uuid2), 42));
+    QSet<Uuid> set{uuid1};
+    EXPECT_TRUE(set.contains(uuid2));
+  }
+}
+
 TEST_P(UuidTest, testSerialize) {
   const UuidTestData& data = GetParam();
   if (data.valid) {
@@ -0,0 +1,111 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/core/utils/clipperareaindex.h>
+#include <librepcb/core/utils/clipperhelpers.h>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class ClipperAreaIndexTest : public ::testing::Test {
+protected:
+  static ClipperLib::Paths createRingArea() {
+    // Circular ring with many vertices, similar to a board clearance area.
+    const PositiveLength tolerance(10000);
+    return ClipperHelpers::convert(
+        QVector<Path>{Path::circle(PositiveLength(100000000)),
+                      Path::circle(PositiveLength(90000000))},
+        tolerance);
+  }
+
+  static ClipperLib::Paths createSquare(const Point& center) {
+    return ClipperHelpers::convert(
+        QVector<Path>{Path::centeredRect(PositiveLength(2000000),
+                                         PositiveLength(2000000))
+                          .translated(center)},
+        PositiveLength(5000));
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(ClipperAreaIndexTest, testEmptyArea) {
+  const ClipperAreaIndex index(ClipperLib::Paths{});
+  EXPECT_TRUE(index.getArea().empty());
+  EXPECT_FALSE(index.intersects(createSquare(Point(0, 0))));
+  EXPECT_EQ(0, index.intersect(createSquare(Point(0, 0)))->Total());
+}
+
+TEST_F(ClipperAreaIndexTest, testGetBounds) {
+  const ClipperLib::IntRect rect =
+      ClipperAreaIndex::getBounds(createSquare(Point(5000000, -3000000)));
+  EXPECT_EQ(4000000, rect.left);
+  EXPECT_EQ(-4000000, rect.top);
+  EXPECT_EQ(6000000, rect.right);
+  EXPECT_EQ(-2000000, rect.bottom);
+}
+
+TEST_F(ClipperAreaIndexTest, testGetAreaWithin) {
+  const ClipperLib::Paths area = createRingArea();
+  const ClipperAreaIndex index(area, 16);
+  const ClipperLib::IntRect rect{-1000000, -1000000, 1000000, 1000000};
+  EXPECT_TRUE(index.getAreaWithin(rect).empty());
+  const ClipperLib::Paths nearby =
+      index.getAreaWithin(ClipperAreaIndex::getBounds(area));
+  EXPECT_FALSE(nearby.empty());
+}
+
+TEST_F(ClipperAreaIndexTest, testIntersectSameAsWithoutIndex) {
+  const ClipperLib::Paths area = createRingArea();
+  const ClipperAreaIndex index(area, 16);
+  for (int x = -110; x <= 110; x += 5) {
+    for (int y = -110; y <= 110; y += 5) {
+      const ClipperLib::Paths square =
+          createSquare(Point(x * 1000000, y * 1000000));
+      const ClipperLib::Paths expected =
+          ClipperHelpers::treeToPaths(*ClipperHelpers::intersect(area, square));
+      const ClipperLib::Paths actual =
+          ClipperHelpers::treeToPaths(*index.intersect(square));
+      EXPECT_EQ(expected, actual) << "x=" << x << " y=" << y;
+      EXPECT_EQ(!expected.empty(), index.intersects(square))
+          << "x=" << x << " y=" << y;
+    }
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -34,7 +34,34 @@ namespace tests {
  *  Test Class
  ******************************************************************************/
 
-class ClipperHelpersTest : public ::testing::Test {};
+class ClipperHelpersTest : public ::testing::Test {
+protected:
+  /**
+   * @brief Reference implementation of ClipperHelpers::contains()
+   *
+   * Independent of the polygon engine: even-odd crossing count with exact
+   * integer arithmetic, points on the path count as inside.
+   */
+  static bool referenceContains(const ClipperLib::Path& path,
+                                const ClipperLib::IntPoint& p) {
+    bool inside = false;
+    for (std::size_t i = 0; i < path.size(); ++i) {
+      const ClipperLib::IntPoint& a = path.at(i);
+      const ClipperLib::IntPoint& b = path.at((i + 1) % path.size());
+      const ClipperLib::cInt cross =
+          (b.X - a.X) * (p.Y - a.Y) - (p.X - a.X) * (b.Y - a.Y);
+      if ((cross == 0) && (p.X >= std::min(a.X, b.X)) &&
+          (p.X <= std::max(a.X, b.X)) && (p.Y >= std::min(a.Y, b.Y)) &&
+          (p.Y <= std::max(a.Y, b.Y))) {
+        return true;  // On the path.
+      }
+      if (((a.Y > p.Y) != (b.Y > p.Y)) && ((cross > 0) == (b.Y > a.Y))) {
+        inside = !inside;
+      }
+    }
+    return inside;
+  }
+};
 
 /*******************************************************************************
  *  Test Methods
@@ -59,6 +86,126 @@ TEST_F(ClipperHelpersTest, testConvertPathWithApproximate) {
       outputStr.toStdString());
 }
 
+TEST_F(ClipperHelpersTest, testExecuteDifference) {
+  ClipperLib::Paths subject{
+      {{0, 0}, {100, 0}, {100, 100}, {0, 100}},
+  };
+  ClipperLib::Paths clip{
+      {{50, -10}, {150, -10}, {150, 110}, {50, 110}},
+  };
+  ClipperLib::Paths expected = subject;
+  ClipperHelpers::subtract(expected, clip);
+
+  ClipperLib::Paths result;
+  ClipperHelpers::execute(result, subject, clip, ClipperLib::ctDifference,
+                          ClipperLib::pftEvenOdd, ClipperLib::pftEvenOdd);
+  EXPECT_EQ(expected, result);
+  ASSERT_EQ(1, result.size());
+  EXPECT_EQ(5000, std::abs(ClipperLib::Area(result.front())));
+}
+
+TEST_F(ClipperHelpersTest, testExecuteInPlace) {
+  ClipperLib::Paths paths{
+      {{0, 0}, {100, 0}, {100, 100}, {0, 100}},
+      {{50, 0}, {150, 0}, {150, 100}, {50, 100}},
+  };
+  ClipperHelpers::execute(paths, paths, ClipperLib::Paths(),
+                          ClipperLib::ctUnion, ClipperLib::pftNonZero,
+                          ClipperLib::pftNonZero);
+  ASSERT_EQ(1, paths.size());
+  EXPECT_EQ(15000, std::abs(ClipperLib::Area(paths.front())));
+}
+
+TEST_F(ClipperHelpersTest, testExecuteToTree) {
+  ClipperLib::Paths subject{
+      {{0, 0}, {100, 0}, {100, 100}, {0, 100}},
+      {{25, 25}, {75, 25}, {75, 75}, {25, 75}},
+  };
+  std::unique_ptr<ClipperLib::PolyTree> tree = ClipperHelpers::executeToTree(
+      subject, ClipperLib::Paths(), ClipperLib::ctXor, ClipperLib::pftEvenOdd,
+      ClipperLib::pftEvenOdd);
+  ASSERT_EQ(1, tree->ChildCount());
+  EXPECT_FALSE(tree->Childs.front()->IsHole());
+  ASSERT_EQ(1, tree->Childs.front()->ChildCount());
+  EXPECT_TRUE(tree->Childs.front()->Childs.front()->IsHole());
+}
+
+TEST_F(ClipperHelpersTest, testContainsMatchesReference) {
+  const QList<ClipperLib::Path> paths{
+      // Square, counterclockwise.
+      {{0, 0}, {100, 0}, {100, 100}, {0, 100}},
+      // Same square, clockwise.
+      {{0, 0}, {0, 100}, {100, 100}, {100, 0}},
+      // Comb with three concave notches.
+      {{0, 0},
+       {100, 0},
+       {100, 100},
+       {80, 100},
+       {80, 30},
+       {60, 30},
+       {60, 100},
+       {40, 100},
+       {40, 30},
+       {20, 30},
+       {20, 100},
+       {0, 100}},
+      // Diamond with diagonal edges.
+      {{50, 0}, {100, 50}, {50, 100}, {0, 50}},
+  };
+  foreach (const ClipperLib::Path& path, paths) {
+    // The step hits all vertices and edges, and the points in between.
+    for (ClipperLib::cInt x = -10; x <= 110; x += 5) {
+      for (ClipperLib::cInt y = -10; y <= 110; y += 5) {
+        const ClipperLib::IntPoint p(x, y);
+        EXPECT_EQ(referenceContains(path, p), ClipperHelpers::contains(path, p))
+            << "point (" << x << ", " << y << ")";
+      }
+    }
+  }
+}
+
+// Not run by default, use --gtest_also_run_disabled_tests to run it.
+TEST_F(ClipperHelpersTest, DISABLED_benchmarkContains) {
+  // Circle-like outline with 1000 vertices, as found on plane fragments.
+  const int vertices = 1000;
+  const int count = 100000;
+  ClipperLib::Path path;
+  for (int i = 0; i < vertices; ++i) {
+    const qreal angle = 2 * M_PI * i / vertices;
+    path.push_back(ClipperLib::IntPoint(qRound64(10000000 * qCos(angle)),
+                                        qRound64(10000000 * qSin(angle))));
+  }
+  QVector<ClipperLib::IntPoint> points;
+  for (int i = 0; i < count; ++i) {
+    const ClipperLib::cInt n = i;
+    points.append(ClipperLib::IntPoint((n * 7919) % 24000000 - 12000000,
+                                       (n * 104729) % 24000000 - 12000000));
+  }
+
+  QElapsedTimer timer;
+  timer.start();
+  int inside = 0;
+  foreach (const ClipperLib::IntPoint& p, points) {
+    if (ClipperHelpers::contains(path, p)) {
+      ++inside;
+    }
+  }
+  qInfo() << "ClipperHelpers::contains():" << timer.nsecsElapsed() / count
+          << "ns";
+
+  timer.restart();
+  int referenceInside = 0;
+  foreach (const ClipperLib::IntPoint& p, points) {
+    if (referenceContains(path, p)) {
+      ++referenceInside;
+    }
+  }
+  qInfo() << "Reference implementation:" << timer.nsecsElapsed() / count
+          << "ns";
+
+  EXPECT_EQ(referenceInside, inside);
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
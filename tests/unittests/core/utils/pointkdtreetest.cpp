@@ -0,0 +1,94 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/core/utils/pointkdtree.h>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class PointKdTreeTest : public ::testing::Test {};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(PointKdTreeTest, testEmpty) {
+  const PointKdTree tree;
+  EXPECT_TRUE(tree.isEmpty());
+  EXPECT_EQ(0, tree.count());
+  EXPECT_FALSE(tree.findNearest(Point(0, 0)));
+}
+
+TEST_F(PointKdTreeTest, testSinglePoint) {
+  const PointKdTree tree({Point(100, 200)});
+  EXPECT_FALSE(tree.isEmpty());
+  EXPECT_EQ(1, tree.count());
+  EXPECT_EQ(Point(100, 200), tree.findNearest(Point(-5000, 7000)));
+}
+
+TEST_F(PointKdTreeTest, testMaxDistance) {
+  const PointKdTree tree({Point(0, 0), Point(1000, 0)});
+  EXPECT_EQ(Point(1000, 0),
+            tree.findNearest(Point(1000, 300), UnsignedLength(300)));
+  EXPECT_FALSE(tree.findNearest(Point(1000, 300), UnsignedLength(299)));
+}
+
+TEST_F(PointKdTreeTest, testSameResultAsBruteForce) {
+  QVector<Point> points;
+  for (int i = 0; i < 1000; ++i) {
+    // Deterministic pseudo-random points, including duplicates.
+    points.append(Point((i * 7919) % 1013 * 1000, (i * 104729) % 997 * 1000));
+  }
+  const PointKdTree tree(points);
+  EXPECT_EQ(points.count(), tree.count());
+  for (int x = -50000; x <= 1050000; x += 25000) {
+    for (int y = -50000; y <= 1050000; y += 25000) {
+      const Point pos(x, y);
+      Length expected(-1);
+      foreach (const Point& p, points) {
+        const Length distance = *(p - pos).getLength();
+        if ((expected < 0) || (distance < expected)) {
+          expected = distance;
+        }
+      }
+      const tl::optional<Point> nearest = tree.findNearest(pos);
+      ASSERT_TRUE(nearest);
+      EXPECT_EQ(expected, *(*nearest - pos).getLength()) << x << "/" << y;
+    }
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -49,6 +49,18 @@ struct Receiver {
   MOCK_METHOD2(callback, void(const Sender&, int));
 };
 
+struct EventSender {
+  enum class Event { A, B, C };
+  Signal<EventSender, Event> signal;
+  EventSender() : signal(*this) {}
+};
+
+struct EventReceiver {
+  Slot<EventSender, EventSender::Event> slot;
+  EventReceiver() : slot(*this, &EventReceiver::callback) {}
+  MOCK_METHOD2(callback, void(const EventSender&, EventSender::Event));
+};
+
 /*******************************************************************************
  *  Test Class
  ******************************************************************************/
@@ -98,6 +110,142 @@ TEST(SignalSlotTest, testDuringCallbackDetachedSlotsAreNotCalled) {
   EXPECT_EQ(1, callbackCounter);
 }
 
+TEST(SignalSlotTest, testEventFilter) {
+  EventSender sender;
+  EventReceiver receiverAll;
+  EventReceiver receiverB;
+  receiverB.slot.setEventFilter({EventSender::Event::B});
+  sender.signal.attach(receiverAll.slot);
+  sender.signal.attach(receiverB.slot);
+
+  {
+    testing::InSequence s;
+    EXPECT_CALL(receiverAll, callback(testing::_, EventSender::Event::A));
+    EXPECT_CALL(receiverAll, callback(testing::_, EventSender::Event::B));
+    EXPECT_CALL(receiverAll, callback(testing::_, EventSender::Event::C));
+    EXPECT_CALL(receiverAll, callback(testing::_, EventSender::Event::B));
+  }
+  EXPECT_CALL(receiverB, callback(testing::_, EventSender::Event::B)).Times(2);
+  sender.signal.notify(EventSender::Event::A);
+  sender.signal.notify(EventSender::Event::B);
+  sender.signal.detach(receiverAll.slot);
+  sender.signal.notify(EventSender::Event::C);  // Not received by anyone.
+  receiverB.slot.clearEventFilter();
+  sender.signal.attach(receiverAll.slot);
+  receiverB.slot.setEventFilter({EventSender::Event::B});
+  sender.signal.notify(EventSender::Event::C);
+  sender.signal.notify(EventSender::Event::B);
+}
+
+TEST(SignalSlotTest, testDetachInArbitraryOrder) {
+  Sender sender1;
+  Sender sender2;
+  QVector<int> counters(10, 0);
+  QList<std::shared_ptr<Slot<Sender, int>>> slots;
+  for (int i = 0; i < counters.count(); ++i) {
+    auto slot = std::make_shared<Slot<Sender, int>>(
+        [&counters, i](const Sender&, int) { ++counters[i]; });
+    sender1.signal.attach(*slot);
+    sender2.signal.attach(*slot);
+    slots.append(slot);
+  }
+
+  // Detach some slots from the first signal, and destroy some other slots.
+  sender1.signal.detach(*slots[0]);
+  sender1.signal.detach(*slots[5]);
+  sender1.signal.detach(*slots[9]);
+  sender1.signal.detach(*slots[5]);  // No-op.
+  slots[3].reset();
+  slots[7].reset();
+  EXPECT_EQ(5, sender1.signal.getSlotCount());
+  EXPECT_EQ(8, sender2.signal.getSlotCount());
+
+  sender1.signal.notify(42);
+  EXPECT_EQ((QVector<int>{0, 1, 1, 0, 1, 0, 1, 0, 1, 0}), counters);
+  sender2.signal.notify(42);
+  EXPECT_EQ((QVector<int>{1, 2, 2, 0, 2, 1, 2, 0, 2, 1}), counters);
+
+  // Attaching again must work as well.
+  sender1.signal.attach(*slots[5]);
+  sender1.signal.notify(42);
+  EXPECT_EQ((QVector<int>{1, 3, 3, 0, 3, 2, 3, 0, 3, 1}), counters);
+  EXPECT_EQ(2, slots[1]->getSignalCount());
+}
+
+TEST(SignalSlotTest, testEventFilterAfterDetach) {
+  EventSender sender;
+  EventReceiver receiverA;
+  EventReceiver receiverB;
+  receiverA.slot.setEventFilter({EventSender::Event::A});
+  receiverB.slot.setEventFilter({EventSender::Event::A, EventSender::Event::B});
+  sender.signal.attach(receiverA.slot);
+  sender.signal.attach(receiverB.slot);
+  sender.signal.detach(receiverB.slot);
+
+  // Only receiverA is still attached, it must still receive A, but B must
+  // no longer be delivered to anyone.
+  EXPECT_CALL(receiverA, callback(testing::_, EventSender::Event::A)).Times(1);
+  EXPECT_CALL(receiverB, callback(testing::_, testing::_)).Times(0);
+  sender.signal.notify(EventSender::Event::A);
+  sender.signal.notify(EventSender::Event::B);
+}
+
+// Not run by default, use --gtest_also_run_disabled_tests to run it.
+TEST(SignalSlotTest, DISABLED_benchmarkNotify) {
+  const int count = 10000000;
+  EventSender sender;
+  int callbackCounter = 0;
+  QVector<std::shared_ptr<Slot<EventSender, EventSender::Event>>> slots;
+  for (int i = 0; i < 10; ++i) {
+    auto slot = std::make_shared<Slot<EventSender, EventSender::Event>>(
+        [&](const EventSender&, EventSender::Event) { ++callbackCounter; });
+    slot->setEventFilter({EventSender::Event::B});
+    sender.signal.attach(*slot);
+    slots.append(slot);
+  }
+
+  QElapsedTimer timer;
+  timer.start();
+  for (int i = 0; i < count; ++i) {
+    sender.signal.notify(EventSender::Event::A);
+  }
+  qInfo() << "Filtered notifications:" << timer.nsecsElapsed() / count
+          << "ns";
+
+  timer.restart();
+  for (int i = 0; i < count; ++i) {
+    sender.signal.notify(EventSender::Event::B);
+  }
+  qInfo() << "Delivered notifications (10 slots):"
+          << timer.nsecsElapsed() / count << "ns";
+
+  EXPECT_EQ(10 * count, callbackCounter);
+}
+
+// Not run by default, use --gtest_also_run_disabled_tests to run it.
+TEST(SignalSlotTest, DISABLED_benchmarkDetach) {
+  const int count = 100000;
+  Sender sender;
+  QVector<std::shared_ptr<Slot<Sender, int>>> slots;
+  for (int i = 0; i < count; ++i) {
+    slots.append(
+        std::make_shared<Slot<Sender, int>>([](const Sender&, int) {}));
+  }
+
+  QElapsedTimer timer;
+  timer.start();
+  for (auto& slot : slots) {
+    sender.signal.attach(*slot);
+  }
+  qInfo() << "Attached" << count << "slots:" << timer.elapsed() << "ms";
+
+  timer.restart();
+  slots.clear();  // Destroys (thus detaches) the slots in attach order.
+  qInfo() << "Detached" << count << "slots:" << timer.elapsed() << "ms";
+
+  EXPECT_EQ(0, sender.signal.getSlotCount());
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -101,6 +101,42 @@ TEST_F(ToolboxTest, testNoPenBrushReturnsUnmodifiedPath) {
   EXPECT_EQ(path, Toolbox::shapeFromPath(path, pen, brush));
 }
 
+/*******************************************************************************
+ *  shortestDistanceBetweenLines() Tests
+ ******************************************************************************/
+
+TEST_F(ToolboxTest, testShortestDistanceBetweenCrossingLines) {
+  EXPECT_EQ(UnsignedLength(0),
+            Toolbox::shortestDistanceBetweenLines(
+                Point(-1000, -1000), Point(1000, 1000), Point(-1000, 1000),
+                Point(1000, -1000)));
+}
+
+TEST_F(ToolboxTest, testShortestDistanceBetweenParallelLines) {
+  EXPECT_EQ(UnsignedLength(300),
+            Toolbox::shortestDistanceBetweenLines(Point(0, 0), Point(1000, 0),
+                                                  Point(500, 300),
+                                                  Point(2000, 300)));
+}
+
+TEST_F(ToolboxTest, testShortestDistanceBetweenCollinearLines) {
+  EXPECT_EQ(UnsignedLength(0),
+            Toolbox::shortestDistanceBetweenLines(Point(0, 0), Point(1000, 0),
+                                                  Point(500, 0),
+                                                  Point(2000, 0)));
+  EXPECT_EQ(UnsignedLength(1000),
+            Toolbox::shortestDistanceBetweenLines(Point(0, 0), Point(1000, 0),
+                                                  Point(2000, 0),
+                                                  Point(3000, 0)));
+}
+
+TEST_F(ToolboxTest, testShortestDistanceBetweenPoints) {
+  EXPECT_EQ(UnsignedLength(500),
+            Toolbox::shortestDistanceBetweenLines(Point(0, 0), Point(0, 0),
+                                                  Point(300, 400),
+                                                  Point(300, 400)));
+}
+
 /*******************************************************************************
  *  Parametrized arcCenter() Tests
  ******************************************************************************/
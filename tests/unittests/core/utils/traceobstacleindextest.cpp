@@ -0,0 +1,162 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/core/utils/traceobstacleindex.h>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class TraceObstacleIndexTest : public ::testing::Test {};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(TraceObstacleIndexTest, testEmpty) {
+  const TraceObstacleIndex index;
+  EXPECT_TRUE(index.isEmpty());
+  EXPECT_TRUE(index.isFree(Point(0, 0), Point(10000000, 0),
+                           PositiveLength(500000), UnsignedLength(200000)));
+}
+
+TEST_F(TraceObstacleIndexTest, testSegmentClearance) {
+  TraceObstacleIndex index;
+  // Horizontal trace at y=1mm with 0.2mm width.
+  index.addSegment(Point(0, 1000000), Point(10000000, 1000000),
+                   UnsignedLength(200000));
+  EXPECT_EQ(1, index.count());
+
+  // Parallel trace at y=0 with 0.2mm width -> gap of 0.8mm.
+  const Point p1(0, 0);
+  const Point p2(10000000, 0);
+  const PositiveLength width(200000);
+  EXPECT_TRUE(index.isFree(p1, p2, width, UnsignedLength(800000)));
+  EXPECT_FALSE(index.isFree(p1, p2, width, UnsignedLength(800001)));
+}
+
+TEST_F(TraceObstacleIndexTest, testCrossingSegment) {
+  TraceObstacleIndex index;
+  index.addSegment(Point(5000000, -5000000), Point(5000000, 5000000),
+                   UnsignedLength(0));
+  EXPECT_FALSE(index.isFree(Point(0, 0), Point(10000000, 0),
+                            PositiveLength(1), UnsignedLength(0)));
+}
+
+TEST_F(TraceObstacleIndexTest, testSameNetIsIgnored) {
+  const Uuid net1 = Uuid::createRandom();
+  const Uuid net2 = Uuid::createRandom();
+  TraceObstacleIndex index;
+  index.addSegment(Point(0, 0), Point(0, 0), UnsignedLength(1000000), net1);
+  const Point p1(-1000000, 0);
+  const Point p2(1000000, 0);
+  const PositiveLength width(100000);
+  const UnsignedLength clearance(0);
+  EXPECT_FALSE(index.isFree(p1, p2, width, clearance));
+  EXPECT_FALSE(index.isFree(p1, p2, width, clearance, net2));
+  EXPECT_TRUE(index.isFree(p1, p2, width, clearance, net1));
+}
+
+TEST_F(TraceObstacleIndexTest, testArea) {
+  TraceObstacleIndex index;
+  index.addArea({{0, 0}, {1000000, 0}, {1000000, 1000000}, {0, 1000000}});
+  const PositiveLength width(100000);
+
+  // Trace completely within the area.
+  EXPECT_FALSE(index.isFree(Point(100000, 100000), Point(200000, 200000),
+                            width, UnsignedLength(0)));
+  // Trace crossing the area.
+  EXPECT_FALSE(index.isFree(Point(-5000000, 500000), Point(5000000, 500000),
+                            width, UnsignedLength(0)));
+  // Trace next to the area (gap of 0.45mm).
+  EXPECT_TRUE(index.isFree(Point(-5000000, 1500000), Point(5000000, 1500000),
+                           width, UnsignedLength(450000)));
+  EXPECT_FALSE(index.isFree(Point(-5000000, 1500000), Point(5000000, 1500000),
+                            width, UnsignedLength(450001)));
+}
+
+TEST_F(TraceObstacleIndexTest, testRemove) {
+  TraceObstacleIndex index;
+  const int id = index.addSegment(Point(0, 0), Point(0, 0),
+                                  UnsignedLength(1000000));
+  EXPECT_FALSE(index.isFree(Point(-1000000, 0), Point(1000000, 0),
+                            PositiveLength(100000), UnsignedLength(0)));
+  index.remove(id);
+  EXPECT_TRUE(index.isEmpty());
+  EXPECT_TRUE(index.isFree(Point(-1000000, 0), Point(1000000, 0),
+                           PositiveLength(100000), UnsignedLength(0)));
+}
+
+TEST_F(TraceObstacleIndexTest, testLargeObstacle) {
+  // Area covering far more cells than allowed for normal obstacles.
+  TraceObstacleIndex index(PositiveLength(1000));
+  const int id = index.addArea(
+      {{0, 0}, {100000000, 0}, {100000000, 100000000}, {0, 100000000}});
+  EXPECT_FALSE(index.isFree(Point(50000000, 50000000),
+                            Point(50000000, 50000000), PositiveLength(1000),
+                            UnsignedLength(0)));
+  index.remove(id);
+  EXPECT_TRUE(index.isFree(Point(50000000, 50000000),
+                           Point(50000000, 50000000), PositiveLength(1000),
+                           UnsignedLength(0)));
+}
+
+TEST_F(TraceObstacleIndexTest, testFindLastFreePoint) {
+  TraceObstacleIndex index;
+  // Via with 1mm diameter at x=10mm.
+  index.addSegment(Point(10000000, 0), Point(10000000, 0),
+                   UnsignedLength(1000000));
+  const PositiveLength width(200000);
+  const UnsignedLength clearance(300000);
+
+  // Trace towards the via stops 0.5+0.1+0.3=0.9mm before its center.
+  const Point p = index.findLastFreePoint(Point(0, 0), Point(20000000, 0),
+                                          width, clearance);
+  EXPECT_EQ(Length(0), p.getY());
+  EXPECT_LE(p.getX(), Length(9100000));
+  EXPECT_GE(p.getX(), Length(9099000));
+
+  // Trace which does not collide is not modified.
+  EXPECT_EQ(Point(20000000, 5000000),
+            index.findLastFreePoint(Point(0, 5000000), Point(20000000, 5000000),
+                                    width, clearance));
+
+  // Trace starting within the clearance is not modified.
+  EXPECT_EQ(Point(20000000, 0),
+            index.findLastFreePoint(Point(9500000, 0), Point(20000000, 0),
+                                    width, clearance));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
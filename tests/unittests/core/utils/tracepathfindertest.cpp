@@ -0,0 +1,197 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/utils/traceobstacleindex.h>
+#include <librepcb/core/utils/tracepathfinder.h>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class TracePathFinderTest : public ::testing::Test {
+protected:
+  TraceObstacleIndex mTop;
+  TraceObstacleIndex mBot;
+  Uuid mNet;
+
+  TracePathFinderTest() : mTop(), mBot(), mNet(Uuid::createRandom()) {}
+
+  // 1mm grid, 0.2mm traces, 0.6mm vias, 0.2mm clearance.
+  std::unique_ptr<TracePathFinder> createFinder(bool twoLayers = false) const {
+    QVector<const TraceObstacleIndex*> layers{&mTop};
+    if (twoLayers) {
+      layers.append(&mBot);
+    }
+    return std::unique_ptr<TracePathFinder>(new TracePathFinder(
+        layers, PositiveLength(200000), PositiveLength(600000),
+        UnsignedLength(200000), PositiveLength(1000000)));
+  }
+
+  // Vertical wall of another net at x=5mm.
+  void addWall(TraceObstacleIndex& index, const Length& halfHeight) {
+    index.addSegment(Point(5000000, -halfHeight), Point(5000000, halfHeight),
+                     UnsignedLength(0));
+  }
+
+  static bool containsLayer(const QVector<TracePathFinder::Vertex>& path,
+                            int layer) {
+    foreach (const TracePathFinder::Vertex& vertex, path) {
+      if (vertex.layer == layer) {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(TracePathFinderTest, testStraightPath) {
+  std::unique_ptr<TracePathFinder> finder = createFinder();
+  const Point start(0, 0);
+  const Point goal(10000000, 0);
+  QVector<TracePathFinder::Vertex> path;
+  EXPECT_TRUE(finder->findPath(start, {true}, goal, {true}, mNet, path));
+  ASSERT_GE(path.count(), 2);
+  EXPECT_EQ(start, path.first().position);
+  EXPECT_EQ(goal, path.last().position);
+  foreach (const TracePathFinder::Vertex& vertex, path) {
+    EXPECT_EQ(Length(0), vertex.position.getY());
+    EXPECT_EQ(0, vertex.layer);
+  }
+}
+
+TEST_F(TracePathFinderTest, testGoalOffGrid) {
+  std::unique_ptr<TracePathFinder> finder = createFinder();
+  const Point goal(3300000, 1700000);
+  QVector<TracePathFinder::Vertex> path;
+  EXPECT_TRUE(finder->findPath(Point(0, 0), {true}, goal, {true}, mNet, path));
+  ASSERT_GE(path.count(), 2);
+  EXPECT_EQ(goal, path.last().position);
+}
+
+TEST_F(TracePathFinderTest, testObstaclesOfSameNetAreIgnored) {
+  mTop.addSegment(Point(5000000, -50000000), Point(5000000, 50000000),
+                  UnsignedLength(0), mNet);
+  std::unique_ptr<TracePathFinder> finder = createFinder();
+  QVector<TracePathFinder::Vertex> path;
+  EXPECT_TRUE(finder->findPath(Point(0, 0), {true}, Point(10000000, 0), {true},
+                               mNet, path));
+}
+
+TEST_F(TracePathFinderTest, testBlockedGoal) {
+  // Goal enclosed by a box of another net.
+  const Point goal(10000000, 0);
+  const Point p1(7000000, -3000000);
+  const Point p2(13000000, -3000000);
+  const Point p3(13000000, 3000000);
+  const Point p4(7000000, 3000000);
+  mTop.addSegment(p1, p2, UnsignedLength(0));
+  mTop.addSegment(p2, p3, UnsignedLength(0));
+  mTop.addSegment(p3, p4, UnsignedLength(0));
+  mTop.addSegment(p4, p1, UnsignedLength(0));
+  std::unique_ptr<TracePathFinder> finder = createFinder();
+  QVector<TracePathFinder::Vertex> path;
+  EXPECT_FALSE(finder->findPath(Point(0, 0), {true}, goal, {true}, mNet, path));
+  EXPECT_TRUE(path.isEmpty());
+}
+
+TEST_F(TracePathFinderTest, testMaxDetour) {
+  // The wall needs a detour of 6 grid steps.
+  addWall(mTop, Length(5000000));
+  std::unique_ptr<TracePathFinder> finder = createFinder();
+  const Point start(0, 0);
+  const Point goal(10000000, 0);
+  QVector<TracePathFinder::Vertex> path;
+  finder->setMaxDetour(5);
+  EXPECT_FALSE(finder->findPath(start, {true}, goal, {true}, mNet, path));
+  finder->setMaxDetour(6);
+  EXPECT_TRUE(finder->findPath(start, {true}, goal, {true}, mNet, path));
+}
+
+TEST_F(TracePathFinderTest, testMaxExpansions) {
+  std::unique_ptr<TracePathFinder> finder = createFinder();
+  const Point start(0, 0);
+  const Point goal(100000000, 0);
+  QVector<TracePathFinder::Vertex> path;
+  finder->setMaxExpansions(50);
+  EXPECT_FALSE(finder->findPath(start, {true}, goal, {true}, mNet, path));
+  finder->setMaxExpansions(200);
+  EXPECT_TRUE(finder->findPath(start, {true}, goal, {true}, mNet, path));
+}
+
+TEST_F(TracePathFinderTest, testViaCost) {
+  // Going around the wall on the top layer costs about 43 grid steps more
+  // than a straight trace, while switching to the bottom layer and back
+  // costs two vias.
+  addWall(mTop, Length(20000000));
+  std::unique_ptr<TracePathFinder> finder = createFinder(true);
+  finder->setMaxDetour(30);
+  const Point start(0, 0);
+  const Point goal(10000000, 0);
+  const QVector<bool> topOnly{true, false};
+
+  QVector<TracePathFinder::Vertex> path;
+  finder->setViaCost(10);
+  EXPECT_TRUE(finder->findPath(start, topOnly, goal, topOnly, mNet, path));
+  EXPECT_TRUE(containsLayer(path, 1));
+  EXPECT_EQ(0, path.last().layer);
+  foreach (const TracePathFinder::Vertex& vertex, path) {
+    EXPECT_EQ(Length(0), vertex.position.getY());
+  }
+
+  finder->setViaCost(1000);
+  EXPECT_TRUE(finder->findPath(start, topOnly, goal, topOnly, mNet, path));
+  EXPECT_FALSE(containsLayer(path, 1));
+}
+
+TEST_F(TracePathFinderTest, testViaKeepsClearanceOnAllLayers) {
+  // Bottom layer is only reachable by a via, but the vias are blocked by
+  // obstacles on the bottom layer itself.
+  addWall(mTop, Length(20000000));
+  for (int x = 1; x <= 9; ++x) {
+    mBot.addSegment(Point(x * 1000000, 0), Point(x * 1000000, 0),
+                    UnsignedLength(0));
+  }
+  std::unique_ptr<TracePathFinder> finder = createFinder(true);
+  finder->setMaxDetour(0);
+  const QVector<bool> topOnly{true, false};
+  QVector<TracePathFinder::Vertex> path;
+  EXPECT_FALSE(finder->findPath(Point(0, 0), topOnly, Point(10000000, 0),
+                                topOnly, mNet, path));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -21,6 +21,7 @@
  *  Includes
  ******************************************************************************/
 #include <gtest/gtest.h>
+#include <librepcb/core/exceptions.h>
 #include <librepcb/core/fileio/fileutils.h>
 #include <librepcb/core/library/cat/componentcategory.h>
 #include <librepcb/core/library/cat/packagecategory.h>
@@ -969,6 +970,135 @@ TEST_F(WorkspaceLibraryDbTest, testGetByCategoryDuplicates) {
             str(mWsDb->getByCategory<Component>(tl::nullopt)));
 }
 
+/*******************************************************************************
+ *  Tests for getCategoryTree()
+ ******************************************************************************/
+
+TEST_F(WorkspaceLibraryDbTest, testGetCategoryTreeNotUpdated) {
+  mWriter->addCategory<ComponentCategory>(0, toAbs("cmpcat"), uuid(1),
+                                          version("0.1"), false, tl::nullopt);
+
+  EXPECT_EQ(0, mWsDb->getCategoryTree<ComponentCategory>({}).count());
+}
+
+TEST_F(WorkspaceLibraryDbTest, testGetCategoryTreeEmptyDb) {
+  mWriter->updateCategoryTree<ComponentCategory>();
+  mWriter->updateCategoryTree<PackageCategory>();
+
+  const QList<QList<WorkspaceLibraryDb::CategoryTreeEntry>> trees = {
+      mWsDb->getCategoryTree<ComponentCategory>({}),
+      mWsDb->getCategoryTree<PackageCategory>({}),
+  };
+  foreach (const auto& tree, trees) {
+    ASSERT_EQ(1, tree.count());
+    EXPECT_FALSE(tree.at(0).uuid.has_value());
+    EXPECT_FALSE(tree.at(0).parent.has_value());
+    EXPECT_EQ(0, tree.at(0).symbols);
+    EXPECT_EQ(0, tree.at(0).packages);
+    EXPECT_EQ(0, tree.at(0).components);
+    EXPECT_EQ(0, tree.at(0).devices);
+  }
+}
+
+TEST_F(WorkspaceLibraryDbTest, testGetCategoryTree) {
+  // - cat 1
+  //   - cat 2
+  // - cat 3 (with inexistent parent)
+  int cat = mWriter->addCategory<ComponentCategory>(
+      0, toAbs("cmpcat1"), uuid(1), version("0.1"), false, tl::nullopt);
+  mWriter->addTranslation<ComponentCategory>(cat, "", ElementName("cat 1"),
+                                             "desc 1", tl::nullopt);
+  cat = mWriter->addCategory<ComponentCategory>(0, toAbs("cmpcat2"), uuid(2),
+                                                version("0.1"), false, uuid(1));
+  mWriter->addTranslation<ComponentCategory>(cat, "", ElementName("cat 2"),
+                                             tl::nullopt, tl::nullopt);
+  mWriter->addCategory<ComponentCategory>(0, toAbs("cmpcat3"), uuid(3),
+                                          version("0.1"), false, uuid(4));
+  int sym1 = mWriter->addElement<Symbol>(0, toAbs("sym1"), uuid(5),
+                                         version("0.1"), false);
+  mWriter->addToCategory<Symbol>(sym1, uuid(2));
+  mWriter->addElement<Symbol>(0, toAbs("sym2"), uuid(6), version("0.1"),
+                              false);
+  int cmp = mWriter->addElement<Component>(0, toAbs("cmp"), uuid(7),
+                                           version("0.1"), false);
+  mWriter->addToCategory<Component>(cmp, uuid(1));
+  mWriter->addToCategory<Component>(cmp, uuid(2));
+  mWriter->updateCategoryTree<ComponentCategory>();
+
+  QHash<tl::optional<Uuid>, WorkspaceLibraryDb::CategoryTreeEntry> entries;
+  foreach (const auto& entry, mWsDb->getCategoryTree<ComponentCategory>({})) {
+    EXPECT_FALSE(entries.contains(entry.uuid));
+    entries.insert(entry.uuid, entry);
+  }
+  ASSERT_EQ(4, entries.count());
+
+  const auto cat1 = entries.value(uuid(1));
+  EXPECT_EQ(tl::nullopt, cat1.parent);
+  EXPECT_EQ("cat 1", cat1.name.toStdString());
+  EXPECT_EQ("desc 1", cat1.description.toStdString());
+  EXPECT_EQ(1, cat1.symbols);  // From subcategory.
+  EXPECT_EQ(1, cat1.components);  // Counted only once.
+  EXPECT_EQ(0, cat1.devices);
+
+  const auto cat2 = entries.value(uuid(2));
+  EXPECT_EQ(tl::make_optional(uuid(1)), cat2.parent);
+  EXPECT_EQ("cat 2", cat2.name.toStdString());
+  EXPECT_EQ("", cat2.description.toStdString());
+  EXPECT_EQ(1, cat2.symbols);
+  EXPECT_EQ(1, cat2.components);
+
+  const auto cat3 = entries.value(uuid(3));
+  EXPECT_EQ(tl::nullopt, cat3.parent);
+  EXPECT_EQ("", cat3.name.toStdString());
+  EXPECT_EQ(0, cat3.symbols);
+
+  const auto uncategorized = entries.value(tl::nullopt);
+  EXPECT_EQ(tl::nullopt, uncategorized.parent);
+  EXPECT_EQ(1, uncategorized.symbols);
+  EXPECT_EQ(0, uncategorized.components);
+}
+
+TEST_F(WorkspaceLibraryDbTest, testGetCategoryTreeLatestTranslations) {
+  int cat = mWriter->addCategory<ComponentCategory>(
+      0, toAbs("cmpcat1"), uuid(1), version("0.2"), false, tl::nullopt);
+  mWriter->addTranslation<ComponentCategory>(cat, "", ElementName("new"),
+                                             tl::nullopt, tl::nullopt);
+  mWriter->addTranslation<ComponentCategory>(cat, "de_CH", ElementName("neu"),
+                                             tl::nullopt, tl::nullopt);
+  cat = mWriter->addCategory<ComponentCategory>(
+      1, toAbs("cmpcat2"), uuid(1), version("0.1"), false, tl::nullopt);
+  mWriter->addTranslation<ComponentCategory>(cat, "", ElementName("old"),
+                                             tl::nullopt, tl::nullopt);
+  mWriter->updateCategoryTree<ComponentCategory>();
+
+  auto tree = mWsDb->getCategoryTree<ComponentCategory>({});
+  ASSERT_EQ(2, tree.count());
+  const int index = tree.at(0).uuid ? 0 : 1;
+  EXPECT_EQ("new", tree.at(index).name.toStdString());
+
+  tree = mWsDb->getCategoryTree<ComponentCategory>({"de_CH"});
+  ASSERT_EQ(2, tree.count());
+  EXPECT_EQ("neu", tree.at(index).name.toStdString());
+}
+
+TEST_F(WorkspaceLibraryDbTest, testGetCategoryTreeEndlessRecursion) {
+  mWriter->addCategory<ComponentCategory>(0, toAbs("cmpcat1"), uuid(1),
+                                          version("0.1"), false, uuid(2));
+  mWriter->addCategory<ComponentCategory>(0, toAbs("cmpcat2"), uuid(2),
+                                          version("0.1"), false, uuid(1));
+  int cmp = mWriter->addElement<Component>(0, toAbs("cmp"), uuid(3),
+                                           version("0.1"), false);
+  mWriter->addToCategory<Component>(cmp, uuid(1));
+  mWriter->updateCategoryTree<ComponentCategory>();
+
+  // Must terminate, and each category contains the element of the other.
+  const auto tree = mWsDb->getCategoryTree<ComponentCategory>({});
+  ASSERT_EQ(3, tree.count());
+  foreach (const auto& entry, tree) {
+    EXPECT_EQ(entry.uuid ? 1 : 0, entry.components);
+  }
+}
+
 /*******************************************************************************
  *  Tests for getComponentDevices()
  ******************************************************************************/
@@ -1000,6 +1130,86 @@ TEST_F(WorkspaceLibraryDbTest, testGetComponentDevicesDuplicates) {
   EXPECT_EQ(str(QSet<Uuid>{uuid(1)}), str(mWsDb->getComponentDevices(uuid(0))));
 }
 
+/*******************************************************************************
+ *  Tests for bulk loading
+ ******************************************************************************/
+
+TEST_F(WorkspaceLibraryDbTest, testBulkLoad) {
+  SQLiteDatabase::TransactionScopeGuard transactionGuard(*mDb);
+  mWriter->beginBulkLoad();
+  mWriter->addCategory<ComponentCategory>(0, toAbs("cmpcat"), uuid(1),
+                                          version("0.1"), false, tl::nullopt);
+  // Add more rows than fit into a single multi-row INSERT statement.
+  for (int i = 0; i < 500; ++i) {
+    const QString name = QString("cmp%1").arg(i);
+    int cmp = mWriter->addElement<Component>(0, toAbs(name), uuid(),
+                                             version("0.1"), false);
+    mWriter->addTranslation<Component>(cmp, "", ElementName(name), "d", "k");
+    mWriter->addToCategory<Component>(cmp, uuid(1));
+  }
+  mWriter->endBulkLoad();
+  transactionGuard.commit();
+
+  EXPECT_EQ(500, mWsDb->getByCategory<Component>(uuid(1)).count());
+  testGetTr<Component>(*mWsDb, toAbs("cmp0"), {}, true, "cmp0", "d", "k");
+  testGetTr<Component>(*mWsDb, toAbs("cmp499"), {}, true, "cmp499", "d", "k");
+}
+
+TEST_F(WorkspaceLibraryDbTest, testBulkLoadNotStarted) {
+  EXPECT_THROW(mWriter->endBulkLoad(), Exception);
+}
+
+TEST_F(WorkspaceLibraryDbTest, testBulkLoadAlreadyStarted) {
+  SQLiteDatabase::TransactionScopeGuard transactionGuard(*mDb);
+  mWriter->beginBulkLoad();
+  EXPECT_THROW(mWriter->beginBulkLoad(), Exception);
+}
+
+// Not run by default, use --gtest_also_run_disabled_tests to run it.
+TEST_F(WorkspaceLibraryDbTest, DISABLED_benchmarkBulkLoad) {
+  const int count = 100000;
+  auto fill = [this, count](const FilePath& root, SQLiteDatabase& db,
+                            WorkspaceLibraryDbWriter& writer, bool bulkLoad) {
+    SQLiteDatabase::TransactionScopeGuard transactionGuard(db);
+    if (bulkLoad) {
+      writer.beginBulkLoad();
+    }
+    writer.addCategory<ComponentCategory>(0, root.getPathTo("cmpcat"), uuid(1),
+                                          version("0.1"), false, tl::nullopt);
+    for (int i = 0; i < count; ++i) {
+      const QString name = QString("cmp%1").arg(i);
+      int cmp = writer.addElement<Component>(0, root.getPathTo(name), uuid(),
+                                             version("0.1"), false);
+      writer.addTranslation<Component>(cmp, "", ElementName(name), "d", "k");
+      writer.addToCategory<Component>(cmp, uuid(1));
+    }
+    if (bulkLoad) {
+      writer.endBulkLoad();
+    }
+    transactionGuard.commit();
+  };
+
+  // Reference without bulk load, in a separate database.
+  const FilePath refDir = mWsDir.getPathTo("reference");
+  FileUtils::makePath(refDir);
+  WorkspaceLibraryDb refWsDb(refDir);
+  SQLiteDatabase refDb(refWsDb.getFilePath());
+  WorkspaceLibraryDbWriter refWriter(refDir, refDb);
+  QElapsedTimer timer;
+  timer.start();
+  fill(refDir, refDb, refWriter, false);
+  qInfo() << "Loading" << count << "elements without bulk load:"
+          << timer.elapsed() << "ms";
+
+  timer.restart();
+  fill(mWsDir, *mDb, *mWriter, true);
+  qInfo() << "Loading" << count << "elements with bulk load:"
+          << timer.elapsed() << "ms";
+
+  EXPECT_EQ(count, refWsDb.getByCategory<Component>(uuid(1)).count());
+  EXPECT_EQ(count, mWsDb->getByCategory<Component>(uuid(1)).count());
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
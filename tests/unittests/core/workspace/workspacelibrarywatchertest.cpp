@@ -0,0 +1,176 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../../testhelpers.h"
+
+#include <gtest/gtest.h>
+#include <librepcb/core/fileio/fileutils.h>
+#include <librepcb/core/workspace/workspacelibrarywatcher.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class WorkspaceLibraryWatcherTest : public ::testing::Test {
+protected:
+  FilePath mLibsDir;
+  FilePath mLibDir;
+  FilePath mSymDir;
+  FilePath mPkgDir;
+  std::unique_ptr<WorkspaceLibraryWatcher> mWatcher;
+  QList<QSet<FilePath>> mElementsModified;
+  QList<QSet<FilePath>> mModifiedElements;
+  int mLibrariesModified;
+
+  WorkspaceLibraryWatcherTest()
+    : mLibsDir(FilePath::getRandomTempPath()),
+      mLibDir(mLibsDir.getPathTo("local/Lib.lplib")),
+      mSymDir(mLibDir.getPathTo("sym")),
+      mPkgDir(mLibDir.getPathTo("pkg")),
+      mLibrariesModified(0) {
+    FileUtils::writeFile(mSymDir.getPathTo("sym1/symbol.lp"), "1");
+    FileUtils::writeFile(mSymDir.getPathTo("sym2/symbol.lp"), "2");
+    FileUtils::makePath(mPkgDir);
+    FileUtils::makePath(mLibsDir.getPathTo("remote"));
+
+    mWatcher.reset(new WorkspaceLibraryWatcher(mLibsDir));
+    mWatcher->setDebounceInterval(50);
+    QObject::connect(mWatcher.get(), &WorkspaceLibraryWatcher::elementsModified,
+                     [this](const QSet<FilePath>& dirs,
+                            const QSet<FilePath>& elements) {
+                       mElementsModified.append(dirs);
+                       mModifiedElements.append(elements);
+                     });
+    QObject::connect(mWatcher.get(),
+                     &WorkspaceLibraryWatcher::librariesModified,
+                     [this]() { ++mLibrariesModified; });
+    mWatcher->setWatchedDirectories({
+        mLibsDir.getPathTo("local").toStr(),
+        mLibsDir.getPathTo("remote").toStr(),
+        mLibDir.toStr(),
+        mSymDir.toStr(),
+        mSymDir.getPathTo("sym1").toStr(),
+        mSymDir.getPathTo("sym2").toStr(),
+        mPkgDir.toStr(),
+    });
+  }
+
+  virtual ~WorkspaceLibraryWatcherTest() {
+    mWatcher.reset();
+    QDir(mLibsDir.toStr()).removeRecursively();
+  }
+
+  bool waitForSignal() {
+    return TestHelpers::waitFor([this]() {
+      return (!mElementsModified.isEmpty()) || (mLibrariesModified > 0);
+    });
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(WorkspaceLibraryWatcherTest, testAddedElement) {
+  FileUtils::writeFile(mPkgDir.getPathTo("pkg1/package.lp"), "1");
+  ASSERT_TRUE(waitForSignal());
+  EXPECT_EQ(1, mElementsModified.count());
+  EXPECT_EQ(QSet<FilePath>{mPkgDir}, mElementsModified.value(0));
+  EXPECT_EQ(0, mLibrariesModified);
+}
+
+TEST_F(WorkspaceLibraryWatcherTest, testRemovedElement) {
+  FileUtils::removeDirRecursively(mSymDir.getPathTo("sym2"));
+  ASSERT_TRUE(waitForSignal());
+  EXPECT_EQ(1, mElementsModified.count());
+  EXPECT_EQ(QSet<FilePath>{mSymDir}, mElementsModified.value(0));
+  EXPECT_EQ(0, mLibrariesModified);
+}
+
+TEST_F(WorkspaceLibraryWatcherTest, testRenamedElement) {
+  ASSERT_TRUE(QDir(mSymDir.toStr()).rename("sym1", "sym3"));
+  ASSERT_TRUE(waitForSignal());
+  EXPECT_EQ(1, mElementsModified.count());
+  EXPECT_EQ(QSet<FilePath>{mSymDir}, mElementsModified.value(0));
+  EXPECT_EQ(0, mLibrariesModified);
+}
+
+TEST_F(WorkspaceLibraryWatcherTest, testModifiedElement) {
+  // Files are replaced, not overwritten in place (like Git does it).
+  FileUtils::writeFile(mSymDir.getPathTo("sym1/symbol.lp"), "modified");
+  ASSERT_TRUE(waitForSignal());
+  EXPECT_EQ(1, mElementsModified.count());
+  EXPECT_EQ(QSet<FilePath>{}, mElementsModified.value(0));
+  EXPECT_EQ(QSet<FilePath>{mSymDir.getPathTo("sym1")},
+            mModifiedElements.value(0));
+  EXPECT_EQ(0, mLibrariesModified);
+}
+
+TEST_F(WorkspaceLibraryWatcherTest, testModificationsAreBatched) {
+  FileUtils::writeFile(mSymDir.getPathTo("sym3/symbol.lp"), "3");
+  FileUtils::writeFile(mPkgDir.getPathTo("pkg1/package.lp"), "1");
+  FileUtils::removeDirRecursively(mSymDir.getPathTo("sym2"));
+  ASSERT_TRUE(waitForSignal());
+  EXPECT_EQ(1, mElementsModified.count());
+  EXPECT_EQ((QSet<FilePath>{mSymDir, mPkgDir}), mElementsModified.value(0));
+  EXPECT_EQ(0, mLibrariesModified);
+}
+
+TEST_F(WorkspaceLibraryWatcherTest, testAddedLibrary) {
+  FileUtils::makePath(mLibsDir.getPathTo("local/New.lplib"));
+  ASSERT_TRUE(waitForSignal());
+  EXPECT_EQ(0, mElementsModified.count());
+  EXPECT_EQ(1, mLibrariesModified);
+}
+
+TEST_F(WorkspaceLibraryWatcherTest, testModifiedLibraryMetadata) {
+  FileUtils::writeFile(mLibDir.getPathTo("library.lp"), "lib");
+  FileUtils::writeFile(mSymDir.getPathTo("sym3/symbol.lp"), "3");
+  ASSERT_TRUE(waitForSignal());
+  EXPECT_EQ(0, mElementsModified.count());  // Covered by the full rescan.
+  EXPECT_EQ(1, mLibrariesModified);
+}
+
+TEST_F(WorkspaceLibraryWatcherTest, testSetWatchedDirectoriesReplacesOld) {
+  mWatcher->setWatchedDirectories({mPkgDir.toStr()});
+  FileUtils::writeFile(mLibDir.getPathTo("library.lp"), "lib");
+  FileUtils::writeFile(mPkgDir.getPathTo("pkg1/package.lp"), "1");
+  ASSERT_TRUE(waitForSignal());
+  EXPECT_EQ(1, mElementsModified.count());
+  EXPECT_EQ(QSet<FilePath>{mPkgDir}, mElementsModified.value(0));
+  EXPECT_EQ(0, mLibrariesModified);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -181,6 +181,9 @@ TEST_F(AddComponentDialogTest, testChooseComponentDevice) {
   // Save everything to disk
   mFs->save();
 
+  // Update category tree
+  mWriter->updateCategoryTree<ComponentCategory>();
+
   // Create dialog
   AddComponentDialog dialog(*mWsDb, {}, {}, Theme());
   QTreeView& catView =
@@ -256,6 +259,9 @@ TEST_F(AddComponentDialogTest, testSetNormOrder) {
   // Save everything to disk
   mFs->save();
 
+  // Update category tree
+  mWriter->updateCategoryTree<ComponentCategory>();
+
   // Create dialog
   AddComponentDialog dialog(*mWsDb, {}, {"NORM"}, Theme());
   QTreeView& catView =
@@ -57,7 +57,7 @@ TEST(BoardClipboardDataTest, testToFromMimeDataEmpty) {
   std::unique_ptr<QMimeData> mime1 = obj1.toMimeData();
 
   // Load from MIME data and validate
-  std::unique_ptr<BoardClipboardData> obj2 =
+  std::shared_ptr<const BoardClipboardData> obj2 =
       BoardClipboardData::fromMimeData(mime1.get());
   EXPECT_EQ(uuid, obj2->getBoardUuid());
   EXPECT_EQ(pos, obj2->getCursorPos());
@@ -207,7 +207,7 @@ TEST(BoardClipboardDataTest, testToFromMimeDataPopulated) {
   std::unique_ptr<QMimeData> mime1 = obj1.toMimeData();
 
   // Load from MIME data and validate
-  std::unique_ptr<BoardClipboardData> obj2 =
+  std::shared_ptr<const BoardClipboardData> obj2 =
       BoardClipboardData::fromMimeData(mime1.get());
   EXPECT_EQ(uuid, obj2->getBoardUuid());
   EXPECT_EQ(pos, obj2->getCursorPos());
@@ -220,6 +220,34 @@ TEST(BoardClipboardDataTest, testToFromMimeDataPopulated) {
   EXPECT_EQ(obj1.getPadPositions(), obj2->getPadPositions());
 }
 
+TEST(BoardClipboardDataTest, testToFromLazyMimeData) {
+  // Create object
+  Uuid uuid = Uuid::createRandom();
+  Point pos(12345, 54321);
+  std::shared_ptr<BoardClipboardData> obj1 =
+      std::make_shared<BoardClipboardData>(uuid, pos);
+  obj1->getPolygons().append(std::make_shared<Polygon>(
+      Uuid::createRandom(), Layer::topCopper(), UnsignedLength(1), false, true,
+      Path({Vertex(Point(1, 2), Angle(3)), Vertex(Point(4, 5), Angle(6))})));
+
+  // Within the same process, the object is passed by reference
+  std::unique_ptr<QMimeData> mime1 = BoardClipboardData::toLazyMimeData(obj1);
+  EXPECT_EQ(obj1, BoardClipboardData::fromMimeData(mime1.get()));
+
+  // Other processes only see the serialized data
+  QMimeData mime2;
+  foreach (const QString& format, mime1->formats()) {
+    mime2.setData(format, mime1->data(format));
+  }
+  std::shared_ptr<const BoardClipboardData> obj2 =
+      BoardClipboardData::fromMimeData(&mime2);
+  ASSERT_TRUE(obj2);
+  EXPECT_NE(obj1, obj2);
+  EXPECT_EQ(uuid, obj2->getBoardUuid());
+  EXPECT_EQ(pos, obj2->getCursorPos());
+  EXPECT_EQ(obj1->getPolygons(), obj2->getPolygons());
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
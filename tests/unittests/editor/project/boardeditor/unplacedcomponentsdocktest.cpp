@@ -0,0 +1,154 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/library/cmp/component.h>
+#include <librepcb/core/project/board/board.h>
+#include <librepcb/core/project/circuit/circuit.h>
+#include <librepcb/core/project/circuit/componentinstance.h>
+#include <librepcb/core/project/project.h>
+#include <librepcb/core/project/projectlibrary.h>
+#include <librepcb/core/workspace/workspace.h>
+#include <librepcb/editor/project/boardeditor/unplacedcomponentsdock.h>
+#include <librepcb/editor/project/projecteditor.h>
+
+#include <QtCore>
+#include <QtWidgets>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace editor {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class UnplacedComponentsDockTest : public ::testing::Test {
+protected:
+  FilePath mTmpDir;
+  std::unique_ptr<Workspace> mWorkspace;
+  std::unique_ptr<Project> mProject;
+  Board* mBoard;
+  Component* mComponent;
+  Uuid mSymbolVariantUuid;
+
+  UnplacedComponentsDockTest()
+    : mTmpDir(FilePath::getRandomTempPath()),
+      mBoard(nullptr),
+      mComponent(nullptr),
+      mSymbolVariantUuid(Uuid::createRandom()) {
+    QSettings().clear();
+    const FilePath wsDir = mTmpDir.getPathTo("workspace");
+    Workspace::createNewWorkspace(wsDir);
+    mWorkspace.reset(new Workspace(wsDir, "data"));
+    mProject = Project::create(
+        std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory(
+            TransactionalFileSystem::openRW(mTmpDir.getPathTo("project")))),
+        "project.lpp");
+    mBoard = new Board(
+        *mProject,
+        std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory()),
+        "board", Uuid::createRandom(), ElementName("Board"));
+    mProject->addBoard(*mBoard);
+    mComponent =
+        new Component(Uuid::createRandom(), Version::fromString("0.1"), "",
+                      ElementName("Resistor"), "", "");
+    mComponent->getSymbolVariants().append(
+        std::make_shared<ComponentSymbolVariant>(mSymbolVariantUuid, "",
+                                                 ElementName("default"), ""));
+    mProject->getLibrary().addComponent(*mComponent);
+  }
+
+  virtual ~UnplacedComponentsDockTest() {
+    mProject.reset();
+    mWorkspace.reset();
+    QDir(mTmpDir.toStr()).removeRecursively();
+  }
+
+  ComponentInstance& addComponent(const QString& name) {
+    Circuit& circuit = mProject->getCircuit();
+    ComponentInstance* cmp = new ComponentInstance(
+        circuit, Uuid::createRandom(), *mComponent, mSymbolVariantUuid,
+        CircuitIdentifier(name), tl::nullopt);
+    circuit.addComponentInstance(*cmp);
+    return *cmp;
+  }
+
+  static QStringList getItemTexts(const UnplacedComponentsDock& dock) {
+    const QListWidget* list =
+        dock.findChild<QListWidget*>("lstUnplacedComponents");
+    QStringList texts;
+    if (list) {
+      for (int i = 0; i < list->count(); ++i) {
+        texts.append(list->item(i)->text());
+      }
+    }
+    return texts;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(UnplacedComponentsDockTest, testItemsFollowComponentModifications) {
+  ComponentInstance& r1 = addComponent("R1");
+  addComponent("R2");
+  ProjectEditor editor(*mWorkspace, *mProject, tl::nullopt);
+  UnplacedComponentsDock dock(editor);
+  dock.setBoard(mBoard);
+  addComponent("R10");  // added after dock creation
+  EXPECT_EQ(QStringList({"R1:  Resistor", "R2:  Resistor", "R10:  Resistor"}),
+            getItemTexts(dock));
+
+  // Modifying the value updates the item in place.
+  r1.setValue("1k");
+  EXPECT_EQ(
+      QStringList({"R1: 1k Resistor", "R2:  Resistor", "R10:  Resistor"}),
+      getItemTexts(dock));
+
+  // Renaming moves the item to keep the list sorted.
+  r1.setName(CircuitIdentifier("R20"));
+  EXPECT_EQ(
+      QStringList({"R2:  Resistor", "R10:  Resistor", "R20: 1k Resistor"}),
+      getItemTexts(dock));
+  EXPECT_EQ(3, dock.getUnplacedComponentsCount());
+
+  // Removed components are no longer updated.
+  mProject->getCircuit().removeComponentInstance(r1);
+  r1.setName(CircuitIdentifier("R3"));
+  EXPECT_EQ(QStringList({"R2:  Resistor", "R10:  Resistor"}),
+            getItemTexts(dock));
+  delete &r1;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace editor
+}  // namespace librepcb
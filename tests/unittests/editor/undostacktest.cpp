@@ -0,0 +1,159 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/editor/undocommandgroup.h>
+#include <librepcb/editor/undostack.h>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace editor {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class UndoStackTest : public ::testing::Test {
+protected:
+  /**
+   * @brief Command which defers a side effect each time it is executed
+   */
+  class SideEffectCmd final : public UndoCommand {
+  public:
+    SideEffectCmd(QObject& object, int& counter) noexcept
+      : UndoCommand("Side Effect"), mObject(object), mCounter(counter) {}
+
+  private:
+    bool performExecute() override {
+      performRedo();
+      return true;
+    }
+    void performUndo() override { defer(); }
+    void performRedo() override { defer(); }
+    void defer() noexcept {
+      int& counter = mCounter;
+      UndoStack::deferSideEffect(mObject, "count",
+                                 [&counter]() { ++counter; });
+    }
+
+    QObject& mObject;
+    int& mCounter;
+  };
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(UndoStackTest, testSideEffectOutsideOfStackIsExecutedImmediately) {
+  QObject object;
+  int counter = 0;
+  UndoStack::deferSideEffect(object, "count", [&counter]() { ++counter; });
+  EXPECT_EQ(1, counter);
+  UndoStack::deferSideEffect(object, "count", [&counter]() { ++counter; });
+  EXPECT_EQ(2, counter);
+}
+
+TEST_F(UndoStackTest, testSideEffectsOfCommandGroupAreDeduplicated) {
+  QObject object;
+  int counter = 0;
+  UndoCommandGroup* cmd = new UndoCommandGroup("Group");
+  cmd->appendChild(new SideEffectCmd(object, counter));
+  cmd->appendChild(new SideEffectCmd(object, counter));
+  cmd->appendChild(new SideEffectCmd(object, counter));
+
+  UndoStack stack;
+  stack.execCmd(cmd);
+  EXPECT_EQ(1, counter);
+  stack.undo();
+  EXPECT_EQ(2, counter);
+  stack.redo();
+  EXPECT_EQ(3, counter);
+}
+
+TEST_F(UndoStackTest, testSideEffectsOfTransactionAreExecutedOnCommit) {
+  QObject object1;
+  QObject object2;
+  int counter1 = 0;
+  int counter2 = 0;
+
+  UndoStack stack;
+  {
+    UndoStackTransaction transaction(stack, "Transaction");
+    transaction.append(new SideEffectCmd(object1, counter1));
+    transaction.append(new SideEffectCmd(object2, counter2));
+    transaction.append(new SideEffectCmd(object1, counter1));
+    EXPECT_EQ(0, counter1);
+    EXPECT_EQ(0, counter2);
+    transaction.commit();
+    EXPECT_EQ(1, counter1);
+    EXPECT_EQ(1, counter2);
+  }
+  stack.undo();
+  EXPECT_EQ(2, counter1);
+  EXPECT_EQ(2, counter2);
+}
+
+TEST_F(UndoStackTest, testSideEffectsOfTransactionAreExecutedOnAbort) {
+  QObject object;
+  int counter = 0;
+
+  UndoStack stack;
+  {
+    UndoStackTransaction transaction(stack, "Transaction");
+    transaction.append(new SideEffectCmd(object, counter));
+    transaction.append(new SideEffectCmd(object, counter));
+    EXPECT_EQ(0, counter);
+  }  // Aborts the transaction.
+  EXPECT_EQ(1, counter);
+  EXPECT_FALSE(stack.canUndo());
+}
+
+TEST_F(UndoStackTest, testSideEffectsOfOtherStackAreNotDeferred) {
+  QObject object1;
+  QObject object2;
+  int counter1 = 0;
+  int counter2 = 0;
+
+  UndoStack stack1;
+  UndoStack stack2;
+  UndoStackTransaction transaction(stack1, "Transaction");
+  transaction.append(new SideEffectCmd(object1, counter1));
+  stack2.execCmd(new SideEffectCmd(object2, counter2));
+  EXPECT_EQ(0, counter1);
+  EXPECT_EQ(1, counter2);
+  transaction.commit();
+  EXPECT_EQ(1, counter1);
+  EXPECT_EQ(1, counter2);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace editor
+}  // namespace librepcb
@@ -90,6 +90,12 @@ protected:
 
   FilePath toAbs(const QString& fp) { return mWsDir.getPathTo(fp); }
 
+  void updateCategoryTrees() {
+    // Normally done by the library scanner after adding all elements.
+    mWriter->updateCategoryTree<ComponentCategory>();
+    mWriter->updateCategoryTree<PackageCategory>();
+  }
+
   Uuid uuid(int index = -1) {
     static QHash<int, Uuid> cache;
     if (index >= 0) {
@@ -123,6 +129,7 @@ TEST_F(CategoryTreeModelTest, testDatabaseError) {
 }
 
 TEST_F(CategoryTreeModelTest, testEmptyDb) {
+  updateCategoryTrees();
   CategoryTreeModel model(*mWsDb, {},
                           CategoryTreeModel::Filter::CmpCat |
                               CategoryTreeModel::Filter::CmpCatWithComponents);
@@ -141,6 +148,7 @@ TEST_F(CategoryTreeModelTest, testData) {
   mWriter->addTranslation<ComponentCategory>(cat, "", ElementName("cat 2"),
                                              tl::nullopt, tl::nullopt);
 
+  updateCategoryTrees();
   CategoryTreeModel model(*mWsDb, {}, CategoryTreeModel::Filter::CmpCat);
   QModelIndex i1 = model.index(0, 0);
   EXPECT_EQ("cat 1", str(i1.data(Qt::DisplayRole)));
@@ -174,6 +182,7 @@ TEST_F(CategoryTreeModelTest, testComponentCategories) {
   mWriter->addTranslation<ComponentCategory>(cat, "", ElementName("cat 4"),
                                              tl::nullopt, tl::nullopt);
 
+  updateCategoryTrees();
   CategoryTreeModel model(*mWsDb, {}, CategoryTreeModel::Filter::CmpCat);
   QVector<Item> expected = {
       {"cat 1",
@@ -210,6 +219,7 @@ TEST_F(CategoryTreeModelTest, testPackageCategories) {
   mWriter->addTranslation<PackageCategory>(cat, "", ElementName("cat 4"),
                                            tl::nullopt, tl::nullopt);
 
+  updateCategoryTrees();
   CategoryTreeModel model(*mWsDb, {}, CategoryTreeModel::Filter::PkgCat);
   QVector<Item> expected = {
       {"cat 1",
@@ -248,6 +258,7 @@ TEST_F(CategoryTreeModelTest, testSort) {
   mWriter->addTranslation<ComponentCategory>(cat, "", ElementName("cat 9"),
                                              tl::nullopt, tl::nullopt);
 
+  updateCategoryTrees();
   CategoryTreeModel model(*mWsDb, {}, CategoryTreeModel::Filter::CmpCat);
   QVector<Item> expected = {
       {"cat 9", {}},
@@ -274,6 +285,7 @@ TEST_F(CategoryTreeModelTest, testCmpCatWithEmpty) {
   mWriter->addTranslation<ComponentCategory>(cat, "", ElementName("cat 3"),
                                              tl::nullopt, tl::nullopt);
 
+  updateCategoryTrees();
   CategoryTreeModel model(*mWsDb, {},
                           CategoryTreeModel::Filter::CmpCatWithSymbols |
                               CategoryTreeModel::Filter::CmpCatWithComponents |
@@ -301,6 +313,7 @@ TEST_F(CategoryTreeModelTest, testCmpCatWithSymbols) {
                                         false);
   mWriter->addToCategory<Symbol>(sym, uuid(3));
 
+  updateCategoryTrees();
   CategoryTreeModel model(*mWsDb, {},
                           CategoryTreeModel::Filter::CmpCatWithSymbols);
   QVector<Item> expected = {
@@ -332,6 +345,7 @@ TEST_F(CategoryTreeModelTest, testCmpCatWithComponents) {
                                            version("0.1"), false);
   mWriter->addToCategory<Component>(cmp, uuid(3));
 
+  updateCategoryTrees();
   CategoryTreeModel model(*mWsDb, {},
                           CategoryTreeModel::Filter::CmpCatWithComponents);
   QVector<Item> expected = {
@@ -363,6 +377,7 @@ TEST_F(CategoryTreeModelTest, testCmpCatWithDevices) {
                                uuid(), uuid());
   mWriter->addToCategory<Device>(dev, uuid(3));
 
+  updateCategoryTrees();
   CategoryTreeModel model(*mWsDb, {},
                           CategoryTreeModel::Filter::CmpCatWithDevices);
   QVector<Item> expected = {
@@ -391,6 +406,7 @@ TEST_F(CategoryTreeModelTest, testPkgCatWithEmpty) {
   mWriter->addTranslation<PackageCategory>(cat, "", ElementName("cat 3"),
                                            tl::nullopt, tl::nullopt);
 
+  updateCategoryTrees();
   CategoryTreeModel model(*mWsDb, {},
                           CategoryTreeModel::Filter::PkgCatWithPackages);
   EXPECT_EQ(str(QVector<Item>{}), str(getItems(model)));
@@ -416,6 +432,7 @@ TEST_F(CategoryTreeModelTest, testPkgCatWithPackages) {
                                          version("0.1"), false);
   mWriter->addToCategory<Package>(pkg, uuid(3));
 
+  updateCategoryTrees();
   CategoryTreeModel model(*mWsDb, {},
                           CategoryTreeModel::Filter::PkgCatWithPackages);
   QVector<Item> expected = {
@@ -431,6 +448,7 @@ TEST_F(CategoryTreeModelTest, testWithoutCategory) {
   mWriter->addDevice(0, toAbs("dev"), uuid(), version("0.1"), false, uuid(),
                      uuid());
 
+  updateCategoryTrees();
   CategoryTreeModel model(*mWsDb, {},
                           CategoryTreeModel::Filter::CmpCatWithDevices);
   QVector<Item> expected = {
@@ -444,6 +462,7 @@ TEST_F(CategoryTreeModelTest, testInexistentCategory) {
                                uuid(), uuid());
   mWriter->addToCategory<Device>(dev, uuid(1));  // Inexistent category.
 
+  updateCategoryTrees();
   CategoryTreeModel model(*mWsDb, {},
                           CategoryTreeModel::Filter::CmpCatWithDevices);
   QVector<Item> expected = {
@@ -453,6 +472,7 @@ TEST_F(CategoryTreeModelTest, testInexistentCategory) {
 }
 
 TEST_F(CategoryTreeModelTest, testLiveUpdateAllNew) {
+  updateCategoryTrees();
   CategoryTreeModel model(*mWsDb, {}, CategoryTreeModel::Filter::CmpCat);
   QVector<Item> expected = {};
   EXPECT_EQ(str(expected), str(getItems(model)));
@@ -478,6 +498,7 @@ TEST_F(CategoryTreeModelTest, testLiveUpdateAllNew) {
   mWriter->addTranslation<ComponentCategory>(cat, "", ElementName("cat 4"),
                                              tl::nullopt, tl::nullopt);
 
+  updateCategoryTrees();
   emit mWsDb->scanSucceeded(0);  // Triggers a tree model update.
   qApp->processEvents();
   expected = {
@@ -515,6 +536,7 @@ TEST_F(CategoryTreeModelTest, testLiveUpdateAllRemoved) {
   mWriter->addTranslation<ComponentCategory>(cat, "", ElementName("cat 4"),
                                              tl::nullopt, tl::nullopt);
 
+  updateCategoryTrees();
   CategoryTreeModel model(*mWsDb, {}, CategoryTreeModel::Filter::CmpCat);
   QVector<Item> expected = {
       {"cat 1",
@@ -529,6 +551,7 @@ TEST_F(CategoryTreeModelTest, testLiveUpdateAllRemoved) {
   EXPECT_EQ(str(expected), str(getItems(model)));
 
   mWriter->removeAllElements<ComponentCategory>();
+  updateCategoryTrees();
   emit mWsDb->scanSucceeded(0);  // Triggers a tree model update.
   qApp->processEvents();
   expected = {};
@@ -557,6 +580,7 @@ TEST_F(CategoryTreeModelTest, testLiveUpdateVariousModifications) {
   mWriter->addTranslation<ComponentCategory>(cat, "", ElementName("cat 4"),
                                              tl::nullopt, tl::nullopt);
 
+  updateCategoryTrees();
   CategoryTreeModel model(*mWsDb, {}, CategoryTreeModel::Filter::CmpCat);
   QVector<Item> expected = {
       {"cat 1",
@@ -601,6 +625,7 @@ TEST_F(CategoryTreeModelTest, testLiveUpdateVariousModifications) {
   mWriter->addTranslation<ComponentCategory>(cat, "", ElementName("cat 7"),
                                              tl::nullopt, tl::nullopt);
 
+  updateCategoryTrees();
   emit mWsDb->scanSucceeded(0);  // Triggers a tree model update.
   qApp->processEvents();
   expected = {
@@ -633,6 +658,7 @@ TEST_F(CategoryTreeModelTest, testSetLocaleOrder) {
   mWriter->addTranslation<ComponentCategory>(cat, "de_CH", ElementName("cat 0"),
                                              tl::nullopt, tl::nullopt);
 
+  updateCategoryTrees();
   CategoryTreeModel model(*mWsDb, {}, CategoryTreeModel::Filter::CmpCat);
   QVector<Item> expected = {
       {"cat 1", {}},